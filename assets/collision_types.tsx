@@ -1,6 +1,6 @@
 <?xml version="1.0" encoding="UTF-8"?>
-<tileset version="1.10" tiledversion="1.10.1" name="collision_types" tilewidth="8" tileheight="8" tilecount="2" columns="2">
- <image source="editor/collision_types.png" trans="000000" width="16" height="8"/>
+<tileset version="1.10" tiledversion="1.10.1" name="collision_types" tilewidth="8" tileheight="8" tilecount="3" columns="3">
+ <image source="editor/collision_types.png" trans="000000" width="24" height="8"/>
  <tile id="0">
   <properties>
    <property name="collision" value="solid"/>
@@ -11,4 +11,9 @@
    <property name="collision" value="jumpthru"/>
   </properties>
  </tile>
+ <tile id="2">
+  <properties>
+   <property name="collision" value="none"/>
+  </properties>
+ </tile>
 </tileset>
@@ -1,5 +1,8 @@
 <?xml version="1.0" encoding="UTF-8"?>
 <tileset version="1.10" tiledversion="1.10.1" name="grassy_stone" tilewidth="8" tileheight="8" tilecount="55" columns="11">
+ <properties>
+  <property name="collision" value="solid"/>
+ </properties>
  <image source="grassy_stone.png" trans="000000" width="88" height="40"/>
  <wangsets>
   <wangset name="Unnamed Set" type="mixed" tile="-1">
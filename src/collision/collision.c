@@ -1,11 +1,29 @@
 #include "collision.h"
 #include "transition/transition.h"
-
-static int isPositionColliding(const Level* level, int screenX, int screenY) {
-    // 8x11 hitbox with configurable Y shift (adjust PLAYER_HITBOX_Y_SHIFT to change sprite ground position)
-    int playerLeft = screenX - PLAYER_WIDTH / 2;
-    int playerRight = screenX + PLAYER_WIDTH / 2;
-    int playerTop = PLAYER_TOP(screenY);
+#include "core/overlay.h"
+#include "core/cost_model.h"
+
+// Every routine below that depends on the hitbox size is an always_inline
+// body taking the width and height. PLAYER_HITBOXES stamps out one copy per
+// variant with the size as a literal, so each copy keeps the constant loop
+// bounds and edge offsets of a fixed-size hitbox; s_hitboxRoutines picks the
+// copy for the player's current hitbox once per call.
+
+#if HITBOX_TOP(0, PLAYER_HEIGHT) != PLAYER_TOP(0)
+#error "PLAYER_TOP must be the top of the HITBOX_NORMAL hitbox"
+#endif
+
+typedef int (*HitboxProbe)(const Level* level, int screenX, int screenY);
+
+// Hitbox-vs-solid-tile test, the innermost collision loop. Inlined into
+// both the gameplay IWRAM overlay copy and the ROM copy of each variant.
+static inline __attribute__((always_inline))
+int hitboxCollidesBody(const Level* level, int screenX, int screenY, int width, int height) {
+    // Hitbox with configurable Y shift (adjust PLAYER_HITBOX_Y_SHIFT to change sprite ground position)
+    COST_INSNS(20);
+    int playerLeft = screenX - width / 2;
+    int playerRight = screenX + width / 2;
+    int playerTop = HITBOX_TOP(screenY, height);
     int playerBottom = PLAYER_BOTTOM(screenY);
 
     int tileMinX = playerLeft / 8;
@@ -32,8 +50,17 @@ static int isPositionColliding(const Level* level, int screenX, int screenY) {
     return 0;
 }
 
+// Position test inside a sweep (ledge pop, bonk nudge): the variant's own
+// probe, or the runtime-sized body when there is none.
+static inline __attribute__((always_inline))
+int sweepProbe(HitboxProbe probe, const Level* level, int screenX, int screenY, int width, int height) {
+    return probe ? probe(level, screenX, screenY)
+                 : hitboxCollidesBody(level, screenX, screenY, width, height);
+}
 
-void collideHorizontal(Player* player, const Level* level) {
+static inline __attribute__((always_inline))
+void collideHorizontalBody(Player* player, const Level* level, int width, int height, HitboxProbe probe) {
+    COST_INSNS(40);
     // Horizontal sweep
     player->x += player->vx;
     int screenX = player->x >> FIXED_SHIFT;
@@ -41,7 +68,7 @@ void collideHorizontal(Player* player, const Level* level) {
 
     // Level bounds
     int levelWidthPx = level->width * 8;
-    int halfWidth = PLAYER_WIDTH / 2;
+    int halfWidth = width / 2;
     if (screenX < halfWidth) {
         player->x = halfWidth << FIXED_SHIFT;
         if (!tryTriggerTransition(level, CONN_SIDE_LEFT, screenY, player)) {
@@ -55,9 +82,9 @@ void collideHorizontal(Player* player, const Level* level) {
     } else {
         // Check for tile collision at new X position
         screenX = player->x >> FIXED_SHIFT;
-        int playerLeft = screenX - PLAYER_WIDTH / 2;
-        int playerRight = screenX + PLAYER_WIDTH / 2;
-        int playerTop = PLAYER_TOP(screenY);
+        int playerLeft = screenX - width / 2;
+        int playerRight = screenX + width / 2;
+        int playerTop = HITBOX_TOP(screenY, height);
         int playerBottom = PLAYER_BOTTOM(screenY);
 
         int tileMinX = playerLeft / 8;
@@ -79,8 +106,8 @@ void collideHorizontal(Player* player, const Level* level) {
                     playerBottom > tileTop && playerTop < tileBottom) {
                     // Collision - snap to tile edge instead of reverting
                     int snappedX = player->vx > 0
-                        ? (tileLeft - PLAYER_WIDTH / 2) << FIXED_SHIFT
-                        : (tileRight + PLAYER_WIDTH / 2) << FIXED_SHIFT;
+                        ? (tileLeft - width / 2) << FIXED_SHIFT
+                        : (tileRight + width / 2) << FIXED_SHIFT;
 
                     // Dash ledge pop: pop up only if overlap is within range
                     int popped = 0;
@@ -93,7 +120,7 @@ void collideHorizontal(Player* player, const Level* level) {
                         if (requiredPopPx > 0 && requiredPop <= DASH_LEDGE_POP_HEIGHT) {
                             int newY = originalY - requiredPop;
                             int newScreenY = newY >> FIXED_SHIFT;
-                            if (!isPositionColliding(level, baseScreenX, newScreenY)) {
+                            if (!sweepProbe(probe, level, baseScreenX, newScreenY, width, height)) {
                                 player->y = newY;
                                 popped = 1;
                             }
@@ -111,7 +138,9 @@ void collideHorizontal(Player* player, const Level* level) {
     }
 }
 
-void collideVertical(Player* player, const Level* level) {
+static inline __attribute__((always_inline))
+void collideVerticalBody(Player* player, const Level* level, int width, int height, HitboxProbe probe) {
+    COST_INSNS(40);
     // Vertical sweep
     player->y += player->vy;
     int screenX = player->x >> FIXED_SHIFT;
@@ -120,16 +149,16 @@ void collideVertical(Player* player, const Level* level) {
     player->onGround = 0;
 
     // Ceiling bounds
-    if (PLAYER_TOP(screenY) < 0) {
-        player->y = (-PLAYER_TOP(0)) << FIXED_SHIFT;
+    if (HITBOX_TOP(screenY, height) < 0) {
+        player->y = (-HITBOX_TOP(0, height)) << FIXED_SHIFT;
         if (!tryTriggerTransition(level, CONN_SIDE_TOP, screenX, player)) {
             player->vy = 0;
         }
     } else {
         // Check for tile collision at new Y position
-        int playerLeft = screenX - PLAYER_WIDTH / 2;
-        int playerRight = screenX + PLAYER_WIDTH / 2;
-        int playerTop = PLAYER_TOP(screenY);
+        int playerLeft = screenX - width / 2;
+        int playerRight = screenX + width / 2;
+        int playerTop = HITBOX_TOP(screenY, height);
         int playerBottom = PLAYER_BOTTOM(screenY);
 
         int tileMinX = playerLeft / 8;
@@ -174,11 +203,11 @@ void collideVertical(Player* player, const Level* level) {
                         for (int nudge = FIXED_ONE; nudge <= BONK_NUDGE_RANGE; nudge += FIXED_ONE) {
                             int newXRight = originalX + nudge;
                             int newScreenXRight = newXRight >> FIXED_SHIFT;
-                            int clearRight = !isPositionColliding(level, newScreenXRight, screenY);
+                            int clearRight = !sweepProbe(probe, level, newScreenXRight, screenY, width, height);
 
                             int newXLeft = originalX - nudge;
                             int newScreenXLeft = newXLeft >> FIXED_SHIFT;
-                            int clearLeft = !isPositionColliding(level, newScreenXLeft, screenY);
+                            int clearLeft = !sweepProbe(probe, level, newScreenXLeft, screenY, width, height);
 
                             if (clearRight ^ clearLeft) {
                                 if (clearRight) {
@@ -193,8 +222,8 @@ void collideVertical(Player* player, const Level* level) {
 
                         if (!nudged) {
                             player->x = originalX;
-                            // PLAYER_TOP(Y) = tileBottom, so solve for Y
-                            player->y = (tileBottom + PLAYER_HEIGHT / 2 + 1 - PLAYER_HITBOX_Y_SHIFT) << FIXED_SHIFT;
+                            // HITBOX_TOP(Y) = tileBottom, so solve for Y
+                            player->y = (tileBottom - HITBOX_TOP(0, height)) << FIXED_SHIFT;
                             player->vy = 0;
                         }
                     }
@@ -217,8 +246,8 @@ void collideVertical(Player* player, const Level* level) {
         screenX = player->x >> FIXED_SHIFT;
         screenY = player->y >> FIXED_SHIFT;
         int playerBottom = PLAYER_BOTTOM(screenY);
-        int playerLeft = screenX - PLAYER_WIDTH / 2;
-        int playerRight = screenX + PLAYER_WIDTH / 2;
+        int playerLeft = screenX - width / 2;
+        int playerRight = screenX + width / 2;
         int feetY = (playerBottom + 1) / 8;
         int tileMinX = playerLeft / 8;
         int tileMaxX = playerRight / 8;
@@ -242,8 +271,58 @@ void collideVertical(Player* player, const Level* level) {
     }
 }
 
+// One variant: IWRAM and ROM probe copies behind a residency dispatch, and
+// the two sweeps, which run from ROM.
+#define HITBOX_VARIANT(id, name, width, height) \
+    IWRAM_OVERLAY_GAMEPLAY \
+    static int hitboxCollides##name##Iwram(const Level* level, int screenX, int screenY) { \
+        return hitboxCollidesBody(level, screenX, screenY, width, height); \
+    } \
+    static int hitboxCollides##name##Rom(const Level* level, int screenX, int screenY) { \
+        return hitboxCollidesBody(level, screenX, screenY, width, height); \
+    } \
+    static int hitboxCollides##name(const Level* level, int screenX, int screenY) { \
+        return OVERLAY_DISPATCH(OVERLAY_GAMEPLAY, \
+                                hitboxCollides##name##Iwram(level, screenX, screenY), \
+                                hitboxCollides##name##Rom(level, screenX, screenY)); \
+    } \
+    static void collideHorizontal##name(Player* player, const Level* level) { \
+        collideHorizontalBody(player, level, width, height, hitboxCollides##name); \
+    } \
+    static void collideVertical##name(Player* player, const Level* level) { \
+        collideVerticalBody(player, level, width, height, hitboxCollides##name); \
+    }
+
+PLAYER_HITBOXES(HITBOX_VARIANT)
+
+typedef struct {
+    HitboxProbe collides;
+    void (*collideHorizontal)(Player* player, const Level* level);
+    void (*collideVertical)(Player* player, const Level* level);
+} HitboxRoutines;
+
+#define HITBOX_ROUTINES_ENTRY(id, name, width, height) \
+    [HITBOX_##id] = { hitboxCollides##name, collideHorizontal##name, collideVertical##name },
+
+static const HitboxRoutines s_hitboxRoutines[HITBOX_COUNT] = {
+    PLAYER_HITBOXES(HITBOX_ROUTINES_ENTRY)
+};
+
+
+void collideHorizontal(Player* player, const Level* level) {
+    s_hitboxRoutines[playerHitbox(player)].collideHorizontal(player, level);
+}
+
+void collideVertical(Player* player, const Level* level) {
+    s_hitboxRoutines[playerHitbox(player)].collideVertical(player, level);
+}
+
 int isPositionCollidingAt(const Level* level, int screenX, int screenY) {
-    return isPositionColliding(level, screenX, screenY);
+    return hitboxCollidesNormal(level, screenX, screenY);
+}
+
+int isHitboxCollidingAt(const Level* level, HitboxId hitbox, int screenX, int screenY) {
+    return s_hitboxRoutines[hitbox].collides(level, screenX, screenY);
 }
 
 int checkWallAt(const Player* player, const Level* level, int dir, int yAdd, int dist) {
@@ -254,7 +333,7 @@ int checkWallAt(const Player* player, const Level* level, int dir, int yAdd, int
     int checkX = screenX + (dir * dist);
     int checkY = screenY;
 
-    return isPositionCollidingAt(level, checkX, checkY);
+    return isHitboxCollidingAt(level, playerHitbox(player), checkX, checkY);
 }
 
 int checkWall(const Player* player, const Level* level, int dir) {
@@ -262,27 +341,29 @@ int checkWall(const Player* player, const Level* level, int dir) {
 }
 
 int checkCeiling(const Player* player, const Level* level) {
+    // Unducking swaps the duck hitbox for the standing one around the same
+    // bottom edge; it is blocked if the standing hitbox would overlap a solid
+    // tile there (Celeste CanUnDuck). JumpThru never blocks it.
     int screenX = player->x >> FIXED_SHIFT;
     int screenY = player->y >> FIXED_SHIFT;
 
-    // When ducking, player has reduced height
-    // Check if standing height would collide with ceiling
-    // Standing uses full PLAYER_RADIUS_Y (8), ducking typically uses half
-    // We need to check if the top of standing hitbox would hit anything
-
-    int standingTop = PLAYER_TOP(screenY);
+    return hitboxCollidesNormal(level, screenX, screenY);
+}
 
-    // Check tiles above the player at standing height
-    int tileMinX = (screenX - PLAYER_WIDTH / 2) / 8;
-    int tileMaxX = (screenX + PLAYER_WIDTH / 2) / 8;
-    int tileY = standingTop / 8;
+#ifdef DESKTOP_BUILD
+// noclone: keep GCC from propagating the benchmark's sizes into a copy
+__attribute__((noinline, noclone))
+int hitboxCollidesSized(const Level* level, int screenX, int screenY, int width, int height) {
+    return hitboxCollidesBody(level, screenX, screenY, width, height);
+}
 
-    for (int tx = tileMinX; tx <= tileMaxX; tx++) {
-        // Only solid tiles block unducking (JumpThru doesn't)
-        if (getTileCollision(level, tx, tileY) == COL_SOLID) {
-            return 1;  // Ceiling blocking
-        }
-    }
+__attribute__((noinline, noclone))
+void collideHorizontalSized(Player* player, const Level* level, int width, int height) {
+    collideHorizontalBody(player, level, width, height, NULL);
+}
 
-    return 0;  // Clear to unduck
+__attribute__((noinline, noclone))
+void collideVerticalSized(Player* player, const Level* level, int width, int height) {
+    collideVerticalBody(player, level, width, height, NULL);
 }
+#endif
@@ -5,9 +5,33 @@
 #include "core/game_math.h"
 #include "level/level.h"
 
+// Player hitbox variants: X(id, name, width, height). Every variant is
+// centred on the player's X and shares the bottom edge (PLAYER_BOTTOM), so
+// only its top edge and width differ. collision.c compiles one copy of the
+// sweeps and probes per entry, with the size folded in as constants.
+#define PLAYER_HITBOXES(X) \
+    X(NORMAL, Normal, PLAYER_WIDTH, PLAYER_HEIGHT) \
+    X(DUCK,   Duck,   PLAYER_WIDTH, PLAYER_DUCK_HEIGHT)
+
+#define HITBOX_ENUM_ENTRY(id, name, width, height) HITBOX_##id,
+typedef enum {
+    PLAYER_HITBOXES(HITBOX_ENUM_ENTRY)
+    HITBOX_COUNT
+} HitboxId;
+#undef HITBOX_ENUM_ENTRY
+
+// Top edge of a hitbox of the given height, in pixels
+#define HITBOX_TOP(y, height) (PLAYER_BOTTOM(y) - (height))
+
+// The hitbox the sweeps use for the player's current state
+static inline HitboxId playerHitbox(const Player* player) {
+    return player->ducking ? HITBOX_DUCK : HITBOX_NORMAL;
+}
+
 /**
  * Perform horizontal collision sweep
- * Moves player horizontally and resolves collisions with tiles and level bounds
+ * Moves player horizontally and resolves collisions with tiles and level bounds,
+ * using the player's current hitbox (playerHitbox)
  *
  * @param player The player to move
  * @param level The level to check collisions against
@@ -16,7 +40,8 @@ void collideHorizontal(Player* player, const Level* level);
 
 /**
  * Perform vertical collision sweep
- * Moves player vertically and resolves collisions with tiles and level bounds
+ * Moves player vertically and resolves collisions with tiles and level bounds,
+ * using the player's current hitbox (playerHitbox)
  * Updates onGround flag and dash state
  *
  * @param player The player to move
@@ -25,7 +50,7 @@ void collideHorizontal(Player* player, const Level* level);
 void collideVertical(Player* player, const Level* level);
 
 /**
- * Check if the player's hitbox collides at a given screen position.
+ * Check if the standing (HITBOX_NORMAL) hitbox collides at a given screen position.
  *
  * @param level The level to check against
  * @param screenX Player center X in pixels
@@ -35,7 +60,19 @@ void collideVertical(Player* player, const Level* level);
 int isPositionCollidingAt(const Level* level, int screenX, int screenY);
 
 /**
- * Check if there's a wall adjacent to the player at a Y offset
+ * Check if a given hitbox variant collides at a given screen position.
+ *
+ * @param level The level to check against
+ * @param hitbox Hitbox variant to test
+ * @param screenX Player center X in pixels
+ * @param screenY Player center Y in pixels
+ * @return 1 if colliding, 0 otherwise
+ */
+int isHitboxCollidingAt(const Level* level, HitboxId hitbox, int screenX, int screenY);
+
+/**
+ * Check if there's a wall adjacent to the player at a Y offset, using the
+ * player's current hitbox
  *
  * @param player The player to check
  * @param level The level to check against
@@ -57,7 +94,8 @@ int checkWallAt(const Player* player, const Level* level, int dir, int yAdd, int
 int checkWall(const Player* player, const Level* level, int dir);
 
 /**
- * Check if there's a ceiling above the player that would prevent unducking
+ * Check if there's a ceiling above the player that would prevent unducking,
+ * i.e. whether the standing hitbox collides at the player's position
  *
  * @param player The player to check
  * @param level The level to check against
@@ -65,4 +103,27 @@ int checkWall(const Player* player, const Level* level, int dir);
  */
 int checkCeiling(const Player* player, const Level* level);
 
+/**
+ * Unduck if the standing hitbox fits, otherwise stay in the duck hitbox.
+ * Every unduck goes through here so the player is never left standing
+ * inside a ceiling.
+ *
+ * @param player The player to unduck
+ * @param level The level to check against
+ */
+static inline void tryUnduck(Player* player, const Level* level) {
+    if (player->ducking && !checkCeiling(player, level)) {
+        player->ducking = 0;
+    }
+}
+
+#ifdef DESKTOP_BUILD
+// Runtime-sized builds of the same routines: one copy for any hitbox size,
+// with the width and height as ordinary arguments. Only the desktop
+// benchmark (tests/test_hitbox_variants.c) calls them.
+int hitboxCollidesSized(const Level* level, int screenX, int screenY, int width, int height);
+void collideHorizontalSized(Player* player, const Level* level, int width, int height);
+void collideVerticalSized(Player* player, const Level* level, int width, int height);
+#endif
+
 #endif
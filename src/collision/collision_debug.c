@@ -0,0 +1,161 @@
+#include "collision_debug.h"
+
+#if COLLISION_DEBUG_ENABLED
+
+#include "collision.h"
+#include "level/level.h"
+
+ColDebugProbe g_colDebugProbes[COLDEBUG_MAX_PROBES];
+int g_colDebugProbeCount = 0;
+
+static int s_redundant = 0;
+
+void colDebugBeginFrame(void) {
+    g_colDebugProbeCount = 0;
+}
+
+int colDebugProbeCount(void) {
+    return g_colDebugProbeCount;
+}
+
+int colDebugRedundantCount(void) {
+    return s_redundant;
+}
+
+#ifndef DESKTOP_BUILD
+
+#include "core/assets.h"
+#include "core/vblank_queue.h"
+#include "core/vram_layout.h"
+
+// Palette entries: one per CollisionType, then the hitbox
+#define COLOUR_NONE     1
+#define COLOUR_SOLID    2
+#define COLOUR_JUMPTHRU 3
+#define COLOUR_HITBOX   4
+
+#define HITBOX_TOO_BIG(id, name, width, height) || (width) > 8 || (height) > 16
+#if 0 PLAYER_HITBOXES(HITBOX_TOO_BIG)
+#error "Hitbox outline sprite is 8x16"
+#endif
+#undef HITBOX_TOO_BIG
+
+#define OUTLINE_ROW(c) (0x11111111u * (c))
+#define OUTLINE_SIDES(c) ((u32)(c) | ((u32)(c) << 28))
+#define OUTLINE_TILE(c) { OUTLINE_ROW(c), OUTLINE_SIDES(c), OUTLINE_SIDES(c), OUTLINE_SIDES(c), \
+                          OUTLINE_SIDES(c), OUTLINE_SIDES(c), OUTLINE_SIDES(c), OUTLINE_ROW(c) }
+
+// Indexed by CollisionType (TILE_OBJ_COLDEBUG + result)
+static const u32 s_outlineTiles[3][8] = {
+    OUTLINE_TILE(COLOUR_NONE),
+    OUTLINE_TILE(COLOUR_SOLID),
+    OUTLINE_TILE(COLOUR_JUMPTHRU),
+};
+
+static const u16 s_palette[16] = {
+    0,
+    RGB15(20, 20, 20),  // probed, passable
+    RGB15(31, 4, 4),    // solid
+    RGB15(31, 28, 0),   // jump-through
+    RGB15(4, 28, 31),   // hitbox
+};
+
+// One 8x16 sprite (two tiles, 1D mapping) per HitboxId, with that hitbox's
+// outline at its top left
+static u32 s_hitboxTiles[HITBOX_COUNT][2][8] __attribute__((aligned(4)));
+
+#define HITBOX_SIZE_ENTRY(id, name, width, height) { width, height },
+static const u8 s_hitboxSizes[HITBOX_COUNT][2] = {
+    PLAYER_HITBOXES(HITBOX_SIZE_ENTRY)
+};
+#undef HITBOX_SIZE_ENTRY
+
+static void buildHitboxTiles(void) {
+    for (int h = 0; h < HITBOX_COUNT; h++) {
+        int width = s_hitboxSizes[h][0];
+        int height = s_hitboxSizes[h][1];
+        u32* rows = &s_hitboxTiles[h][0][0];
+        u32 right = (u32)COLOUR_HITBOX << ((width - 1) * 4);
+        for (int y = 0; y < 16; y++) {
+            if (y == 0 || y == height - 1) {
+                rows[y] = OUTLINE_ROW(COLOUR_HITBOX) >> ((8 - width) * 4);
+            } else if (y < height) {
+                rows[y] = COLOUR_HITBOX | right;
+            } else {
+                rows[y] = 0;
+            }
+        }
+    }
+}
+
+void colDebugInit(void) {
+    buildHitboxTiles();
+    AssetEntry entries[] = {
+        { "coldebug outlines", ASSET_COPY, s_outlineTiles, &tile_mem[4][TILE_OBJ_COLDEBUG], sizeof(s_outlineTiles), 0 },
+        { "coldebug hitbox",   ASSET_COPY, s_hitboxTiles,  &tile_mem[4][TILE_OBJ_COLDEBUG_HITBOX], sizeof(s_hitboxTiles), 0 },
+        { "coldebug palette",  ASSET_COPY, s_palette,      &pal_obj_mem[PAL_OBJ_COLDEBUG * 16], sizeof(s_palette), 0 },
+    };
+    assetLoad(entries, sizeof(entries) / sizeof(entries[0]));
+    colDebugHide();
+}
+
+static void setSprite(int index, int x, int y, u16 shape, u16 tile) {
+    g_oamShadow[index].attr0 = (u16)((y & 0xFF) | (shape << 14));
+    g_oamShadow[index].attr1 = (u16)(x & 0x1FF);
+    g_oamShadow[index].attr2 = (u16)(tile | (0 << 10) | (PAL_OBJ_COLDEBUG << 12));
+}
+
+void colDebugRender(const Player* player, int cameraX, int cameraY) {
+    // Distinct tiles, in probe order; repeats only bump the redundant count
+    u8 distinct[COLDEBUG_MAX_PROBES];
+    int distinctCount = 0;
+    int recorded = g_colDebugProbeCount < COLDEBUG_MAX_PROBES ? g_colDebugProbeCount : COLDEBUG_MAX_PROBES;
+    s_redundant = 0;
+    for (int i = 0; i < recorded; i++) {
+        const ColDebugProbe* p = &g_colDebugProbes[i];
+        int seen = 0;
+        for (int j = 0; j < distinctCount; j++) {
+            const ColDebugProbe* q = &g_colDebugProbes[distinct[j]];
+            if (q->tileX == p->tileX && q->tileY == p->tileY) {
+                seen = 1;
+                break;
+            }
+        }
+        if (seen) {
+            s_redundant++;
+        } else {
+            distinct[distinctCount++] = (u8)i;
+        }
+    }
+
+    HitboxId hitbox = playerHitbox(player);
+    int playerX = player->x >> FIXED_SHIFT;
+    int playerY = player->y >> FIXED_SHIFT;
+    int sprite = OAM_COLDEBUG_BASE;
+    setSprite(sprite++, playerX - s_hitboxSizes[hitbox][0] / 2 - cameraX,
+              HITBOX_TOP(playerY, s_hitboxSizes[hitbox][1]) - cameraY,
+              2, (u16)(TILE_OBJ_COLDEBUG_HITBOX + hitbox * 2));  // shape 2 + size 0 = 8x16
+
+    for (int i = 0; i < distinctCount && sprite < OAM_COLDEBUG_BASE + OAM_COLDEBUG_COUNT; i++) {
+        const ColDebugProbe* p = &g_colDebugProbes[distinct[i]];
+        int x = p->tileX * 8 - cameraX;
+        int y = p->tileY * 8 - cameraY;
+        if (x <= -8 || x >= 240 || y <= -8 || y >= 160) continue;
+        int result = p->result <= COL_JUMPTHRU ? p->result : COL_SOLID;
+        setSprite(sprite++, x, y, 0, (u16)(TILE_OBJ_COLDEBUG + result));
+    }
+
+    while (sprite < OAM_COLDEBUG_BASE + OAM_COLDEBUG_COUNT) {
+        g_oamShadow[sprite++].attr0 = 160;  // Y offscreen
+    }
+}
+
+void colDebugHide(void) {
+    for (int i = 0; i < OAM_COLDEBUG_COUNT; i++) {
+        g_oamShadow[OAM_COLDEBUG_BASE + i].attr0 = 160;
+    }
+}
+
+#endif // !DESKTOP_BUILD
+
+#endif // COLLISION_DEBUG_ENABLED
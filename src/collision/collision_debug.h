@@ -0,0 +1,74 @@
+#ifndef COLLISION_DEBUG_H
+#define COLLISION_DEBUG_H
+
+#include "core/game_types.h"
+
+// On-device collision probe overlay (make COLDEBUG=1).
+//
+// Every getTileCollision() call is a probe, whoever makes it: the sweeps,
+// the hitbox tests behind checkWallAt / isPositionCollidingAt, the bonk
+// nudge search and the player states' own tile checks. With the overlay
+// compiled in, each probe appends its tile and result to a fixed per-frame
+// buffer (a compare, three stores and an increment); colDebugRender() then
+// outlines the distinct tiles with reserved OBJ sprites, colour-coded by
+// result, plus the player hitbox. The profiling text gains a "Pr:" line
+// with the worst probe count and how many of those probes re-read a tile
+// already probed that frame.
+//
+// Release builds (COLDEBUG=0, the default) compile all of it out.
+
+#ifndef COLLISION_DEBUG_ENABLED
+#define COLLISION_DEBUG_ENABLED 0
+#endif
+
+#define COLDEBUG_MAX_PROBES 64   // recorded per frame; the count keeps going
+
+#if COLLISION_DEBUG_ENABLED
+
+typedef struct {
+    s16 tileX;
+    s16 tileY;
+    u8 result;   // CollisionType
+    u8 pad;
+} ColDebugProbe;
+
+extern ColDebugProbe g_colDebugProbes[COLDEBUG_MAX_PROBES];
+extern int g_colDebugProbeCount;
+
+static inline void colDebugProbe(int tileX, int tileY, int result) {
+    int n = g_colDebugProbeCount++;
+    if (n < COLDEBUG_MAX_PROBES) {
+        g_colDebugProbes[n].tileX = (s16)tileX;
+        g_colDebugProbes[n].tileY = (s16)tileY;
+        g_colDebugProbes[n].result = (u8)result;
+    }
+}
+
+#define COLDEBUG_PROBE(tileX, tileY, result) colDebugProbe((tileX), (tileY), (result))
+
+// Start a new frame's recording (before the player update).
+void colDebugBeginFrame(void);
+
+// Probes this frame, and how many of the recorded ones repeated a tile
+// (valid after colDebugRender).
+int colDebugProbeCount(void);
+int colDebugRedundantCount(void);
+
+#ifndef DESKTOP_BUILD
+// Outline tiles and palette (boot).
+void colDebugInit(void);
+
+// Draw this frame's probes and the outline of the hitbox the sweeps use
+// for the player's state (playerHitbox), relative to the camera.
+void colDebugRender(const Player* player, int cameraX, int cameraY);
+
+void colDebugHide(void);
+#endif
+
+#else
+
+#define COLDEBUG_PROBE(tileX, tileY, result) ((void)0)
+
+#endif // COLLISION_DEBUG_ENABLED
+
+#endif // COLLISION_DEBUG_H
@@ -0,0 +1,64 @@
+#include <tonc.h>
+#include "assets.h"
+#include "core/vram_layout.h"
+#include "nightsky.h"
+#include "grassy_stone.h"
+#include "plants.h"
+#include "decals.h"
+#include "skelly.h"
+#include "tinypixie.h"
+
+// Dash trail fade: PAL_OBJ_TRAIL_COUNT silhouettes from bright (10,20,31)
+// down to light blue (2,6,16), index 0 transparent.
+#define TRAIL_CLAMP(v, lo) ((v) < (lo) ? (lo) : (v))
+#define TRAIL_RGB(p) RGB15(TRAIL_CLAMP(10 - ((p) * 8) / 10, 2), \
+                           TRAIL_CLAMP(20 - ((p) * 14) / 10, 6), \
+                           TRAIL_CLAMP(31 - ((p) * 15) / 10, 16))
+#define TRAIL_PAL(p) 0, TRAIL_RGB(p), TRAIL_RGB(p), TRAIL_RGB(p), TRAIL_RGB(p), TRAIL_RGB(p), \
+                     TRAIL_RGB(p), TRAIL_RGB(p), TRAIL_RGB(p), TRAIL_RGB(p), TRAIL_RGB(p), \
+                     TRAIL_RGB(p), TRAIL_RGB(p), TRAIL_RGB(p), TRAIL_RGB(p), TRAIL_RGB(p)
+
+static const u16 s_trailPals[PAL_OBJ_TRAIL_COUNT * 16] __attribute__((aligned(4))) = {
+    TRAIL_PAL(0), TRAIL_PAL(1), TRAIL_PAL(2), TRAIL_PAL(3), TRAIL_PAL(4),
+    TRAIL_PAL(5), TRAIL_PAL(6), TRAIL_PAL(7), TRAIL_PAL(8), TRAIL_PAL(9),
+};
+#if PAL_OBJ_TRAIL_COUNT != 10
+#error "s_trailPals lists one TRAIL_PAL per trail bank"
+#endif
+
+// Entities use colour 1 of their bank on the shared filled tile
+static const u16 s_springPal[2]      __attribute__((aligned(4))) = { 0, RGB15(31, 0, 0) };   // bright red
+static const u16 s_redBubblePal[2]   __attribute__((aligned(4))) = { 0, RGB15(31, 16, 0) };  // orange
+static const u16 s_greenBubblePal[2] __attribute__((aligned(4))) = { 0, RGB15(0, 31, 0) };   // bright green
+
+#define BG_PAL(bank)  (&pal_bg_mem[(bank) * 16])
+#define OBJ_PAL(bank) (&pal_obj_mem[(bank) * 16])
+
+const AssetEntry g_bootAssets[] = {
+    // BG0 night sky: tiles, map (with its palette bank ORed in), palette
+    { "nightsky tiles", ASSET_COPY,   nightskyTiles, &tile_mem[CB_NIGHTSKY][0], nightskyTilesLen, 0 },
+    { "nightsky map",   ASSET_MAP_OR, nightskyMap,   se_mem[SB_NIGHTSKY],       nightskyMapLen,   PAL_BG_NIGHTSKY << 12 },
+    { "nightsky pal",   ASSET_COPY,   nightskyPal,   BG_PAL(PAL_BG_NIGHTSKY),   nightskyPalLen,   0 },
+
+    // Gameplay / text BG palettes; colour 0 is the transparent backdrop
+    { "terrain pal",    ASSET_COPY,   grassy_stonePal, BG_PAL(PAL_BG_TERRAIN),  32, 0 },
+    { "backdrop",       ASSET_FILL,   0,               BG_PAL(PAL_BG_TERRAIN),  2,  0 },
+    { "font pal",       ASSET_COPY,   tinypixiePal,    BG_PAL(PAL_BG_FONT),     32, 0 },
+    { "plants pal",     ASSET_COPY,   plantsPal,       BG_PAL(PAL_BG_PLANTS),   32, 0 },
+    { "decals pal",     ASSET_COPY,   decalsPal,       BG_PAL(PAL_BG_DECALS),   32, 0 },
+
+    // Gameplay maps start empty (the menu shows no level)
+    { "bg1 map",        ASSET_FILL,   0, se_mem[SB_BG1], 32 * 32 * 2, 0 },
+    { "bg2 map",        ASSET_FILL,   0, se_mem[SB_BG2], 32 * 32 * 2, 0 },
+
+    // Sprites: player (4 tiles), shared entity square, palettes
+    { "player tiles",   ASSET_COPY,   skellyTiles, &tile_mem[4][TILE_OBJ_PLAYER], 4 * 32, 0 },
+    { "entity tile",    ASSET_FILL,   0,           &tile_mem[4][TILE_OBJ_ENTITY], 32,     0x1111 },
+    { "player pal",     ASSET_COPY,   skellyPal,   OBJ_PAL(PAL_OBJ_PLAYER),       32,     0 },
+    { "trail pals",     ASSET_COPY,   s_trailPals, OBJ_PAL(PAL_OBJ_TRAIL_BASE),   sizeof(s_trailPals), 0 },
+    { "spring pal",     ASSET_COPY,   s_springPal,      OBJ_PAL(PAL_OBJ_SPRING),       sizeof(s_springPal), 0 },
+    { "red bubble pal", ASSET_COPY,   s_redBubblePal,   OBJ_PAL(PAL_OBJ_RED_BUBBLE),   sizeof(s_redBubblePal), 0 },
+    { "green bubble pal", ASSET_COPY, s_greenBubblePal, OBJ_PAL(PAL_OBJ_GREEN_BUBBLE), sizeof(s_greenBubblePal), 0 },
+};
+
+const int g_bootAssetCount = sizeof(g_bootAssets) / sizeof(g_bootAssets[0]);
@@ -0,0 +1,65 @@
+#include <tonc.h>
+#include "assets.h"
+
+static u32 s_lastLoadBytes = 0;
+
+static int wordAligned(const volatile void* p) {
+    return ((u32)p & 3) == 0;
+}
+
+static void copyAsset(const AssetEntry* e) {
+    if ((e->bytes & 31) == 0 && wordAligned(e->src) && wordAligned(e->dst)) {
+        CpuFastSet(e->src, (void*)e->dst, (e->bytes >> 2) | CFS_CPY);
+    } else if ((e->bytes & 3) == 0 && wordAligned(e->src) && wordAligned(e->dst)) {
+        dma3_cpy((void*)e->dst, e->src, e->bytes);
+    } else {
+        dma_cpy((void*)e->dst, e->src, e->bytes >> 1, 3, DMA_CPY16);
+    }
+}
+
+static void fillAsset(const AssetEntry* e) {
+    // CpuFastSet / DMA fill read the value from memory
+    volatile u32 fill = e->arg | ((u32)e->arg << 16);
+    if ((e->bytes & 31) == 0 && wordAligned(e->dst)) {
+        CpuFastSet((const void*)&fill, (void*)e->dst, (e->bytes >> 2) | CFS_FILL);
+    } else if ((e->bytes & 3) == 0 && wordAligned(e->dst)) {
+        dma3_fill((void*)e->dst, fill, e->bytes);
+    } else {
+        dma_fill((void*)e->dst, fill, e->bytes >> 1, 3, DMA_FILL16);
+    }
+}
+
+// Screen entries are ORed two at a time (src and dst must be word aligned,
+// as grit output and screenblocks are).
+static void mapOrAsset(const AssetEntry* e) {
+    u32 bits = e->arg | ((u32)e->arg << 16);
+    const u32* src = (const u32*)e->src;
+    volatile u32* dst = (volatile u32*)e->dst;
+    for (u32 i = 0; i < (e->bytes >> 2); i++) {
+        dst[i] = src[i] | bits;
+    }
+    if (e->bytes & 2) {
+        ((volatile u16*)e->dst)[(e->bytes >> 1) - 1] = ((const u16*)e->src)[(e->bytes >> 1) - 1] | e->arg;
+    }
+}
+
+u16 assetLoad(const AssetEntry* entries, int count) {
+    u16 t0 = REG_TM0CNT_L;
+    u32 bytes = 0;
+    for (int i = 0; i < count; i++) {
+        const AssetEntry* e = &entries[i];
+        if (e->bytes == 0) continue;
+        switch (e->transform) {
+        case ASSET_COPY:   copyAsset(e);  break;
+        case ASSET_FILL:   fillAsset(e);  break;
+        case ASSET_MAP_OR: mapOrAsset(e); break;
+        }
+        bytes += e->bytes;
+    }
+    s_lastLoadBytes = bytes;
+    return (u16)(REG_TM0CNT_L - t0);
+}
+
+u32 assetLastLoadBytes(void) {
+    return s_lastLoadBytes;
+}
@@ -0,0 +1,43 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include "core/game_types.h"
+
+// Declarative VRAM / palette loads.
+//
+// Boot used to hand-copy every tileset, map and palette with its own loop.
+// Instead each load is an AssetEntry (source, destination, size, transform)
+// and assetLoad() runs a table of them with the fastest transfer the entry
+// allows: CpuFastSet for 32-byte multiples, DMA3 (32- or 16-bit) otherwise.
+// Transforms that have to touch every element (the palette bank OR on a
+// tilemap) run as a word loop that does two screen entries at a time.
+//
+// The boot manifest lives in asset_manifest.c; adding an asset means adding
+// a row there, not another copy loop in main().
+
+typedef enum {
+    ASSET_COPY = 0,    // dst[i] = src[i]
+    ASSET_FILL,        // dst[i] = arg (16-bit value, repeated)
+    ASSET_MAP_OR,      // dst[i] = src[i] | arg (screen entries: palette bank bits)
+} AssetTransform;
+
+typedef struct {
+    const char* name;
+    AssetTransform transform;
+    const void* src;           // unused for ASSET_FILL
+    volatile void* dst;
+    u32 bytes;                 // multiple of 2
+    u16 arg;
+} AssetEntry;
+
+// Run a manifest in order. Returns the TM0 ticks it took.
+u16 assetLoad(const AssetEntry* entries, int count);
+
+// Bytes moved by the last assetLoad() call.
+u32 assetLastLoadBytes(void);
+
+// Everything main() loads before the menu comes up (asset_manifest.c).
+extern const AssetEntry g_bootAssets[];
+extern const int g_bootAssetCount;
+
+#endif // ASSETS_H
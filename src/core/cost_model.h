@@ -0,0 +1,53 @@
+#ifndef COST_MODEL_H
+#define COST_MODEL_H
+
+// Hooks for the desktop GBA cycle-cost model (src/desktop/gba_cost.c).
+//
+// Hot code annotates its memory traffic and rough Thumb instruction counts
+// with these macros. On the GBA they compile to nothing; on the desktop
+// build they are tallied per subsystem and weighted with GBA wait states, so
+// the replay suites can report estimated hardware cycles per frame.
+// Desktop benchmarks that time the code itself build with -DCOST_MODEL_OFF
+// to drop the tallies as well.
+
+// Where the touched data lives on the GBA.
+typedef enum {
+    COST_ROM,     // cartridge: level data, collision maps, assets
+    COST_EWRAM,   // decompressed level tile buffers
+    COST_IWRAM,   // globals, stack, tile entry tables
+    COST_VRAM,    // tilemaps and tile graphics
+    COST_OAM,
+    COST_IO,      // display/blend registers
+    COST_REGION_COUNT
+} CostRegion;
+
+// What the cycles are charged to.
+typedef enum {
+    COST_SUB_OTHER,
+    COST_SUB_PLAYER,
+    COST_SUB_COLLISION,
+    COST_SUB_ENTITIES,
+    COST_SUB_TILEMAP,
+    COST_SUB_VIDEO,
+    COST_SUB_COUNT
+} CostSubsystem;
+
+#if defined(DESKTOP_BUILD) && !defined(COST_MODEL_OFF)
+#include "desktop/gba_cost.h"
+// `count` accesses of `bytes` (1, 2 or 4) each to `region`.
+#define COST_ACCESS(region, bytes, count) gbaCostAccess((region), (bytes), (count))
+// Estimated Thumb instructions executed from ROM.
+#define COST_INSNS(n)                     gbaCostInstructions(n)
+// Charge everything until the matching COST_POP() to `sub`.
+#define COST_PUSH(sub)                    gbaCostPush(sub)
+#define COST_POP()                        gbaCostPop()
+#else
+// The arguments are still evaluated (for nothing), so values computed only
+// for the tally do not show up as unused.
+#define COST_ACCESS(region, bytes, count) ((void)(region), (void)(bytes), (void)(count))
+#define COST_INSNS(n)                     ((void)(n))
+#define COST_PUSH(sub)                    ((void)(sub))
+#define COST_POP()                        ((void)0)
+#endif
+
+#endif // COST_MODEL_H
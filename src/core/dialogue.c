@@ -0,0 +1,225 @@
+#include <tonc.h>
+#include "dialogue.h"
+#include "core/assets.h"
+#include "core/text.h"
+#include "core/vblank_queue.h"
+#include "core/vram_layout.h"
+
+#define TEXT_SCREENBLOCK 28   // BG3 map (core/text.c)
+#define BOX_TILES        (DIALOGUE_COLS * DIALOGUE_LINES)
+#define BOX_WIDTH_PX     (DIALOGUE_COLS * 8)
+#define GLYPH_SPACE      0xFF
+
+#if TILE_BG3_DIALOGUE + BOX_TILES > 512
+#error "Dialogue box tiles run past the end of char block 1"
+#endif
+
+// One laid-out character: font index (or GLYPH_SPACE) and where it lands.
+typedef struct {
+    u8 glyph;
+    u8 x;      // pixel offset in its line
+    u8 line;
+    u8 page;
+} DialogueGlyph;
+
+static DialogueGlyph s_glyphs[DIALOGUE_MAX_GLYPHS] __attribute__((section(".ewram"), aligned(4)));
+static int s_glyphCount = 0;
+static int s_revealed = 0;
+static int s_pageEnd = 0;      // first glyph of the next page
+static int s_page = 0;
+static int s_open = 0;
+static int s_tileX = 0;
+static int s_tileY = 0;
+static int s_rate = DIALOGUE_RATE_DEFAULT;
+static int s_accum = 0;        // 8.8 glyphs owed
+static int s_hold = 0;
+
+// ---------------------------------------------------------------------------
+// Layout (on open)
+// ---------------------------------------------------------------------------
+
+static int glyphWidth(char c) {
+    if (c < FONT_START_CHAR || c > FONT_END_CHAR) return 0;
+    return font_char_widths[c - FONT_START_CHAR];
+}
+
+typedef struct {
+    int x;
+    int line;
+    int page;
+} LayoutCursor;
+
+static void newLine(LayoutCursor* cur) {
+    cur->x = 0;
+    if (++cur->line == DIALOGUE_LINES) {
+        cur->line = 0;
+        cur->page++;
+    }
+}
+
+static void addGlyph(LayoutCursor* cur, char c) {
+    if (s_glyphCount >= DIALOGUE_MAX_GLYPHS) return;
+    DialogueGlyph* g = &s_glyphs[s_glyphCount++];
+    g->glyph = (c == ' ') ? GLYPH_SPACE : (u8)(c - FONT_START_CHAR);
+    g->x = (u8)cur->x;
+    g->line = (u8)cur->line;
+    g->page = (u8)cur->page;
+    cur->x += glyphWidth(c);
+}
+
+// Greedy word wrap: a word that does not fit on the current line starts the
+// next one, spaces at a break are dropped, and a word wider than the box is
+// broken wherever it runs out of room.
+static void layoutText(const char* text) {
+    LayoutCursor cur = { 0, 0, 0 };
+    s_glyphCount = 0;
+
+    const char* p = text;
+    while (*p && s_glyphCount < DIALOGUE_MAX_GLYPHS) {
+        if (*p == '\n') {
+            newLine(&cur);
+            p++;
+        } else if (*p == ' ') {
+            if (cur.x > 0 && cur.x + glyphWidth(' ') <= BOX_WIDTH_PX) {
+                addGlyph(&cur, ' ');
+            }
+            p++;
+        } else {
+            int wordWidth = 0;
+            const char* end = p;
+            while (*end && *end != ' ' && *end != '\n') {
+                wordWidth += glyphWidth(*end);
+                end++;
+            }
+            if (cur.x > 0 && cur.x + wordWidth > BOX_WIDTH_PX) {
+                newLine(&cur);
+            }
+            for (; p < end; p++) {
+                int w = glyphWidth(*p);
+                if (w == 0) continue;
+                if (cur.x + w > BOX_WIDTH_PX) {
+                    newLine(&cur);
+                }
+                addGlyph(&cur, *p);
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Rendering
+// ---------------------------------------------------------------------------
+
+static volatile u32* boxTile(int line, int col) {
+    return (volatile u32*)&tile_mem[1][TILE_BG3_DIALOGUE + line * DIALOGUE_COLS + col];
+}
+
+static void clearBoxTiles(void) {
+    AssetEntry clear = { "dialogue tiles", ASSET_FILL, 0, boxTile(0, 0), BOX_TILES * 32, 0 };
+    assetLoad(&clear, 1);
+}
+
+static void writeBoxMap(int show) {
+    volatile u16* map = vramScreenblock(TEXT_SCREENBLOCK);
+    for (int line = 0; line < DIALOGUE_LINES; line++) {
+        int ty = s_tileY + line;
+        if (ty < 0 || ty >= 32) continue;
+        for (int col = 0; col < DIALOGUE_COLS; col++) {
+            int tx = s_tileX + col;
+            if (tx < 0 || tx >= 32) continue;
+            u16 tile = (u16)(TILE_BG3_DIALOGUE + line * DIALOGUE_COLS + col);
+            map[ty * 32 + tx] = show ? (tile | (PAL_BG_FONT << 12)) : 0;
+        }
+    }
+}
+
+// OR one glyph into the one or two tiles it overlaps: 8 rows, each a
+// masked, shifted 4bpp font row.
+static void drawGlyph(const DialogueGlyph* g) {
+    if (g->glyph == GLYPH_SPACE) return;
+
+    const u32* font = &((const u32*)tinypixieTiles)[g->glyph * 8];
+    int width = font_char_widths[g->glyph];
+    u32 mask = (width >= 8) ? 0xFFFFFFFF : ((1u << (width * 4)) - 1);
+    int col = g->x >> 3;
+    int shift = (g->x & 7) * 4;
+
+    volatile u32* left = boxTile(g->line, col);
+    volatile u32* right = (shift != 0 && col + 1 < DIALOGUE_COLS) ? boxTile(g->line, col + 1) : 0;
+    for (int row = 0; row < 8; row++) {
+        u32 bits = font[row] & mask;
+        left[row] |= bits << shift;
+        if (right) {
+            right[row] |= bits >> (32 - shift);
+        }
+    }
+}
+
+static void startPage(void) {
+    s_pageEnd = s_revealed;
+    while (s_pageEnd < s_glyphCount && s_glyphs[s_pageEnd].page == s_page) {
+        s_pageEnd++;
+    }
+    s_accum = 0;
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+void dialogueOpen(const char* text, int tileX, int tileY, int glyphsPerFrame) {
+    if (s_open) {
+        dialogueClose();
+    }
+    layoutText(text);
+    s_tileX = tileX;
+    s_tileY = tileY;
+    s_rate = glyphsPerFrame;
+    s_revealed = 0;
+    s_page = 0;
+    s_hold = 0;
+    s_open = 1;
+
+    clearBoxTiles();
+    writeBoxMap(1);
+    startPage();
+}
+
+int dialogueUpdate(int fast) {
+    if (!s_open) return 0;
+
+    if (s_revealed < s_pageEnd) {
+        s_accum += fast ? DIALOGUE_RATE_FAST : s_rate;
+        int n = s_accum >> 8;
+        s_accum &= 0xFF;
+        if (n > DIALOGUE_MAX_GLYPHS_PER_FRAME) n = DIALOGUE_MAX_GLYPHS_PER_FRAME;
+        while (n-- > 0 && s_revealed < s_pageEnd) {
+            drawGlyph(&s_glyphs[s_revealed++]);
+        }
+        if (s_revealed == s_pageEnd) {
+            s_hold = DIALOGUE_HOLD_FRAMES;
+        }
+        return 1;
+    }
+
+    if (--s_hold > 0) return 1;
+
+    if (s_revealed >= s_glyphCount) {
+        dialogueClose();
+        return 0;
+    }
+    s_page++;
+    clearBoxTiles();
+    startPage();
+    return 1;
+}
+
+void dialogueClose(void) {
+    if (!s_open) return;
+    writeBoxMap(0);
+    s_open = 0;
+}
+
+int dialogueIsOpen(void) {
+    return s_open;
+}
@@ -0,0 +1,45 @@
+#ifndef DIALOGUE_H
+#define DIALOGUE_H
+
+#include "core/game_types.h"
+
+// Typewriter dialogue box on BG3 (signs, room intros).
+//
+// Every cell of the box owns one tile (TILE_BG3_DIALOGUE up, see
+// core/vram_layout.h), so the box map is written once when it opens and a
+// glyph never has to be re-rasterised with its neighbours. dialogueOpen()
+// word-wraps the whole message against font_char_widths up front and
+// records each glyph's cell and pixel offset; dialogueUpdate() then ORs at
+// most DIALOGUE_MAX_GLYPHS_PER_FRAME newly revealed glyphs into their one
+// or two tiles. Per-frame cost is a few hundred cycles whatever the message
+// length. Only opening the box and turning a page clear its tiles.
+//
+// Messages longer than the box are split into pages; a full page stays up
+// for DIALOGUE_HOLD_FRAMES before the next one (or before closing).
+
+#define DIALOGUE_COLS     20   // box width in tiles (160 px)
+#define DIALOGUE_LINES    3
+#define DIALOGUE_MAX_GLYPHS 255  // characters per message, spaces included
+
+// Reveal rate in glyphs per frame, 8.8 fixed point
+#define DIALOGUE_RATE_DEFAULT 0x0080  // one glyph every other frame
+#define DIALOGUE_RATE_FAST    0x0200
+#define DIALOGUE_MAX_GLYPHS_PER_FRAME 4
+
+#define DIALOGUE_HOLD_FRAMES 120
+
+// Open the box at BG3 tile (tileX, tileY) and start revealing `text`
+// ('\n' forces a line break). Replaces any open message. `text` must stay
+// valid while the box is open.
+void dialogueOpen(const char* text, int tileX, int tileY, int glyphsPerFrame);
+
+// Reveal this frame's glyphs; `fast` uses DIALOGUE_RATE_FAST. Closes the
+// box after the last page has been held. Returns 1 while the box is open.
+int dialogueUpdate(int fast);
+
+// Hide the box (its map entries are cleared; BG text slots are untouched).
+void dialogueClose(void);
+
+int dialogueIsOpen(void);
+
+#endif // DIALOGUE_H
@@ -0,0 +1,164 @@
+#include <tonc.h>
+#include <stdio.h>
+#include "frame_step.h"
+#include "core/input.h"
+#include "core/text.h"
+#include "player/state.h"
+
+// Overlay: top right, clear of the profiling column. Menu slots 1-4 are
+// free during gameplay (slot 0 is the COLDEBUG probe line).
+#define OVERLAY_SLOT   1
+#define OVERLAY_X      15
+#define OVERLAY_Y      1
+#define OVERLAY_LINES  4
+#define OVERLAY_WIDTH  (32 - OVERLAY_X)
+#define OVERLAY_VALUES 5
+
+#if ST_DREAM_DASH + 1 != MAX_PLAYER_STATES
+#error "State name table is out of date"
+#endif
+
+static const char* const s_stateNames[MAX_PLAYER_STATES] = {
+    "ST_NORMAL", "ST_CLIMB", "ST_DASH", "ST_SWIM", "ST_BOOST",
+    "ST_RED_DASH", "ST_HIT_SQUASH", "ST_LAUNCH", "ST_PICKUP", "ST_DREAM_DASH",
+};
+
+// VBlanks per simulated frame, by mode (paused waits for an advance)
+static const u8 s_divisors[FRAME_STEP_MODE_COUNT] = { 1, 0, 2, 4, 8 };
+
+static FrameStepMode s_mode = FRAME_STEP_RUN;
+static int s_phase = 0;          // VBlanks since the last simulated frame
+static int s_advance = 0;        // SELECT tapped while paused
+static u16 s_latch = 0;          // keys seen since the last simulated frame
+static u16 s_heldAtSelect = 0;   // keys already down when SELECT went down
+static int s_selectClean = 0;    // nothing else pressed since SELECT went down
+static int s_steppedFrames = 0;  // simulated frames since leaving run mode
+
+static int s_shown[OVERLAY_LINES][OVERLAY_VALUES];
+static int s_overlayVisible = 0;
+
+void frameStepReset(void) {
+    s_mode = FRAME_STEP_RUN;
+    s_phase = 0;
+    s_advance = 0;
+    s_latch = 0;
+    s_selectClean = 0;
+    s_overlayVisible = 0;  // returnToMenu clears the text layer
+}
+
+FrameStepMode frameStepMode(void) {
+    return s_mode;
+}
+
+int frameStepUpdate(u16 realKeys, u16 prevRealKeys, u16* keys) {
+    u16 down = realKeys & ~prevRealKeys;
+    u16 released = prevRealKeys & ~realKeys;
+
+    if (down & BTN_SELECT) {
+        s_heldAtSelect = realKeys & ~BTN_SELECT;
+        s_selectClean = !(down & ~BTN_SELECT);
+    } else if ((realKeys & BTN_SELECT) && down) {
+        s_selectClean = 0;
+    }
+
+    if ((realKeys & BTN_SELECT) && (down & BTN_STEP_MODE)) {
+        s_mode = (FrameStepMode)((s_mode + 1) % FRAME_STEP_MODE_COUNT);
+        s_phase = 0;
+        s_advance = 0;
+        s_latch = 0;
+        if (s_mode == FRAME_STEP_PAUSED) {
+            s_steppedFrames = 0;
+        }
+    } else if ((released & BTN_SELECT) && s_selectClean && s_mode == FRAME_STEP_PAUSED) {
+        s_advance = 1;
+    }
+
+    if (s_mode == FRAME_STEP_RUN) {
+        return 1;
+    }
+
+    u16 live = (realKeys & BTN_SELECT) ? (realKeys & s_heldAtSelect) : realKeys;
+    s_latch |= live & ~BTN_SELECT;
+
+    int simulate;
+    if (s_mode == FRAME_STEP_PAUSED) {
+        simulate = s_advance;
+    } else {
+        simulate = (++s_phase >= s_divisors[s_mode]);
+    }
+    if (!simulate) {
+        return 0;
+    }
+
+    *keys = s_latch;
+    s_latch = 0;
+    s_phase = 0;
+    s_advance = 0;
+    s_steppedFrames++;
+    return 1;
+}
+
+// Record a line's values; non-zero if the line needs redrawing.
+static int overlayChanged(int line, const int* values) {
+    int* shown = s_shown[line];
+    int changed = !s_overlayVisible;
+    for (int i = 0; i < OVERLAY_VALUES; i++) {
+        if (shown[i] != values[i]) {
+            shown[i] = values[i];
+            changed = 1;
+        }
+    }
+    return changed;
+}
+
+static void overlayLine(int line, const char* str) {
+    clear_bg_text_region(OVERLAY_X, OVERLAY_Y + line, OVERLAY_WIDTH, 1);
+    draw_bg_text_slot(str, OVERLAY_X, OVERLAY_Y + line, OVERLAY_SLOT + line);
+}
+
+void frameStepDrawOverlay(const Player* player) {
+    if (s_mode == FRAME_STEP_RUN) {
+        if (s_overlayVisible) {
+            clear_bg_text_region(OVERLAY_X, OVERLAY_Y, OVERLAY_WIDTH, OVERLAY_LINES);
+            s_overlayVisible = 0;
+        }
+        return;
+    }
+
+    char str[40];
+    int state = player->stateMachine.state;
+
+    int mode[OVERLAY_VALUES] = { s_mode, s_steppedFrames, 0, 0, 0 };
+    if (overlayChanged(0, mode)) {
+        if (s_mode == FRAME_STEP_PAUSED) {
+            siprintf(str, "PAUSED F:%d", s_steppedFrames);
+        } else {
+            siprintf(str, "SLOW x%d F:%d", s_divisors[s_mode], s_steppedFrames);
+        }
+        overlayLine(0, str);
+    }
+
+    int pos[OVERLAY_VALUES] = { player->x, player->y, 0, 0, 0 };
+    if (overlayChanged(1, pos)) {
+        siprintf(str, "X:%d Y:%d", player->x, player->y);
+        overlayLine(1, str);
+    }
+
+    int vel[OVERLAY_VALUES] = { player->vx, player->vy, 0, 0, 0 };
+    if (overlayChanged(2, vel)) {
+        siprintf(str, "VX:%d VY:%d", player->vx, player->vy);
+        overlayLine(2, str);
+    }
+
+    int timers[OVERLAY_VALUES] = { state, player->onGround, player->coyoteTime,
+                                   timerRemaining(player, player->jumpBufferUntil), player->dashes };
+    if (overlayChanged(3, timers)) {
+        siprintf(str, "%s G:%d C:%d J:%d D:%d",
+                 (state >= 0 && state < MAX_PLAYER_STATES) ? s_stateNames[state] : "ST_?",
+                 player->onGround, player->coyoteTime,
+                 timerRemaining(player, player->jumpBufferUntil), player->dashes);
+        overlayLine(3, str);
+    }
+
+    s_overlayVisible = 1;
+}
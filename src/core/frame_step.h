@@ -0,0 +1,44 @@
+#ifndef FRAME_STEP_H
+#define FRAME_STEP_H
+
+#include "core/game_types.h"
+
+// Pause, single-frame advance and slow motion, for reproducing frame-precise
+// mechanics (coyote time, jump buffering, dash timing) on hardware.
+//
+// SELECT+LEFT cycles run -> paused -> slow x2 -> x4 -> x8 -> run. While
+// paused, tapping SELECT on its own advances one frame; in slow motion the
+// simulation runs on every Nth VBlank. The loop itself keeps going every
+// VBlank, so the display, text and dialogue box stay live.
+//
+// Keys are ORed together over the VBlanks a simulated frame spans and handed
+// to that frame as one input, so a tap that starts and ends between two
+// simulated frames is still seen, and the replay records exactly what the
+// simulation got. SELECT never reaches the game while stepping, and neither
+// do keys first pressed while it is held (SELECT+LEFT itself). Run mode
+// passes keys straight through, so normal play and replays are unchanged.
+
+typedef enum {
+    FRAME_STEP_RUN = 0,
+    FRAME_STEP_PAUSED,
+    FRAME_STEP_SLOW2,
+    FRAME_STEP_SLOW4,
+    FRAME_STEP_SLOW8,
+    FRAME_STEP_MODE_COUNT
+} FrameStepMode;
+
+// Back to run mode (on the way back to the menu).
+void frameStepReset(void);
+
+// Call once per gameplay VBlank with the live pad state. Returns non-zero if
+// the simulation runs this VBlank, with *keys replaced by the latched input
+// for the frame (left alone in run mode).
+int frameStepUpdate(u16 realKeys, u16 prevRealKeys, u16* keys);
+
+FrameStepMode frameStepMode(void);
+
+// Player fields and state name while stepping; each line is redrawn only
+// when a value on it has changed. Clears itself on the way back to run.
+void frameStepDrawOverlay(const Player* player);
+
+#endif // FRAME_STEP_H
@@ -132,6 +132,7 @@
 // Player constants (exactly matching Celeste's 8x11 hitbox)
 #define PLAYER_WIDTH 8
 #define PLAYER_HEIGHT 11
+#define PLAYER_DUCK_HEIGHT 6  // Celeste duckHitbox: 8x6, bottom edge shared with the standing hitbox
 #define PLAYER_HITBOX_Y_SHIFT 3  // Higher value = player stands higher on ground (shifts hitbox down relative to center)
 #define PLAYER_TOP(y) ((y) - PLAYER_HEIGHT / 2 - 1 + PLAYER_HITBOX_Y_SHIFT)
 #define PLAYER_BOTTOM(y) ((y) + PLAYER_HEIGHT / 2 + PLAYER_HITBOX_Y_SHIFT)
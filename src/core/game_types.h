@@ -36,6 +36,20 @@ typedef struct {
 
 // Player structure
 struct Player {
+    // Gameplay timers as deadlines on `clock` (player_timer.h). Packed as
+    // u16: timerRebase keeps the clock and deadlines far below 65536.
+    u16 clock;  // Frames updatePlayer has run, rebased now and then
+    u16 jumpBufferUntil;  // Jump buffer deadline (player_timer.h)
+    u16 autoJumpUntil;  // AutoJump window deadline; TIMER_OFF = until landing
+    u16 varJumpUntil;   // Variable jump window deadline
+    u16 dashCooldownUntil;     // Deadline before can dash again
+    u16 dashRefillCooldownUntil;  // Deadline before dash refills on ground
+    u16 dashAttackUntil;   // Deadline of the window where super jumps can be triggered (set on dash start)
+    u16 climbNoMoveUntil;  // Deadline before climb movement is allowed (prevents grab spam)
+    u16 wallBoostUntil;    // Deadline to convert climb jump to wall jump (refunds stamina)
+    u16 forceMoveXUntil; // Deadline to force horizontal input
+    u16 prevKeys;     // Previous frame keys for detecting button presses
+
     int x;  // Fixed-point
     int y;  // Fixed-point
     int vx; // Fixed-point
@@ -44,28 +58,21 @@ struct Player {
     int onGround;
     int wasOnGround;  // Previous frame onGround (for lift boost detection)
     int coyoteTime;   // Frames remaining for coyote time jump
-    int jumpBuffer;   // Frames remaining in jump buffer
     int jumpHeld;     // 1 if jump was initiated this aerial phase
     int autoJump;     // 1 if AutoJump is active (simulates holding jump button for maintained jump height)
-    int autoJumpTimer;  // Frames remaining for AutoJump window
     int liftBoostX; // Velocity from moving platforms (X component)
     int liftBoostY; // Velocity from moving platforms (Y component)
     int varJumpSpeed; // Initial jump velocity for var jump clamping
-    int varJumpTimer;   // Frames remaining for variable jump window
     int dashing;
     int dashes;                // Current dashes available (0-2)
     int maxDashes;             // Maximum dashes (usually 1)
-    int dashCooldownTimer;     // Frames before can dash again
-    int dashRefillCooldownTimer;  // Frames before dash refills on ground
     int facingRight;  // 1 = right, 0 = left
-    u16 prevKeys;     // Previous frame keys for detecting button presses
 
     // Wall slide/jump
     int wallSlideTimer;  // Time remaining for wall slide ability (resets on ground/jump)
     int wallSlideDir;      // Direction of current wall slide: 1=right, -1=left, 0=none
 
     // Dash attack (for super jumps)
-    int dashAttackTimer;   // Frames remaining where super jumps can be triggered (set on dash start)
     int dashDirX;          // Dash direction X: -1=left, 0=none, 1=right
     int dashDirY;          // Dash direction Y: -1=up, 0=none, 1=down
     int beforeDashSpeedX;  // Horizontal speed before dash (for preserving higher speeds)
@@ -75,16 +82,13 @@ struct Player {
 
     // Climbing
     int stamina;         // Current stamina (0-28160 in fixed-point, 0-110 logical)
-    int climbNoMoveTimer;  // Frames before climb movement is allowed (prevents grab spam)
     int lastClimbMove;     // Last climb movement direction: -1=up, 0=still, 1=down
-    int wallBoostTimer;    // Frames remaining to convert climb jump to wall jump (refunds stamina)
     int wallBoostDir;      // Direction to press for wall boost: -1=left, 1=right
 
     // Climb hop system (Celeste Player.cs line 218-219)
     int hopWaitX;          // If you climb hop onto a solid, snap beside it until you get above it
     int hopWaitXSpeed;   // Horizontal speed to apply when hopWaitX releases
     int forceMoveX;        // Force horizontal input to this value
-    int forceMoveXTimer; // Frames remaining to force horizontal input
 
     // HitSquash state (Celeste Player.cs line 3936)
     int hitSquashNoMoveTimer;  // Frames remaining before can control movement after wall hit
@@ -107,6 +111,10 @@ struct Player {
 
     // State machine
     StateMachine stateMachine;
+
+    // Idle fast path: set once a grounded, input-free frame left the player
+    // unchanged; updatePlayer then skips physics until woken
+    int asleep;
 };
 
 typedef struct {
@@ -29,6 +29,10 @@
 #define BTN_REPLAY_SAVE   KEY_B
 #define BTN_REPLAY_LOAD   KEY_DOWN
 
+// Debug controls (used with SELECT modifier)
+#define BTN_PROFILE       KEY_UP
+#define BTN_STEP_MODE     KEY_LEFT   // run / pause / slow motion (core/frame_step.h)
+
 // Helpers to reduce boilerplate in state update functions
 static inline u16 inputPressed(u16 keys, u16 prevKeys) {
     return keys & ~prevKeys;
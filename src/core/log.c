@@ -0,0 +1,127 @@
+#include "log.h"
+
+#ifdef DESKTOP_BUILD
+#include <stdio.h>
+#define LOG_SPRINTF sprintf
+#else
+#include <stdio.h>
+#define LOG_SPRINTF siprintf  // newlib's integer-only sprintf
+
+// mGBA debug registers. Writing 0xC0DE to the enable register makes it read
+// back 0x1DEA when the emulator supports them; elsewhere the writes go to
+// unmapped I/O and are ignored.
+#define REG_DEBUG_ENABLE (*(vu16*)0x04FFF780)
+#define REG_DEBUG_FLAGS  (*(vu16*)0x04FFF700)
+#define REG_DEBUG_STRING ((char*)0x04FFF600)
+#define DEBUG_FLAG_SEND  0x100
+#endif
+
+typedef struct {
+    u16 id;
+    u32 frame;
+    int args[3];
+} LogEntry;
+
+typedef struct {
+    const char* format;
+    u8 level;
+    u8 category;
+} LogFormatInfo;
+
+static const LogFormatInfo s_formats[LOG_FORMAT_COUNT] = {
+#define LOG_FORMAT(id, level, category, format) { format, level, category },
+#include "core/log_formats.h"
+#undef LOG_FORMAT
+};
+
+static const char* const s_levelNames[] = { "ERROR", "WARN", "INFO", "DEBUG" };
+
+#ifdef DESKTOP_BUILD
+static LogEntry s_ring[LOG_RING_SIZE];
+#else
+static LogEntry s_ring[LOG_RING_SIZE] __attribute__((section(".ewram"), aligned(4)));
+#endif
+static u32 s_head = 0;     // next write
+static u32 s_tail = 0;     // next drain
+static u32 s_dropped = 0;
+
+u32 g_logFrame = 0;
+
+void logPush(LogFormatId id, int a, int b, int c) {
+    if (s_head - s_tail >= LOG_RING_SIZE) {
+        s_dropped++;
+        return;
+    }
+    LogEntry* e = &s_ring[s_head & (LOG_RING_SIZE - 1)];
+    e->id = (u16)id;
+    e->frame = g_logFrame;
+    e->args[0] = a;
+    e->args[1] = b;
+    e->args[2] = c;
+    s_head++;
+}
+
+int logPending(void) {
+    return (int)(s_head - s_tail);
+}
+
+static const char* categoryName(u8 category) {
+    switch (category) {
+        case LOG_CAT_CORE:       return "core";
+        case LOG_CAT_PLAYER:     return "player";
+        case LOG_CAT_TRANSITION: return "transition";
+        case LOG_CAT_LEVEL:      return "level";
+        case LOG_CAT_REPLAY:     return "replay";
+        default:                 return "?";
+    }
+}
+
+static void writeLine(int level, const char* line) {
+#ifdef DESKTOP_BUILD
+    (void)level;
+    fputs(line, stdout);
+    fputc('\n', stdout);
+#else
+    static int s_debugChecked = 0;
+    static int s_debugEnabled = 0;
+    if (!s_debugChecked) {
+        REG_DEBUG_ENABLE = 0xC0DE;
+        s_debugEnabled = (REG_DEBUG_ENABLE == 0x1DEA);
+        s_debugChecked = 1;
+    }
+    if (!s_debugEnabled) return;
+
+    char* out = REG_DEBUG_STRING;
+    int i = 0;
+    for (; line[i] && i < 255; i++) {
+        out[i] = line[i];
+    }
+    out[i] = '\0';
+    REG_DEBUG_FLAGS = (u16)(level + 1) | DEBUG_FLAG_SEND;  // mGBA: 1 = error .. 4 = debug
+#endif
+}
+
+int logDrain(int maxEntries) {
+    char line[128];
+    int written = 0;
+
+    while (written < maxEntries && s_tail != s_head) {
+        const LogEntry* e = &s_ring[s_tail & (LOG_RING_SIZE - 1)];
+        const LogFormatInfo* info = &s_formats[e->id];
+        int n = LOG_SPRINTF(line, "[%5lu] %-5s %s: ", (unsigned long)e->frame,
+                            s_levelNames[info->level], categoryName(info->category));
+        LOG_SPRINTF(line + n, info->format, e->args[0], e->args[1], e->args[2]);
+        writeLine(info->level, line);
+        s_tail++;
+        written++;
+    }
+
+    if (s_dropped && s_tail == s_head && written < maxEntries) {
+        LOG_SPRINTF(line, "[%5lu] WARN  core: %lu log entries dropped",
+                    (unsigned long)g_logFrame, (unsigned long)s_dropped);
+        writeLine(LOG_LEVEL_WARN, line);
+        s_dropped = 0;
+        written++;
+    }
+    return written;
+}
@@ -0,0 +1,83 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include "core/game_types.h"
+
+// Deferred structured logging.
+//
+// A log call stores a format ID, the frame number and up to three raw int
+// arguments in a ring buffer; nothing is formatted at the call site, so it
+// is cheap enough for setState or a transition trigger. logDrain() formats
+// queued entries later, from the main loop's slack time on GBA, and writes
+// them to the mGBA debug port (a no-op on hardware), or to stdout on
+// desktop. When the ring is full new entries are dropped and counted.
+//
+// Messages live in core/log_formats.h, each with a level and category.
+// Calls below LOG_LEVEL or outside LOG_CATEGORIES compile to nothing.
+
+#define LOG_LEVEL_ERROR 0
+#define LOG_LEVEL_WARN  1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_DEBUG 3
+
+#define LOG_CAT_CORE       (1 << 0)
+#define LOG_CAT_PLAYER     (1 << 1)
+#define LOG_CAT_TRANSITION (1 << 2)
+#define LOG_CAT_LEVEL      (1 << 3)
+#define LOG_CAT_REPLAY     (1 << 4)
+#define LOG_CAT_ALL        0xFF
+
+// Desktop defaults to warnings so the test output stays readable; build
+// with -DLOG_LEVEL=LOG_LEVEL_DEBUG to see everything.
+#ifndef LOG_LEVEL
+#ifdef DESKTOP_BUILD
+#define LOG_LEVEL LOG_LEVEL_WARN
+#else
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+#endif
+
+#ifndef LOG_CATEGORIES
+#define LOG_CATEGORIES LOG_CAT_ALL
+#endif
+
+#define LOG_RING_SIZE 64  // power of two
+
+typedef enum {
+#define LOG_FORMAT(id, level, category, format) id,
+#include "core/log_formats.h"
+#undef LOG_FORMAT
+    LOG_FORMAT_COUNT
+} LogFormatId;
+
+// Per-ID level and category as constants, for the compile-time filter.
+enum {
+#define LOG_FORMAT(id, level, category, format) id##_LEVEL = level, id##_CATEGORY = category,
+#include "core/log_formats.h"
+#undef LOG_FORMAT
+};
+
+#define LOG_ENABLED(id) ((id##_LEVEL) <= LOG_LEVEL && ((id##_CATEGORY) & LOG_CATEGORIES))
+
+#define LOG0(id)          do { if (LOG_ENABLED(id)) logPush(id, 0, 0, 0); } while (0)
+#define LOG1(id, a)       do { if (LOG_ENABLED(id)) logPush(id, (a), 0, 0); } while (0)
+#define LOG2(id, a, b)    do { if (LOG_ENABLED(id)) logPush(id, (a), (b), 0); } while (0)
+#define LOG3(id, a, b, c) do { if (LOG_ENABLED(id)) logPush(id, (a), (b), (c)); } while (0)
+
+// Frame number stamped on new entries.
+extern u32 g_logFrame;
+
+static inline void logSetFrame(u32 frame) {
+    g_logFrame = frame;
+}
+
+void logPush(LogFormatId id, int a, int b, int c);
+
+// Format and write up to maxEntries queued entries. Returns how many were
+// written; the dropped count is reported once the ring has caught up.
+int logDrain(int maxEntries);
+
+// Entries waiting to be drained.
+int logPending(void);
+
+#endif // LOG_H
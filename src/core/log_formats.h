@@ -0,0 +1,15 @@
+// Log message table: LOG_FORMAT(id, level, category, format)
+//
+// Formats take up to three int arguments (%d, %x, %c ...). Strings cannot
+// be passed: arguments are stored raw and only formatted when the ring is
+// drained, by which time a pointer may no longer be valid.
+
+LOG_FORMAT(LOG_PLAYER_STATE,       LOG_LEVEL_DEBUG, LOG_CAT_PLAYER,     "state %d -> %d")
+LOG_FORMAT(LOG_TRANSITION_SCROLL,  LOG_LEVEL_INFO,  LOG_CAT_TRANSITION, "scroll room %d -> %d, %d frames")
+LOG_FORMAT(LOG_TRANSITION_FADE,    LOG_LEVEL_INFO,  LOG_CAT_TRANSITION, "fade room %d -> %d (tiles %d)")
+LOG_FORMAT(LOG_LEVEL_ENTER,        LOG_LEVEL_INFO,  LOG_CAT_LEVEL,      "enter room %d")
+LOG_FORMAT(LOG_REPLAY_SAVED,       LOG_LEVEL_INFO,  LOG_CAT_REPLAY,     "replay saved, %d frames, room %d")
+LOG_FORMAT(LOG_REPLAY_LOADED,      LOG_LEVEL_INFO,  LOG_CAT_REPLAY,     "replay loaded, %d frames, room %d")
+LOG_FORMAT(LOG_REPLAY_EMPTY,       LOG_LEVEL_WARN,  LOG_CAT_REPLAY,     "no replay in save")
+LOG_FORMAT(LOG_BOOT,               LOG_LEVEL_INFO,  LOG_CAT_CORE,       "boot assets %d bytes in %d ticks, menu at %d ticks")
+LOG_FORMAT(LOG_QUALITY_LEVEL,      LOG_LEVEL_INFO,  LOG_CAT_CORE,       "quality level %d -> %d")
@@ -0,0 +1,92 @@
+#include "overlay.h"
+
+// Symbols provided by the devkitARM linker script for its IWRAM overlay
+// sections: one shared run address, one load image per overlay.
+extern u8 __iwram_overlay_start[];
+extern u8 __load_start_iwram0[], __load_stop_iwram0[];
+extern u8 __load_start_iwram1[], __load_stop_iwram1[];
+extern u8 __load_start_iwram2[], __load_stop_iwram2[];
+
+typedef struct {
+    const u8* start;
+    const u8* stop;
+} OverlayImage;
+
+static const OverlayImage s_images[OVERLAY_COUNT] = {
+    { __load_start_iwram0, __load_stop_iwram0 },
+    { __load_start_iwram1, __load_stop_iwram1 },
+    { __load_start_iwram2, __load_stop_iwram2 },
+};
+
+static volatile int s_resident = OVERLAY_NONE;
+static int s_requested = OVERLAY_NONE;
+// Measured copy time per overlay; 0 until it has been copied once.
+static u16 s_copyTicks[OVERLAY_COUNT];
+static u16 s_lastCopyTicks = 0;
+static u16 s_maxCopyTicks = 0;
+
+void initOverlays(void) {
+    s_resident = OVERLAY_NONE;
+    s_requested = OVERLAY_NONE;
+    for (int i = 0; i < OVERLAY_COUNT; i++) {
+        s_copyTicks[i] = 0;
+    }
+    s_lastCopyTicks = 0;
+    s_maxCopyTicks = 0;
+}
+
+void overlayRequest(OverlayId id) {
+    s_requested = id;
+}
+
+static int estimateCopyTicks(OverlayId id) {
+    if (s_copyTicks[id] != 0) {
+        return s_copyTicks[id];
+    }
+    // DMA3 from ROM at default waitstates costs ~8 cycles per word, i.e. 2
+    // cycles per byte; one TM0 tick is 1024 cycles. Round up generously.
+    u32 bytes = (u32)(s_images[id].stop - s_images[id].start);
+    return (int)((bytes * 2) >> 10) + 2;
+}
+
+int overlayService(int ticksLeft) {
+    int id = s_requested;
+    if (id == OVERLAY_NONE || id == s_resident) {
+        return 0;
+    }
+    if (estimateCopyTicks(id) > ticksLeft) {
+        // Not enough headroom this frame; callers keep running the ROM copies.
+        return 0;
+    }
+
+    u32 bytes = (u32)(s_images[id].stop - s_images[id].start);
+
+    // Invalidate before the region is overwritten so nothing dispatches
+    // into a half-copied overlay.
+    s_resident = OVERLAY_NONE;
+
+    u16 t0 = REG_TM0CNT_L;
+    if (bytes > 0) {
+        dma3_cpy(__iwram_overlay_start, s_images[id].start, bytes);
+    }
+    u16 dt = (u16)(REG_TM0CNT_L - t0) + 1;  // +1: never record a zero cost
+
+    s_copyTicks[id] = dt;
+    s_lastCopyTicks = dt;
+    if (dt > s_maxCopyTicks) s_maxCopyTicks = dt;
+
+    s_resident = id;
+    return 1;
+}
+
+int overlayIsResident(OverlayId id) {
+    return s_resident == id;
+}
+
+u16 overlayLastCopyTicks(void) {
+    return s_lastCopyTicks;
+}
+
+u16 overlayMaxCopyTicks(void) {
+    return s_maxCopyTicks;
+}
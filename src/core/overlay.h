@@ -0,0 +1,59 @@
+#ifndef OVERLAY_H
+#define OVERLAY_H
+
+#include "core/game_types.h"
+
+// IWRAM code overlays.
+//
+// Menu, gameplay and transition frames have disjoint hot routines, so they
+// share one IWRAM region instead of each keeping code resident. Each
+// overlay is linked into its own devkitARM overlay section (.iwram0-2: same
+// IWRAM address, separate ROM load image) and copied in with DMA3 when the
+// game mode changes.
+//
+// Overlaid routines are compiled twice: an ARM copy in the overlay section
+// and a normal ROM copy. Callers only ever see a ROM entry point that
+// dispatches on residency, so a deferred or pending swap just means running
+// from ROM for a few frames and never jumping into another overlay's code.
+
+typedef enum {
+    OVERLAY_NONE = -1,
+    OVERLAY_MENU = 0,     // text glyph rasteriser (.iwram0)
+    OVERLAY_GAMEPLAY,     // player hitbox vs tile collision (.iwram1)
+    OVERLAY_TRANSITION,   // scroll transition span writers (.iwram2)
+    OVERLAY_COUNT
+} OverlayId;
+
+#ifndef DESKTOP_BUILD
+#define IWRAM_OVERLAY_MENU       __attribute__((section(".iwram0"), long_call, noinline, target("arm")))
+#define IWRAM_OVERLAY_GAMEPLAY   __attribute__((section(".iwram1"), long_call, noinline, target("arm")))
+#define IWRAM_OVERLAY_TRANSITION __attribute__((section(".iwram2"), long_call, noinline, target("arm")))
+
+// Evaluate iwramCall if overlay `id` is resident, romCall otherwise.
+#define OVERLAY_DISPATCH(id, iwramCall, romCall) \
+    (overlayIsResident(id) ? (iwramCall) : (romCall))
+#else
+// Desktop builds have no IWRAM: only the ROM copies are ever called.
+#define IWRAM_OVERLAY_MENU       __attribute__((unused))
+#define IWRAM_OVERLAY_GAMEPLAY   __attribute__((unused))
+#define IWRAM_OVERLAY_TRANSITION __attribute__((unused))
+#define OVERLAY_DISPATCH(id, iwramCall, romCall) (romCall)
+#endif
+
+void initOverlays(void);
+
+// Ask for `id` to be resident. The copy happens in overlayService().
+void overlayRequest(OverlayId id);
+
+// Perform a pending swap if its expected copy time fits in ticksLeft (TM0
+// ticks left in the current frame). Returns 1 if an overlay was copied.
+// Must be called from ROM code outside any overlaid routine.
+int overlayService(int ticksLeft);
+
+int overlayIsResident(OverlayId id);
+
+// Measured cost of the most recent / slowest swap, in TM0 ticks.
+u16 overlayLastCopyTicks(void);
+u16 overlayMaxCopyTicks(void);
+
+#endif // OVERLAY_H
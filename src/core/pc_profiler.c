@@ -0,0 +1,207 @@
+#ifdef DESKTOP_BUILD
+#define _GNU_SOURCE  // REG_RIP in <ucontext.h>
+#endif
+
+#include "pc_profiler.h"
+
+#if PC_PROFILER_ENABLED
+
+#ifndef DESKTOP_BUILD
+
+#include "save.h"
+
+// ---------------------------------------------------------------------------
+// GBA: TM2 overflow IRQ samples the interrupted PC
+// ---------------------------------------------------------------------------
+
+// The BIOS IRQ vector pushes {r0-r3, r12, lr} onto the IRQ stack, which crt0
+// starts at 0x03007FA0. The saved lr is the interrupted PC + 4 in both ARM
+// and Thumb state.
+#define BIOS_IRQ_FRAME_LR (*(vu32*)0x03007F9C)
+
+#define TM2_HZ 262144  // 16.78 MHz / 64
+
+static u16 s_romBuckets[PC_PROFILER_ROM_BUCKETS]     __attribute__((section(".ewram"), aligned(4)));
+static u16 s_iwramBuckets[PC_PROFILER_IWRAM_BUCKETS] __attribute__((section(".ewram"), aligned(4)));
+static u32 s_samples = 0;
+static u32 s_biosSamples = 0;
+static u32 s_otherSamples = 0;
+static int s_running = 0;
+
+static inline void bump(u16* bucket) {
+    if (*bucket != 0xFFFF) {
+        (*bucket)++;
+    }
+}
+
+static void pcProfilerSample(void) {
+    u32 pc = BIOS_IRQ_FRAME_LR - 4;
+    s_samples++;
+
+    if (pc < 0x00004000) {
+        s_biosSamples++;        // Halted in VBlankIntrWait, or another SWI
+    } else if (pc - 0x08000000 < PC_PROFILER_ROM_SPAN) {
+        bump(&s_romBuckets[(pc - 0x08000000) >> PC_PROFILER_BUCKET_SHIFT]);
+    } else if (pc - 0x03000000 < PC_PROFILER_IWRAM_SPAN) {
+        bump(&s_iwramBuckets[(pc - 0x03000000) >> PC_PROFILER_BUCKET_SHIFT]);
+    } else {
+        s_otherSamples++;
+    }
+}
+
+void pcProfilerStart(void) {
+    for (int i = 0; i < PC_PROFILER_ROM_BUCKETS; i++) s_romBuckets[i] = 0;
+    for (int i = 0; i < PC_PROFILER_IWRAM_BUCKETS; i++) s_iwramBuckets[i] = 0;
+    s_samples = 0;
+    s_biosSamples = 0;
+    s_otherSamples = 0;
+
+    REG_TM2CNT_H = 0;
+    REG_TM2CNT_L = (u16)(65536 - TM2_HZ / PC_PROFILER_HZ);
+    irq_add(II_TIMER2, pcProfilerSample);
+    REG_TM2CNT_H = TM_ENABLE | TM_IRQ | TM_FREQ_64;
+    s_running = 1;
+}
+
+void pcProfilerStop(void) {
+    REG_TM2CNT_H = 0;
+    irq_disable(II_TIMER2);
+    s_running = 0;
+}
+
+int pcProfilerRunning(void) { return s_running; }
+u32 pcProfilerSampleCount(void) { return s_samples; }
+
+void pcProfilerDumpToSRAM(void) {
+    u32 base = PC_PROFILER_SRAM_OFFSET;
+    saveWrite32(base + 0, PC_PROFILER_MAGIC);
+    saveWrite32(base + 4, s_samples);
+    saveWrite32(base + 8, PC_PROFILER_BUCKET_SHIFT);
+    saveWrite32(base + 12, PC_PROFILER_ROM_BUCKETS);
+    saveWrite32(base + 16, PC_PROFILER_IWRAM_BUCKETS);
+    saveWrite32(base + 20, s_biosSamples);
+    saveWrite32(base + 24, s_otherSamples);
+    saveWrite32(base + 28, PC_PROFILER_HZ);
+
+    u32 offset = base + 32;
+    for (int i = 0; i < PC_PROFILER_ROM_BUCKETS; i++) {
+        saveWrite16(offset, s_romBuckets[i]);
+        offset += 2;
+    }
+    for (int i = 0; i < PC_PROFILER_IWRAM_BUCKETS; i++) {
+        saveWrite16(offset, s_iwramBuckets[i]);
+        offset += 2;
+    }
+}
+
+#else // DESKTOP_BUILD
+
+// ---------------------------------------------------------------------------
+// Desktop: SIGPROF samples the host PC into a fixed open-addressing table
+// (no allocation in the signal handler). The dump records the runtime
+// address of pcProfilerStart so the tool can undo PIE relocation.
+// ---------------------------------------------------------------------------
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include <ucontext.h>
+
+#define DESKTOP_SLOTS 8192  // power of two
+
+typedef struct {
+    uintptr_t pc;
+    u32 count;
+} PcSlot;
+
+static PcSlot s_slots[DESKTOP_SLOTS];
+static volatile u32 s_samples = 0;
+static volatile u32 s_otherSamples = 0;
+static int s_running = 0;
+
+static uintptr_t interruptedPc(void* context) {
+    ucontext_t* uc = (ucontext_t*)context;
+#if defined(__x86_64__)
+    return (uintptr_t)uc->uc_mcontext.gregs[REG_RIP];
+#elif defined(__aarch64__)
+    return (uintptr_t)uc->uc_mcontext.pc;
+#else
+    (void)uc;
+    return 0;
+#endif
+}
+
+static void pcProfilerSignal(int sig, siginfo_t* info, void* context) {
+    (void)sig;
+    (void)info;
+    uintptr_t pc = interruptedPc(context);
+    s_samples++;
+
+    u32 slot = (u32)((pc >> 2) * 2654435761u) & (DESKTOP_SLOTS - 1);
+    for (int probe = 0; probe < 16; probe++) {
+        PcSlot* s = &s_slots[(slot + probe) & (DESKTOP_SLOTS - 1)];
+        if (s->pc == pc || s->pc == 0) {
+            s->pc = pc;
+            s->count++;
+            return;
+        }
+    }
+    s_otherSamples++;
+}
+
+static void setSampleTimer(long usec) {
+    struct itimerval timer;
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = usec;
+    timer.it_value = timer.it_interval;
+    setitimer(ITIMER_PROF, &timer, NULL);
+}
+
+void pcProfilerStart(void) {
+    memset(s_slots, 0, sizeof(s_slots));
+    s_samples = 0;
+    s_otherSamples = 0;
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = pcProfilerSignal;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGPROF, &action, NULL);
+
+    setSampleTimer(1000000L / PC_PROFILER_HZ);
+    s_running = 1;
+}
+
+void pcProfilerStop(void) {
+    setSampleTimer(0);
+    signal(SIGPROF, SIG_IGN);
+    s_running = 0;
+}
+
+int pcProfilerRunning(void) { return s_running; }
+u32 pcProfilerSampleCount(void) { return s_samples; }
+
+int pcProfilerDumpToFile(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        return -1;
+    }
+    fprintf(f, "# pc_profiler desktop\n");
+    fprintf(f, "hz %d\n", PC_PROFILER_HZ);
+    fprintf(f, "anchor pcProfilerStart 0x%lx\n", (unsigned long)(uintptr_t)pcProfilerStart);
+    fprintf(f, "samples %u\n", (unsigned)s_samples);
+    fprintf(f, "other %u\n", (unsigned)s_otherSamples);
+    for (int i = 0; i < DESKTOP_SLOTS; i++) {
+        if (s_slots[i].count) {
+            fprintf(f, "0x%lx %u\n", (unsigned long)s_slots[i].pc, (unsigned)s_slots[i].count);
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+#endif // DESKTOP_BUILD
+
+#endif // PC_PROFILER_ENABLED
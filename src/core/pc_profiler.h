@@ -0,0 +1,82 @@
+#ifndef PC_PROFILER_H
+#define PC_PROFILER_H
+
+#include "core/game_types.h"
+
+// Statistical PC profiler.
+//
+// The TM0 scopes in main.c only time what we already suspect. This samples
+// instead: a spare timer (TM2) interrupts PC_PROFILER_HZ times a second and
+// the handler bins the interrupted PC, taken from the BIOS IRQ stack frame,
+// into a u16 histogram in EWRAM (one bucket per 32 bytes of ROM / IWRAM
+// code, plus BIOS and "other" counters). pcProfilerDumpToSRAM() writes it
+// after the replay block; tools/pc_profile.py symbolises it against
+// game.elf and prints the top functions and lines.
+//
+// Overhead is one IRQ per sample: the master ISR plus ~30 Thumb instructions,
+// roughly 250 cycles, so ~1.5% of the CPU at the default 1024 Hz. Buckets
+// saturate instead of wrapping. Samples taken while another ISR runs are
+// charged to the code that ISR interrupted.
+//
+// Build with PC_PROFILER_ENABLED=0 (make PROFILER=0) to compile it out; the
+// API below then reduces to empty inlines.
+//
+// Desktop builds sample the host PC with SIGPROF instead and write a text
+// profile that the same tool reads (see tests/README.md).
+
+#ifndef PC_PROFILER_ENABLED
+#define PC_PROFILER_ENABLED 1
+#endif
+
+// Sample rate. TM2 runs at 262144 Hz (prescaler 64), so 4..262144 Hz.
+#ifndef PC_PROFILER_HZ
+#define PC_PROFILER_HZ 1024
+#endif
+
+// Histogram geometry
+#define PC_PROFILER_BUCKET_SHIFT 5          // 32 bytes of code per bucket
+#define PC_PROFILER_ROM_SPAN     0x40000    // first 256KB of ROM
+#define PC_PROFILER_IWRAM_SPAN   0x8000
+#define PC_PROFILER_ROM_BUCKETS   (PC_PROFILER_ROM_SPAN >> PC_PROFILER_BUCKET_SHIFT)
+#define PC_PROFILER_IWRAM_BUCKETS (PC_PROFILER_IWRAM_SPAN >> PC_PROFILER_BUCKET_SHIFT)
+
+// Save memory dump (core/save.h): header of eight little-endian u32s (magic, samples, bucket
+// shift, ROM buckets, IWRAM buckets, BIOS samples, other samples, Hz), then
+// the ROM and IWRAM buckets as u16s. Starts past the replay block
+// (17 + 2 * MAX_REPLAY_FRAMES bytes at offset 0).
+#define PC_PROFILER_SRAM_OFFSET 0x2000
+#define PC_PROFILER_MAGIC       0x46504350  // "PCPF"
+
+#if PC_PROFILER_ENABLED
+
+// Clear the histogram and start sampling.
+void pcProfilerStart(void);
+
+// Stop sampling; the histogram is kept until the next start.
+void pcProfilerStop(void);
+
+int pcProfilerRunning(void);
+u32 pcProfilerSampleCount(void);
+
+#ifndef DESKTOP_BUILD
+void pcProfilerDumpToSRAM(void);
+#else
+// Write the text profile to `path`. Returns 0 on success.
+int pcProfilerDumpToFile(const char* path);
+#endif
+
+#else
+
+static inline void pcProfilerStart(void) {}
+static inline void pcProfilerStop(void) {}
+static inline int pcProfilerRunning(void) { return 0; }
+static inline u32 pcProfilerSampleCount(void) { return 0; }
+#ifndef DESKTOP_BUILD
+static inline void pcProfilerDumpToSRAM(void) {}
+#else
+static inline int pcProfilerDumpToFile(const char* path) { (void)path; return -1; }
+#endif
+
+#endif // PC_PROFILER_ENABLED
+
+#endif // PC_PROFILER_H
@@ -0,0 +1,54 @@
+#include "quality.h"
+#include "log.h"
+
+static int s_level = QUALITY_FULL;
+static int s_calmFrames = 0;
+static int s_cooldown = 0;
+static u32 s_degradedFrames = 0;
+
+void initQualityGovernor(void) {
+    s_level = QUALITY_FULL;
+    s_calmFrames = 0;
+    s_cooldown = 0;
+    s_degradedFrames = 0;
+}
+
+void qualityGovernorUpdate(u16 workTicks) {
+    if (s_cooldown > 0) {
+        s_cooldown--;
+    }
+
+    if (workTicks > QUALITY_SHED_TICKS) {
+        s_calmFrames = 0;
+        if (s_cooldown == 0 && s_level < QUALITY_SHED_COUNT - 1) {
+            s_level++;
+            s_cooldown = QUALITY_SHED_COOLDOWN;
+            LOG2(LOG_QUALITY_LEVEL, s_level - 1, s_level);
+        }
+    } else if (workTicks < QUALITY_RESTORE_TICKS) {
+        if (s_level > QUALITY_FULL && ++s_calmFrames >= QUALITY_RESTORE_FRAMES) {
+            s_level--;
+            s_calmFrames = 0;
+            LOG2(LOG_QUALITY_LEVEL, s_level + 1, s_level);
+        }
+    } else {
+        // Between the marks: hold the current level.
+        s_calmFrames = 0;
+    }
+
+    if (s_level > QUALITY_FULL) {
+        s_degradedFrames++;
+    }
+}
+
+int qualityShedding(QualityShed feature) {
+    return s_level >= (int)feature;
+}
+
+int qualityLevel(void) {
+    return s_level;
+}
+
+u32 qualityDegradedFrames(void) {
+    return s_degradedFrames;
+}
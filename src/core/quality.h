@@ -0,0 +1,47 @@
+#ifndef QUALITY_H
+#define QUALITY_H
+
+#include "core/game_types.h"
+
+// Adaptive quality governor.
+//
+// Fed the measured CPU cost of each gameplay frame, it sheds optional
+// presentation work in a fixed order when headroom runs out and restores it
+// with hysteresis once frames are comfortably cheap again. It never gates
+// anything that feeds player/entity simulation, so recorded replays play
+// back identically whatever the governor decides.
+
+// Shed levels, in the order optional work is dropped. Querying a feature
+// returns true once the current level has reached it.
+typedef enum {
+    QUALITY_FULL = 0,
+    QUALITY_SHED_OVERLAY,  // profiling / replay status text refresh (not "Deg:")
+    QUALITY_SHED_TRAIL,    // dash trail sprites (trail state still simulates)
+    QUALITY_SHED_COUNT
+} QualityShed;
+
+// One frame of CPU time in TM0 ticks (prescaler 1024: 280896 / 1024).
+#define QUALITY_FRAME_TICKS    274
+// Shed the next feature when a frame uses more than ~85% of the budget...
+#define QUALITY_SHED_TICKS     233
+// ...and restore one when frames stay under ~60% for a full second.
+#define QUALITY_RESTORE_TICKS  164
+#define QUALITY_RESTORE_FRAMES 60
+// Minimum frames between two shed steps, so one spike drops one feature.
+#define QUALITY_SHED_COOLDOWN  8
+
+void initQualityGovernor(void);
+
+// Report the work time (TM0 ticks, VBlank to end of frame) of a gameplay frame.
+void qualityGovernorUpdate(u16 workTicks);
+
+// Non-zero if the given feature is currently shed.
+int qualityShedding(QualityShed feature);
+
+// Current shed level (QUALITY_FULL when nothing is shed).
+int qualityLevel(void);
+
+// Total frames spent with at least one feature shed.
+u32 qualityDegradedFrames(void);
+
+#endif // QUALITY_H
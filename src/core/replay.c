@@ -1,4 +1,5 @@
 #include "replay.h"
+#include "save.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -164,80 +165,47 @@ int getReplayLevel(ReplayState* replay) {
     return replay->levelIndex;
 }
 
-// SRAM save/load - must use byte writes for GBA SRAM
-#ifndef DESKTOP_BUILD
-#define SRAM_START ((u8*)0x0E000000)
-#endif
+// Save memory layout (core/save.h), little endian: magic byte, frame
+// count, start X, start Y, level index (4 bytes each), then 2 bytes per
+// input frame.
 #define REPLAY_MAGIC 0x59  // Just first byte 'Y' from "RPLY"
+#define REPLAY_INPUTS_OFFSET 17
 
 void saveReplayToSRAM(ReplayState* replay) {
 #ifndef DESKTOP_BUILD
-    u8* sram = SRAM_START;
-
-    // Write magic byte
-    sram[0] = REPLAY_MAGIC;
-
-    // Write frame count (4 bytes, little endian)
-    sram[1] = (replay->frameCount >> 0) & 0xFF;
-    sram[2] = (replay->frameCount >> 8) & 0xFF;
-    sram[3] = (replay->frameCount >> 16) & 0xFF;
-    sram[4] = (replay->frameCount >> 24) & 0xFF;
-
-    // Write starting position (8 bytes: 4 for X, 4 for Y, little endian)
-    sram[5] = (replay->startX >> 0) & 0xFF;
-    sram[6] = (replay->startX >> 8) & 0xFF;
-    sram[7] = (replay->startX >> 16) & 0xFF;
-    sram[8] = (replay->startX >> 24) & 0xFF;
-    sram[9] = (replay->startY >> 0) & 0xFF;
-    sram[10] = (replay->startY >> 8) & 0xFF;
-    sram[11] = (replay->startY >> 16) & 0xFF;
-    sram[12] = (replay->startY >> 24) & 0xFF;
-
-    // Write level index (4 bytes, little endian)
-    sram[13] = (replay->levelIndex >> 0) & 0xFF;
-    sram[14] = (replay->levelIndex >> 8) & 0xFF;
-    sram[15] = (replay->levelIndex >> 16) & 0xFF;
-    sram[16] = (replay->levelIndex >> 24) & 0xFF;
-
-    // Write input data (2 bytes per frame, little endian)
-    int offset = 17;
+    saveWrite8(0, REPLAY_MAGIC);
+    saveWrite32(1, (u32)replay->frameCount);
+    saveWrite32(5, (u32)replay->startX);
+    saveWrite32(9, (u32)replay->startY);
+    saveWrite32(13, (u32)replay->levelIndex);
+
+    u32 offset = REPLAY_INPUTS_OFFSET;
     for (int i = 0; i < replay->frameCount && i < MAX_REPLAY_FRAMES; i++) {
-        sram[offset++] = (replay->inputs[i] >> 0) & 0xFF;  // Low byte
-        sram[offset++] = (replay->inputs[i] >> 8) & 0xFF;  // High byte
+        saveWrite16(offset, replay->inputs[i]);
+        offset += 2;
     }
 #endif
 }
 
 void loadReplayFromSRAM(ReplayState* replay) {
 #ifndef DESKTOP_BUILD
-    u8* sram = SRAM_START;
-
-    // Check magic byte
-    if (sram[0] != REPLAY_MAGIC) {
+    if (saveRead8(0) != REPLAY_MAGIC) {
         replay->frameCount = 0;
         return;
     }
 
-    // Read frame count (4 bytes, little endian)
-    replay->frameCount = sram[1] | (sram[2] << 8) | (sram[3] << 16) | (sram[4] << 24);
-
+    replay->frameCount = (int)saveRead32(1);
     if (replay->frameCount > MAX_REPLAY_FRAMES) {
         replay->frameCount = MAX_REPLAY_FRAMES;
     }
+    replay->startX = (int)saveRead32(5);
+    replay->startY = (int)saveRead32(9);
+    replay->levelIndex = (int)saveRead32(13);
 
-    // Read starting position (8 bytes: 4 for X, 4 for Y, little endian)
-    replay->startX = sram[5] | (sram[6] << 8) | (sram[7] << 16) | (sram[8] << 24);
-    replay->startY = sram[9] | (sram[10] << 8) | (sram[11] << 16) | (sram[12] << 24);
-
-    // Read level index (4 bytes, little endian)
-    replay->levelIndex = sram[13] | (sram[14] << 8) | (sram[15] << 16) | (sram[16] << 24);
-
-    // Read input data (2 bytes per frame, little endian)
-    int offset = 17;
+    u32 offset = REPLAY_INPUTS_OFFSET;
     for (int i = 0; i < replay->frameCount; i++) {
-        u8 low = sram[offset++];
-        u8 high = sram[offset++];
-        replay->inputs[i] = low | (high << 8);
+        replay->inputs[i] = saveRead16(offset);
+        offset += 2;
     }
 
     replay->currentFrame = 0;
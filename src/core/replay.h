@@ -54,7 +54,8 @@ void loadReplayFromFile(ReplayState* replay, const char* filename);
 // Print replay data to console for copying (desktop only)
 void printReplayData(ReplayState* replay);
 
-// Save/load replay to/from SRAM (GBA save file)
+// Save/load replay to/from save memory at offset 0 (core/save.h; the
+// names predate flash support)
 void saveReplayToSRAM(ReplayState* replay);
 void loadReplayFromSRAM(ReplayState* replay);
 
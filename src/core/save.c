@@ -0,0 +1,401 @@
+#include "save.h"
+
+// Flash backends (and their EWRAM mirror) only exist in flash builds and on
+// the desktop, where tests run both against the chip emulator.
+#if SAVE_TYPE != SAVE_TYPE_SRAM || defined(DESKTOP_BUILD)
+#define SAVE_FLASH_BACKENDS 1
+#endif
+
+#ifndef DESKTOP_BUILD
+
+#define SAVE_MEM ((volatile u8*)0x0E000000)
+
+static inline u8 busRead(u32 addr) { return SAVE_MEM[addr]; }
+static inline void busWrite(u32 addr, u8 value) { SAVE_MEM[addr] = value; }
+
+// Save type ID for emulators and flash carts (searched for in the ROM, word
+// aligned, padded).
+#if SAVE_TYPE == SAVE_TYPE_FLASH128
+#define SAVE_TYPE_ID "FLASH1M_V103"
+#elif SAVE_TYPE == SAVE_TYPE_FLASH64
+#define SAVE_TYPE_ID "FLASH_V126"
+#else
+#define SAVE_TYPE_ID "SRAM_V113"
+#endif
+__attribute__((used, aligned(4))) const char g_saveTypeId[] = SAVE_TYPE_ID "\0\0\0";
+
+#else // DESKTOP_BUILD
+
+#include "desktop/flash_emu.h"
+
+static u8 s_desktopSram[SAVE_LOGICAL_SIZE];
+
+#define busRead  flashEmuRead
+#define busWrite flashEmuWrite
+
+#endif
+
+static const SaveBackend* s_backend = 0;
+
+// ---------------------------------------------------------------------------
+// SRAM
+// ---------------------------------------------------------------------------
+
+static void sramMount(void) {
+}
+
+#ifndef DESKTOP_BUILD
+static u8 sramRead8(u32 offset) { return SAVE_MEM[offset]; }
+static void sramWrite8(u32 offset, u8 value) { SAVE_MEM[offset] = value; }
+#else
+static u8 sramRead8(u32 offset) { return s_desktopSram[offset]; }
+static void sramWrite8(u32 offset, u8 value) { s_desktopSram[offset] = value; }
+#endif
+
+static int sramService(int ticksLeft) {
+    (void)ticksLeft;
+    return 0;
+}
+
+const SaveBackend g_saveSram = {
+    .name = "SRAM",
+    .mount = sramMount,
+    .read8 = sramRead8,
+    .write8 = sramWrite8,
+    .service = sramService,
+};
+
+#ifdef SAVE_FLASH_BACKENDS
+
+// ---------------------------------------------------------------------------
+// Flash
+// ---------------------------------------------------------------------------
+
+#define FLASH_CMD_ADDR1     0x5555
+#define FLASH_CMD_ADDR2     0x2AAA
+#define FLASH_SECTORS_PER_BANK 16
+#define FLASH_PROGRAM_POLLS 0x1000   // ~20 us worst case per byte on real chips
+#define FLASH_ERASE_TIMEOUT 120      // service calls (frames) before giving up on a sector
+#define FLASH_HEADER_BYTES  9        // magic, sequence, logical sector
+
+#if SAVE_FLASH_PAYLOAD != 4080 || SAVE_LOGICAL_SIZE > 32768
+#error "sectorOf() reciprocal assumes 4080-byte payloads and offsets below 32 KB"
+#endif
+
+// offset / SAVE_FLASH_PAYLOAD without a library divide (exact for every
+// offset below SAVE_LOGICAL_SIZE).
+#define sectorOf(offset) (((offset) * 65794u) >> 28)
+
+typedef enum {
+    JOB_IDLE = 0,
+    JOB_ERASING,
+    JOB_PAYLOAD,
+    JOB_HEADER,
+} FlashJobState;
+
+typedef struct {
+    FlashJobState state;
+    int logical;
+    int phys;
+    int pos;       // next payload / header byte
+    int polls;     // erase polls so far
+    u8 header[FLASH_HEADER_BYTES];
+} FlashJob;
+
+static u8 s_mirror[SAVE_LOGICAL_SIZE] __attribute__((section(".ewram"), aligned(4)));
+static u8 s_dirty[SAVE_FLASH_LOGICAL_SECTORS];
+static s8 s_live[SAVE_FLASH_LOGICAL_SECTORS];  // physical sector, or -1
+static int s_physSectors = 0;
+static int s_bank = -1;
+static int s_nextPhys = 0;
+static u32 s_nextSeq = 1;
+static FlashJob s_job;
+
+static void flashCommand(u8 command) {
+    busWrite(FLASH_CMD_ADDR1, 0xAA);
+    busWrite(FLASH_CMD_ADDR2, 0x55);
+    busWrite(FLASH_CMD_ADDR1, command);
+}
+
+// Select the 64K bank holding `phys` and return its base address there.
+static u32 sectorBase(int phys) {
+    int bank = phys / FLASH_SECTORS_PER_BANK;
+    if (s_physSectors > FLASH_SECTORS_PER_BANK && bank != s_bank) {
+        flashCommand(0xB0);
+        busWrite(0x0000, (u8)bank);
+        s_bank = bank;
+    }
+    return (u32)(phys % FLASH_SECTORS_PER_BANK) * SAVE_FLASH_SECTOR_SIZE;
+}
+
+static u32 busRead32(u32 addr) {
+    return (u32)busRead(addr) | ((u32)busRead(addr + 1) << 8) |
+           ((u32)busRead(addr + 2) << 16) | ((u32)busRead(addr + 3) << 24);
+}
+
+static void eraseStart(int phys) {
+    u32 base = sectorBase(phys);
+    flashCommand(0x80);
+    busWrite(FLASH_CMD_ADDR1, 0xAA);
+    busWrite(FLASH_CMD_ADDR2, 0x55);
+    busWrite(base, 0x30);
+}
+
+// An erasing chip returns status bits; the sector reads 0xFF once it is done.
+static int eraseDone(int phys) {
+    return busRead(sectorBase(phys)) == 0xFF;
+}
+
+static int programByte(u32 addr, u8 value) {
+    flashCommand(0xA0);
+    busWrite(addr, value);
+    for (int i = 0; i < FLASH_PROGRAM_POLLS; i++) {
+        if (busRead(addr) == value) return 1;
+    }
+    return 0;
+}
+
+static int isLive(int phys) {
+    for (int i = 0; i < SAVE_FLASH_LOGICAL_SECTORS; i++) {
+        if (s_live[i] == phys) return 1;
+    }
+    return 0;
+}
+
+// Pick the next dirty logical sector and the next physical sector (round
+// robin) that holds no live copy, and start erasing it.
+static int startJob(void) {
+    int logical = -1;
+    for (int i = 0; i < SAVE_FLASH_LOGICAL_SECTORS; i++) {
+        if (s_dirty[i]) {
+            logical = i;
+            break;
+        }
+    }
+    if (logical < 0) return 0;
+
+    int phys = s_nextPhys;
+    while (isLive(phys)) {
+        phys = (phys + 1) % s_physSectors;
+    }
+    s_nextPhys = (phys + 1) % s_physSectors;
+    s_dirty[logical] = 0;
+
+    FlashJob* job = &s_job;
+    job->state = JOB_ERASING;
+    job->logical = logical;
+    job->phys = phys;
+    job->pos = 0;
+    job->polls = 0;
+    for (int i = 0; i < 4; i++) {
+        job->header[i] = (u8)(SAVE_FLASH_MAGIC >> (i * 8));
+        job->header[4 + i] = (u8)(s_nextSeq >> (i * 8));
+    }
+    job->header[8] = (u8)logical;
+    eraseStart(phys);
+    return 1;
+}
+
+// Abandon the job: the sector is retried elsewhere on a later call.
+static void failJob(void) {
+    s_dirty[s_job.logical] = 1;
+    s_job.state = JOB_IDLE;
+}
+
+static void flashMountSectors(int sectors) {
+    s_physSectors = sectors;
+    s_bank = -1;
+    s_job.state = JOB_IDLE;
+
+    u32 liveSeq[SAVE_FLASH_LOGICAL_SECTORS];
+    u32 newestSeq = 0;
+    int newestPhys = -1;
+    for (int i = 0; i < SAVE_FLASH_LOGICAL_SECTORS; i++) {
+        s_live[i] = -1;
+        s_dirty[i] = 0;
+        liveSeq[i] = 0;
+    }
+
+    busWrite(FLASH_CMD_ADDR1, 0xF0);  // leave any half-issued command
+    for (int phys = 0; phys < sectors; phys++) {
+        u32 base = sectorBase(phys);
+        if (busRead32(base) != SAVE_FLASH_MAGIC) continue;
+        if (busRead(base + SAVE_FLASH_COMMIT_OFFSET) != 0x00) continue;
+        int logical = busRead(base + 8);
+        if (logical >= SAVE_FLASH_LOGICAL_SECTORS) continue;
+
+        u32 seq = busRead32(base + 4);
+        if (s_live[logical] < 0 || seq > liveSeq[logical]) {
+            s_live[logical] = (s8)phys;
+            liveSeq[logical] = seq;
+        }
+        if (newestPhys < 0 || seq > newestSeq) {
+            newestSeq = seq;
+            newestPhys = phys;
+        }
+    }
+    s_nextSeq = newestSeq + 1;
+    s_nextPhys = (newestPhys + 1) % sectors;
+
+    for (int logical = 0; logical < SAVE_FLASH_LOGICAL_SECTORS; logical++) {
+        u8* dst = &s_mirror[logical * SAVE_FLASH_PAYLOAD];
+        if (s_live[logical] < 0) {
+            for (int i = 0; i < SAVE_FLASH_PAYLOAD; i++) dst[i] = 0xFF;
+            continue;
+        }
+        u32 base = sectorBase(s_live[logical]) + SAVE_FLASH_HEADER_SIZE;
+        for (int i = 0; i < SAVE_FLASH_PAYLOAD; i++) {
+            dst[i] = busRead(base + i);
+        }
+    }
+}
+
+static void flash64Mount(void) { flashMountSectors(FLASH_SECTORS_PER_BANK); }
+static void flash128Mount(void) { flashMountSectors(FLASH_SECTORS_PER_BANK * 2); }
+
+static u8 flashRead8(u32 offset) {
+    return s_mirror[offset];
+}
+
+static void flashWrite8(u32 offset, u8 value) {
+    if (s_mirror[offset] == value) return;
+    s_mirror[offset] = value;
+    s_dirty[sectorOf(offset)] = 1;
+}
+
+// Bytes still 0xFF after the erase are skipped; skipping sixteen of them
+// costs as much budget as programming one.
+static int flashService(int ticksLeft) {
+    int budget = ticksLeft > 0 ? SAVE_FLASH_TICKS_TO_BYTES(ticksLeft) : 0;
+    if (budget > SAVE_FLASH_BYTES_PER_SERVICE) budget = SAVE_FLASH_BYTES_PER_SERVICE;
+    if (s_job.state == JOB_IDLE && !startJob()) return 0;
+    if (budget <= 0) return 1;
+
+    FlashJob* job = &s_job;
+    if (job->state == JOB_ERASING) {
+        if (!eraseDone(job->phys)) {
+            if (++job->polls >= FLASH_ERASE_TIMEOUT) failJob();
+            return 1;
+        }
+        job->state = JOB_PAYLOAD;
+    }
+
+    u32 base = sectorBase(job->phys);
+    int skipped = 0;
+    while (budget > 0 && job->state == JOB_PAYLOAD) {
+        u8 value = s_mirror[job->logical * SAVE_FLASH_PAYLOAD + job->pos];
+        if (value != 0xFF) {
+            if (!programByte(base + SAVE_FLASH_HEADER_SIZE + job->pos, value)) {
+                failJob();
+                return 1;
+            }
+            budget--;
+        } else if (++skipped == 16) {
+            skipped = 0;
+            budget--;
+        }
+        if (++job->pos == SAVE_FLASH_PAYLOAD) {
+            job->state = JOB_HEADER;
+            job->pos = 0;
+        }
+    }
+
+    // Header last, commit byte very last: until it reads 0x00 the sector is
+    // ignored by mount and the previous copy stays current.
+    while (budget > 0 && job->state == JOB_HEADER) {
+        int ok;
+        if (job->pos < FLASH_HEADER_BYTES) {
+            ok = programByte(base + job->pos, job->header[job->pos]);
+        } else {
+            ok = programByte(base + SAVE_FLASH_COMMIT_OFFSET, 0x00);
+        }
+        if (!ok) {
+            failJob();
+            return 1;
+        }
+        budget--;
+        if (++job->pos > FLASH_HEADER_BYTES) {
+            s_live[job->logical] = (s8)job->phys;
+            s_nextSeq++;
+            job->state = JOB_IDLE;
+        }
+    }
+
+    if (job->state != JOB_IDLE) return 1;
+    for (int i = 0; i < SAVE_FLASH_LOGICAL_SECTORS; i++) {
+        if (s_dirty[i]) return 1;
+    }
+    return 0;
+}
+
+const SaveBackend g_saveFlash64 = {
+    .name = "Flash 64K",
+    .mount = flash64Mount,
+    .read8 = flashRead8,
+    .write8 = flashWrite8,
+    .service = flashService,
+};
+
+const SaveBackend g_saveFlash128 = {
+    .name = "Flash 128K",
+    .mount = flash128Mount,
+    .read8 = flashRead8,
+    .write8 = flashWrite8,
+    .service = flashService,
+};
+
+#endif // SAVE_FLASH_BACKENDS
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+void saveInit(const SaveBackend* backend) {
+    s_backend = backend;
+    backend->mount();
+}
+
+const SaveBackend* saveBackend(void) {
+    if (!s_backend) saveInit(&SAVE_DEFAULT_BACKEND);
+    return s_backend;
+}
+
+u8 saveRead8(u32 offset) {
+    if (offset >= SAVE_LOGICAL_SIZE) return 0xFF;
+    return saveBackend()->read8(offset);
+}
+
+void saveWrite8(u32 offset, u8 value) {
+    if (offset >= SAVE_LOGICAL_SIZE) return;
+    saveBackend()->write8(offset, value);
+}
+
+u16 saveRead16(u32 offset) {
+    return (u16)(saveRead8(offset) | (saveRead8(offset + 1) << 8));
+}
+
+u32 saveRead32(u32 offset) {
+    return (u32)saveRead8(offset) | ((u32)saveRead8(offset + 1) << 8) |
+           ((u32)saveRead8(offset + 2) << 16) | ((u32)saveRead8(offset + 3) << 24);
+}
+
+void saveWrite16(u32 offset, u16 value) {
+    saveWrite8(offset, (u8)value);
+    saveWrite8(offset + 1, (u8)(value >> 8));
+}
+
+void saveWrite32(u32 offset, u32 value) {
+    saveWrite8(offset, (u8)value);
+    saveWrite8(offset + 1, (u8)(value >> 8));
+    saveWrite8(offset + 2, (u8)(value >> 16));
+    saveWrite8(offset + 3, (u8)(value >> 24));
+}
+
+int saveService(int ticksLeft) {
+    return saveBackend()->service(ticksLeft);
+}
+
+void saveFlush(void) {
+    while (saveService(SAVE_FLASH_SERVICE_TICKS)) {
+    }
+}
@@ -0,0 +1,114 @@
+#ifndef SAVE_H
+#define SAVE_H
+
+#include "core/game_types.h"
+
+// Save memory backends.
+//
+// Everything persistent (replay, profiler dump, telemetry) lives in one
+// logical byte space of SAVE_LOGICAL_SIZE bytes and goes through
+// saveRead8 / saveWrite8 with a logical offset; the backend decides where
+// the bytes really go.
+//
+// SRAM: battery-backed SRAM at 0x0E000000, byte writes straight through.
+//
+// Flash (64K or 128K, SST / Macronix / Panasonic / Sanyo command set):
+// bytes can only be programmed from 1 to 0 and a 4 KB sector has to be
+// erased before it is rewritten, so the logical space is split into
+// SAVE_FLASH_LOGICAL_SECTORS sectors of SAVE_FLASH_PAYLOAD bytes that are
+// mirrored in EWRAM. Writes only touch the mirror and mark it dirty;
+// saveService() later copies a dirty logical sector into a fresh physical
+// sector (erase, program payload, program header, program commit byte)
+// and only then retires the old copy. Physical sectors are taken round
+// robin from everything that does not hold a live copy, so erases are
+// spread over the whole chip, and a power cut at any point leaves the
+// previous copy of every sector intact.
+//
+// saveService() never waits on the chip: an erase is started and polled on
+// later calls, and at most SAVE_FLASH_BYTES_PER_SERVICE bytes are
+// programmed per call, fewer if the frame has less slack.
+//
+// The backend is picked at build time (make SAVE=SRAM|FLASH64|FLASH128),
+// which also puts the matching save type ID string in the ROM so emulators
+// and flash carts emulate the right chip. tools/save_unpack.py turns a
+// flash .sav back into the SRAM layout the other tools expect.
+
+#define SAVE_TYPE_SRAM     0
+#define SAVE_TYPE_FLASH64  1
+#define SAVE_TYPE_FLASH128 2
+
+#ifndef SAVE_TYPE
+#define SAVE_TYPE SAVE_TYPE_SRAM
+#endif
+
+#define SAVE_FLASH_SECTOR_SIZE     0x1000
+#define SAVE_FLASH_HEADER_SIZE     16
+#define SAVE_FLASH_PAYLOAD         (SAVE_FLASH_SECTOR_SIZE - SAVE_FLASH_HEADER_SIZE)
+#define SAVE_FLASH_LOGICAL_SECTORS 8
+#define SAVE_FLASH_MAGIC           0x46564153  // "SAVF"
+
+// Highest logical offset + 1 any backend can hold
+#define SAVE_LOGICAL_SIZE (SAVE_FLASH_LOGICAL_SECTORS * SAVE_FLASH_PAYLOAD)
+
+// Flash sector header (little-endian):
+//    0  u32 SAVE_FLASH_MAGIC
+//    4  u32 sequence (newest copy of a logical sector wins)
+//    8  u8  logical sector
+//   15  u8  commit: 0x00 once payload and header are programmed
+// Payload follows at SAVE_FLASH_HEADER_SIZE.
+#define SAVE_FLASH_COMMIT_OFFSET 15
+
+// Programming budget. A byte program is ~20 us worst case on real chips;
+// with its command sequence and status polling it is budgeted at 512 CPU
+// cycles, two per TM0 tick (1024 cycles). The slack a call is given is
+// converted to bytes at that rate and capped per call.
+#define SAVE_FLASH_BYTE_CYCLES       512
+#define SAVE_FLASH_TICK_CYCLES       1024
+#define SAVE_FLASH_BYTES_PER_SERVICE 128
+#define SAVE_FLASH_TICKS_TO_BYTES(ticks) ((ticks) * SAVE_FLASH_TICK_CYCLES / SAVE_FLASH_BYTE_CYCLES)
+// Slack that buys a full SAVE_FLASH_BYTES_PER_SERVICE call
+#define SAVE_FLASH_SERVICE_TICKS \
+    ((SAVE_FLASH_BYTES_PER_SERVICE * SAVE_FLASH_BYTE_CYCLES + SAVE_FLASH_TICK_CYCLES - 1) / SAVE_FLASH_TICK_CYCLES)
+
+typedef struct {
+    const char* name;
+    void (*mount)(void);
+    u8 (*read8)(u32 offset);
+    void (*write8)(u32 offset, u8 value);
+    // Do up to `ticksLeft` TM0 ticks of deferred work. Returns 1 while
+    // writes are still pending.
+    int (*service)(int ticksLeft);
+} SaveBackend;
+
+extern const SaveBackend g_saveSram;
+extern const SaveBackend g_saveFlash64;
+extern const SaveBackend g_saveFlash128;
+
+// Mount `backend` (flash: scan headers, fill the mirror). Boot calls this
+// with SAVE_DEFAULT_BACKEND before anything reads or writes save memory.
+void saveInit(const SaveBackend* backend);
+const SaveBackend* saveBackend(void);
+
+u8 saveRead8(u32 offset);
+void saveWrite8(u32 offset, u8 value);
+u16 saveRead16(u32 offset);
+u32 saveRead32(u32 offset);
+void saveWrite16(u32 offset, u16 value);
+void saveWrite32(u32 offset, u32 value);
+
+// Main loop slack: push pending writes to the chip. Returns 1 while
+// anything is still pending.
+int saveService(int ticksLeft);
+
+// Service until nothing is pending (tests, tools).
+void saveFlush(void);
+
+#if SAVE_TYPE == SAVE_TYPE_FLASH128
+#define SAVE_DEFAULT_BACKEND g_saveFlash128
+#elif SAVE_TYPE == SAVE_TYPE_FLASH64
+#define SAVE_DEFAULT_BACKEND g_saveFlash64
+#else
+#define SAVE_DEFAULT_BACKEND g_saveSram
+#endif
+
+#endif // SAVE_H
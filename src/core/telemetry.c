@@ -0,0 +1,275 @@
+#include "telemetry.h"
+#include "quality.h"
+#include "save.h"
+
+// Save memory records (little-endian, core/save.h):
+//
+//   room, 32 bytes                       transition, 16 bytes
+//     0  u16 room index                    0  u16 from room
+//     2  u16 visits                        2  u16 to room
+//     4  u32 frames                        4  u16 count
+//     8  u32 lag frames                    6  u16 longest (frames)
+//    12  u32 total ticks                   8  u16 worst frame
+//    16  u16 worst frame                  10  u16 worst transition phase
+//    18  u16 p95 (worst of any visit)     12  u32 lag frames
+//    20  u16 phase worst[5]
+//    30  u16 reserved
+//
+// Free slots have room / from = TELEMETRY_NO_ROOM.
+
+#define SRAM_BASE        TELEMETRY_SRAM_OFFSET
+#define HEADER_SIZE      16
+#define ROOM_RECORD      32
+#define TRANSITION_RECORD 16
+#define ROOMS_BASE       (SRAM_BASE + HEADER_SIZE)
+#define TRANSITIONS_BASE (ROOMS_BASE + TELEMETRY_ROOM_SLOTS * ROOM_RECORD)
+
+#if TRANSITIONS_BASE + TELEMETRY_TRANSITION_SLOTS * TRANSITION_RECORD > SAVE_LOGICAL_SIZE
+#error "Telemetry table runs past the end of save memory"
+#endif
+
+typedef struct {
+    u16 room;
+    u32 frames;
+    u32 lagFrames;
+    u32 totalTicks;
+    u16 worst;
+    u16 phaseWorst[TELEMETRY_PHASE_COUNT];
+    u16 hist[TELEMETRY_HIST_BINS];
+} RoomAccum;
+
+typedef struct {
+    int active;
+    u16 from;
+    u32 frames;
+    u32 lagFrames;
+    u16 worst;
+    u16 worstPhase;
+} TransitionAccum;
+
+u16 g_telemetryFrame[TELEMETRY_PHASE_COUNT];
+
+static RoomAccum s_room;
+static TransitionAccum s_transition;
+static int s_frameInTransition = 0;
+static int s_headerChecked = 0;
+
+// ---------------------------------------------------------------------------
+// Save memory helpers
+// ---------------------------------------------------------------------------
+
+static void saveMax16(u32 offset, u16 value) {
+    if (value > saveRead16(offset)) {
+        saveWrite16(offset, value);
+    }
+}
+
+static void saveAdd32(u32 offset, u32 value) {
+    saveWrite32(offset, saveRead32(offset) + value);
+}
+
+static void clearSRAM(void) {
+    u32 sram = SRAM_BASE;
+    saveWrite32(sram + 0, TELEMETRY_MAGIC);
+    saveWrite16(sram + 4, TELEMETRY_VERSION);
+    saveWrite16(sram + 6, TELEMETRY_ROOM_SLOTS);
+    saveWrite16(sram + 8, TELEMETRY_TRANSITION_SLOTS);
+    saveWrite16(sram + 10, QUALITY_FRAME_TICKS);
+    saveWrite32(sram + 12, 0);
+
+    for (int i = 0; i < TELEMETRY_ROOM_SLOTS * ROOM_RECORD; i++) {
+        saveWrite8(ROOMS_BASE + i, 0);
+    }
+    for (int i = 0; i < TELEMETRY_TRANSITION_SLOTS * TRANSITION_RECORD; i++) {
+        saveWrite8(TRANSITIONS_BASE + i, 0);
+    }
+    for (int i = 0; i < TELEMETRY_ROOM_SLOTS; i++) {
+        saveWrite16(ROOMS_BASE + i * ROOM_RECORD, TELEMETRY_NO_ROOM);
+    }
+    for (int i = 0; i < TELEMETRY_TRANSITION_SLOTS; i++) {
+        saveWrite16(TRANSITIONS_BASE + i * TRANSITION_RECORD, TELEMETRY_NO_ROOM);
+    }
+}
+
+// Keep whatever earlier sessions recorded unless the layout changed.
+static void ensureHeader(void) {
+    if (s_headerChecked) return;
+    s_headerChecked = 1;
+
+    u32 sram = SRAM_BASE;
+    if (saveRead32(sram + 0) != TELEMETRY_MAGIC ||
+        saveRead16(sram + 4) != TELEMETRY_VERSION ||
+        saveRead16(sram + 6) != TELEMETRY_ROOM_SLOTS ||
+        saveRead16(sram + 8) != TELEMETRY_TRANSITION_SLOTS) {
+        clearSRAM();
+    }
+}
+
+// Slot holding `key`, else the first free slot, else the slot with the
+// smallest `weight` field (u32 at weightOffset for rooms, u16 for transitions).
+static u32 findSlot(u32 base, int slots, int recordSize, u32 key, int keyBytes,
+                    int weightOffset, int weightBytes) {
+    u32 freeSlot = 0;
+    u32 lightest = base;
+    u32 lightestWeight = 0xFFFFFFFF;
+
+    for (int i = 0; i < slots; i++) {
+        u32 rec = base + i * recordSize;
+        u32 recKey = (keyBytes == 4) ? saveRead32(rec) : saveRead16(rec);
+        if (recKey == key) {
+            return rec;
+        }
+        if (saveRead16(rec) == TELEMETRY_NO_ROOM) {
+            if (!freeSlot) freeSlot = rec;
+            continue;
+        }
+        u32 weight = (weightBytes == 4) ? saveRead32(rec + weightOffset) : saveRead16(rec + weightOffset);
+        if (weight < lightestWeight) {
+            lightestWeight = weight;
+            lightest = rec;
+        }
+    }
+
+    u32 rec = freeSlot ? freeSlot : lightest;
+    for (int i = 0; i < recordSize; i++) {
+        saveWrite8(rec + i, 0);
+    }
+    return rec;
+}
+
+// ---------------------------------------------------------------------------
+// Room and transition records
+// ---------------------------------------------------------------------------
+
+static u16 roomP95(const RoomAccum* room) {
+    u32 target = room->frames - room->frames / 20;
+    u32 seen = 0;
+    for (int bin = 0; bin < TELEMETRY_HIST_BINS - 1; bin++) {
+        seen += room->hist[bin];
+        if (seen >= target) {
+            u16 upper = (u16)(((bin + 1) << TELEMETRY_HIST_SHIFT) - 1);
+            return upper < room->worst ? upper : room->worst;
+        }
+    }
+    return room->worst;
+}
+
+static void beginRoom(int roomIndex) {
+    RoomAccum* room = &s_room;
+    room->room = (u16)roomIndex;
+    room->frames = 0;
+    room->lagFrames = 0;
+    room->totalTicks = 0;
+    room->worst = 0;
+    for (int i = 0; i < TELEMETRY_PHASE_COUNT; i++) room->phaseWorst[i] = 0;
+    for (int i = 0; i < TELEMETRY_HIST_BINS; i++) room->hist[i] = 0;
+}
+
+static void writeRoom(void) {
+    const RoomAccum* room = &s_room;
+    if (room->room == TELEMETRY_NO_ROOM || room->frames == 0) return;
+    ensureHeader();
+
+    u32 rec = findSlot(ROOMS_BASE, TELEMETRY_ROOM_SLOTS, ROOM_RECORD,
+                       room->room, 2, 4, 4);
+    saveWrite16(rec + 0, room->room);
+    saveWrite16(rec + 2, saveRead16(rec + 2) + 1);
+    saveAdd32(rec + 4, room->frames);
+    saveAdd32(rec + 8, room->lagFrames);
+    saveAdd32(rec + 12, room->totalTicks);
+    saveMax16(rec + 16, room->worst);
+    saveMax16(rec + 18, roomP95(room));
+    for (int i = 0; i < TELEMETRY_PHASE_COUNT; i++) {
+        saveMax16(rec + 20 + i * 2, room->phaseWorst[i]);
+    }
+}
+
+static void writeTransition(int toRoom) {
+    const TransitionAccum* t = &s_transition;
+    if (t->from == TELEMETRY_NO_ROOM || t->frames == 0) return;
+    ensureHeader();
+
+    u32 key = (u32)t->from | ((u32)(u16)toRoom << 16);
+    u32 rec = findSlot(TRANSITIONS_BASE, TELEMETRY_TRANSITION_SLOTS, TRANSITION_RECORD,
+                       key, 4, 4, 2);
+    saveWrite32(rec + 0, key);
+    saveWrite16(rec + 4, saveRead16(rec + 4) + 1);
+    saveMax16(rec + 6, t->frames > 0xFFFF ? 0xFFFF : (u16)t->frames);
+    saveMax16(rec + 8, t->worst);
+    saveMax16(rec + 10, t->worstPhase);
+    saveAdd32(rec + 12, t->lagFrames);
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+void initTelemetry(void) {
+    s_room.room = TELEMETRY_NO_ROOM;
+    s_transition.active = 0;
+    s_frameInTransition = 0;
+    for (int i = 0; i < TELEMETRY_PHASE_COUNT; i++) g_telemetryFrame[i] = 0;
+}
+
+void telemetrySetRoom(int roomIndex, int transitioning) {
+    if (transitioning && !s_transition.active) {
+        s_transition.active = 1;
+        s_transition.from = s_room.room;
+        s_transition.frames = 0;
+        s_transition.lagFrames = 0;
+        s_transition.worst = 0;
+        s_transition.worstPhase = 0;
+    }
+
+    if (s_room.room != (u16)roomIndex) {
+        writeRoom();
+        beginRoom(roomIndex);
+    }
+
+    if (!transitioning && s_transition.active) {
+        writeTransition(roomIndex);
+        s_transition.active = 0;
+    }
+
+    s_frameInTransition = transitioning;
+}
+
+void telemetryFlush(void) {
+    writeRoom();
+    if (s_transition.active) {
+        writeTransition(s_room.room);
+    }
+    initTelemetry();
+}
+
+void telemetryEndFrame(u16 workTicks) {
+    RoomAccum* room = &s_room;
+    if (room->room == TELEMETRY_NO_ROOM) return;
+
+    int lag = workTicks > QUALITY_FRAME_TICKS;
+    room->frames++;
+    room->lagFrames += lag;
+    room->totalTicks += workTicks;
+    if (workTicks > room->worst) room->worst = workTicks;
+
+    int bin = workTicks >> TELEMETRY_HIST_SHIFT;
+    if (bin >= TELEMETRY_HIST_BINS) bin = TELEMETRY_HIST_BINS - 1;
+    if (room->hist[bin] != 0xFFFF) room->hist[bin]++;
+
+    if (s_frameInTransition && s_transition.active) {
+        TransitionAccum* t = &s_transition;
+        t->frames++;
+        t->lagFrames += lag;
+        if (workTicks > t->worst) t->worst = workTicks;
+        if (g_telemetryFrame[TELEMETRY_PHASE_TRANSITION] > t->worstPhase) {
+            t->worstPhase = g_telemetryFrame[TELEMETRY_PHASE_TRANSITION];
+        }
+    }
+
+    for (int i = 0; i < TELEMETRY_PHASE_COUNT; i++) {
+        if (g_telemetryFrame[i] > room->phaseWorst[i]) {
+            room->phaseWorst[i] = g_telemetryFrame[i];
+        }
+        g_telemetryFrame[i] = 0;
+    }
+}
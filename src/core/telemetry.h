@@ -0,0 +1,70 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "core/game_types.h"
+
+// Per-room performance telemetry.
+//
+// The on-screen max counters reset every 16 frames, so a tester can see that
+// something hitched but not where. This keeps running aggregates for the
+// current room (frames, lag frames, total / worst / p95 frame cost, worst
+// cost per phase) and for each transition between rooms, and merges them
+// into a table in save memory (core/save.h) when the room or transition
+// ends. Per frame it costs a histogram increment and a handful of compares;
+// save memory is only touched on room exit, and records survive across
+// sessions until the layout changes.
+// tools/telemetry_report.py ranks the rooms and transitions in a
+// tester's .sav.
+//
+// All costs are TM0 ticks (16.384 kHz, QUALITY_FRAME_TICKS per frame).
+
+typedef enum {
+    TELEMETRY_PHASE_PLAYER = 0,   // player + entities
+    TELEMETRY_PHASE_CAMERA,
+    TELEMETRY_PHASE_TILEMAP,
+    TELEMETRY_PHASE_RENDER,
+    TELEMETRY_PHASE_TRANSITION,   // updateTransition (replaces player)
+    TELEMETRY_PHASE_COUNT
+} TelemetryPhase;
+
+// Frame cost histogram used for p95: 64 bins of 8 ticks (0..2 frames; the
+// last bin also takes anything slower).
+#define TELEMETRY_HIST_SHIFT 3
+#define TELEMETRY_HIST_BINS  64
+
+// Save memory layout, after the profiler dump (see pc_profiler.h):
+//   header   16 bytes: magic, version, room slots, transition slots,
+//            ticks per frame
+//   rooms    TELEMETRY_ROOM_SLOTS x 32 bytes
+//   trans    TELEMETRY_TRANSITION_SLOTS x 16 bytes
+// All fields little-endian; see telemetry.c for the record layouts.
+#define TELEMETRY_SRAM_OFFSET      0x7000
+#define TELEMETRY_MAGIC            0x4D4C4554  // "TELM"
+#define TELEMETRY_VERSION          1
+#define TELEMETRY_ROOM_SLOTS       64
+#define TELEMETRY_TRANSITION_SLOTS 64
+#define TELEMETRY_NO_ROOM          0xFFFF
+
+// Forget the current room without writing it (boot).
+void initTelemetry(void);
+
+// Gameplay frame context, once per frame after the room index is final.
+// A room change or transition start/end writes the finished record to save memory.
+void telemetrySetRoom(int roomIndex, int transitioning);
+
+// Close and write the current room (returning to the menu).
+void telemetryFlush(void);
+
+// This frame's cost per phase; folded into the room / transition records by
+// telemetryEndFrame().
+extern u16 g_telemetryFrame[TELEMETRY_PHASE_COUNT];
+
+static inline void telemetryPhase(TelemetryPhase phase, u16 ticks) {
+    g_telemetryFrame[phase] = ticks;
+}
+
+// Work time of the previous gameplay frame (same value the quality governor
+// is fed). Counted against the room and transition set for that frame.
+void telemetryEndFrame(u16 workTicks);
+
+#endif // TELEMETRY_H
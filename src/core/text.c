@@ -1,4 +1,7 @@
 #include "text.h"
+#include "core/vblank_queue.h"
+#include "core/overlay.h"
+#include "core/vram_layout.h"
 #include <string.h>
 
 #define FONT_TILE_START 512  // Font tiles start at index 512 in sprite VRAM
@@ -8,6 +11,10 @@
 #define BG_TEXT_DYNAMIC_START 1   // Start at tile 1 in char block 1 for dynamic text tiles
 #define TEXT_SLOT_TILES 28        // Number of tiles allocated per text slot
 
+#if BG_TEXT_DYNAMIC_START + BG_TEXT_MAX_SLOTS * TEXT_SLOT_TILES > TILE_BG3_DIALOGUE
+#error "BG text slots overlap the dialogue box tiles"
+#endif
+
 // Tile slot tracking
 static u8 tile_slot_used[BG_TEXT_MAX_SLOTS] = {0};  // 0 = free, 1 = in use
 static int next_free_slot = 0;
@@ -23,7 +30,7 @@ const unsigned char font_char_widths[] = {
 };
 
 // Helper: Get pixel from font tile (4bpp format)
-static u8 get_font_pixel(int char_index, int px, int py) {
+static inline u8 get_font_pixel(int char_index, int px, int py) {
     // Read directly from ROM font data
     const u32* fontData = (const u32*)tinypixieTiles;
 
@@ -40,7 +47,7 @@ static u8 get_font_pixel(int char_index, int px, int py) {
 }
 
 // Helper: Set pixel in dynamic tile buffer (4bpp format)
-static void set_tile_pixel(u32* tileData, int px, int py, u8 colorIndex) {
+static inline void set_tile_pixel(u32* tileData, int px, int py, u8 colorIndex) {
     // Each row is one u32, with 8 pixels (4 bits each)
     int shift = px * 4;
     tileData[py] = (tileData[py] & ~(0xF << shift)) | ((colorIndex & 0xF) << shift);
@@ -56,7 +63,7 @@ void init_bg_text() {
     // Char base 1
     // Note: We only use char block 1 for dynamic text tiles (starting at BG_TEXT_DYNAMIC_START)
     // Font character tiles are read directly from ROM, not stored in VRAM
-    REG_BG3CNT = 0x0000 | (28 << 8) | (1 << 2);
+    vblankQueueReg(VREG_BG3CNT, 0x0000 | (28 << 8) | (1 << 2));
 
     // Clear the text background
     clear_bg_text();
@@ -92,28 +99,11 @@ void clear_bg_text_region(int tile_x, int tile_y, int width, int height) {
     }
 }
 
-// Internal function to draw text to a specific slot
-static void draw_bg_text_internal(const char* str, int tile_x, int tile_y, int dynamic_tile_slot) {
-    volatile u16* bgMap = (volatile u16*)se_mem[28];
-    volatile u32* charBlock1 = (volatile u32*)tile_mem[1];
-    
-    // Calculate starting tile in char block 1
-    int base_tile = BG_TEXT_DYNAMIC_START + (dynamic_tile_slot * TEXT_SLOT_TILES);
-    
-    // Calculate string width in pixels
-    int total_width = 0;
-    for (int i = 0; str[i] != '\0'; i++) {
-        char c = str[i];
-        if (c >= FONT_START_CHAR && c <= FONT_END_CHAR) {
-            int char_index = c - FONT_START_CHAR;
-            total_width += font_char_widths[char_index];
-        }
-    }
-    
-    // Calculate number of tiles needed
-    int tiles_needed = (total_width + 7) / 8;
-    if (tiles_needed > TEXT_SLOT_TILES) tiles_needed = TEXT_SLOT_TILES;  // Limit to prevent overflow
-
+// Rasterise str into tiles_needed consecutive 4bpp tiles at dst. This is
+// the menu's hot loop; inlined into both the menu IWRAM overlay copy and the
+// ROM copy below.
+static inline __attribute__((always_inline))
+void rasterize_text_body(const char* str, volatile u32* dst, int tiles_needed) {
     // Create pixel buffer for the text (8 pixels tall, width = TEXT_SLOT_TILES * 8 pixels)
     u8 pixelBuffer[8][TEXT_SLOT_TILES * 8];
     for (int y = 0; y < 8; y++) {
@@ -161,12 +151,50 @@ static void draw_bg_text_internal(const char* str, int tile_x, int tile_y, int d
         }
         
         // Upload to VRAM - each tile is 8 u32s
-        int vram_tile_offset = (base_tile + tile_idx) * 8;
         for (int i = 0; i < 8; i++) {
-            charBlock1[vram_tile_offset + i] = tileData[i];
+            dst[tile_idx * 8 + i] = tileData[i];
         }
-        
-        // Update background map
+    }
+}
+
+IWRAM_OVERLAY_MENU
+static void rasterize_text_iwram(const char* str, volatile u32* dst, int tiles_needed) {
+    rasterize_text_body(str, dst, tiles_needed);
+}
+
+static void rasterize_text_rom(const char* str, volatile u32* dst, int tiles_needed) {
+    rasterize_text_body(str, dst, tiles_needed);
+}
+
+// Internal function to draw text to a specific slot
+static void draw_bg_text_internal(const char* str, int tile_x, int tile_y, int dynamic_tile_slot) {
+    volatile u16* bgMap = (volatile u16*)se_mem[28];
+    volatile u32* charBlock1 = (volatile u32*)tile_mem[1];
+    
+    // Calculate starting tile in char block 1
+    int base_tile = BG_TEXT_DYNAMIC_START + (dynamic_tile_slot * TEXT_SLOT_TILES);
+    
+    // Calculate string width in pixels
+    int total_width = 0;
+    for (int i = 0; str[i] != '\0'; i++) {
+        char c = str[i];
+        if (c >= FONT_START_CHAR && c <= FONT_END_CHAR) {
+            int char_index = c - FONT_START_CHAR;
+            total_width += font_char_widths[char_index];
+        }
+    }
+    
+    // Calculate number of tiles needed
+    int tiles_needed = (total_width + 7) / 8;
+    if (tiles_needed > TEXT_SLOT_TILES) tiles_needed = TEXT_SLOT_TILES;  // Limit to prevent overflow
+
+    volatile u32* dst = &charBlock1[base_tile * 8];
+    OVERLAY_DISPATCH(OVERLAY_MENU,
+                     rasterize_text_iwram(str, dst, tiles_needed),
+                     rasterize_text_rom(str, dst, tiles_needed));
+
+    // Update background map
+    for (int tile_idx = 0; tile_idx < tiles_needed; tile_idx++) {
         if ((tile_x + tile_idx) < 32 && tile_y < 32) {
             int tile_num = base_tile + tile_idx;
             bgMap[tile_y * 32 + (tile_x + tile_idx)] = tile_num | (1 << 12);
@@ -233,9 +261,9 @@ int draw_char(char c, int x, int y, int oam_index) {
     int tile_index = FONT_TILE_START + (char_row * FONT_CHARS_PER_ROW) + char_col;
     
     // Set OAM entry (8x8 sprite, 16-color mode, palette 1)
-    oam_mem[oam_index].attr0 = (y & 0xFF) | (0 << 8) | (0 << 10) | (0 << 13) | (0 << 14);
-    oam_mem[oam_index].attr1 = (x & 0x1FF) | (0 << 12) | (0 << 13) | (0 << 14);
-    oam_mem[oam_index].attr2 = tile_index | (FONT_PALETTE << 12) | (0 << 10);
+    g_oamShadow[oam_index].attr0 = (y & 0xFF) | (0 << 8) | (0 << 10) | (0 << 13) | (0 << 14);
+    g_oamShadow[oam_index].attr1 = (x & 0x1FF) | (0 << 12) | (0 << 13) | (0 << 14);
+    g_oamShadow[oam_index].attr2 = tile_index | (FONT_PALETTE << 12) | (0 << 10);
     
     return width;
 }
@@ -5,7 +5,7 @@
 #include "tinypixie.h"
 #include "assets/tinypixie_widths.h"
 
-#define BG_TEXT_MAX_SLOTS 18
+#define BG_TEXT_MAX_SLOTS 16
 
 // Background text functions (BG1-based) - for lots of text
 void init_bg_text();
@@ -0,0 +1,193 @@
+#include "vblank_queue.h"
+#include "core/cost_model.h"
+
+typedef struct {
+    u8 screenBase;
+    u8 isColumn;
+    u8 index;       // Map row (isColumn=0) or column (isColumn=1), 0-31
+    u16 entries[32];
+} MapLineCmd;
+
+typedef struct {
+    VBlankRegCmd regs[VBLANK_QUEUE_MAX_REGS];
+    int regCount;
+    MapLineCmd lines[VBLANK_QUEUE_MAX_MAP_LINES];
+    int lineCount;
+} VBlankCmdBuffer;
+
+// Two buffers: game code fills s_buffers[s_building] while the ISR may still
+// own the other one. s_pending is only set between submit and flush.
+static VBlankCmdBuffer s_buffers[2];
+static volatile int s_building = 0;
+static volatile int s_pending = 0;
+
+#ifndef DESKTOP_BUILD
+OBJ_ATTR g_oamShadow[128];
+
+static inline void writeReg(u16 reg, u16 value) {
+    *(volatile u16*)(REG_BASE + reg) = value;
+}
+
+#else
+static VBlankRegCmd s_log[VBLANK_QUEUE_LOG_SIZE];
+static int s_logCount = 0;
+static u16 s_desktopRegs[0x60 / 2];
+static u16 s_desktopScreenblocks[32][32 * 32];
+static u8 s_desktopMapWrites[32][32 * 32];
+
+static inline void writeReg(u16 reg, u16 value) {
+    if (reg < sizeof(s_desktopRegs) * 2) {
+        s_desktopRegs[reg >> 1] = value;
+    }
+    if (s_logCount < VBLANK_QUEUE_LOG_SIZE) {
+        s_log[s_logCount].reg = reg;
+        s_log[s_logCount].value = value;
+        s_logCount++;
+    }
+}
+
+volatile u16* vramScreenblock(u8 screenBase) {
+    return s_desktopScreenblocks[screenBase & 31];
+}
+
+void vblankQueueDesktopClearVram(void) {
+    memset(s_desktopScreenblocks, 0, sizeof(s_desktopScreenblocks));
+    memset(s_desktopRegs, 0, sizeof(s_desktopRegs));
+    memset(s_desktopMapWrites, 0, sizeof(s_desktopMapWrites));
+}
+
+int vblankQueueLogCount(void) { return s_logCount; }
+const VBlankRegCmd* vblankQueueLog(void) { return s_log; }
+void vblankQueueClearLog(void) { s_logCount = 0; }
+u16 vblankQueueDesktopReg(u16 reg) {
+    return (reg < sizeof(s_desktopRegs) * 2) ? s_desktopRegs[reg >> 1] : 0;
+}
+
+void vblankQueueDesktopNoteMapWrites(volatile u16* first, int count, int stride) {
+    int offset = (int)((const u16*)first - &s_desktopScreenblocks[0][0]);
+    u8* writes = &s_desktopMapWrites[0][0];
+    for (int i = 0; i < count; i++) {
+        int index = offset + i * stride;
+        if (index >= 0 && index < 32 * 32 * 32 && writes[index] < 255) {
+            writes[index]++;
+        }
+    }
+}
+
+void vblankQueueDesktopClearMapWrites(void) {
+    memset(s_desktopMapWrites, 0, sizeof(s_desktopMapWrites));
+}
+
+int vblankQueueDesktopMapWrites(u8 screenBase, int index) {
+    return s_desktopMapWrites[screenBase & 31][index & (32 * 32 - 1)];
+}
+#endif
+
+static void writeMapLine(const MapLineCmd* line) {
+    COST_ACCESS(COST_VRAM, 2, 32);
+    volatile u16* bgMap = vramScreenblock(line->screenBase);
+    if (line->isColumn) {
+        for (int i = 0; i < 32; i++) {
+            bgMap[i * 32 + line->index] = line->entries[i];
+        }
+        VRAM_NOTE_MAP_WRITES(&bgMap[line->index], 32, 32);
+    } else {
+        volatile u16* dst = &bgMap[line->index * 32];
+        for (int i = 0; i < 32; i++) {
+            dst[i] = line->entries[i];
+        }
+        VRAM_NOTE_MAP_WRITES(dst, 32, 1);
+    }
+}
+
+void initVBlankQueue(void) {
+    s_buffers[0].regCount = 0;
+    s_buffers[0].lineCount = 0;
+    s_buffers[1].regCount = 0;
+    s_buffers[1].lineCount = 0;
+    s_building = 0;
+    s_pending = 0;
+}
+
+void vblankQueueReg(u16 reg, u16 value) {
+    VBlankCmdBuffer* buf = &s_buffers[s_building];
+    for (int i = 0; i < buf->regCount; i++) {
+        if (buf->regs[i].reg == reg) {
+            buf->regs[i].value = value;
+            return;
+        }
+    }
+    if (buf->regCount >= VBLANK_QUEUE_MAX_REGS) {
+        writeReg(reg, value);
+        return;
+    }
+    buf->regs[buf->regCount].reg = reg;
+    buf->regs[buf->regCount].value = value;
+    buf->regCount++;
+}
+
+static void queueMapLine(u8 screenBase, int isColumn, int index, const u16* entries) {
+    VBlankCmdBuffer* buf = &s_buffers[s_building];
+    MapLineCmd* line;
+    MapLineCmd overflow;
+
+    if (buf->lineCount < VBLANK_QUEUE_MAX_MAP_LINES) {
+        line = &buf->lines[buf->lineCount++];
+    } else {
+        line = &overflow;
+    }
+
+    line->screenBase = screenBase;
+    line->isColumn = (u8)isColumn;
+    line->index = (u8)(index & 31);
+    for (int i = 0; i < 32; i++) {
+        line->entries[i] = entries[i];
+    }
+
+    if (line == &overflow) {
+        writeMapLine(line);
+    }
+}
+
+void vblankQueueMapRow(u8 screenBase, int mapY, const u16* line) {
+    queueMapLine(screenBase, 0, mapY, line);
+}
+
+void vblankQueueMapColumn(u8 screenBase, int mapX, const u16* line) {
+    queueMapLine(screenBase, 1, mapX, line);
+}
+
+void vblankQueueSubmit(void) {
+    // Hand the finished buffer to the ISR and start the next frame on the
+    // other one. If the previous submission was never flushed (VBlank IRQ
+    // disabled), withdraw it before its buffer is recycled so the ISR can
+    // never replay a half-cleared frame.
+    int next = s_building ^ 1;
+    s_pending = 0;
+    s_buffers[next].regCount = 0;
+    s_buffers[next].lineCount = 0;
+    s_building = next;
+    s_pending = 1;
+}
+
+void vblankQueueFlush(void) {
+    if (!s_pending) {
+        return;
+    }
+
+    const VBlankCmdBuffer* buf = &s_buffers[s_building ^ 1];
+    COST_PUSH(COST_SUB_VIDEO);
+    COST_ACCESS(COST_IO, 2, buf->regCount);
+    for (int i = 0; i < buf->regCount; i++) {
+        writeReg(buf->regs[i].reg, buf->regs[i].value);
+    }
+    for (int i = 0; i < buf->lineCount; i++) {
+        writeMapLine(&buf->lines[i]);
+    }
+#ifndef DESKTOP_BUILD
+    oam_copy(oam_mem, g_oamShadow, 128);
+#endif
+    COST_ACCESS(COST_OAM, 4, 128 * 2);
+    COST_POP();
+    s_pending = 0;
+}
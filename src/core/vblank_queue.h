@@ -0,0 +1,98 @@
+#ifndef VBLANK_QUEUE_H
+#define VBLANK_QUEUE_H
+
+#include "core/game_types.h"
+
+// Deferred video state changes, committed atomically by the VBlank ISR.
+//
+// Game code never writes display registers, edge tilemap lines, or OAM
+// directly during a frame. Instead it appends to the frame's command buffer;
+// vblankQueueSubmit() publishes the finished frame and vblankQueueFlush()
+// (installed as the VBlank handler) replays it in order. A frame that
+// overruns VBlank is simply shown one VBlank later as a whole, instead of
+// tearing partway down the display.
+
+// Video register IDs: byte offsets from REG_BASE (0x04000000).
+#define VREG_DISPCNT   0x0000
+#define VREG_BG0CNT    0x0008
+#define VREG_BG1CNT    0x000A
+#define VREG_BG2CNT    0x000C
+#define VREG_BG3CNT    0x000E
+#define VREG_BG0HOFS   0x0010
+#define VREG_BG0VOFS   0x0012
+#define VREG_BG1HOFS   0x0014
+#define VREG_BG1VOFS   0x0016
+#define VREG_BG2HOFS   0x0018
+#define VREG_BG2VOFS   0x001A
+#define VREG_BG3HOFS   0x001C
+#define VREG_BG3VOFS   0x001E
+#define VREG_BLDCNT    0x0050
+#define VREG_BLDALPHA  0x0052
+#define VREG_BLDY      0x0054
+
+// Distinct registers per frame (repeated writes coalesce into one slot).
+#define VBLANK_QUEUE_MAX_REGS 32
+// Staged 32-entry screenblock lines per frame: 2 BG layers x (2 columns + 2 rows).
+#define VBLANK_QUEUE_MAX_MAP_LINES 8
+
+typedef struct {
+    u16 reg;    // VREG_* offset
+    u16 value;
+} VBlankRegCmd;
+
+// Reset both command buffers (call once before enabling the VBlank handler).
+void initVBlankQueue(void);
+
+// Queue a video register write. A later write to the same register in the
+// same frame replaces the earlier value but keeps its position in the stream.
+void vblankQueueReg(u16 reg, u16 value);
+
+// Queue a full screenblock row (mapY) or column (mapX) of 32 entries.
+// line[i] is the entry for map column/row i. Falls back to an immediate
+// write if the frame's staging area is full.
+void vblankQueueMapRow(u8 screenBase, int mapY, const u16* line);
+void vblankQueueMapColumn(u8 screenBase, int mapX, const u16* line);
+
+// Publish everything queued since the last submit. Call once per frame,
+// right before waiting for VBlank.
+void vblankQueueSubmit(void);
+
+// VBlank ISR: replay the last submitted frame (registers, map lines, OAM).
+void vblankQueueFlush(void);
+
+#ifndef DESKTOP_BUILD
+// Shadow OAM, copied to hardware OAM by the VBlank ISR after each submit.
+extern OBJ_ATTR g_oamShadow[128];
+
+// Screenblock in VRAM (the desktop build keeps an array of 32 instead).
+static inline volatile u16* vramScreenblock(u8 screenBase) {
+    return (volatile u16*)se_mem[screenBase];
+}
+#else
+volatile u16* vramScreenblock(u8 screenBase);
+// Zero the desktop screenblocks and register shadow file.
+void vblankQueueDesktopClearVram(void);
+
+// Desktop-only test hooks: every flushed register command is appended to a
+// log, and the last flushed value of each register is kept in a shadow file.
+#define VBLANK_QUEUE_LOG_SIZE 256
+int vblankQueueLogCount(void);
+const VBlankRegCmd* vblankQueueLog(void);
+void vblankQueueClearLog(void);
+u16 vblankQueueDesktopReg(u16 reg);
+
+// Desktop-only write counts per screen entry (saturating at 255), noted by
+// every gameplay map writer so tests can check nothing is written twice.
+void vblankQueueDesktopNoteMapWrites(volatile u16* first, int count, int stride);
+void vblankQueueDesktopClearMapWrites(void);
+int vblankQueueDesktopMapWrites(u8 screenBase, int index);
+#endif
+
+#ifdef DESKTOP_BUILD
+#define VRAM_NOTE_MAP_WRITES(first, count, stride) \
+    vblankQueueDesktopNoteMapWrites((first), (count), (stride))
+#else
+#define VRAM_NOTE_MAP_WRITES(first, count, stride) ((void)0)
+#endif
+
+#endif // VBLANK_QUEUE_H
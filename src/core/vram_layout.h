@@ -19,25 +19,42 @@
 #define PAL_OBJ_SPRING      11  // spring entities
 #define PAL_OBJ_RED_BUBBLE  12  // red bubble entities
 #define PAL_OBJ_GREEN_BUBBLE 13 // green bubble entities
+#define PAL_OBJ_COLDEBUG    14  // collision probe overlay (COLDEBUG builds)
+#define PAL_OBJ_PREDICT     15  // trajectory prediction dots (PREDICT builds)
 
 // --- OBJ tile indices (4bpp, tile_mem[4]) ---
 #define TILE_OBJ_PLAYER     0   // 16x16 player (tiles 0-3)
 #define TILE_OBJ_ENTITY     4   // shared 8x8 filled square for entities
+#define TILE_OBJ_COLDEBUG   5   // probe outlines by CollisionType (tiles 5-7)
+#define TILE_OBJ_COLDEBUG_HITBOX 8 // 8x16 outline per HitboxId (tiles 8-11)
+#define TILE_OBJ_PREDICT    12  // trajectory dots: ST_NORMAL, other states (tiles 12-13)
 
 // --- OAM sprite index ranges ---
 #define OAM_PLAYER          0
 #define OAM_TRAIL_BASE      1   // trail sprites 1..3
+#define OAM_PREDICT_BASE    4   // trajectory prediction dots 4..15
+#define OAM_PREDICT_COUNT   12
 #define OAM_SPRING_BASE     16  // springs 16..47
 #define OAM_SPRING_COUNT    32
 #define OAM_RED_BUBBLE_BASE 48  // red bubbles 48..79
 #define OAM_RED_BUBBLE_COUNT 32
 #define OAM_GREEN_BUBBLE_BASE 80 // green bubbles 80..111
 #define OAM_GREEN_BUBBLE_COUNT 32
+#define OAM_COLDEBUG_BASE   112 // collision probe overlay 112..127
+#define OAM_COLDEBUG_COUNT  16
 
 // --- BG screen bases (0x06000000 + (base << 11)) ---
 #define SB_NIGHTSKY         24  // BG0 nightsky tilemap
 #define SB_BG1              25  // BG1 gameplay layer
 #define SB_BG2              26  // BG2 gameplay layer
+// (28 is the BG3 text map, see core/text.c)
+#define SB_BG1_BACK         29  // BG1 spare: full refreshes are built here, then flipped in
+#define SB_BG2_BACK         30  // BG2 spare
+
+// --- BG3 text tiles (char block 1) ---
+// 1..448: fixed-width text slots (core/text.c); the dialogue box owns the
+// top of the block, one tile per box cell (core/dialogue.h).
+#define TILE_BG3_DIALOGUE   452 // DIALOGUE_COLS x DIALOGUE_LINES tiles, up to 511
 
 // --- BG char bases (0x06000000 + (base << 14)) ---
 #define CB_NIGHTSKY         2   // nightsky tile graphics
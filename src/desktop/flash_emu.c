@@ -0,0 +1,175 @@
+#ifdef DESKTOP_BUILD
+
+#include <string.h>
+#include "flash_emu.h"
+
+#define MAX_BANKS   2
+#define MAX_SECTORS (MAX_BANKS * FLASH_EMU_BANK_SIZE / FLASH_EMU_SECTOR_SIZE)
+
+typedef enum {
+    CMD_IDLE = 0,
+    CMD_UNLOCK1,        // got AA
+    CMD_UNLOCK2,        // got 55, next write is the command
+    CMD_ERASE_ARMED,    // got 80, expecting a second unlock
+    CMD_ERASE_UNLOCK1,
+    CMD_ERASE_UNLOCK2,  // next write is 30@sector or 10@5555
+    CMD_PROGRAM,        // next write is the data byte
+    CMD_BANK,           // next write is the bank number @0
+} CmdState;
+
+static u8 s_mem[MAX_BANKS * FLASH_EMU_BANK_SIZE];
+static u32 s_eraseCount[MAX_SECTORS];
+static int s_banks = 1;
+static int s_bank = 0;
+static int s_idMode = 0;
+static CmdState s_state = CMD_IDLE;
+static int s_erasing = -1;        // sector, or -1
+static int s_erasePolls = 0;
+static int s_cutAfter = -1;       // writes left before power is lost, -1 = never
+static u32 s_violations = 0;
+static u32 s_writes = 0;
+
+void flashEmuReset(int banks) {
+    s_banks = (banks == 2) ? 2 : 1;
+    memset(s_mem, 0xFF, sizeof(s_mem));
+    memset(s_eraseCount, 0, sizeof(s_eraseCount));
+    s_violations = 0;
+    s_writes = 0;
+    flashEmuPowerCycle();
+}
+
+void flashEmuPowerCycle(void) {
+    if (s_erasing >= 0) {
+        // Interrupted erase: only part of the sector made it back to 0xFF
+        u8* sector = &s_mem[s_erasing * FLASH_EMU_SECTOR_SIZE];
+        for (int i = 0; i < FLASH_EMU_SECTOR_SIZE; i += 2) sector[i] = 0xFF;
+        s_erasing = -1;
+    }
+    s_bank = 0;
+    s_idMode = 0;
+    s_state = CMD_IDLE;
+    s_cutAfter = -1;
+}
+
+static void finishErase(void) {
+    memset(&s_mem[s_erasing * FLASH_EMU_SECTOR_SIZE], 0xFF, FLASH_EMU_SECTOR_SIZE);
+    s_eraseCount[s_erasing]++;
+    s_erasing = -1;
+}
+
+u8 flashEmuRead(u32 addr) {
+    addr &= FLASH_EMU_BANK_SIZE - 1;
+    if (s_cutAfter == 0) return 0xFF;  // powered off: the bus floats
+    if (s_erasing >= 0) {
+        if (--s_erasePolls > 0) return 0x00;
+        finishErase();
+    }
+    if (s_idMode && addr < 2) {
+        return (addr == 0) ? 0xC2 : (s_banks == 2 ? 0x09 : 0x1C);
+    }
+    return s_mem[s_bank * FLASH_EMU_BANK_SIZE + addr];
+}
+
+static void violation(void) {
+    s_violations++;
+    s_state = CMD_IDLE;
+}
+
+static void command(u32 addr, u8 value) {
+    if (addr != 0x5555) {
+        violation();
+        return;
+    }
+    s_state = CMD_IDLE;
+    switch (value) {
+    case 0x90: s_idMode = 1; break;
+    case 0xF0: s_idMode = 0; break;
+    case 0x80: s_state = CMD_ERASE_ARMED; break;
+    case 0xA0: s_state = CMD_PROGRAM; break;
+    case 0xB0:
+        if (s_banks == 2) s_state = CMD_BANK;
+        else violation();
+        break;
+    default:
+        violation();
+        break;
+    }
+}
+
+void flashEmuWrite(u32 addr, u8 value) {
+    addr &= FLASH_EMU_BANK_SIZE - 1;
+    if (s_cutAfter == 0) return;
+    if (s_cutAfter > 0) s_cutAfter--;
+    s_writes++;
+
+    if (s_erasing >= 0) {
+        violation();
+        return;
+    }
+
+    switch (s_state) {
+    case CMD_IDLE:
+        if (value == 0xF0) {
+            s_idMode = 0;  // single-cycle reset
+        } else if (value == 0xAA && addr == 0x5555) {
+            s_state = CMD_UNLOCK1;
+        } else {
+            violation();  // a plain write never reaches the array
+        }
+        break;
+    case CMD_UNLOCK1:
+        if (value == 0x55 && addr == 0x2AAA) s_state = CMD_UNLOCK2;
+        else violation();
+        break;
+    case CMD_UNLOCK2:
+        command(addr, value);
+        break;
+    case CMD_ERASE_ARMED:
+        if (value == 0xAA && addr == 0x5555) s_state = CMD_ERASE_UNLOCK1;
+        else violation();
+        break;
+    case CMD_ERASE_UNLOCK1:
+        if (value == 0x55 && addr == 0x2AAA) s_state = CMD_ERASE_UNLOCK2;
+        else violation();
+        break;
+    case CMD_ERASE_UNLOCK2:
+        s_state = CMD_IDLE;
+        if (value == 0x30 && (addr % FLASH_EMU_SECTOR_SIZE) == 0) {
+            s_erasing = (s_bank * FLASH_EMU_BANK_SIZE + addr) / FLASH_EMU_SECTOR_SIZE;
+            s_erasePolls = FLASH_EMU_ERASE_POLLS;
+        } else if (value == 0x10 && addr == 0x5555) {
+            for (int i = 0; i < s_banks * FLASH_EMU_BANK_SIZE / FLASH_EMU_SECTOR_SIZE; i++) {
+                s_erasing = i;
+                finishErase();
+            }
+        } else {
+            violation();
+        }
+        break;
+    case CMD_PROGRAM: {
+        u8* cell = &s_mem[s_bank * FLASH_EMU_BANK_SIZE + addr];
+        if (value & ~*cell) {
+            s_violations++;  // 0 -> 1 needs an erase
+        }
+        *cell &= value;
+        s_state = CMD_IDLE;
+        break;
+    }
+    case CMD_BANK:
+        s_state = CMD_IDLE;
+        if (addr == 0 && value < s_banks) s_bank = value;
+        else violation();
+        break;
+    }
+}
+
+void flashEmuCutPowerAfter(int writes) {
+    s_cutAfter = writes;
+}
+
+u32 flashEmuViolations(void) { return s_violations; }
+u32 flashEmuWriteCount(void) { return s_writes; }
+u32 flashEmuEraseCount(int sector) { return s_eraseCount[sector]; }
+const u8* flashEmuImage(void) { return s_mem; }
+
+#endif // DESKTOP_BUILD
@@ -0,0 +1,44 @@
+#ifndef FLASH_EMU_H
+#define FLASH_EMU_H
+
+#ifdef DESKTOP_BUILD
+
+#include "desktop/desktop_stubs.h"
+
+// Desktop model of a 64K / 128K GBA flash chip (Macronix command set), used
+// by core/save.c in place of the 0x0E000000 bus. It enforces what the real
+// part does and flags what it would silently get wrong:
+//
+//  - commands only through the AA@5555, 55@2AAA, cmd@5555 unlock sequence
+//  - programming can only clear bits (the chip ANDs); trying to set a bit
+//    that is already 0 counts as a violation
+//  - a sector erase takes FLASH_EMU_ERASE_POLLS status reads to finish;
+//    reads return status (0x00) and writes are violations until then
+//  - 128K parts see addresses through the bank selected with command B0
+//
+// flashEmuCutPowerAfter() drops every bus write after the next n, which is
+// how tests cut the power in the middle of a save.
+
+#define FLASH_EMU_BANK_SIZE   0x10000
+#define FLASH_EMU_SECTOR_SIZE 0x1000
+#define FLASH_EMU_ERASE_POLLS 4
+
+// Fresh, fully erased chip with 1 (64K) or 2 (128K) banks.
+void flashEmuReset(int banks);
+
+// Power back on: command state, bank and ID mode reset, the power cut is
+// lifted, and an erase that was still running is left half done.
+void flashEmuPowerCycle(void);
+
+u8 flashEmuRead(u32 addr);
+void flashEmuWrite(u32 addr, u8 value);
+
+void flashEmuCutPowerAfter(int writes);
+
+u32 flashEmuViolations(void);
+u32 flashEmuWriteCount(void);     // bus writes since reset
+u32 flashEmuEraseCount(int sector);
+const u8* flashEmuImage(void);    // whole chip, bank 0 first
+
+#endif // DESKTOP_BUILD
+#endif // FLASH_EMU_H
@@ -0,0 +1,126 @@
+#ifdef DESKTOP_BUILD
+
+#include <stdio.h>
+#include "gba_cost.h"
+
+// Cycles per access by width (8/16-bit, 32-bit) with the default WAITCNT
+// (ROM WS0 4/2). ROM accesses are costed as non-sequential since data reads
+// interleave with opcode fetches.
+static const unsigned kAccessCycles[COST_REGION_COUNT][2] = {
+    /* ROM   */ { 5, 8 },
+    /* EWRAM */ { 3, 6 },
+    /* IWRAM */ { 1, 1 },
+    /* VRAM  */ { 1, 2 },
+    /* OAM   */ { 1, 1 },
+    /* IO    */ { 1, 1 },
+};
+
+// Thumb code runs from ROM: each 16-bit opcode fetch is a sequential ROM
+// access (3 cycles), which dominates execution time.
+#define THUMB_ROM_CYCLES_PER_INSN 3
+
+#define COST_STACK_DEPTH 8
+
+static const char* const kSubsystemNames[COST_SUB_COUNT] = {
+    "other", "player", "collision", "entities", "tilemap", "video",
+};
+static const char* const kRegionNames[COST_REGION_COUNT] = {
+    "ROM", "EWRAM", "IWRAM", "VRAM", "OAM", "IO",
+};
+
+static int s_stack[COST_STACK_DEPTH];
+static int s_depth = 0;
+static unsigned s_frameCycles[COST_SUB_COUNT];
+static unsigned long long s_totalCycles[COST_SUB_COUNT];
+static unsigned s_worstCycles[COST_SUB_COUNT];
+static unsigned s_worstFrameTotal = 0;
+static unsigned long long s_accesses[COST_REGION_COUNT];
+static unsigned s_frames = 0;
+
+static int currentSubsystem(void) {
+    return s_depth > 0 ? s_stack[s_depth - 1] : COST_SUB_OTHER;
+}
+
+void gbaCostReset(void) {
+    s_depth = 0;
+    for (int i = 0; i < COST_SUB_COUNT; i++) {
+        s_frameCycles[i] = 0;
+        s_totalCycles[i] = 0;
+        s_worstCycles[i] = 0;
+    }
+    for (int i = 0; i < COST_REGION_COUNT; i++) {
+        s_accesses[i] = 0;
+    }
+    s_worstFrameTotal = 0;
+    s_frames = 0;
+}
+
+void gbaCostAccess(int region, int bytes, int count) {
+    if (region < 0 || region >= COST_REGION_COUNT || count <= 0) return;
+    s_frameCycles[currentSubsystem()] += kAccessCycles[region][bytes >= 4] * (unsigned)count;
+    s_accesses[region] += (unsigned)count;
+}
+
+void gbaCostInstructions(int thumbInsns) {
+    if (thumbInsns <= 0) return;
+    s_frameCycles[currentSubsystem()] += (unsigned)thumbInsns * THUMB_ROM_CYCLES_PER_INSN;
+}
+
+void gbaCostPush(int subsystem) {
+    if (s_depth < COST_STACK_DEPTH) {
+        s_stack[s_depth] = subsystem;
+    }
+    s_depth++;
+}
+
+void gbaCostPop(void) {
+    if (s_depth > 0) s_depth--;
+}
+
+void gbaCostEndFrame(void) {
+    unsigned frameTotal = 0;
+    for (int i = 0; i < COST_SUB_COUNT; i++) {
+        s_totalCycles[i] += s_frameCycles[i];
+        if (s_frameCycles[i] > s_worstCycles[i]) s_worstCycles[i] = s_frameCycles[i];
+        frameTotal += s_frameCycles[i];
+        s_frameCycles[i] = 0;
+    }
+    if (frameTotal > s_worstFrameTotal) s_worstFrameTotal = frameTotal;
+    s_frames++;
+}
+
+unsigned gbaCostAverage(int sub) {
+    return s_frames ? (unsigned)(s_totalCycles[sub] / s_frames) : 0;
+}
+
+unsigned gbaCostWorst(int sub) {
+    return s_worstCycles[sub];
+}
+
+void gbaCostPrintReport(const char* indent) {
+    if (s_frames == 0) return;
+
+    unsigned avgTotal = 0;
+    for (int i = 0; i < COST_SUB_COUNT; i++) {
+        avgTotal += gbaCostAverage(i);
+    }
+
+    printf("%sGBA cost: ~%u cycles/frame avg, %u worst (%u.%u%% of frame) over %u frames\n",
+           indent, avgTotal, s_worstFrameTotal,
+           (unsigned)(s_worstFrameTotal * 100ULL / GBA_CYCLES_PER_FRAME),
+           (unsigned)(s_worstFrameTotal * 1000ULL / GBA_CYCLES_PER_FRAME % 10),
+           s_frames);
+    for (int i = 0; i < COST_SUB_COUNT; i++) {
+        if (s_totalCycles[i] == 0) continue;
+        printf("%s  %-10s avg %7u  worst %7u\n",
+               indent, kSubsystemNames[i], gbaCostAverage(i), s_worstCycles[i]);
+    }
+    printf("%s  accesses:", indent);
+    for (int i = 0; i < COST_REGION_COUNT; i++) {
+        if (s_accesses[i] == 0) continue;
+        printf(" %s %llu", kRegionNames[i], s_accesses[i]);
+    }
+    printf("\n");
+}
+
+#endif // DESKTOP_BUILD
@@ -0,0 +1,30 @@
+#ifndef GBA_COST_H
+#define GBA_COST_H
+
+#ifdef DESKTOP_BUILD
+
+#include "core/cost_model.h"
+
+// GBA frame: 228 scanlines * 1232 cycles.
+#define GBA_CYCLES_PER_FRAME 280896
+
+// Clear all counters (call before each replay).
+void gbaCostReset(void);
+
+void gbaCostAccess(int region, int bytes, int count);
+void gbaCostInstructions(int thumbInsns);
+void gbaCostPush(int subsystem);
+void gbaCostPop(void);
+
+// Close the current frame: fold its per-subsystem cycles into the totals.
+void gbaCostEndFrame(void);
+
+// Estimated cycles for subsystem `sub`: average / worst frame so far.
+unsigned gbaCostAverage(int sub);
+unsigned gbaCostWorst(int sub);
+
+// Print per-subsystem average and worst-frame cycle estimates.
+void gbaCostPrintReport(const char* indent);
+
+#endif // DESKTOP_BUILD
+#endif // GBA_COST_H
@@ -4,6 +4,7 @@
 #ifdef DESKTOP_BUILD
 
 #include <stdint.h>
+#include <stddef.h>
 
 // GBA types
 typedef uint8_t u8;
@@ -1,4 +1,5 @@
 #include "entity_managers.h"
+#include "core/cost_model.h"
 
 void initEntityManagers(EntityManagers* em) {
     initSpringManager(&em->springs);
@@ -13,9 +14,11 @@ void loadEntitiesFromLevel(EntityManagers* em, const Level* level) {
 }
 
 void updateEntities(EntityManagers* em, Player* player) {
+    COST_PUSH(COST_SUB_ENTITIES);
     updateSprings(&em->springs, player);
     updateRedBubbles(&em->redBubbles, player);
     updateGreenBubbles(&em->greenBubbles, player);
+    COST_POP();
 }
 
 void renderEntities(const EntityManagers* em, int cameraX, int cameraY) {
@@ -4,6 +4,8 @@
 #include "player/state.h"
 #include "core/game_math.h"
 #include "core/vram_layout.h"
+#include "core/vblank_queue.h"
+#include "core/cost_model.h"
 #include <string.h>  // For memset
 
 void initGreenBubbleManager(GreenBubbleManager* manager) {
@@ -44,6 +46,7 @@ void updateGreenBubbles(GreenBubbleManager* manager, Player* player) {
     // Check collision with each bubble
     for (int i = 0; i < manager->count; i++) {
         GreenBubble* bubble = &manager->bubbles[i];
+        COST_INSNS(24);
         if (!bubble->active) continue;
 
         AABB bBox = entityAABBCentered(bubble->x, bubble->y,
@@ -72,14 +75,14 @@ void updateGreenBubbles(GreenBubbleManager* manager, Player* player) {
 void renderGreenBubbles(const GreenBubbleManager* manager, int cameraX, int cameraY) {
 #ifndef DESKTOP_BUILD
     // Render all green bubbles using hardware OBJ sprites
-    volatile u16* oam = (volatile u16*)MEM_OAM;
+    u16* oam = (u16*)g_oamShadow;
 
     for (int i = 0; i < manager->count; i++) {
         const GreenBubble* bubble = &manager->bubbles[i];
         if (i >= OAM_GREEN_BUBBLE_COUNT) break;
 
         int spriteIndex = OAM_GREEN_BUBBLE_BASE + i;
-        volatile u16* spriteAttrs = &oam[spriteIndex * 4];
+        u16* spriteAttrs = &oam[spriteIndex * 4];
 
         // Check if bubble is active and onscreen
         if (!bubble->active) {
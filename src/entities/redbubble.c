@@ -4,6 +4,8 @@
 #include "player/state.h"
 #include "core/game_math.h"
 #include "core/vram_layout.h"
+#include "core/vblank_queue.h"
+#include "core/cost_model.h"
 #include <string.h>  // For memset
 
 void initRedBubbleManager(RedBubbleManager* manager) {
@@ -44,6 +46,7 @@ void updateRedBubbles(RedBubbleManager* manager, Player* player) {
     // Check collision with each bubble
     for (int i = 0; i < manager->count; i++) {
         RedBubble* bubble = &manager->bubbles[i];
+        COST_INSNS(24);
         if (!bubble->active) continue;
 
         AABB bBox = entityAABBCentered(bubble->x, bubble->y,
@@ -72,14 +75,14 @@ void updateRedBubbles(RedBubbleManager* manager, Player* player) {
 void renderRedBubbles(const RedBubbleManager* manager, int cameraX, int cameraY) {
 #ifndef DESKTOP_BUILD
     // Render all red bubbles using hardware OBJ sprites
-    volatile u16* oam = (volatile u16*)MEM_OAM;
+    u16* oam = (u16*)g_oamShadow;
 
     for (int i = 0; i < manager->count; i++) {
         const RedBubble* bubble = &manager->bubbles[i];
         if (i >= OAM_RED_BUBBLE_COUNT) break;
 
         int spriteIndex = OAM_RED_BUBBLE_BASE + i;
-        volatile u16* spriteAttrs = &oam[spriteIndex * 4];
+        u16* spriteAttrs = &oam[spriteIndex * 4];
 
         // Check if bubble is active and onscreen
         if (!bubble->active) {
@@ -3,6 +3,8 @@
 #include "player/player.h"
 #include "core/game_math.h"
 #include "core/vram_layout.h"
+#include "core/vblank_queue.h"
+#include "core/cost_model.h"
 #include <string.h>  // For memset
 
 void initSpringManager(SpringManager* manager) {
@@ -59,6 +61,7 @@ void updateSprings(SpringManager* manager, Player* player) {
     // Check collision with each spring
     for (int i = 0; i < manager->count; i++) {
         Spring* spring = &manager->springs[i];
+        COST_INSNS(24);
         if (!spring->active) continue;
 
         AABB sBox = entityAABBTopLeft(spring->x, spring->y, spring->width, spring->height);
@@ -92,14 +95,14 @@ void updateSprings(SpringManager* manager, Player* player) {
 void renderSprings(const SpringManager* manager, int cameraX, int cameraY) {
 #ifndef DESKTOP_BUILD
     // Render all springs using hardware OBJ sprites
-    volatile u16* oam = (volatile u16*)MEM_OAM;
+    u16* oam = (u16*)g_oamShadow;
 
     for (int i = 0; i < manager->count; i++) {
         const Spring* spring = &manager->springs[i];
         if (i >= OAM_SPRING_COUNT) break;
 
         int spriteIndex = OAM_SPRING_BASE + i;
-        volatile u16* spriteAttrs = &oam[spriteIndex * 4];
+        u16* spriteAttrs = &oam[spriteIndex * 4];
 
         // Check if spring is active and onscreen
         if (!spring->active) {
@@ -1,3 +1,7 @@
+#include <string.h>
+#ifdef DESKTOP_BUILD
+#include <stdio.h>
+#endif
 #include "level.h"
 #include "grassy_stone.h"
 #include "plants.h"
@@ -22,12 +26,39 @@ static u16 g_tileEntryTableA[LEVEL_VRAM_TILE_LIMIT];
 static u16 g_tileEntryTableB[LEVEL_VRAM_TILE_LIMIT];
 u16* g_levelTileEntries  = g_tileEntryTableA;
 u16* g_levelBTileEntries = g_tileEntryTableB;
+static RoomCollision g_roomCollisionA;
+static RoomCollision g_roomCollisionB;
+RoomCollision* g_levelCollision = &g_roomCollisionA;
 
-// Swappable base pointers: adoptLevelBBuffer swaps these so that
-// g_levelLayerTiles and the next loadLevelBToVRAM call always use
-// different physical storage (preventing buffer corruption on reverse transitions).
-static u16* s_mainBufBase = g_tileBuffer;
-static u16* s_sBufBase    = g_tileBBuffer;
+// ---------------------------------------------------------------------------
+// Room residency
+//
+// Each slot pairs a decompressed tile buffer with its entry table and
+// collision tables, and records which level it holds and where that
+// level's tile graphics sit in VRAM. A room that is still resident (e.g. the
+// one just left through a scroll transition) is reused without decompressing
+// or uploading again. Slots are
+// recycled least-recently-used; the main slot is never chosen as a victim,
+// so g_levelLayerTiles and the next loadLevelBToVRAM call always use
+// different physical storage.
+// ---------------------------------------------------------------------------
+typedef struct {
+    u16* tiles;             // Decompressed layers (TILE_BUFFER_SIZE u16s)
+    u16* entries;           // Tile entry table (LEVEL_VRAM_TILE_LIMIT u16s)
+    RoomCollision* collision; // Collision tables, built with the layers
+    const Level* level;     // Resident level, 0 if empty
+    s16 entryVramOffset;    // VRAM offset the entry table was built for, -1 if none
+    s16 vramOffset;         // First VRAM slot holding this level's tiles, -1 if not resident
+    u32 lastUse;
+} RoomSlot;
+
+static RoomSlot s_rooms[LEVEL_ROOM_SLOTS] = {
+    { g_tileBuffer,  g_tileEntryTableA, &g_roomCollisionA, 0, -1, -1, 0 },
+    { g_tileBBuffer, g_tileEntryTableB, &g_roomCollisionB, 0, -1, -1, 0 },
+};
+static int s_mainRoom = 0;
+static int s_secRoom  = 1;
+static u32 s_roomClock = 0;
 
 static int g_tileVramOffset = 0;
 static int g_levelBTileVramOffset = 0;
@@ -36,8 +67,8 @@ void setLevelTileVramOffset(int offset) { g_tileVramOffset = offset; }
 
 #ifdef DESKTOP_BUILD
 // Test helpers: expose which physical buffer main and secondary currently use.
-const u16* getMainBufBase(void)  { return s_mainBufBase; }
-const u16* getSecBufBase(void)   { return s_sBufBase; }
+const u16* getMainBufBase(void)  { return s_rooms[s_mainRoom].tiles; }
+const u16* getSecBufBase(void)   { return s_rooms[s_secRoom].tiles; }
 const u16* getTileBufA(void)     { return g_tileBuffer; }
 const u16* getTileBufB(void)     { return g_tileBBuffer; }
 static u16 g_desktopVramTiles[LEVEL_VRAM_TILE_LIMIT];
@@ -52,6 +83,7 @@ static void RLUnCompWram(const void* src, void* dst) {
     const u8* s = (const u8*)src;
     u8* d = (u8*)dst;
     u32 decompressed_size = (u32)s[1] | ((u32)s[2] << 8) | ((u32)s[3] << 16);
+    const u8* start = s;
     s += 4;
     u32 written = 0;
     while (written < decompressed_size) {
@@ -67,6 +99,10 @@ static void RLUnCompWram(const void* src, void* dst) {
                 *d++ = *s++;
         }
     }
+    // BIOS SWI 0x14: byte reads from ROM, byte writes to EWRAM, ~4 insns/byte.
+    COST_ACCESS(COST_ROM, 1, (int)(s - start));
+    COST_ACCESS(COST_EWRAM, 1, (int)decompressed_size);
+    COST_INSNS((int)decompressed_size * 4);
 }
 #endif
 
@@ -83,6 +119,65 @@ static void buildTileEntryTable(const Level* level, int vramOffset, u16* table)
     for (u16 i = 1; i < limit; i++) {
         table[i] = (u16)(i + vramOffset) | ((u16)level->tilePaletteBanks[i] << 12);
     }
+    COST_ACCESS(COST_IWRAM, 2, LEVEL_VRAM_TILE_LIMIT + limit);
+    COST_ACCESS(COST_ROM, 1, limit);
+}
+
+// Copied out of ROM with the decoded layers: collision lookups then cost an
+// IWRAM read on a tile the buffer already holds, and only rows with override
+// runs walk them.
+static void buildRoomCollision(const Level* level, RoomCollision* tables) {
+    int words = (level->uniqueTileCount + 15) >> 4;
+    if (words > LEVEL_TILE_COLLISION_WORDS) {
+        words = LEVEL_TILE_COLLISION_WORDS;
+    }
+    for (int i = 0; i < words; i++) {
+        tables->tileTypes[i] = level->tileCollision[i];
+    }
+    for (int i = words; i < LEVEL_TILE_COLLISION_WORDS; i++) {
+        tables->tileTypes[i] = 0;
+    }
+    COST_ACCESS(COST_IWRAM, 4, LEVEL_TILE_COLLISION_WORDS);
+    COST_ACCESS(COST_ROM, 4, words);
+
+    tables->overrideRows[0] = 0;
+    tables->overrideRows[1] = 0;
+    const u16* rows = level->collisionRowRuns;
+    if (rows) {
+        for (int y = 0; y < level->height; y++) {
+            if (rows[y] != rows[y + 1]) {
+                tables->overrideRows[(y >> 5) & 1] |= 1u << (y & 31);
+            }
+        }
+        COST_ACCESS(COST_ROM, 2, level->height + 1);
+        COST_INSNS(level->height * 5);
+    }
+    tables->level = level;
+}
+
+// Level headers define static data, so a unit that includes one has its own
+// copy of the Level; match on content rather than address.
+static int isSameLevel(const Level* a, const Level* b) {
+    return a == b || (a && b && a->width == b->width && a->height == b->height &&
+                      strcmp(a->name, b->name) == 0);
+}
+
+CollisionType getResidentTileCollision(const Level* level, int tileX, int tileY) {
+    COST_INSNS(8 * LEVEL_ROOM_SLOTS);
+    for (int i = 0; i < LEVEL_ROOM_SLOTS; i++) {
+        const RoomSlot* slot = &s_rooms[i];
+        if (isSameLevel(slot->level, level) && isSameLevel(slot->collision->level, level)) {
+            return resolveTileCollision(level, slot->tiles, slot->collision, tileX, tileY);
+        }
+    }
+#ifdef DESKTOP_BUILD
+    static const Level* s_reported = 0;
+    if (s_reported != level) {
+        fprintf(stderr, "getTileCollision: %s is not resident, reading COL_NONE\n", level->name);
+        s_reported = level;
+    }
+#endif
+    return COL_NONE;
 }
 
 #define TILESET_COUNT 3
@@ -127,6 +222,9 @@ static void writeTilesToVRAM(const Level* level, int vramSlot) {
     for (u16 i = 0; i < level->uniqueTileCount && (vramSlot + i) < LEVEL_VRAM_TILE_LIMIT; i++) {
         g_desktopVramTiles[vramSlot + i] = level->uniqueTileIds[i];
     }
+    // One 32-byte tile copied ROM -> VRAM per unique tile.
+    COST_ACCESS(COST_ROM, 4, level->uniqueTileCount * 8);
+    COST_ACCESS(COST_VRAM, 4, level->uniqueTileCount * 8);
     return;
 #else
     volatile u32* bgTiles = (volatile u32*)0x06000000;
@@ -180,57 +278,259 @@ static void writeTilesToVRAM(const Level* level, int vramSlot) {
 #endif // DESKTOP_BUILD
 }
 
+static int findResidentRoom(const Level* level) {
+    for (int i = 0; i < LEVEL_ROOM_SLOTS; i++) {
+        if (s_rooms[i].level == level) return i;
+    }
+    return -1;
+}
+
+// Slot for `level`, excluding `keep`: the resident copy if there is one,
+// else an empty slot, else the least recently used one.
+static int chooseRoom(const Level* level, int keep) {
+    int resident = findResidentRoom(level);
+    if (resident >= 0 && resident != keep) return resident;
+
+    int victim = -1;
+    for (int i = 0; i < LEVEL_ROOM_SLOTS; i++) {
+        if (i == keep) continue;
+        if (!s_rooms[i].level) return i;
+        if (victim < 0 || s_rooms[i].lastUse < s_rooms[victim].lastUse) victim = i;
+    }
+    return victim;
+}
+
+// Make `room` hold `level`'s decompressed layers and its tiles at vramOffset,
+// doing only the work the residency table says is missing.
+static void fillRoom(int room, const Level* level, int vramOffset) {
+    RoomSlot* slot = &s_rooms[room];
+    slot->lastUse = ++s_roomClock;
+
+    if (slot->level != level) {
+        u16* bufPtr = slot->tiles;
+        u32 tilesPerLayer = (u32)level->width * level->height;
+        for (u8 i = 0; i < level->layerCount && i < 4; i++) {
+            RLUnCompWram(level->layers[i].rleData, bufPtr);
+            bufPtr += tilesPerLayer;
+        }
+        buildRoomCollision(level, slot->collision);
+        slot->level = level;
+        slot->entryVramOffset = -1;
+        slot->vramOffset = -1;
+    }
+
+    if (slot->entryVramOffset != vramOffset) {
+        buildTileEntryTable(level, vramOffset, slot->entries);
+        slot->entryVramOffset = (s16)vramOffset;
+    }
+
+    if (slot->vramOffset != vramOffset) {
+        // Uploading over another room's range evicts its VRAM residency
+        int end = vramOffset + level->uniqueTileCount;
+        for (int i = 0; i < LEVEL_ROOM_SLOTS; i++) {
+            RoomSlot* other = &s_rooms[i];
+            if (i == room || other->vramOffset < 0) continue;
+            int otherEnd = other->vramOffset + other->level->uniqueTileCount;
+            if (other->vramOffset < end && vramOffset < otherEnd) {
+                other->vramOffset = -1;
+            }
+        }
+        writeTilesToVRAM(level, vramOffset);
+        slot->vramOffset = (s16)vramOffset;
+    }
+}
+
+static void bindRoomLayers(u16** layers, int room) {
+    const Level* level = s_rooms[room].level;
+    u16* bufPtr = s_rooms[room].tiles;
+    u32 tilesPerLayer = (u32)level->width * level->height;
+    for (u8 i = 0; i < 4; i++) {
+        if (i < level->layerCount) {
+            layers[i] = bufPtr;
+            bufPtr += tilesPerLayer;
+        } else {
+            layers[i] = 0;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Speculative preload (level select)
+//
+// RLUnCompWram cannot stop part way, so the preload decodes the same BIOS RLE
+// stream in C, a byte budget at a time, resuming mid-packet next frame. The
+// target room is marked empty while it is written and only becomes resident,
+// entry table included, once every layer is done; a cancelled preload leaves
+// an empty room behind, never a half-decoded one.
+// ---------------------------------------------------------------------------
+typedef struct {
+    const Level* level;     // Level being preloaded, 0 if idle
+    int room;
+    u8 layer;               // Layer being decoded (or next to start)
+    u8 runFill;             // Current packet is a fill run
+    u8 fillValue;
+    u8 runLeft;             // Bytes left in the current packet
+    const u8* src;          // Current layer's stream, 0 between layers
+    u8* dst;
+    u32 layerLeft;          // Bytes still to write for the current layer
+} LevelPreload;
+
+static LevelPreload s_preload;
+
+void levelPreloadStart(const Level* level) {
+    if (s_preload.level == level) {
+        return;
+    }
+    s_preload.level = 0;
+
+    int resident = findResidentRoom(level);
+    if (resident >= 0) {
+        // Already decoded: only the entry table for VRAM slot 0 may be missing
+        RoomSlot* slot = &s_rooms[resident];
+        if (slot->entryVramOffset != 0) {
+            buildTileEntryTable(level, 0, slot->entries);
+            slot->entryVramOffset = 0;
+        }
+        return;
+    }
+
+    int room = chooseRoom(level, -1);
+    RoomSlot* slot = &s_rooms[room];
+    slot->level = 0;
+    slot->entryVramOffset = -1;
+    slot->vramOffset = -1;
+
+    s_preload.level = level;
+    s_preload.room = room;
+    s_preload.layer = 0;
+    s_preload.src = 0;
+}
+
+int levelPreloadStep(int budget) {
+    LevelPreload* p = &s_preload;
+    const Level* level = p->level;
+    if (!level) {
+        return 1;
+    }
+    RoomSlot* slot = &s_rooms[p->room];
+    u32 tilesPerLayer = (u32)level->width * level->height;
+    int written = 0;
+    const u8* srcStart = p->src;
+
+    while (budget > 0) {
+        if (!p->src) {
+            if (p->layer >= level->layerCount || p->layer >= 4) {
+                buildTileEntryTable(level, 0, slot->entries);
+                buildRoomCollision(level, slot->collision);
+                slot->level = level;
+                slot->entryVramOffset = 0;
+                slot->vramOffset = -1;
+                slot->lastUse = ++s_roomClock;
+                p->level = 0;
+                break;
+            }
+            const u8* header = (const u8*)level->layers[p->layer].rleData;
+            p->layerLeft = (u32)header[1] | ((u32)header[2] << 8) | ((u32)header[3] << 16);
+            p->src = srcStart = header + 4;
+            p->dst = (u8*)(slot->tiles + p->layer * tilesPerLayer);
+            p->runLeft = 0;
+        }
+
+        if (p->layerLeft == 0) {
+            COST_ACCESS(COST_ROM, 1, (int)(p->src - srcStart));
+            p->src = 0;
+            p->layer++;
+            continue;
+        }
+
+        if (p->runLeft == 0) {
+            u8 flag = *p->src++;
+            p->runFill = (u8)(flag >> 7);
+            p->runLeft = (u8)((flag & 0x7F) + (p->runFill ? 3 : 1));
+            if (p->runFill) {
+                p->fillValue = *p->src++;
+            }
+        }
+
+        int n = p->runLeft;
+        if (n > budget) n = budget;
+        if ((u32)n > p->layerLeft) n = (int)p->layerLeft;
+        u8* dst = p->dst;
+        if (p->runFill) {
+            u8 value = p->fillValue;
+            for (int i = 0; i < n; i++) dst[i] = value;
+        } else {
+            const u8* src = p->src;
+            for (int i = 0; i < n; i++) dst[i] = src[i];
+            p->src += n;
+        }
+        p->dst += n;
+        p->runLeft = (u8)(p->runLeft - n);
+        p->layerLeft -= (u32)n;
+        budget -= n;
+        written += n;
+    }
+
+    if (p->src) {
+        COST_ACCESS(COST_ROM, 1, (int)(p->src - srcStart));
+    }
+    COST_ACCESS(COST_EWRAM, 1, written);
+    COST_INSNS(written * 6);
+    return p->level == 0;
+}
+
+// A direct load finishes a preload of the same level and drops any other.
+static void settlePreload(const Level* level) {
+    if (s_preload.level == level) {
+        levelPreloadStep(0x7FFFFFFF);
+    } else {
+        s_preload.level = 0;
+    }
+}
+
 void loadLevelToVRAM(const Level* level) {
+    settlePreload(level);
     g_tileVramOffset = 0;
     g_levelBTileVramOffset = 0;
 
-    // Decompress tile layers into RAM
-    u16* bufPtr = s_mainBufBase;
-    u32 tilesPerLayer = (u32)level->width * level->height;
-    for (u8 i = 0; i < level->layerCount && i < 4; i++) {
-        g_levelLayerTiles[i] = bufPtr;
-        RLUnCompWram(level->layers[i].rleData, bufPtr);
-        bufPtr += tilesPerLayer;
+    int room = findResidentRoom(level);
+    if (room < 0) room = chooseRoom(level, -1);
+    if (room == s_secRoom) {
+        s_secRoom = s_mainRoom;
     }
-    for (u8 i = level->layerCount; i < 4; i++)
-        g_levelLayerTiles[i] = 0;
+    s_mainRoom = room;
 
-    buildTileEntryTable(level, 0, g_levelTileEntries);
-    writeTilesToVRAM(level, 0);
+    fillRoom(room, level, 0);
+    bindRoomLayers(g_levelLayerTiles, room);
+    g_levelTileEntries = s_rooms[room].entries;
+    g_levelCollision = s_rooms[room].collision;
 }
 
 void loadLevelBToVRAM(const Level* level, int vramOffset) {
+    settlePreload(level);
     g_levelBTileVramOffset = vramOffset;
 
-    // Decompress tile layers into the secondary RAM buffer
-    u16* bufPtr = s_sBufBase;
-    u32 tilesPerLayer = (u32)level->width * level->height;
-    for (u8 i = 0; i < level->layerCount && i < 4; i++) {
-        g_levelBLayerTiles[i] = bufPtr;
-        RLUnCompWram(level->layers[i].rleData, bufPtr);
-        bufPtr += tilesPerLayer;
-    }
-    for (u8 i = level->layerCount; i < 4; i++)
-        g_levelBLayerTiles[i] = 0;
+    int room = chooseRoom(level, s_mainRoom);
+    s_secRoom = room;
 
-    buildTileEntryTable(level, vramOffset, g_levelBTileEntries);
-    writeTilesToVRAM(level, vramOffset);
+    fillRoom(room, level, vramOffset);
+    bindRoomLayers(g_levelBLayerTiles, room);
+    g_levelBTileEntries = s_rooms[room].entries;
 }
 
 void adoptLevelBBuffer(const Level* level) {
     // Fast path used at scroll transition end: level B was already decompressed
     // by loadLevelBToVRAM and its tile graphics are already in VRAM at
-    // g_levelBTileVramOffset. Swap the base pointers first so that the next
-    // loadLevelBToVRAM call writes into the OLD main buffer, not the one
-    // g_levelLayerTiles now points into. Without this swap, both arrays would
-    // reference the same physical storage and a reverse transition would corrupt
-    // the active level's tile data mid-scroll.
-    u16* tmp    = s_mainBufBase;
-    s_mainBufBase = s_sBufBase;
-    s_sBufBase    = tmp;
-    u16* tmpEntries = g_levelTileEntries;
-    g_levelTileEntries = g_levelBTileEntries;
-    g_levelBTileEntries = tmpEntries;
+    // g_levelBTileVramOffset. Swap main and secondary so that the next
+    // loadLevelBToVRAM call never picks the room g_levelLayerTiles now points
+    // into; the room just left stays resident for a cheap return trip.
+    int tmp    = s_mainRoom;
+    s_mainRoom = s_secRoom;
+    s_secRoom  = tmp;
+    s_rooms[s_mainRoom].lastUse = ++s_roomClock;
+    g_levelTileEntries = s_rooms[s_mainRoom].entries;
+    g_levelBTileEntries = s_rooms[s_secRoom].entries;
+    g_levelCollision = s_rooms[s_mainRoom].collision;
 
     g_tileVramOffset = g_levelBTileVramOffset;
     for (u8 i = 0; i < level->layerCount && i < 4; i++) {
@@ -244,6 +544,33 @@ void adoptLevelBBuffer(const Level* level) {
     g_levelBTileVramOffset = 0;
 }
 
+#ifdef DESKTOP_BUILD
+void invalidateLevelResidency(void) {
+    s_preload.level = 0;
+    for (int i = 0; i < LEVEL_ROOM_SLOTS; i++) {
+        s_rooms[i].level = 0;
+        s_rooms[i].entryVramOffset = -1;
+        s_rooms[i].vramOffset = -1;
+    }
+}
+#endif
+
+int isLayerRegionEmpty(const Level* level, u8 layerIndex, int x0, int y0, int x1, int y1) {
+    if (layerIndex >= level->layerCount) return 1;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= level->width) x1 = level->width - 1;
+    if (y1 >= level->height) y1 = level->height - 1;
+    if (x0 > x1 || y0 > y1) return 1;
+
+    for (int cy = y0 >> LEVEL_CHUNK_SHIFT; cy <= (y1 >> LEVEL_CHUNK_SHIFT); cy++) {
+        for (int cx = x0 >> LEVEL_CHUNK_SHIFT; cx <= (x1 >> LEVEL_CHUNK_SHIFT); cx++) {
+            if (isLayerChunkOccupied(level, layerIndex, cx, cy)) return 0;
+        }
+    }
+    return 1;
+}
+
 u16 getVramTileIndex(u16 vramIndex) {
     // Tiles are already VRAM indices (remapped at build time)
     return vramIndex;
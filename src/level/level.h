@@ -2,9 +2,15 @@
 #define LEVEL_H
 
 #include "core/game_types.h"
+#include "core/cost_model.h"
+#include "collision/collision_debug.h"
 
 #define LEVEL_VRAM_TILE_LIMIT 512
 
+// Decompressed room buffers kept resident (current room + LRU cache). Each
+// slot needs its own EWRAM tile buffer and entry table in level.c.
+#define LEVEL_ROOM_SLOTS 2
+
 // Collision type for each tile position
 typedef enum {
     COL_NONE     = 0,  // No collision (passable)
@@ -12,6 +18,22 @@ typedef enum {
     COL_JUMPTHRU = 2,  // One-way platform (blocks only from above when falling)
 } CollisionType;
 
+// Collision comes from the tiles: each tileset gives its tiles a default
+// type (the "collision" property in the TSX), looked up by the tile on this
+// layer. A level's Collision layer only overrides it, stored as runs.
+// Must match COLLISION_LAYER in tools/level_converter.py.
+#define LEVEL_COLLISION_LAYER 0
+
+// Default CollisionType per compact tile ID, 2 bits each
+#define LEVEL_TILE_COLLISION_WORDS (LEVEL_VRAM_TILE_LIMIT / 16)
+
+// Tiles [start, end) of one row forced to `type`
+typedef struct {
+    u16 start;
+    u16 end;
+    u8 type;     // CollisionType
+} CollisionRun;
+
 // Object types enum - add new types here
 typedef enum {
     OBJ_NONE = 0,
@@ -45,8 +67,14 @@ typedef struct {
     u8 bgLayer;      // Which BG layer (0-3)
     u8 priority;     // Priority (0-3, lower = in front)
     const u32* rleData;  // BIOS RLE compressed tile data (SWI 0x14 format)
+    const u32* chunkMask; // Occupancy bit per 8x8-tile chunk, set if any tile is non-zero
 } TileLayer;
 
+// Occupancy chunks are (1 << LEVEL_CHUNK_SHIFT) tiles square. Must match
+// CHUNK_SIZE in tools/level_converter.py.
+#define LEVEL_CHUNK_SHIFT 3
+#define LEVEL_CHUNK_SIZE  (1 << LEVEL_CHUNK_SHIFT)
+
 // RAM buffers holding decompressed tile data for the current level.
 // Populated by loadLevelToVRAM(). Index matches layer index in Level.layers.
 extern u16* g_levelLayerTiles[4];
@@ -61,6 +89,16 @@ extern u16* g_levelBLayerTiles[4];
 extern u16* g_levelTileEntries;
 extern u16* g_levelBTileEntries;
 
+// Collision tables of a decoded room (IWRAM), built with its layers
+typedef struct {
+    const struct Level* level;                  // Level the tables were built for, 0 if none
+    u32 tileTypes[LEVEL_TILE_COLLISION_WORDS];  // Copy of Level.tileCollision
+    u32 overrideRows[2];                        // Bit (row & 63) set if such a row has runs
+} RoomCollision;
+
+// Collision tables of the current level, set with g_levelTileEntries
+extern RoomCollision* g_levelCollision;
+
 typedef struct Level {
     const char* name;
     u16 width;
@@ -73,7 +111,9 @@ typedef struct Level {
     u16 playerSpawnY;
     u8 tilesetCount;
     const TilesetInfo* tilesets;
-    const u8* collisionMap;  // Packed 4-bit collision: 2 tiles per byte, low nibble first
+    const u32* tileCollision;       // Default CollisionType per unique tile, 2 bits, 16 per word
+    const u16* collisionRowRuns;    // height + 1 offsets into collisionRuns, 0 if no overrides
+    const CollisionRun* collisionRuns;
     u16 uniqueTileCount;
     const u16* uniqueTileIds;
     const u8* tilePaletteBanks;
@@ -95,19 +135,93 @@ typedef struct Level {
  * @return The tile ID, or 0 if out of bounds
  */
 static inline u16 getTileAt(const Level* level, u8 layerIndex, int tileX, int tileY) {
+    COST_INSNS(14);
     if (layerIndex >= level->layerCount) return 0;
     if (tileX < 0 || tileX >= level->width || tileY < 0 || tileY >= level->height) return 0;
     if (!g_levelLayerTiles[layerIndex]) return 0;
+    COST_ACCESS(COST_EWRAM, 2, 1);
     return g_levelLayerTiles[layerIndex][tileY * level->width + tileX];
 }
 
 static inline u16 mapTileEntry(const u16* entryTable, u16 tileId) {
+    COST_INSNS(4);
     if (tileId >= LEVEL_VRAM_TILE_LIMIT) return 0;
+    COST_ACCESS(COST_IWRAM, 2, 1);
     return entryTable[tileId];
 }
 
+/**
+ * Check whether an 8x8-tile chunk of a layer holds any non-zero tile.
+ * Chunk coordinates must be inside the level.
+ *
+ * @param level The level to query
+ * @param layerIndex The layer index (must be < layerCount)
+ * @param chunkX Chunk column (tileX >> LEVEL_CHUNK_SHIFT)
+ * @param chunkY Chunk row (tileY >> LEVEL_CHUNK_SHIFT)
+ * @return Non-zero if the chunk has at least one visible tile
+ */
+static inline int isLayerChunkOccupied(const Level* level, u8 layerIndex, int chunkX, int chunkY) {
+    COST_INSNS(8);
+    int chunksWide = (level->width + LEVEL_CHUNK_SIZE - 1) >> LEVEL_CHUNK_SHIFT;
+    u32 bit = (u32)(chunkY * chunksWide + chunkX);
+    COST_ACCESS(COST_ROM, 4, 1);
+    return (level->layers[layerIndex].chunkMask[bit >> 5] >> (bit & 31)) & 1;
+}
+
+/**
+ * Check whether a tile rectangle of a layer is entirely tile 0.
+ * The rectangle is clipped to the level; a missing layer counts as empty.
+ *
+ * @param level The level to query
+ * @param layerIndex The layer index
+ * @param x0 First tile column (inclusive)
+ * @param y0 First tile row (inclusive)
+ * @param x1 Last tile column (inclusive)
+ * @param y1 Last tile row (inclusive)
+ * @return 1 if no chunk overlapping the rectangle holds a visible tile
+ */
+int isLayerRegionEmpty(const Level* level, u8 layerIndex, int x0, int y0, int x1, int y1);
+
+// Collision of an in-bounds cell of a decoded room: the default of its tile
+// on the collision layer, unless one of the row's runs overrides it. Rows the
+// override mask rules out never touch the runs in ROM.
+static inline CollisionType resolveTileCollision(const Level* level, const u16* layer,
+                                                 const RoomCollision* tables, int tileX, int tileY) {
+    COST_ACCESS(COST_EWRAM, 2, 1);
+    u16 tile = layer[tileY * level->width + tileX];
+    COST_ACCESS(COST_IWRAM, 4, 2);
+    CollisionType col = (CollisionType)((tables->tileTypes[tile >> 4] >> ((tile & 15) * 2)) & 3);
+    if (!((tables->overrideRows[(tileY >> 5) & 1] >> (tileY & 31)) & 1)) {
+        return col;
+    }
+
+    const u16* rows = level->collisionRowRuns;
+    COST_ACCESS(COST_ROM, 2, 2);
+    for (int i = rows[tileY], end = rows[tileY + 1]; i < end; i++) {
+        const CollisionRun* run = &level->collisionRuns[i];
+        COST_INSNS(4);
+        COST_ACCESS(COST_ROM, 2, 2);
+        if (tileX < run->start) break;
+        if (tileX < run->end) {
+            return (CollisionType)run->type;
+        }
+    }
+    return col;
+}
+
+/**
+ * Collision of a level that is not the current one, from its room if it is
+ * still resident (e.g. level B during a scroll transition).
+ *
+ * @return CollisionType, or COL_NONE if the level holds no room
+ */
+CollisionType getResidentTileCollision(const Level* level, int tileX, int tileY);
+
 /**
  * Get the collision type for a tile at the given tile coordinates.
+ * The type is the collision-layer tile's default, unless a Collision layer
+ * run overrides it. The current level resolves through g_levelCollision;
+ * any other level through its resident room, if it has one.
  *
  * @param level The level to query
  * @param tileX The tile X coordinate
@@ -115,17 +229,26 @@ static inline u16 mapTileEntry(const u16* entryTable, u16 tileId) {
  * @return CollisionType (COL_NONE, COL_SOLID, or COL_JUMPTHRU)
  */
 static inline CollisionType getTileCollision(const Level* level, int tileX, int tileY) {
-    if (tileX < 0 || tileX >= level->width || tileY < 0 || tileY >= level->height) {
+    COST_INSNS(12);
+    if ((unsigned)tileX >= level->width || (unsigned)tileY >= level->height) {
+        COLDEBUG_PROBE(tileX, tileY, COL_NONE);
         return COL_NONE;
     }
-    int idx = tileY * level->width + tileX;
-    u8 packed = level->collisionMap[idx >> 1];
-    return (CollisionType)((idx & 1) ? (packed >> 4) : (packed & 0x0F));
+    COST_ACCESS(COST_IWRAM, 4, 1);
+    CollisionType col;
+    if (g_levelCollision->level == level) {
+        col = resolveTileCollision(level, g_levelLayerTiles[LEVEL_COLLISION_LAYER], g_levelCollision, tileX, tileY);
+    } else {
+        col = getResidentTileCollision(level, tileX, tileY);
+    }
+    COLDEBUG_PROBE(tileX, tileY, col);
+    return col;
 }
 
 /**
  * Load level tile data to VRAM starting at slot 0.
- * Resets g_levelTileVramOffset to 0.
+ * Resets g_levelTileVramOffset to 0. Skips decompression when the level is
+ * still resident in a room buffer.
  */
 void loadLevelToVRAM(const Level* level);
 
@@ -142,18 +265,42 @@ void adoptLevelBBuffer(const Level* level);
 /**
  * Load level tile data to VRAM starting at the given slot offset.
  * Decompresses into g_levelBLayerTiles. Used for scroll transitions.
+ * A room that is still resident (decompressed, and its tiles still in VRAM
+ * at vramOffset) is reused without touching ROM or VRAM.
  *
  * @param level      The incoming level
  * @param vramOffset First VRAM slot to use (= current level's uniqueTileCount)
  */
 void loadLevelBToVRAM(const Level* level, int vramOffset);
 
+// Decoded per level-select frame; the largest level (2 layers of 512x40)
+// takes 20 frames.
+#define LEVEL_PRELOAD_BYTES_PER_FRAME 4096
+
+/**
+ * Speculative load for the level select: decompress `level` into the room
+ * loadLevelToVRAM() would use, a slice per levelPreloadStep() call, and build
+ * its entry table for VRAM slot 0. Confirming then only uploads the tiles.
+ * Starting another level cancels the one in progress (its room is left
+ * empty); the same level again is a no-op. loadLevelToVRAM() finishes a
+ * preload of its own level and cancels any other.
+ */
+void levelPreloadStart(const Level* level);
+
+/**
+ * Decode up to `budget` bytes of the preload in progress.
+ * @return 1 once nothing is left (done, cancelled or idle)
+ */
+int levelPreloadStep(int budget);
+
 /** Current VRAM offset applied to this level's tile indices (0 normally). */
 int getLevelTileVramOffset(void);
 void setLevelTileVramOffset(int offset);
 
 #ifdef DESKTOP_BUILD
 const u16* getDesktopVramTiles(void);
+// Forget every resident room (tests that scribble on tile buffers).
+void invalidateLevelResidency(void);
 #endif
 
 /**
@@ -1,10 +1,5 @@
 #include <tonc.h>
-#include "skelly.h"
-#include "grassy_stone.h"
-#include "plants.h"
-#include "decals.h"
 #include "core/text.h"
-#include "nightsky.h"
 #include <stdlib.h>
 #include "core/game_math.h"
 #include "core/game_types.h"
@@ -15,6 +10,7 @@
 #include "collision/collision.h"
 #include "player/player.h"
 #include "player/player_render.h"
+#include "player/player_predict.h"
 #include "util/calc.h"
 #include "menu/menu.h"
 #include "core/replay.h"
@@ -22,6 +18,17 @@
 #include "transition/scroll_tilemap.h"
 #include "entities/entity_managers.h"
 #include "core/vram_layout.h"
+#include "core/vblank_queue.h"
+#include "core/quality.h"
+#include "core/overlay.h"
+#include "core/pc_profiler.h"
+#include "core/telemetry.h"
+#include "core/log.h"
+#include "core/assets.h"
+#include "core/dialogue.h"
+#include "core/save.h"
+#include "core/frame_step.h"
+#include "collision/collision_debug.h"
 
 // Fixed slot indices for profiling (8-13)
 #define PROFILING_SLOT_FPS 8
@@ -30,134 +37,67 @@
 #define PROFILING_SLOT_TILEMAP 11
 #define PROFILING_SLOT_RENDER 12
 #define PROFILING_SLOT_TOTAL 13
+#define PROFILING_SLOT_QUALITY 15
+#define PROFILING_SLOT_PROBES 0   // COLDEBUG builds; menu slots are cleared in gameplay
+
+// Room intro box: bottom of the screen, clear of the profiling text
+#define ROOM_INTRO_TILE_X 5
+#define ROOM_INTRO_TILE_Y 16
+
+// Drain queued log entries only while the frame has used less than this
+#define LOG_DRAIN_SLACK_TICKS 200
+#define LOG_DRAIN_PER_FRAME   4
 // Profiling state
 static int profilingInitialized = 0;
 
 int main() {
+    initVBlankQueue();
+    initOverlays();
     irq_init(NULL);
-    irq_add(II_VBLANK, NULL);
+    irq_add(II_VBLANK, vblankQueueFlush);
     
     // Mode 0 with BG0, BG1, BG2, BG3 and sprites enabled
     // BG0 = nightsky, BG1 = decorative layer, BG2 = terrain layer, BG3 = text
-    REG_DISPCNT = DCNT_MODE0 | DCNT_BG0 | DCNT_BG1 | DCNT_BG2 | DCNT_BG3 | DCNT_OBJ | DCNT_OBJ_1D;
+    vblankQueueReg(VREG_DISPCNT, DCNT_MODE0 | DCNT_BG0 | DCNT_BG1 | DCNT_BG2 | DCNT_BG3 | DCNT_OBJ | DCNT_OBJ_1D);
 
-    // Load nightsky tiles to VRAM
-    volatile u32* nightskyTilesDst = (volatile u32*)(0x06000000 + (CB_NIGHTSKY << 14));
-    for (int i = 0; i < nightskyTilesLen / 4; i++) {
-        nightskyTilesDst[i] = ((const u32*)nightskyTiles)[i];
-    }
-
-    // Load nightsky tilemap to BG0 screen base
-    // Adjust tilemap entries to use nightsky palette bank
-    volatile u16* nightskyMapDst = (volatile u16*)(0x06000000 + (SB_NIGHTSKY << 11));
-    for (int i = 0; i < nightskyMapLen / 2; i++) {
-        u16 tileEntry = ((const u16*)nightskyMap)[i];
-        u16 tileIndex = tileEntry & 0x03FF;  // Extract tile index
-        u16 flags = tileEntry & 0xFC00;      // Extract flip/rotation flags
-        nightskyMapDst[i] = tileIndex | flags | (PAL_BG_NIGHTSKY << 12);
-    }
+    // Initialize timers for FPS counter and profiling (started first so boot
+    // is timed too)
+    // Timer 0: counts at 16.384 KHz (overflow after ~4 seconds)
+    // Timer 1: cascades from Timer 0 for extended range
+    REG_TM0CNT_L = 0;  // Initial value
+    REG_TM1CNT_L = 0;
+    REG_TM0CNT_H = TM_ENABLE | TM_FREQ_1024;  // Enable, prescaler 1024
+    REG_TM1CNT_H = TM_ENABLE | TM_CASCADE;    // Enable, cascade from Timer 0
 
-    // Load nightsky palette
-    volatile u16* bgPalette = pal_bg_mem;
-    for (int i = 0; i < nightskyPalLen / 2; i++) {
-        bgPalette[PAL_BG_NIGHTSKY * 16 + i] = nightskyPal[i];
-    }
+    // Tiles, maps and palettes (core/asset_manifest.c)
+    u16 bootAssetTicks = assetLoad(g_bootAssets, g_bootAssetCount);
+#if COLLISION_DEBUG_ENABLED
+    colDebugInit();
+#endif
+#if PREDICT_OVERLAY_ENABLED
+    predictOverlayInit();
+#endif
 
     // Set BG0 control register (4-bit color, priority 3 - behind everything)
-    REG_BG0CNT = (SB_NIGHTSKY << 8) | (CB_NIGHTSKY << 2) | (3 << 0);
+    vblankQueueReg(VREG_BG0CNT, (SB_NIGHTSKY << 8) | (CB_NIGHTSKY << 2) | (3 << 0));
 
     // Set BG0 scroll to 0,0
-    REG_BG0HOFS = 0;
-    REG_BG0VOFS = 0;
+    vblankQueueReg(VREG_BG0HOFS, 0);
+    vblankQueueReg(VREG_BG0VOFS, 0);
 
     // Enable alpha blending for sprites
     // BLDCNT: Effect=Alpha blend (bit 6), NO global OBJ target (sprites set semi-transparent individually)
     // 2nd target=BG0+BG1+BG2+BD (bits 8,9,10,13) - what semi-transparent sprites blend with
-    REG_BLDCNT = (1 << 6) | (1 << 8) | (1 << 9) | (1 << 10) | (1 << 13);
+    vblankQueueReg(VREG_BLDCNT, (1 << 6) | (1 << 8) | (1 << 9) | (1 << 10) | (1 << 13));
     // Set blend coefficients EVA (sprite) and EVB (background) - must sum to 16 or less
-    REG_BLDALPHA = (7 << 0) | (9 << 8);  // ~44% trail, ~56% background (more transparent)
-
-    // Palette bank 0: grassy_stone (colors 0-15)
-    for (int i = 0; i < 16; i++) {
-        bgPalette[PAL_BG_TERRAIN * 16 + i] = grassy_stonePal[i];
-    }
-
-    // Make palette index 0 transparent for grassy_stone
-    bgPalette[0] = 0;
-    
-    // Palette bank 1: Font (colors 16-31)
-    for (int i = 0; i < 16; i++) {
-        bgPalette[PAL_BG_FONT * 16 + i] = tinypixiePal[i];
-    }
-    
-    // Palette bank 2: plants (colors 32-47)
-    for (int i = 0; i < 16; i++) {
-        bgPalette[PAL_BG_PLANTS * 16 + i] = plantsPal[i];
-    }
-    
-    // Palette bank 3: decals (colors 48-63)
-    for (int i = 0; i < 16; i++) {
-        bgPalette[PAL_BG_DECALS * 16 + i] = decalsPal[i];
-    }
+    vblankQueueReg(VREG_BLDALPHA, (7 << 0) | (9 << 8));  // ~44% trail, ~56% background (more transparent)
 
     // Initialize background text system (BG3 - uses char block 1)
     init_bg_text();
 
-    // Copy sprite palette to VRAM
-    volatile u16* spritePalette = pal_obj_mem;
-
-    // Palette 0: Normal sprite colors
-    for (int i = 0; i < 16; i++) {
-        spritePalette[i] = skellyPal[i];
-    }
-
-    // Palettes 1-10: Light blue/cyan silhouettes with varying opacity for dash trail fade
-    // Create 10 palettes with very gradual color transitions for smooth fade effect
-    for (int pal = 0; pal < PAL_OBJ_TRAIL_COUNT; pal++) {
-        for (int i = 0; i < 16; i++) {
-            if (i == 0) {
-                spritePalette[(pal + PAL_OBJ_TRAIL_BASE) * 16 + i] = 0;  // Index 0 is transparent
-            } else {
-                // Very gradual fade from bright to light blue
-                // Palette 1: Most opaque (10, 20, 31)
-                // Palette 10: Lightest (2, 6, 16)
-                int r = 10 - (pal * 8) / 10;  // 10 -> 2
-                int g = 20 - (pal * 14) / 10; // 20 -> 6
-                int b = 31 - (pal * 15) / 10; // 31 -> 16
-                if (r < 2) r = 2;
-                if (g < 6) g = 6;
-                if (b < 16) b = 16;
-                spritePalette[(pal + PAL_OBJ_TRAIL_BASE) * 16 + i] = RGB15(r, g, b);
-            }
-        }
-    }
-
-    // Copy player sprite to VRAM (char block 4)
-    volatile u32* spriteTiles = (volatile u32*)tile_mem[4];
-    for (int i = 0; i < 32; i++) {  // 16-color mode: 4 tiles, 8 u32s per tile
-        spriteTiles[i] = skellyTiles[i];
-    }
-
-    // Create entity tile (8x8 filled square at tile index TILE_OBJ_ENTITY)
-    volatile u32* entityTile = &spriteTiles[TILE_OBJ_ENTITY * 8];
-    for (int i = 0; i < 8; i++) {
-        entityTile[i] = 0x11111111;  // All pixels = color 1
-    }
-
-    // Spring entity palette
-    spritePalette[PAL_OBJ_SPRING * 16 + 0] = 0;  // Transparent
-    spritePalette[PAL_OBJ_SPRING * 16 + 1] = RGB15(31, 0, 0);  // Bright red
-
-    // Red bubble entity palette
-    spritePalette[PAL_OBJ_RED_BUBBLE * 16 + 0] = 0;  // Transparent
-    spritePalette[PAL_OBJ_RED_BUBBLE * 16 + 1] = RGB15(31, 16, 0);  // Orange
-
-    // Green bubble entity palette
-    spritePalette[PAL_OBJ_GREEN_BUBBLE * 16 + 0] = 0;  // Transparent
-    spritePalette[PAL_OBJ_GREEN_BUBBLE * 16 + 1] = RGB15(0, 31, 0);  // Bright green
-
     // Set up sprite 0 as 16x16, 16-color mode, priority 1
-    volatile u16* oam = (volatile u16*)MEM_OAM;
+    // (shadow OAM; the VBlank handler copies it to hardware)
+    u16* oam = (u16*)g_oamShadow;
     oam[0] = 0;
     oam[1] = (1 << 14);
     oam[2] = (1 << 10);  // Priority 1
@@ -181,25 +121,10 @@ int main() {
     // Hide player sprite initially (we're in menu mode)
     oam[0] = 160;  // Y coordinate offscreen (reuse oam pointer from above)
 
-    // Clear BG1 and BG2 tilemaps (hide level tiles in menu)
-    volatile u16* bg1Map = (volatile u16*)(0x06000000 + (25 << 11));
-    volatile u16* bg2Map = (volatile u16*)(0x06000000 + (26 << 11));
-    for (int i = 0; i < 32 * 32; i++) {
-        bg1Map[i] = 0;
-        bg2Map[i] = 0;
-    }
-
     // Initialize and show the level selection menu
     initMenu();
     renderMenu();
-
-    // Initialize timers for FPS counter
-    // Timer 0: counts at 16.384 KHz (overflow after ~4 seconds)
-    // Timer 1: cascades from Timer 0 for extended range
-    REG_TM0CNT_L = 0;  // Initial value
-    REG_TM1CNT_L = 0;
-    REG_TM0CNT_H = TM_ENABLE | TM_FREQ_1024;  // Enable, prescaler 1024
-    REG_TM1CNT_H = TM_ENABLE | TM_CASCADE;    // Enable, cascade from Timer 0
+    LOG3(LOG_BOOT, (int)assetLastLoadBytes(), bootAssetTicks, (u16)REG_TM0CNT_L);
 
     // Frame counter and profiling (only used during gameplay)
     int frameCount = 0;
@@ -215,9 +140,25 @@ int main() {
     char tilemapTimeStr[32] = "T:0";
     char renderTimeStr[32] = "R:0";
     char totalTimeStr[32] = "Tot:0";
-
-    // Previous frame keys for edge detection
+    char qualityStr[32] = "Deg:0";
+#if COLLISION_DEBUG_ENABLED
+    // Worst probe count over the window, and the redundant probes in it
+    int maxProbes = 0, maxProbesRedundant = 0;
+    char probeStr[32] = "Pr:0/0";
+#endif
+
+    // Quality governor: fed each gameplay frame's work time (VBlank to the
+    // end of the frame, text refresh included) on the next loop iteration.
+    initQualityGovernor();
+    saveInit(&SAVE_DEFAULT_BACKEND);
+    initTelemetry();
+    u16 workStart = 0;
+    int measureWork = 0;
+
+    // Previous frame keys for edge detection: game input (latched while
+    // frame stepping) and the live pad, which the debug combos watch
     u16 prevKeys = 0;
+    u16 prevRealKeys = 0;
 
     // Replay system
     ReplayState replay;
@@ -231,19 +172,44 @@ int main() {
     // Game loop
     while (1) {
         u16 frameStart = REG_TM0CNT_L;  // Measure from start of frame
+        if (measureWork) {
+            u16 workTicks = frameStart - workStart;
+            qualityGovernorUpdate(workTicks);
+            telemetryEndFrame(workTicks);
+            measureWork = 0;
+        }
+
+        // Swap in the IWRAM overlay for the mode the next frame runs in, but
+        // only if the copy fits in what is left of this frame; otherwise the
+        // ROM copies keep running and we try again next frame.
+        if (isInMenuMode()) {
+            overlayRequest(OVERLAY_MENU);
+        } else if (isTransitioning()) {
+            overlayRequest(OVERLAY_TRANSITION);
+        } else {
+            overlayRequest(OVERLAY_GAMEPLAY);
+        }
+        overlayService(QUALITY_FRAME_TICKS - (u16)(REG_TM0CNT_L - workStart));
+        if ((u16)(REG_TM0CNT_L - workStart) < LOG_DRAIN_SLACK_TICKS) {
+            logDrain(LOG_DRAIN_PER_FRAME);
+        }
+        // Flash saves trickle out in whatever slack the frame has left
+        saveService(QUALITY_FRAME_TICKS - (u16)(REG_TM0CNT_L - workStart));
+        vblankQueueSubmit();  // Publish last frame's video writes to the VBlank handler
         VBlankIntrWait();  // Efficient VBlank wait using BIOS interrupt
+        workStart = REG_TM0CNT_L;
         key_poll();
         u16 realKeys = key_curr_state();
         u16 keys = realKeys;
 
         // Replay controls (SELECT + L/R/B)
-        if ((realKeys & BTN_SELECT) && (realKeys & ~prevKeys & BTN_REPLAY_START)) {
+        if ((realKeys & BTN_SELECT) && (realKeys & ~prevRealKeys & BTN_REPLAY_START)) {
             // SELECT+L: Start recording and save current position and level
             startRecording(&replay);
             setReplayStartPosition(&replay, player.x, player.y);
             setReplayLevel(&replay, getCurrentLevelIndex());
             profilingInitialized = 0;  // Force redraw to show replay status
-        } else if ((realKeys & BTN_SELECT) && (realKeys & ~prevKeys & BTN_REPLAY_PLAY)) {
+        } else if ((realKeys & BTN_SELECT) && (realKeys & ~prevRealKeys & BTN_REPLAY_PLAY)) {
             // SELECT+R: Start playback and restore position
             int startX, startY;
             getReplayStartPosition(&replay, &startX, &startY);
@@ -251,26 +217,29 @@ int main() {
             player.y = startY;
             player.vx = 0;
             player.vy = 0;
+            wakePlayer(&player);
             startPlayback(&replay);
             profilingInitialized = 0;  // Force redraw to show replay status
-        } else if ((realKeys & BTN_SELECT) && (realKeys & ~prevKeys & BTN_REPLAY_SAVE)) {
+        } else if ((realKeys & BTN_SELECT) && (realKeys & ~prevRealKeys & BTN_REPLAY_SAVE)) {
             // SELECT+B: Stop and save replay to SRAM
             if (replay.mode != REPLAY_MODE_OFF) {
                 stopReplay(&replay);
                 saveReplayToSRAM(&replay);
+                LOG2(LOG_REPLAY_SAVED, replay.frameCount, getReplayLevel(&replay));
                 // Show confirmation
                 siprintf(replayStr, "SAVED %d frames", replay.frameCount);
                 draw_bg_text_slot(replayStr, 1, 7, 14);
                 profilingInitialized = 0;  // Force redraw later
             }
-        } else if ((realKeys & BTN_SELECT) && (realKeys & ~prevKeys & BTN_REPLAY_LOAD)) {
+        } else if ((realKeys & BTN_SELECT) && (realKeys & ~prevRealKeys & BTN_REPLAY_LOAD)) {
             // SELECT+DOWN: Load replay from SRAM, switch level if needed, and restore position
             loadReplayFromSRAM(&replay);
             if (replay.frameCount > 0) {
                 int replayLevelIndex = getReplayLevel(&replay);
 
                 // Switch to the replay's level if different from current
-                if (replayLevelIndex != getCurrentLevelIndex()) {
+                int switchLevel = (replayLevelIndex != getCurrentLevelIndex());
+                if (switchLevel) {
                     switchToLevel(replayLevelIndex, &player, &camera);
                 }
 
@@ -280,14 +249,48 @@ int main() {
                 player.y = startY;
                 player.vx = 0;
                 player.vy = 0;
+                if (switchLevel) {
+                    // Fill the new level's maps around the replay start
+                    updateCamera(&camera, &player, getCurrentLevel());
+                    enterLevelTilemap(&ts, getCurrentLevel(), camera.x, camera.y);
+                }
+                wakePlayer(&player);
                 startPlayback(&replay);
+                LOG2(LOG_REPLAY_LOADED, replay.frameCount, replayLevelIndex);
                 siprintf(replayStr, "LOADED %d frames", replay.frameCount);
                 draw_bg_text_slot(replayStr, 1, 7, 14);
                 profilingInitialized = 0;
             } else {
+                LOG0(LOG_REPLAY_EMPTY);
                 siprintf(replayStr, "No replay in save");
                 draw_bg_text_slot(replayStr, 1, 7, 14);
             }
+        } else if ((realKeys & BTN_SELECT) && (realKeys & ~prevRealKeys & BTN_PROFILE)) {
+            // SELECT+UP: Toggle the sampling profiler; stopping dumps it to SRAM
+            if (pcProfilerRunning()) {
+                pcProfilerStop();
+                pcProfilerDumpToSRAM();
+                siprintf(replayStr, "PROF %lu samples", (unsigned long)pcProfilerSampleCount());
+            } else {
+                pcProfilerStart();
+                siprintf(replayStr, "PROF running");
+            }
+            draw_bg_text_slot(replayStr, 1, 7, 14);
+        }
+
+        // Pause / slow motion (SELECT+LEFT): between simulated frames only
+        // the display keeps going, and nothing is read from or recorded
+        // into the replay.
+        int simulate = isInMenuMode() || frameStepUpdate(realKeys, prevRealKeys, &keys);
+        prevRealKeys = realKeys;
+        if (!simulate) {
+            frameStepDrawOverlay(&player);
+            dialogueUpdate(0);
+#if PREDICT_OVERLAY_ENABLED
+            predictOverlayUpdate(&player, realKeys & ~BTN_SELECT, getCurrentLevel(), camera.x, camera.y,
+                                 QUALITY_RESTORE_TICKS - (int)(u16)(REG_TM0CNT_L - workStart));
+#endif
+            continue;
         }
 
         // Use replay input if playing back
@@ -309,10 +312,13 @@ int main() {
 
         if (isInMenuMode()) {
             // Menu mode
-            updateAndRenderMenu(keys, pressed, &player, &camera);
+            if (!updateAndRenderMenu(keys, pressed, &player, &camera)) {
+                enterLevelTilemap(&ts, getCurrentLevel(), camera.x, camera.y);
+            }
         } else {
             // Gameplay mode
             frameCount++;
+            logSetFrame(frameCount);
 
             // Draw profiling text on first entry
             if (!profilingInitialized) {
@@ -322,6 +328,10 @@ int main() {
                 draw_bg_text_slot(tilemapTimeStr, 1, 4, PROFILING_SLOT_TILEMAP);
                 draw_bg_text_slot(renderTimeStr, 1, 5, PROFILING_SLOT_RENDER);
                 draw_bg_text_slot(totalTimeStr, 1, 6, PROFILING_SLOT_TOTAL);
+                draw_bg_text_slot(qualityStr, 1, 8, PROFILING_SLOT_QUALITY);
+#if COLLISION_DEBUG_ENABLED
+                draw_bg_text_slot(probeStr, 1, 9, PROFILING_SLOT_PROBES);
+#endif
 
                 // Replay status
                 if (replay.mode == REPLAY_MODE_RECORDING) {
@@ -336,8 +346,10 @@ int main() {
                 profilingInitialized = 1;
             }
 
+            int refreshOverlay = !qualityShedding(QUALITY_SHED_OVERLAY);
+
             // Update replay status every 60 frames
-            if (frameCount % 60 == 0 && replay.mode != REPLAY_MODE_OFF) {
+            if (refreshOverlay && frameCount % 60 == 0 && replay.mode != REPLAY_MODE_OFF) {
                 if (replay.mode == REPLAY_MODE_RECORDING) {
                     siprintf(replayStr, "REC: %d/%d", replay.frameCount, MAX_REPLAY_FRAMES);
                 } else if (replay.mode == REPLAY_MODE_PLAYBACK) {
@@ -348,11 +360,21 @@ int main() {
 
             // Check for START to return to menu
             if (pressed & BTN_MENU) {
+                telemetryFlush();
+                dialogueClose();
+#if COLLISION_DEBUG_ENABLED
+                colDebugHide();
+#endif
+#if PREDICT_OVERLAY_ENABLED
+                predictOverlayHide();
+#endif
+                frameStepReset();
                 returnToMenu();
                 profilingInitialized = 0;  // Reset profiling display for next time
                 resetTilemapState(&ts);
                 continue;
             }
+            measureWork = 1;
 
             // Get current level (initial read; may be updated after transition)
             const Level* currentLevel = getCurrentLevel();
@@ -364,6 +386,9 @@ int main() {
             int transitionActiveAtFrameStart = isTransitioning();
 
             // Profile: Player update
+#if COLLISION_DEBUG_ENABLED
+            colDebugBeginFrame();
+#endif
             u16 t0 = REG_TM0CNT_L;
             if (transitionActiveAtFrameStart) {
                 updateTransition(&player, &camera);
@@ -374,6 +399,7 @@ int main() {
             u16 t1 = REG_TM0CNT_L;
             u16 dtPlayer = t1 - t0;
             if (dtPlayer > maxPlayer) maxPlayer = dtPlayer;
+            telemetryPhase(transitionActiveAtFrameStart ? TELEMETRY_PHASE_TRANSITION : TELEMETRY_PHASE_PLAYER, dtPlayer);
 
             // Re-read level state in case a transition just switched levels
             currentLevel = getCurrentLevel();
@@ -384,6 +410,7 @@ int main() {
             // Skip camera updates both when a transition started this frame and
             // when a transition is committing this frame after starting earlier.
             int transitionBusyThisFrame = transitionActiveAtFrameStart || isTransitioning();
+            telemetrySetRoom(currentLevelIndex, transitionBusyThisFrame);
             if (!transitionBusyThisFrame) {
                 updateCamera(&camera, &player, currentLevel);
             } else {
@@ -392,6 +419,7 @@ int main() {
             u16 t2 = REG_TM0CNT_L;
             u16 dtCamera = t2 - t1;
             if (dtCamera > maxCamera) maxCamera = dtCamera;
+            telemetryPhase(TELEMETRY_PHASE_CAMERA, dtCamera);
 
             // Tilemap update - supports both normal play and scroll transitions.
             ScrollTransInfo scrollInfo;
@@ -403,11 +431,14 @@ int main() {
             u16 t3 = REG_TM0CNT_L;
             u16 dtTilemap = t3 - t2;
             if (dtTilemap > maxTilemap) maxTilemap = dtTilemap;
+            telemetryPhase(TELEMETRY_PHASE_TILEMAP, dtTilemap);
 
             // Keep transition-end tilemap writes first in VBlank to avoid
             // one-frame BG1 garbage when switching levels.
             if (levelChanged) {
+                LOG1(LOG_LEVEL_ENTER, currentLevelIndex);
                 loadEntitiesFromLevel(&entities, currentLevel);
+                dialogueOpen(currentLevel->name, ROOM_INTRO_TILE_X, ROOM_INTRO_TILE_Y, DIALOGUE_RATE_DEFAULT);
                 lastLevelIndex = currentLevelIndex;
             }
 
@@ -426,9 +457,19 @@ int main() {
             u16 playerPriority = scrollInfo.active ? 0 : 1;
             drawPlayer(&player, &renderCamera, playerPriority);
             renderEntities(&entities, renderCamera.x, renderCamera.y);
+#if COLLISION_DEBUG_ENABLED
+            colDebugRender(&player, renderCamera.x, renderCamera.y);
+            if (colDebugProbeCount() > maxProbes) {
+                maxProbes = colDebugProbeCount();
+                maxProbesRedundant = colDebugRedundantCount();
+            }
+#endif
+            dialogueUpdate(0);
+            frameStepDrawOverlay(&player);
             u16 t4 = REG_TM0CNT_L;
             u16 dtRender = t4 - t3;
             if (dtRender > maxRender) maxRender = dtRender;
+            telemetryPhase(TELEMETRY_PHASE_RENDER, dtRender);
 
             // Track subsystem total
             u16 subsystemTotal = dtPlayer + dtCamera + dtTilemap + dtRender;
@@ -453,24 +494,39 @@ int main() {
                 }
 
                 lastTimerValue = currentTimerValue;
-                int_to_string(fps, fpsStr, sizeof(fpsStr), "FPS:");
-                draw_bg_text_slot(fpsStr, 1, 1, PROFILING_SLOT_FPS);
-
-                // Update profiling display - show MAX values (worst frame)
-                int_to_string(maxPlayer, playerTimeStr, sizeof(playerTimeStr), "P:");
-                draw_bg_text_slot(playerTimeStr, 1, 2, PROFILING_SLOT_PLAYER);
 
-                int_to_string(maxCamera, cameraTimeStr, sizeof(cameraTimeStr), "C:");
-                draw_bg_text_slot(cameraTimeStr, 1, 3, PROFILING_SLOT_CAMERA);
-
-                int_to_string(maxTilemap, tilemapTimeStr, sizeof(tilemapTimeStr), "T:");
-                draw_bg_text_slot(tilemapTimeStr, 1, 4, PROFILING_SLOT_TILEMAP);
-
-                int_to_string(maxRender, renderTimeStr, sizeof(renderTimeStr), "R:");
-                draw_bg_text_slot(renderTimeStr, 1, 5, PROFILING_SLOT_RENDER);
-
-                int_to_string(maxTotal, totalTimeStr, sizeof(totalTimeStr), "Max:");
-                draw_bg_text_slot(totalTimeStr, 1, 6, PROFILING_SLOT_TOTAL);
+                // The degraded-time counter is drawn even while the quality
+                // governor has shed the overlay, since those are the frames
+                // it counts: one slot every 16 frames.
+                int_to_string((int)qualityDegradedFrames(), qualityStr, sizeof(qualityStr), "Deg:");
+                draw_bg_text_slot(qualityStr, 1, 8, PROFILING_SLOT_QUALITY);
+
+                // Skip the rest of the text redraw while the overlay is shed;
+                // the max trackers below still reset every window.
+                if (refreshOverlay) {
+                    int_to_string(fps, fpsStr, sizeof(fpsStr), "FPS:");
+                    draw_bg_text_slot(fpsStr, 1, 1, PROFILING_SLOT_FPS);
+
+                    // Update profiling display - show MAX values (worst frame)
+                    int_to_string(maxPlayer, playerTimeStr, sizeof(playerTimeStr), "P:");
+                    draw_bg_text_slot(playerTimeStr, 1, 2, PROFILING_SLOT_PLAYER);
+
+                    int_to_string(maxCamera, cameraTimeStr, sizeof(cameraTimeStr), "C:");
+                    draw_bg_text_slot(cameraTimeStr, 1, 3, PROFILING_SLOT_CAMERA);
+
+                    int_to_string(maxTilemap, tilemapTimeStr, sizeof(tilemapTimeStr), "T:");
+                    draw_bg_text_slot(tilemapTimeStr, 1, 4, PROFILING_SLOT_TILEMAP);
+
+                    int_to_string(maxRender, renderTimeStr, sizeof(renderTimeStr), "R:");
+                    draw_bg_text_slot(renderTimeStr, 1, 5, PROFILING_SLOT_RENDER);
+
+                    int_to_string(maxTotal, totalTimeStr, sizeof(totalTimeStr), "Max:");
+                    draw_bg_text_slot(totalTimeStr, 1, 6, PROFILING_SLOT_TOTAL);
+#if COLLISION_DEBUG_ENABLED
+                    siprintf(probeStr, "Pr:%d/%d", maxProbes, maxProbesRedundant);
+                    draw_bg_text_slot(probeStr, 1, 9, PROFILING_SLOT_PROBES);
+#endif
+                }
 
                 // Reset max trackers
                 maxPlayer = 0;
@@ -478,7 +534,18 @@ int main() {
                 maxTilemap = 0;
                 maxRender = 0;
                 maxTotal = 0;
+#if COLLISION_DEBUG_ENABLED
+                maxProbes = 0;
+                maxProbesRedundant = 0;
+#endif
             }
+
+#if PREDICT_OVERLAY_ENABLED
+            // Predict into the slack below the governor's restore threshold,
+            // so the overlay never costs a shed
+            predictOverlayUpdate(&player, keys, currentLevel, renderCamera.x, renderCamera.y,
+                                 QUALITY_RESTORE_TICKS - (int)(u16)(REG_TM0CNT_L - workStart));
+#endif
         }  // End gameplay mode
     }  // End while loop
 
@@ -0,0 +1,32 @@
+#include "level_entry.h"
+#include "camera/camera.h"
+#include "player/player.h"
+#include "transition/scroll_tilemap.h"
+
+void configureLevelBgs(const Level* level) {
+    queueGameplayBgControl(1, 0);
+    queueGameplayBgControl(2, 1);
+    if (!level) {
+        return;
+    }
+    for (u8 i = 0; i < level->layerCount; i++) {
+        const TileLayer* layer = &level->layers[i];
+        queueGameplayBgControl(layer->bgLayer, layer->priority);
+    }
+}
+
+void beginLevel(const Level* level, Player* player, Camera* camera) {
+    // Tiles to VRAM (finishing whatever the level select preload has not
+    // decoded yet)
+    loadLevelToVRAM(level);
+    configureLevelBgs(level);
+
+    // Reset player to level spawn point
+    initPlayer(player, level);
+
+    // Settle the camera where the first gameplay frame will want it, so the
+    // tilemap is filled once, at the right place
+    camera->x = 0;
+    camera->y = 0;
+    updateCamera(camera, player, level);
+}
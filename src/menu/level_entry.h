@@ -0,0 +1,21 @@
+#ifndef LEVEL_ENTRY_H
+#define LEVEL_ENTRY_H
+
+#include "core/game_types.h"
+#include "level/level.h"
+
+// Level entry without the menu: what the level select and switchToLevel()
+// do to the level buffers, BGs, player and camera. The desktop tests enter
+// levels through it too, so what they measure is the real entry path.
+
+// Queue BGxCNT for gameplay BG1/BG2 and, with a level, for each of its
+// layers.
+void configureLevelBgs(const Level* level);
+
+// Load `level`, set up its BGs, place the player at its spawn and settle the
+// camera on it. The gameplay maps are not touched: the caller fills them
+// once with enterLevelTilemap() at the camera (or wherever it moves the
+// player and camera first, as a replay load does).
+void beginLevel(const Level* level, Player* player, Camera* camera);
+
+#endif // LEVEL_ENTRY_H
@@ -1,9 +1,14 @@
 #include "menu.h"
+#include "level_entry.h"
 #include "core/text.h"
 #include "core/input.h"
 #include "core/vram_layout.h"
+#include "core/vblank_queue.h"
+#include "core/assets.h"
 #include "level/level.h"
+#include "transition/scroll_tilemap.h"
 #include "collision/collision.h"
+#include "camera/camera.h"
 #include "generated/connections.h"
 
 // Menu state
@@ -27,26 +32,16 @@ static int menuInitialized = 0;     // Whether menu text has been drawn
 static const Level* currentLevel = NULL;
 static int currentLevelIndex = -1;  // -1 means in menu
 
-// Tilemap state (accessed by menu functions)
-static int oldCameraTileX = -1;
-static int oldCameraTileY = -1;
-
 static inline u8 gameplayScreenBase(u8 bgLayer) {
-    return (u8)(SB_NIGHTSKY + bgLayer);
+    return getGameplayScreenBase(bgLayer);
 }
 
 static void clearGameplayTilemaps(void) {
-    volatile u16* bg1Map = (volatile u16*)(0x06000000 + (SB_BG1 << 11));
-    volatile u16* bg2Map = (volatile u16*)(0x06000000 + (SB_BG2 << 11));
-    for (int i = 0; i < 32 * 32; i++) {
-        bg1Map[i] = 0;
-        bg2Map[i] = 0;
-    }
-}
-
-static void configureGameplayBgs(void) {
-    REG_BG1CNT = (SB_BG1 << 8) | (0 << 2) | (0 << 0);
-    REG_BG2CNT = (SB_BG2 << 8) | (0 << 2) | (1 << 0);
+    AssetEntry clear[2] = {
+        { "bg1 map", ASSET_FILL, 0, vramScreenblock(gameplayScreenBase(1)), 32 * 32 * 2, 0 },
+        { "bg2 map", ASSET_FILL, 0, vramScreenblock(gameplayScreenBase(2)), 32 * 32 * 2, 0 },
+    };
+    assetLoad(clear, 2);
 }
 
 // Forward declarations
@@ -59,8 +54,6 @@ void initMenu(void) {
     menuInitialized = 0;
     currentLevel = NULL;
     currentLevelIndex = -1;
-    oldCameraTileX = -1;
-    oldCameraTileY = -1;
 }
 
 void renderMenu(void) {
@@ -118,12 +111,18 @@ int updateAndRenderMenu(u16 keys, u16 pressed, Player* player, Camera* camera) {
         renderMenu();
     }
 
-    // Start selected level
+    // Start selected level (loadLevelToVRAM finishes whatever the preload
+    // has not decoded yet)
     if (pressed & BTN_CONFIRM) {
         initGameplayForLevel(menuSelection, player, camera);
         return 0;  // Transitioning to gameplay
     }
 
+    // Decode the highlighted level a slice per frame; a new selection
+    // restarts the preload
+    levelPreloadStart(g_levels[menuSelection]);
+    levelPreloadStep(LEVEL_PRELOAD_BYTES_PER_FRAME);
+
     return 1;  // Still in menu
 }
 
@@ -131,7 +130,7 @@ void returnToMenu(void) {
     inMenu = 1;
 
     // Hide player sprite (move offscreen)
-    volatile u16* oam = (volatile u16*)MEM_OAM;
+    u16* oam = (u16*)g_oamShadow;
     oam[0] = 160;  // Y coordinate offscreen
 
     // Hide spring sprites
@@ -141,7 +140,7 @@ void returnToMenu(void) {
 
     // Clear BG1 and BG2 tilemaps (hide level tiles)
     clearGameplayTilemaps();
-    configureGameplayBgs();
+    configureLevelBgs(NULL);
 
     // Clear all text (both menu and profiling)
     clear_bg_text();
@@ -159,13 +158,9 @@ const Level* getCurrentLevel(void) {
     return currentLevel;
 }
 
-// Internal: Reset menu tilemap state to force full refresh
-static void resetMenuTilemapState(void) {
-    oldCameraTileX = -1;
-    oldCameraTileY = -1;
-}
-
-// Initialize gameplay for a selected level
+// Initialize gameplay for a selected level. Everything but the menu's own
+// state is beginLevel(); the gameplay maps are left to the caller's
+// enterLevelTilemap(), at the camera set up there.
 static void initGameplayForLevel(int levelIndex, Player* player, Camera* camera) {
     currentLevel = g_levels[levelIndex];
     currentLevelIndex = levelIndex;
@@ -174,55 +169,10 @@ static void initGameplayForLevel(int levelIndex, Player* player, Camera* camera)
     clear_bg_text();
     menuInitialized = 0;  // Menu slots are now invalid
 
-    // Load level tiles to VRAM
-    loadLevelToVRAM(currentLevel);
-
-    clearGameplayTilemaps();
-    configureGameplayBgs();
-
-    // Reset tilemap state variables to force full refresh
-    resetMenuTilemapState();
-
-    // Set up BG control registers for each layer
-    for (u8 i = 0; i < currentLevel->layerCount; i++) {
-        const TileLayer* layer = &currentLevel->layers[i];
-        u8 bgLayer = layer->bgLayer;
-        u8 priority = layer->priority;
-        u8 screenBase = gameplayScreenBase(bgLayer);
-
-        if (bgLayer == 1) {
-            REG_BG1CNT = (screenBase << 8) | (0 << 2) | (priority << 0);
-        } else if (bgLayer == 2) {
-            REG_BG2CNT = (screenBase << 8) | (0 << 2) | (priority << 0);
-        }
-    }
-
-    // Initialize tilemaps for each layer
-    for (u8 layerIdx = 0; layerIdx < currentLevel->layerCount; layerIdx++) {
-        const TileLayer* layer = &currentLevel->layers[layerIdx];
-        u8 bgLayer = layer->bgLayer;
-        u8 screenBase = gameplayScreenBase(bgLayer);
-
-        volatile u16* bgMap = (volatile u16*)(0x06000000 + (screenBase << 11));
-
-        for (int y = 0; y < 32; y++) {
-            for (int x = 0; x < 32; x++) {
-                u16 tileId = getTileAt(currentLevel, layerIdx, x, y);
-                bgMap[y * 32 + x] = mapTileEntry(g_levelTileEntries, tileId);
-            }
-        }
-    }
-
-    // Reset player to level spawn point
-    initPlayer(player, currentLevel);
-
-    // Reset camera
-    camera->x = 0;
-    camera->y = 0;
+    beginLevel(currentLevel, player, camera);
 
     // Show player sprite (make sure it's visible)
-    volatile u16* oam = (volatile u16*)MEM_OAM;
-    oam[0] = 0;
+    g_oamShadow[OAM_PLAYER].attr0 = 0;
 
     // Switch to gameplay mode
     inMenu = 0;
@@ -240,13 +190,6 @@ void switchToLevel(int levelIndex, Player* player, Camera* camera) {
 
     // Switch to the requested level
     initGameplayForLevel(levelIndex, player, camera);
-
-    // Initialize player for the level
-    initPlayer(player, currentLevel);
-
-    // Reset camera position
-    camera->x = 0;
-    camera->y = 0;
 }
 
 void loadLevelForTransition(int levelIndex) {
@@ -271,22 +214,8 @@ void loadLevelForTransition(int levelIndex) {
         clearGameplayTilemaps();
     }
 
-    configureGameplayBgs();
-
-    // Set up BG control registers for each layer
-    for (u8 i = 0; i < currentLevel->layerCount; i++) {
-        const TileLayer* layer = &currentLevel->layers[i];
-        u8 bgLayer = layer->bgLayer;
-        u8 priority = layer->priority;
-        u8 screenBase = gameplayScreenBase(bgLayer);
-
-        if (bgLayer == 1) {
-            REG_BG1CNT = (screenBase << 8) | (0 << 2) | (priority << 0);
-        } else if (bgLayer == 2) {
-            REG_BG2CNT = (screenBase << 8) | (0 << 2) | (priority << 0);
-        }
-    }
-    // NOTE: Does NOT call initPlayer, resetMenuTilemapState, or reset camera.
+    configureLevelBgs(currentLevel);
+    // NOTE: Does NOT call initPlayer, enterLevelTilemap, or reset camera.
     // The transition system places the player and camera. The large camera
     // delta on the first gameplay frame will trigger a full tilemap refresh.
 }
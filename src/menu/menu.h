@@ -13,7 +13,8 @@ void initMenu(void);
 void renderMenu(void);
 
 // Update menu state based on input
-// Returns: 1 if still in menu, 0 if transitioning to gameplay
+// Returns: 1 if still in menu, 0 if transitioning to gameplay (the player
+// and camera are placed; the caller fills the maps with enterLevelTilemap)
 int updateAndRenderMenu(u16 keys, u16 pressed, Player* player, Camera* camera);
 
 // Return to menu from gameplay
@@ -28,7 +29,7 @@ const Level* getCurrentLevel(void);
 // Get current level index (-1 if in menu)
 int getCurrentLevelIndex(void);
 
-// Switch to a specific level by index
+// Switch to a specific level by index (maps as for updateAndRenderMenu)
 void switchToLevel(int levelIndex, Player* player, Camera* camera);
 
 // Load a level into VRAM and update internal state for use during screen transitions.
@@ -2,6 +2,32 @@
 #include "state.h"
 #include "util/calc.h"
 #include "core/input.h"
+#include "core/cost_model.h"
+#include <string.h>
+
+#ifdef DESKTOP_BUILD
+int g_playerSleepEnabled = 1;
+#endif
+
+int g_playerPredicting = 0;
+int g_playerPredictExit = 0;
+
+// Grounded, motionless, no input, and every timer updatePlayer reads has
+// run out. Necessary for an idle frame to be a no-op; the full path
+// confirms it is sufficient (unchanged player) before going to sleep.
+static inline int playerIsQuiescent(const Player* player, u16 keys) {
+    return keys == 0 && player->prevKeys == 0 &&
+           player->stateMachine.state == ST_NORMAL &&
+           player->onGround && player->wasOnGround &&
+           player->vx == 0 && player->vy == 0 &&
+           !player->dashing && !player->ducking && player->hopWaitX == 0 &&
+           !timerActive(player, player->autoJumpUntil) && !timerActive(player, player->dashCooldownUntil) &&
+           !timerActive(player, player->dashRefillCooldownUntil) && !timerActive(player, player->jumpBufferUntil) &&
+           !timerActive(player, player->varJumpUntil) && !timerActive(player, player->dashAttackUntil) &&
+           !timerActive(player, player->climbNoMoveUntil) && !timerActive(player, player->wallBoostUntil) &&
+           !timerActive(player, player->forceMoveXUntil) &&
+           player->trailFadeTimer >= TRAIL_LENGTH * 8;
+}
 
 void initPlayer(Player* player, const Level* level) {
     player->x = level->playerSpawnX << FIXED_SHIFT;
@@ -11,25 +37,26 @@ void initPlayer(Player* player, const Level* level) {
     player->maxFall = MAX_FALL_SPEED;
     player->onGround = 0;
     player->wasOnGround = 0;
+    player->clock = 0;
     player->coyoteTime = 0;
-    player->jumpBuffer = 0;
+    player->jumpBufferUntil = TIMER_OFF;
     player->jumpHeld = 0;
     player->autoJump = 0;
-    player->autoJumpTimer = 0;
+    player->autoJumpUntil = TIMER_OFF;
     player->liftBoostX = 0;
     player->liftBoostY = 0;
     player->varJumpSpeed = 0;
-    player->varJumpTimer = 0;
+    player->varJumpUntil = TIMER_OFF;
     player->dashing = 0;
     player->dashes = 1;  // Start with 1 dash
     player->maxDashes = 1;
-    player->dashCooldownTimer = 0;
-    player->dashRefillCooldownTimer = 0;
+    player->dashCooldownUntil = TIMER_OFF;
+    player->dashRefillCooldownUntil = TIMER_OFF;
     player->facingRight = 1;
     player->prevKeys = 0;
     player->wallSlideTimer = WALL_SLIDE_TIME;
     player->wallSlideDir = 0;
-    player->dashAttackTimer = 0;
+    player->dashAttackUntil = TIMER_OFF;
     player->dashDirX = 0;
     player->dashDirY = 0;
     player->beforeDashSpeedX = 0;
@@ -40,16 +67,16 @@ void initPlayer(Player* player, const Level* level) {
 
     // Initialize climb state
     player->stamina = CLIMB_MAX_STAMINA;
-    player->climbNoMoveTimer = 0;
+    player->climbNoMoveUntil = TIMER_OFF;
     player->lastClimbMove = 0;
-    player->wallBoostTimer = 0;
+    player->wallBoostUntil = TIMER_OFF;
     player->wallBoostDir = 0;
 
     // Initialize climb hop system (Celeste line 218-219)
     player->hopWaitX = 0;
     player->hopWaitXSpeed = 0;
     player->forceMoveX = 0;
-    player->forceMoveXTimer = 0;
+    player->forceMoveXUntil = TIMER_OFF;
 
     // Initialize HitSquash state
     player->hitSquashNoMoveTimer = 0;
@@ -61,6 +88,7 @@ void initPlayer(Player* player, const Level* level) {
     player->boostTimer = 0;
     player->currentBubbleX = -1000;  // Sentinel value for no current bubble
     player->currentBubbleY = -1000;
+    player->asleep = 0;
 
     // Initialize state machine (Celeste line 322-332)
     initStateMachine(&player->stateMachine);
@@ -77,43 +105,45 @@ void initPlayer(Player* player, const Level* level) {
 }
 
 void updatePlayer(Player* player, u16 keys, const Level* level) {
-    // === PRE-STATE UPDATE LOGIC ===
-    // Timers that tick down every frame regardless of state
-
-    // AutoJump timer (Celeste line 747-757)
-    // Dash sets AutoJump=true and AutoJumpTimer=0, which stays active until landing
-    if (player->autoJumpTimer > 0) {
-        if (player->autoJump) {
-            player->autoJumpTimer--;
-            if (player->autoJumpTimer <= 0) {
-                player->autoJump = 0;
-            }
-        } else {
-            player->autoJumpTimer = 0;
+    // === SLEEP FAST PATH ===
+    // A sleeping player already reached a fixed point of this function for
+    // no input, so skipping it is bit-identical to running it. Any input (or
+    // an external wakePlayer) drops back to the full path.
+    int quiescent = playerIsQuiescent(player, keys);
+#ifdef DESKTOP_BUILD
+    if (!g_playerSleepEnabled) quiescent = 0;
+#endif
+    // One frame passes whichever path runs (timer deadlines are against this)
+    player->clock++;
+    timerRebase(player);
+    if (player->asleep) {
+        COST_INSNS(20);
+        if (quiescent) {
+            return;
         }
+        player->asleep = 0;
     }
 
-    // Dash cooldowns (Celeste ticks these in engine update)
-    if (player->dashCooldownTimer > 0) {
-        player->dashCooldownTimer--;
-    }
-    if (player->dashRefillCooldownTimer > 0) {
-        player->dashRefillCooldownTimer--;
-    }
-
-    // Jump buffer decay
-    if (player->jumpBuffer > 0) {
-        player->jumpBuffer--;
+    Player before;
+    if (quiescent) {
+        memcpy(&before, player, sizeof(before));
+        COST_ACCESS(COST_IWRAM, 4, sizeof(before) / 4);
     }
 
-    // Var jump timer decay
-    if (player->varJumpTimer > 0) {
-        player->varJumpTimer--;
-    }
+    COST_INSNS(150);  // timers, input edges and state dispatch
+    // === PRE-STATE UPDATE LOGIC ===
+    // Gameplay timers are deadlines on player->clock (player_timer.h), so
+    // they run out by themselves; only the ones with an effect on expiry
+    // are looked at here.
 
-    // Dash attack timer decay
-    if (player->dashAttackTimer > 0) {
-        player->dashAttackTimer--;
+    // AutoJump timer (Celeste line 747-757)
+    // Dash sets AutoJump with no deadline, which stays active until landing
+    if (timerWasActive(player, player->autoJumpUntil)) {
+        if (!player->autoJump) {
+            player->autoJumpUntil = TIMER_OFF;
+        } else if (!timerActive(player, player->autoJumpUntil)) {
+            player->autoJump = 0;
+        }
     }
 
     // Wall slide timer decay when not actively wall sliding
@@ -127,30 +157,18 @@ void updatePlayer(Player* player, u16 keys, const Level* level) {
         player->trailFadeTimer++;
     }
 
-    // Climb no move timer
-    if (player->climbNoMoveTimer > 0) {
-        player->climbNoMoveTimer--;
-    }
-
-    // Wall boost timer
-    if (player->wallBoostTimer > 0) {
-        player->wallBoostTimer--;
-        // Wall Boost (Celeste line 689-698)
-        // After climb jump with no horizontal input, pressing away from wall converts to wall jump
+    // Wall Boost (Celeste line 689-698), including the frame the window closes
+    // After climb jump with no horizontal input, pressing away from wall converts to wall jump
+    if (timerWasActive(player, player->wallBoostUntil)) {
         int moveX = inputMoveX(keys);
         if (moveX == player->wallBoostDir) {
             // Convert climb jump to wall jump and refund stamina
             player->vx = player->wallBoostDir * WALL_JUMP_H_SPEED;
             player->stamina += CLIMB_JUMP_COST;
-            player->wallBoostTimer = 0;
+            player->wallBoostUntil = TIMER_OFF;
         }
     }
 
-    // Force move X timer (Celeste line 762)
-    if (player->forceMoveXTimer > 0) {
-        player->forceMoveXTimer--;
-    }
-
     // Update facing based on input (Celeste line 786-794)
     // This allows reverse hypers: dash one direction, hold opposite direction, jump
     // NOTE: Does NOT update during climb, RedDash, HitSquash, or pickup
@@ -196,7 +214,9 @@ void updatePlayer(Player* player, u16 keys, const Level* level) {
     int prevVx = player->vx;
     int prevVy = player->vy;
 
+    COST_PUSH(COST_SUB_COLLISION);
     collideHorizontal(player, level);
+    COST_POP();
 
     // RedDash horizontal collision handling (Celeste line 2445-2449, 2711-2712)
     // If RedDash hits a wall → HitSquash, if hits bounds → Normal
@@ -223,7 +243,7 @@ void updatePlayer(Player* player, u16 keys, const Level* level) {
     // TIMING: Runs pre-vertical-physics to match Celeste (snap at line 920, MoveV at 935).
     // Uses previous frame's onGround (collideVertical hasn't reset it yet).
     // vy >= 0 guard: prevents snap from cancelling a jump set this frame by the state machine.
-    if (!player->onGround && player->dashAttackTimer > 0 && player->dashDirY == 0 && player->vy >= 0) {
+    if (!player->onGround && timerActive(player, player->dashAttackUntil) && player->dashDirY == 0 && player->vy >= 0) {
         int screenX = player->x >> FIXED_SHIFT;
         int screenY = player->y >> FIXED_SHIFT;
         int playerLeft = screenX - PLAYER_WIDTH / 2;
@@ -252,7 +272,9 @@ void updatePlayer(Player* player, u16 keys, const Level* level) {
         }
     }
 
+    COST_PUSH(COST_SUB_COLLISION);
     collideVertical(player, level);
+    COST_POP();
 
     // RedDash vertical collision handling (Celeste line 2634-2638, 2719-2720)
     // If RedDash hits ceiling or floor → HitSquash, if hits bounds → Normal
@@ -328,20 +350,20 @@ void updatePlayer(Player* player, u16 keys, const Level* level) {
 
     // Refill dash when on ground (Celeste line 735-738)
     // MUST happen before buffered jump execution!
-    if (player->dashRefillCooldownTimer == 0 && player->onGround && player->dashes < player->maxDashes) {
+    if (!timerActive(player, player->dashRefillCooldownUntil) && player->onGround && player->dashes < player->maxDashes) {
         player->dashes = player->maxDashes;
     }
 
     // Execute buffered jump on landing (Celeste uses Input.Jump.Pressed logic)
     // This happens AFTER all onGround checks, because it will set onGround = 0
-    if (player->jumpBuffer > 0 && player->onGround) {
+    if (timerActive(player, player->jumpBufferUntil) && player->onGround) {
         player->vy = JUMP_STRENGTH + player->liftBoostY;  // Apply lift boost
         player->vx += player->liftBoostX;  // Apply horizontal lift boost
         player->varJumpSpeed = JUMP_STRENGTH;
-        player->varJumpTimer = VAR_JUMP_TIME;
+        player->varJumpUntil = timerIn(player, VAR_JUMP_TIME);
         player->onGround = 0;
         player->coyoteTime = 0;
-        player->jumpBuffer = 0;
+        player->jumpBufferUntil = TIMER_OFF;
         player->jumpHeld = 1;
         player->autoJump = 0;  // Clear AutoJump when manually jumping
     }
@@ -361,6 +383,11 @@ void updatePlayer(Player* player, u16 keys, const Level* level) {
     // Track wasOnGround for next frame's walk-off detection (Celeste line 1082)
     // MUST be at the end after all processing, so it captures this frame's final onGround state
     player->wasOnGround = player->onGround;
+
+    // An idle frame that changed nothing will change nothing next time either
+    if (quiescent && memcmp(&before, player, sizeof(before)) == 0) {
+        player->asleep = 1;
+    }
 }
 
 // === HELPER FUNCTIONS ===
@@ -383,6 +410,8 @@ void refillStamina(Player* player) {
 
 // Celeste Player.cs line 1844-1876
 void playerBounce(Player* player, int fromY) {
+    wakePlayer(player);
+
     // Move player to spring top (Celeste line 1855)
     // fromY is the spring top Y position in pixels
     // player->y is fixed-point (8 bits fractional)
@@ -402,12 +431,12 @@ void playerBounce(Player* player, int fromY) {
 
     // Reset timers (Celeste line 1861-1867)
     player->coyoteTime = 0;  // jumpGraceTimer
-    player->varJumpTimer = BOUNCE_VAR_JUMP_TIME;
+    player->varJumpUntil = timerIn(player, BOUNCE_VAR_JUMP_TIME);
     player->autoJump = 1;
-    player->autoJumpTimer = BOUNCE_AUTO_JUMP_TIME;
-    player->dashAttackTimer = 0;
+    player->autoJumpUntil = timerIn(player, BOUNCE_AUTO_JUMP_TIME);
+    player->dashAttackUntil = TIMER_OFF;
     player->wallSlideTimer = WALL_SLIDE_TIME;
-    player->wallBoostTimer = 0;
+    player->wallBoostUntil = TIMER_OFF;
 
     // Set velocity (Celeste line 1869)
     player->varJumpSpeed = player->vy = BOUNCE_SPEED;
@@ -416,6 +445,8 @@ void playerBounce(Player* player, int fromY) {
 
 // Celeste Player.cs line 1878-1914
 void playerSuperBounce(Player* player, int fromY) {
+    wakePlayer(player);
+
     // Move player to spring top (Celeste line 1890)
     int playerBottom = (player->y >> FIXED_SHIFT) + PLAYER_RADIUS_Y;
     int offsetY = fromY - playerBottom;
@@ -433,12 +464,12 @@ void playerSuperBounce(Player* player, int fromY) {
 
     // Reset timers (Celeste line 1896-1902)
     player->coyoteTime = 0;  // jumpGraceTimer
-    player->varJumpTimer = SUPER_BOUNCE_VAR_JUMP_TIME;
+    player->varJumpUntil = timerIn(player, SUPER_BOUNCE_VAR_JUMP_TIME);
     player->autoJump = 1;
-    player->autoJumpTimer = 0;  // AutoJumpTimer = 0 (infinite until landing)
-    player->dashAttackTimer = 0;
+    player->autoJumpUntil = TIMER_OFF;  // AutoJumpTimer = 0 (infinite until landing)
+    player->dashAttackUntil = TIMER_OFF;
     player->wallSlideTimer = WALL_SLIDE_TIME;
-    player->wallBoostTimer = 0;
+    player->wallBoostUntil = TIMER_OFF;
 
     // Set velocity (Celeste line 1904-1905)
     player->vx = 0;  // CANCEL horizontal momentum
@@ -447,6 +478,8 @@ void playerSuperBounce(Player* player, int fromY) {
 
 // Celeste Player.cs line 1919-1953
 void playerSideBounce(Player* player, int dir, int fromX, int fromY) {
+    wakePlayer(player);
+
     // Move player to spring position (Celeste line 1924-1928)
     // Vertical: clamp offset to ±4 pixels (Celeste line 1924)
     int playerBottom = (player->y >> FIXED_SHIFT) + PLAYER_RADIUS_Y;
@@ -479,14 +512,14 @@ void playerSideBounce(Player* player, int dir, int fromX, int fromY) {
 
     // Reset timers (Celeste line 1934-1942)
     player->coyoteTime = 0;  // jumpGraceTimer
-    player->varJumpTimer = BOUNCE_VAR_JUMP_TIME;
+    player->varJumpUntil = timerIn(player, BOUNCE_VAR_JUMP_TIME);
     player->autoJump = 1;
-    player->autoJumpTimer = 0;  // AutoJumpTimer = 0 (infinite until landing)
-    player->dashAttackTimer = 0;
+    player->autoJumpUntil = TIMER_OFF;  // AutoJumpTimer = 0 (infinite until landing)
+    player->dashAttackUntil = TIMER_OFF;
     player->wallSlideTimer = WALL_SLIDE_TIME;
     player->forceMoveX = dir;
-    player->forceMoveXTimer = SIDE_BOUNCE_FORCE_MOVE_TIME;
-    player->wallBoostTimer = 0;
+    player->forceMoveXUntil = timerIn(player, SIDE_BOUNCE_FORCE_MOVE_TIME);
+    player->wallBoostUntil = TIMER_OFF;
 
     // Set velocity (Celeste line 1945-1946)
     player->vx = SIDE_BOUNCE_SPEED * dir;
@@ -494,6 +527,8 @@ void playerSideBounce(Player* player, int dir, int fromX, int fromY) {
 }
 
 void playerRedBoost(Player* player, int centerX, int centerY) {
+    wakePlayer(player);
+
     // Celeste RedBoost() (line 3779-3786)
     // Player enters Boost state, physically moves to bubble center, then starts RedDash
 
@@ -513,6 +548,8 @@ void playerRedBoost(Player* player, int centerX, int centerY) {
 }
 
 void playerGreenBoost(Player* player, int centerX, int centerY) {
+    wakePlayer(player);
+
     // Celeste Boost() (line 3770-3777)
     // Player enters Boost state, physically moves to bubble center, then starts regular Dash
 
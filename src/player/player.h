@@ -2,6 +2,7 @@
 #define PLAYER_H
 
 #include "core/game_types.h"
+#include "player/player_timer.h"
 #include "core/game_math.h"
 #include "collision/collision.h"
 
@@ -23,6 +24,26 @@ static inline void hidePlayerDashTrailPositions(Player* player) {
     }
 }
 
+/**
+ * Leave the idle fast path. Call after writing player position, velocity or
+ * state from outside updatePlayer (bounces, boosts, transitions, replay
+ * restarts) so the next update runs the full physics step.
+ */
+static inline void wakePlayer(Player* player) {
+    player->asleep = 0;
+}
+
+#ifdef DESKTOP_BUILD
+// Differential tests clear this to force the full update path every frame.
+extern int g_playerSleepEnabled;
+#endif
+
+// Set while player_predict.c steps a clone. Room connections then only
+// report the exit (g_playerPredictExit) instead of starting a transition,
+// and state changes are not logged.
+extern int g_playerPredicting;
+extern int g_playerPredictExit;
+
 /**
  * Initialize a player at the level spawn point
  *
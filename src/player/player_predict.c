@@ -0,0 +1,178 @@
+#include "player_predict.h"
+#include "player.h"
+#include "core/input.h"
+#include "level/level.h"
+
+void predictStart(Prediction* p, const Player* player, u16 keys, int frames) {
+    p->clone = *player;
+    p->keys = keys;
+    p->frames = (u8)(frames < 0 ? 0 : (frames > PREDICT_MAX_FRAMES ? PREDICT_MAX_FRAMES : frames));
+    p->done = 0;
+    p->leftRoom = 0;
+}
+
+void predictStartDash(Prediction* p, const Player* player, u16 dirKeys, int frames) {
+    predictStart(p, player, (u16)((dirKeys & (BTN_LEFT | BTN_RIGHT | BTN_UP | BTN_DOWN)) | BTN_DASH), frames);
+    p->clone.prevKeys &= (u16)~BTN_DASH;  // make this frame the press
+}
+
+int predictRun(Prediction* p, const Level* level, int maxSteps) {
+#if COLLISION_DEBUG_ENABLED
+    // The probe overlay shows the real player's frame only
+    int probes = g_colDebugProbeCount;
+#endif
+    g_playerPredicting = 1;
+    for (int i = 0; i < maxSteps && !predictComplete(p); i++) {
+        g_playerPredictExit = 0;
+        updatePlayer(&p->clone, p->keys, level);
+        if (g_playerPredictExit) {
+            p->leftRoom = 1;
+            break;
+        }
+        int n = p->done++;
+        p->pathX[n] = (s16)(p->clone.x >> FIXED_SHIFT);
+        p->pathY[n] = (s16)(p->clone.y >> FIXED_SHIFT);
+        p->state[n] = (u8)p->clone.stateMachine.state;
+    }
+    g_playerPredicting = 0;
+#if COLLISION_DEBUG_ENABLED
+    g_colDebugProbeCount = probes;
+#endif
+    return predictComplete(p);
+}
+
+// Player fields compared as they are by predictSameSource
+#define PREDICT_SOURCE_FIELDS(X) \
+    X(prevKeys) X(x) X(y) X(vx) X(vy) X(maxFall) X(onGround) X(wasOnGround) \
+    X(coyoteTime) X(jumpHeld) X(autoJump) X(liftBoostX) X(liftBoostY) \
+    X(varJumpSpeed) X(dashing) X(dashes) X(maxDashes) X(facingRight) \
+    X(wallSlideTimer) X(wallSlideDir) X(dashDirX) X(dashDirY) \
+    X(beforeDashSpeedX) X(ducking) X(lastAimX) X(lastAimY) X(stamina) \
+    X(lastClimbMove) X(wallBoostDir) X(hopWaitX) X(hopWaitXSpeed) \
+    X(forceMoveX) X(hitSquashNoMoveTimer) X(boostTargetX) X(boostTargetY) \
+    X(boostRed) X(boostTimer) X(currentBubbleX) X(currentBubbleY) \
+    X(stateMachine.state) X(stateMachine.previousState) X(asleep)
+
+int predictSameSource(const Player* a, const Player* b) {
+#define PREDICT_SAME_FIELD(f) if (a->f != b->f) return 0;
+#define PREDICT_SAME_TIMER(f) if (timerRemaining(a, a->f) != timerRemaining(b, b->f)) return 0;
+    PREDICT_SOURCE_FIELDS(PREDICT_SAME_FIELD)
+    PLAYER_DEADLINES(PREDICT_SAME_TIMER)
+#undef PREDICT_SAME_FIELD
+#undef PREDICT_SAME_TIMER
+    return 1;
+}
+
+#if PREDICT_OVERLAY_ENABLED && !defined(DESKTOP_BUILD)
+
+#include "core/assets.h"
+#include "core/vblank_queue.h"
+#include "core/vram_layout.h"
+#include "player/state.h"
+#include "transition/transition.h"
+
+#define PREDICT_OVERLAY_FRAMES 36
+
+#define DOT_ROW(c) ((u32)(c) << 12 | (u32)(c) << 16)  // pixels 3-4
+#define DOT_TILE(c) { 0, 0, 0, DOT_ROW(c), DOT_ROW(c), 0, 0, 0 }
+
+static const u32 s_dotTiles[2][8] = {
+    DOT_TILE(1),
+    DOT_TILE(2),
+};
+
+static const u16 s_palette[16] = {
+    0,
+    RGB15(31, 31, 31),  // ST_NORMAL
+    RGB15(31, 12, 24),  // dashing, climbing, boosting...
+};
+
+static Prediction s_pred;
+static Player s_source;
+static const Level* s_level = NULL;
+static int s_active = 0;    // s_pred is a path for s_source / s_level
+static u16 s_stepTicks = 1; // worst single step seen
+
+static int s_dotCount = 0;
+static s16 s_dotX[OAM_PREDICT_COUNT];
+static s16 s_dotY[OAM_PREDICT_COUNT];
+static u8 s_dotTile[OAM_PREDICT_COUNT];
+
+void predictOverlayInit(void) {
+    AssetEntry entries[] = {
+        { "predict dots",    ASSET_COPY, s_dotTiles, &tile_mem[4][TILE_OBJ_PREDICT], sizeof(s_dotTiles), 0 },
+        { "predict palette", ASSET_COPY, s_palette,  &pal_obj_mem[PAL_OBJ_PREDICT * 16], sizeof(s_palette), 0 },
+    };
+    assetLoad(entries, sizeof(entries) / sizeof(entries[0]));
+    predictOverlayHide();
+}
+
+// Thin the finished path out to the dots OAM has room for, always keeping
+// its last frame.
+static void publishPath(void) {
+    int frames = s_pred.done;
+    int stride = (frames + OAM_PREDICT_COUNT - 1) / OAM_PREDICT_COUNT;
+    if (stride < 1) stride = 1;
+    s_dotCount = 0;
+    for (int f = frames - 1; f >= 0 && s_dotCount < OAM_PREDICT_COUNT; f -= stride) {
+        s_dotX[s_dotCount] = s_pred.pathX[f];
+        s_dotY[s_dotCount] = s_pred.pathY[f];
+        s_dotTile[s_dotCount] = (u8)(s_pred.state[f] == ST_NORMAL ? 0 : 1);
+        s_dotCount++;
+    }
+}
+
+void predictOverlayUpdate(const Player* player, u16 keys, const Level* level,
+                          int cameraX, int cameraY, int ticksLeft) {
+    if (!level || isTransitioning()) {
+        predictOverlayHide();
+        return;
+    }
+
+    if (!s_active || level != s_level ||
+        (predictComplete(&s_pred) &&
+         (keys != s_pred.keys || !predictSameSource(player, &s_source)))) {
+        if (level != s_level) s_dotCount = 0;
+        s_source = *player;
+        s_level = level;
+        predictStart(&s_pred, player, keys, PREDICT_OVERLAY_FRAMES);
+        s_active = 1;
+    }
+
+    if (!predictComplete(&s_pred)) {
+        u16 start = REG_TM0CNT_L;
+        while ((int)(u16)(REG_TM0CNT_L - start) + s_stepTicks <= ticksLeft) {
+            u16 t = REG_TM0CNT_L;
+            int complete = predictRun(&s_pred, level, 1);
+            u16 dt = (u16)(REG_TM0CNT_L - t);
+            if (dt > s_stepTicks) s_stepTicks = dt;
+            if (complete) {
+                publishPath();
+                break;
+            }
+        }
+    }
+
+    for (int i = 0; i < OAM_PREDICT_COUNT; i++) {
+        OBJ_ATTR* obj = &g_oamShadow[OAM_PREDICT_BASE + i];
+        int x = i < s_dotCount ? s_dotX[i] - 4 - cameraX : -8;
+        int y = i < s_dotCount ? s_dotY[i] - 4 - cameraY : -8;
+        if (x <= -8 || x >= 240 || y <= -8 || y >= 160) {
+            obj->attr0 = 160;  // Y offscreen
+            continue;
+        }
+        obj->attr0 = (u16)(y & 0xFF);
+        obj->attr1 = (u16)(x & 0x1FF);
+        obj->attr2 = (u16)((TILE_OBJ_PREDICT + s_dotTile[i]) | (1 << 10) | (PAL_OBJ_PREDICT << 12));
+    }
+}
+
+void predictOverlayHide(void) {
+    s_active = 0;
+    s_dotCount = 0;
+    for (int i = 0; i < OAM_PREDICT_COUNT; i++) {
+        g_oamShadow[OAM_PREDICT_BASE + i].attr0 = 160;
+    }
+}
+
+#endif // PREDICT_OVERLAY_ENABLED && !DESKTOP_BUILD
@@ -0,0 +1,81 @@
+#ifndef PLAYER_PREDICT_H
+#define PLAYER_PREDICT_H
+
+#include "core/game_types.h"
+
+// Trajectory prediction: updatePlayer run on a copy of the player for the
+// next N frames under fixed input, against the level alone. Entities are not
+// stepped, and a room connection ends the path instead of starting a
+// transition, so predicting never touches anything but the Prediction.
+//
+// Stepping is incremental (predictRun takes a step budget), so a long path
+// can be spread over the slack of several frames.
+
+#ifndef PREDICT_OVERLAY_ENABLED
+#define PREDICT_OVERLAY_ENABLED 0
+#endif
+
+#define PREDICT_MAX_FRAMES 60
+
+typedef struct {
+    Player clone;
+    u16 keys;          // held every predicted frame
+    u8 frames;         // requested
+    u8 done;           // simulated so far
+    u8 leftRoom;       // path reached a room connection and stops there
+    u8 pad[3];
+    s16 pathX[PREDICT_MAX_FRAMES];   // player centre after each frame, level pixels
+    s16 pathY[PREDICT_MAX_FRAMES];
+    u8 state[PREDICT_MAX_FRAMES];    // ST_* after each frame
+} Prediction;
+
+/**
+ * Predict holding keys for the next frames (clamped to PREDICT_MAX_FRAMES).
+ * Edge-triggered actions behave exactly as they would for the real player:
+ * a button already held is not pressed again.
+ */
+void predictStart(Prediction* p, const Player* player, u16 keys, int frames);
+
+/**
+ * Predict a dash this frame in the direction of dirKeys (BTN_LEFT/RIGHT/
+ * UP/DOWN, none = facing), with the direction then held.
+ */
+void predictStartDash(Prediction* p, const Player* player, u16 dirKeys, int frames);
+
+/**
+ * Simulate up to maxSteps more frames.
+ *
+ * @return 1 once the path is complete (all frames, or it left the room)
+ */
+int predictRun(Prediction* p, const Level* level, int maxSteps);
+
+static inline int predictComplete(const Prediction* p) {
+    return p->done >= p->frames || p->leftRoom;
+}
+
+/**
+ * Whether a and b predict the same path under the same keys: every field
+ * updatePlayer reads is equal, with timers compared as time left rather than
+ * as deadlines on each player's own clock. The dash trail (drawing only) and
+ * the state callbacks (set by initPlayer) are not compared.
+ */
+int predictSameSource(const Player* a, const Player* b);
+
+#if PREDICT_OVERLAY_ENABLED && !defined(DESKTOP_BUILD)
+// Dot tiles and palette (boot).
+void predictOverlayInit(void);
+
+/**
+ * Keep a path for the currently held keys up to date and draw it as dots
+ * (make PREDICT=1). Steps the prediction only while the frame has used less
+ * than ticksLeft more TM0 ticks, restarts it once complete if the keys have
+ * changed or the player has (predictSameSource), and places the last complete path relative to the
+ * camera every call.
+ */
+void predictOverlayUpdate(const Player* player, u16 keys, const Level* level,
+                          int cameraX, int cameraY, int ticksLeft);
+
+void predictOverlayHide(void);
+#endif
+
+#endif // PLAYER_PREDICT_H
@@ -1,5 +1,7 @@
 #include "player_render.h"
 #include "core/vram_layout.h"
+#include "core/vblank_queue.h"
+#include "core/quality.h"
 #include <tonc.h>
 
 void drawPlayer(Player* player, Camera* camera, u16 objPriority) {
@@ -7,15 +9,17 @@ void drawPlayer(Player* player, Camera* camera, u16 objPriority) {
 
     // Draw dash trail (sprites 1-3)
     // Trail sprites: 0=first (oldest), 1=middle, 2=last (newest/closest to player)
+    // The quality governor may hide them; the trail itself keeps simulating.
+    int showTrail = !qualityShedding(QUALITY_SHED_TRAIL);
     for (int i = 0; i < TRAIL_LENGTH; i++) {
         // Only show trail if actively dashing or still fading
-        if (player->dashing > 0 || player->trailFadeTimer < TRAIL_LENGTH * 8) {
+        if (showTrail && (player->dashing > 0 || player->trailFadeTimer < TRAIL_LENGTH * 8)) {
             int trailScreenX = (player->trailX[i] >> FIXED_SHIFT) - camera->x - 8;
             int trailScreenY = (player->trailY[i] >> FIXED_SHIFT) - camera->y - 8;
 
             // Hide if not initialized or off screen (we use -1000 as sentinel value)
             if (trailScreenX <= -1000 || trailScreenX > 239 || trailScreenY <= -1000 || trailScreenY > 159) {
-                oam_mem[i + 1].attr0 = 160 << 0;  // Hide sprite
+                g_oamShadow[i + 1].attr0 = 160 << 0;  // Hide sprite
             } else {
                 // Calculate progressive fade: base age + fade progress
                 // Base age: sprite 0 (oldest) = 3, sprite 1 = 2, sprite 2 (newest) = 1
@@ -27,19 +31,19 @@ void drawPlayer(Player* player, Camera* camera, u16 objPriority) {
 
                 // Hide sprite only after it reaches max palette (fully faded)
                 if (paletteNum > PAL_OBJ_TRAIL_COUNT) {
-                    oam_mem[i + 1].attr0 = 160 << 0;  // Hide sprite
+                    g_oamShadow[i + 1].attr0 = 160 << 0;  // Hide sprite
                 } else {
                     // Clamp to available palettes (1-10)
                     if (paletteNum < 1) paletteNum = 1;
 
                     // Use progressively lighter palettes for gradual fade effect
-                    oam_mem[i + 1].attr0 = (trailScreenY & 0xFF) | (1 << 10);  // Semi-transparent mode
-                    oam_mem[i + 1].attr1 = (trailScreenX & 0x1FF) | (1 << 14) | (player->trailFacing[i] ? 0 : (1 << 12));
-                    oam_mem[i + 1].attr2 = (paletteNum << 12) | (objPriority << 10);
+                    g_oamShadow[i + 1].attr0 = (trailScreenY & 0xFF) | (1 << 10);  // Semi-transparent mode
+                    g_oamShadow[i + 1].attr1 = (trailScreenX & 0x1FF) | (1 << 14) | (player->trailFacing[i] ? 0 : (1 << 12));
+                    g_oamShadow[i + 1].attr2 = (paletteNum << 12) | (objPriority << 10);
                 }
             }
         } else {
-            oam_mem[i + 1].attr0 = 160 << 0;  // Hide sprite
+            g_oamShadow[i + 1].attr0 = 160 << 0;  // Hide sprite
         }
     }
 
@@ -55,7 +59,7 @@ void drawPlayer(Player* player, Camera* camera, u16 objPriority) {
 
     // Update sprite position (16x16, 16-color mode, palette 0, normal/opaque mode)
     // Clear bits 10-11 to ensure normal mode (not semi-transparent)
-    oam_mem[0].attr0 = (screenY & 0xFF) | (0 << 10);   // attr0: Y position (8 bits), bits 10-11 = 00 (normal mode)
-    oam_mem[0].attr1 = (screenX & 0x1FF) | (1 << 14) | (player->facingRight ? 0 : (1 << 12));   // attr1: X position (9 bits masked) + size 16x16 + H-flip if facing left
-    oam_mem[0].attr2 = (objPriority << 10);    // attr2: tile 0, palette 0, configurable priority
+    g_oamShadow[0].attr0 = (screenY & 0xFF) | (0 << 10);   // attr0: Y position (8 bits), bits 10-11 = 00 (normal mode)
+    g_oamShadow[0].attr1 = (screenX & 0x1FF) | (1 << 14) | (player->facingRight ? 0 : (1 << 12));   // attr1: X position (9 bits masked) + size 16x16 + H-flip if facing left
+    g_oamShadow[0].attr2 = (objPriority << 10);    // attr2: tile 0, palette 0, configurable priority
 }
@@ -0,0 +1,62 @@
+#ifndef PLAYER_TIMER_H
+#define PLAYER_TIMER_H
+
+#include "core/game_types.h"
+
+// Gameplay timers as deadlines.
+//
+// player->clock counts the frames updatePlayer has run for this player (it
+// stands still during transitions, like the player). A timer holds the clock
+// value it runs out at, so nothing has to tick it: it is active while the
+// deadline is ahead of the clock. Because the clock lives in the Player, a
+// copy (snapshot, replay restart, prediction clone) keeps every timer's
+// remaining time.
+
+#define TIMER_OFF 0
+
+// The clock and deadlines are u16. Once the clock reaches TIMER_REBASE_AT
+// (about 4.5 minutes of play), timerRebase moves it and every live deadline
+// back by TIMER_REBASE_BY. Only differences matter, so no timer changes;
+// the longest timer is a few hundred frames, so nothing gets near 65536.
+#define TIMER_REBASE_AT 0x4000
+#define TIMER_REBASE_BY 0x2000
+
+// Every deadline field of Player
+#define PLAYER_DEADLINES(X) \
+    X(jumpBufferUntil) X(autoJumpUntil) X(varJumpUntil) X(dashCooldownUntil) \
+    X(dashRefillCooldownUntil) X(dashAttackUntil) X(climbNoMoveUntil) \
+    X(wallBoostUntil) X(forceMoveXUntil)
+
+// Deadline for a timer that should stay active for the next `frames` frames.
+static inline int timerIn(const Player* player, int frames) {
+    return player->clock + frames;
+}
+
+static inline int timerActive(const Player* player, int deadline) {
+    return deadline > player->clock;
+}
+
+static inline int timerRemaining(const Player* player, int deadline) {
+    return deadline > player->clock ? deadline - player->clock : 0;
+}
+
+// Active when this frame began, including the frame it runs out on (for
+// checks that Celeste makes before ticking the timer). Only meaningful
+// inside updatePlayer, after the clock has advanced.
+static inline int timerWasActive(const Player* player, int deadline) {
+    return deadline >= player->clock;
+}
+
+// Call right after advancing the clock. Deadlines already behind it are
+// inactive either way and become TIMER_OFF; the rest, including one that
+// runs out this frame (timerWasActive), keep their distance to the clock.
+static inline void timerRebase(Player* player) {
+    if (player->clock < TIMER_REBASE_AT) return;
+#define TIMER_REBASE_FIELD(f) \
+    player->f = player->f >= player->clock ? (u16)(player->f - TIMER_REBASE_BY) : TIMER_OFF;
+    PLAYER_DEADLINES(TIMER_REBASE_FIELD)
+#undef TIMER_REBASE_FIELD
+    player->clock -= TIMER_REBASE_BY;
+}
+
+#endif // PLAYER_TIMER_H
@@ -1,5 +1,7 @@
 #include "state.h"
 #include <string.h>
+#include "core/log.h"
+#include "player/player.h"
 
 void initStateMachine(StateMachine* sm) {
     sm->state = ST_NORMAL;
@@ -35,6 +37,9 @@ void setState(StateMachine* sm, int newState, Player* player, const Level* level
     if (newState == sm->state) {
         return;
     }
+    if (!g_playerPredicting) {
+        LOG2(LOG_PLAYER_STATE, sm->state, newState);
+    }
 
     // Call current state's end callback
     if (sm->callbacks[sm->state].end) {
@@ -2,6 +2,7 @@
 #define PLAYER_STATE_H
 
 #include "core/game_types.h"
+#include "player/player_timer.h"
 #include "level/level.h"
 
 // State constants (matching Celeste's Player.cs)
@@ -55,7 +56,7 @@ void boostBegin(Player* player, const Level* level);
 void boostEnd(Player* player);
 
 // Shared helper functions (used by multiple states)
-void jump(Player* player, u16 keys);
-void wallJump(Player* player, int dir, int moveX);
+void jump(Player* player, u16 keys, const Level* level);
+void wallJump(Player* player, int dir, int moveX, const Level* level);
 
 #endif
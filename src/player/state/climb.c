@@ -5,7 +5,7 @@
 #include "core/input.h"
 
 // Forward declarations
-static void climbJump(Player* player, u16 keys);
+static void climbJump(Player* player, u16 keys, const Level* level);
 static void climbHop(Player* player, const Level* level);
 static int slipCheck(const Player* player, const Level* level, int addY);
 
@@ -15,9 +15,9 @@ void climbBegin(Player* player, const Level* level) {
     player->vx = 0;
     player->vy = fpMul(player->vy, FP_CLIMB_GRAB_Y_MULT);
     player->wallSlideTimer = WALL_SLIDE_TIME;
-    player->climbNoMoveTimer = CLIMB_NO_MOVE_TIME;
+    player->climbNoMoveUntil = timerIn(player, CLIMB_NO_MOVE_TIME);
     player->lastClimbMove = 0;
-    player->wallBoostTimer = 0;
+    player->wallBoostUntil = TIMER_OFF;
 
     // Wall snapping (Celeste line 3068-3072)
     // Move player closer to wall, up to ClimbCheckDist pixels
@@ -59,16 +59,16 @@ int climbUpdate(Player* player, u16 keys, const Level* level) {
     if (pressed & BTN_JUMP) {
         if (moveX == -facingDir) {
             // Jump away from wall
-            wallJump(player, -facingDir, moveX);
+            wallJump(player, -facingDir, moveX, level);
         } else {
             // Climb jump (jump up while staying on wall)
-            climbJump(player, keys);
+            climbJump(player, keys, level);
         }
         return ST_NORMAL;
     }
 
     // Dashing (Celeste line 3121-3126)
-    if ((pressed & BTN_DASH) && player->dashCooldownTimer == 0 && player->dashes > 0) {
+    if ((pressed & BTN_DASH) && !timerActive(player, player->dashCooldownUntil) && player->dashes > 0) {
         player->dashes = player->dashes > 0 ? player->dashes - 1 : 0;
         return ST_DASH;
     }
@@ -91,7 +91,7 @@ int climbUpdate(Player* player, u16 keys, const Level* level) {
     int target = 0;
     int trySlip = 0;
 
-    if (player->climbNoMoveTimer <= 0) {
+    if (!timerActive(player, player->climbNoMoveUntil)) {
         if (moveY == -1) {
             // Climbing up
             target = CLIMB_UP_SPEED;
@@ -149,7 +149,7 @@ int climbUpdate(Player* player, u16 keys, const Level* level) {
     }
 
     // Stamina drain (Celeste line 3238-3267)
-    if (player->climbNoMoveTimer <= 0) {
+    if (!timerActive(player, player->climbNoMoveUntil)) {
         if (player->lastClimbMove == -1) {
             // Climbing up costs stamina
             player->stamina -= CLIMB_UP_COST_PF;
@@ -169,7 +169,7 @@ int climbUpdate(Player* player, u16 keys, const Level* level) {
 }
 
 // Helper: Climb Jump (Celeste line 1813-1842)
-static void climbJump(Player* player, u16 keys) {
+static void climbJump(Player* player, u16 keys, const Level* level) {
     int moveX = inputMoveX(keys);
 
     // Consume stamina (Celeste line 1817)
@@ -178,7 +178,7 @@ static void climbJump(Player* player, u16 keys) {
     }
 
     // Normal jump
-    player->ducking = 0;
+    tryUnduck(player, level);
     player->vy = JUMP_STRENGTH;
 
     // Apply lift boost from moving platforms (Celeste line 1825)
@@ -186,12 +186,12 @@ static void climbJump(Player* player, u16 keys) {
     player->vy += player->liftBoostY;
 
     player->varJumpSpeed = JUMP_STRENGTH;
-    player->varJumpTimer = VAR_JUMP_TIME;
+    player->varJumpUntil = timerIn(player, VAR_JUMP_TIME);
     player->autoJump = 0;  // Clear AutoJump (Celeste line 1818)
     player->wallSlideTimer = WALL_SLIDE_TIME;
     player->onGround = 0;
     player->coyoteTime = 0;
-    player->jumpBuffer = 0;
+    player->jumpBufferUntil = TIMER_OFF;
     player->jumpHeld = 1;
 
     // If no horizontal input, boost away from wall (Celeste line 1826-1830)
@@ -202,7 +202,7 @@ static void climbJump(Player* player, u16 keys) {
 
         // Wall boost setup (Celeste line 1828-1829)
         player->wallBoostDir = -facingDir;  // Direction opposite to facing
-        player->wallBoostTimer = CLIMB_JUMP_BOOST_TIME;
+        player->wallBoostUntil = timerIn(player, CLIMB_JUMP_BOOST_TIME);
     }
 }
 
@@ -233,7 +233,7 @@ static void climbHop(Player* player, const Level* level) {
 
     // forceMoveX = 0; forceMoveXTimer = ClimbHopForceTime; (line 3309-3310)
     player->forceMoveX = 0;
-    player->forceMoveXTimer = CLIMB_HOP_FORCE_TIME;
+    player->forceMoveXUntil = timerIn(player, CLIMB_HOP_FORCE_TIME);
 
     // fastJump = false; noWindTimer = ClimbHopNoWindTime; (line 3311-3312) - skip for GBA
     // Play(Sfxs.char_mad_climb_ledge); (line 3313) - audio, skip for GBA
@@ -6,18 +6,17 @@
 #include "core/input.h"
 
 // Forward declarations
-static void superJump(Player* player);
-static void superWallJump(Player* player, int dir);
+static void superJump(Player* player, const Level* level);
+static void superWallJump(Player* player, int dir, const Level* level);
 
 void dashBegin(Player* player, const Level* level) {
     // Celeste DashBegin (line 3442-3467)
-    (void)level;  // Unused in dash state
     player->beforeDashSpeedX = player->vx;
-    player->dashCooldownTimer = DASH_COOLDOWN_TIME;
-    player->dashRefillCooldownTimer = DASH_REFILL_COOLDOWN_TIME;
+    player->dashCooldownUntil = timerIn(player, DASH_COOLDOWN_TIME);
+    player->dashRefillCooldownUntil = timerIn(player, DASH_REFILL_COOLDOWN_TIME);
     player->wallSlideTimer = WALL_SLIDE_TIME;
-    player->dashAttackTimer = DASH_ATTACK_TIME;
-    player->wallBoostTimer = 0;
+    player->dashAttackUntil = timerIn(player, DASH_ATTACK_TIME);
+    player->wallBoostUntil = TIMER_OFF;
 
     // Zero speed initially (Celeste line 3462)
     // The actual dash speed is set after collision (matching yield return null)
@@ -27,8 +26,8 @@ void dashBegin(Player* player, const Level* level) {
     player->dashDirY = 0;
 
     // Unduck if in air (Celeste line 3465-3466)
-    if (!player->onGround && player->ducking) {
-        player->ducking = 0;
+    if (!player->onGround) {
+        tryUnduck(player, level);
     }
 
     // Initialize dash timer (0.15s = 9 frames)
@@ -160,7 +159,7 @@ int dashUpdate(Player* player, u16 keys, const Level* level) {
         }
 
         if ((pressed & BTN_JUMP) && (player->onGround || player->coyoteTime > 0)) {
-            superJump(player);
+            superJump(player, level);
             return ST_NORMAL;
         }
     }
@@ -169,10 +168,10 @@ int dashUpdate(Player* player, u16 keys, const Level* level) {
     else if (player->dashDirX == 0 && player->dashDirY == -1) {
         if (pressed & BTN_JUMP) {
             if (checkWall(player, level, 1)) {
-                superWallJump(player, -1);
+                superWallJump(player, -1, level);
                 return ST_NORMAL;
             } else if (checkWall(player, level, -1)) {
-                superWallJump(player, 1);
+                superWallJump(player, 1, level);
                 return ST_NORMAL;
             }
         }
@@ -182,10 +181,10 @@ int dashUpdate(Player* player, u16 keys, const Level* level) {
     else if (player->dashDirX != 0 || player->dashDirY != 0) {
         if (pressed & BTN_JUMP) {
             if (checkWall(player, level, 1)) {
-                wallJump(player, -1, moveX);
+                wallJump(player, -1, moveX, level);
                 return ST_NORMAL;
             } else if (checkWall(player, level, -1)) {
-                wallJump(player, 1, moveX);
+                wallJump(player, 1, moveX, level);
                 return ST_NORMAL;
             }
         }
@@ -207,7 +206,7 @@ int dashUpdate(Player* player, u16 keys, const Level* level) {
 
             // Set AutoJump for landing after dash (Celeste line 3623-3624)
             player->autoJump = 1;
-            player->autoJumpTimer = 0;  // 0 means infinite, stays until landing
+            player->autoJumpUntil = TIMER_OFF;  // No deadline: stays until landing
 
             // Set end dash speed (Celeste line 3625-3632)
             if (player->dashDirY <= 0) {
@@ -228,7 +227,7 @@ int dashUpdate(Player* player, u16 keys, const Level* level) {
 }
 
 // Helper: Super Jump (Celeste SuperJump() around line 2200+)
-static void superJump(Player* player) {
+static void superJump(Player* player, const Level* level) {
     int facingDir = player->facingRight ? 1 : -1;
 
     player->vx = facingDir * SUPER_JUMP_H;
@@ -240,26 +239,26 @@ static void superJump(Player* player) {
 
     // Duck multipliers (Celeste line 2229+)
     if (player->ducking) {
-        player->ducking = 0;
+        tryUnduck(player, level);
         player->vx = fpMul(player->vx, FP_DUCK_JUMP_X_MULT);
         player->vy = fpMul(player->vy, FP_DUCK_JUMP_Y_MULT);
     }
 
     player->varJumpSpeed = player->vy;
-    player->varJumpTimer = VAR_JUMP_TIME;
+    player->varJumpUntil = timerIn(player, VAR_JUMP_TIME);
     player->autoJump = 0;  // Clear AutoJump (Celeste line 1700)
     player->wallSlideTimer = WALL_SLIDE_TIME;
-    player->dashAttackTimer = 0;
+    player->dashAttackUntil = TIMER_OFF;
     player->dashing = 0;  // End dash so trail can fade
     player->onGround = 0;
     player->coyoteTime = 0;
-    player->jumpBuffer = 0;
+    player->jumpBufferUntil = TIMER_OFF;
     player->jumpHeld = 1;
 }
 
 // Helper: Super Wall Jump (Celeste SuperWallJump() around line 2250+)
-static void superWallJump(Player* player, int dir) {
-    player->ducking = 0;
+static void superWallJump(Player* player, int dir, const Level* level) {
+    tryUnduck(player, level);
     player->vx = dir * SUPER_WALL_JUMP_H;
     player->vy = SUPER_WALL_JUMP_SPEED;
 
@@ -268,13 +267,13 @@ static void superWallJump(Player* player, int dir) {
     player->vy += player->liftBoostY;
 
     player->varJumpSpeed = SUPER_WALL_JUMP_SPEED;
-    player->varJumpTimer = SUPER_WALL_JUMP_VAR_TIME;
+    player->varJumpUntil = timerIn(player, SUPER_WALL_JUMP_VAR_TIME);
     player->autoJump = 0;  // Clear AutoJump (Celeste line 1790)
     player->wallSlideTimer = WALL_SLIDE_TIME;
-    player->dashAttackTimer = 0;
+    player->dashAttackUntil = TIMER_OFF;
     player->dashing = 0;  // End dash so trail can fade
     player->coyoteTime = 0;
-    player->jumpBuffer = 0;
+    player->jumpBufferUntil = TIMER_OFF;
     player->jumpHeld = 1;
     player->facingRight = dir > 0 ? 1 : 0;
 }
@@ -29,25 +29,25 @@ int hitSquashUpdate(Player* player, u16 keys, const Level* level) {
     if (pressed & BTN_JUMP) {
         if (player->onGround) {
             // Ground jump (Celeste line 3951)
-            jump(player, keys);
+            jump(player, keys, level);
             return ST_NORMAL;
         } else if (checkWall(player, level, 1)) {
             // Wall jump left (Celeste line 3952-3953)
-            wallJump(player, -1, moveX);
+            wallJump(player, -1, moveX, level);
             return ST_NORMAL;
         } else if (checkWall(player, level, -1)) {
             // Wall jump right (Celeste line 3954-3955)
-            wallJump(player, 1, moveX);
+            wallJump(player, 1, moveX, level);
             return ST_NORMAL;
         } else {
             // Consume buffer if can't jump (Celeste line 3957)
-            player->jumpBuffer = 0;
+            player->jumpBufferUntil = TIMER_OFF;
         }
     }
 
     // Check for dash (Celeste line 3962-3963)
     // Note: Need to check if can dash (dashes > 0, cooldown == 0)
-    if ((pressed & BTN_DASH) && player->dashes > 0 && player->dashCooldownTimer == 0) {
+    if ((pressed & BTN_DASH) && player->dashes > 0 && !timerActive(player, player->dashCooldownUntil)) {
         // Consume dash
         player->dashes = player->dashes > 0 ? player->dashes - 1 : 0;
         return ST_DASH;
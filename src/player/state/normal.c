@@ -21,7 +21,7 @@ int normalUpdate(Player* player, u16 keys, const Level* level) {
     int moveX = inputMoveX(keys);
 
     // Force Move X - overrides input after climb hop (Celeste line 760-764)
-    if (player->forceMoveXTimer > 0) {
+    if (timerActive(player, player->forceMoveXUntil)) {
         moveX = player->forceMoveX;
     }
 
@@ -32,7 +32,7 @@ int normalUpdate(Player* player, u16 keys, const Level* level) {
 
     // Dashing (Celeste line 2824-2828)
     // Check if can dash and dash button pressed
-    if ((pressed & BTN_DASH) && player->dashCooldownTimer == 0 && player->dashes > 0) {
+    if ((pressed & BTN_DASH) && !timerActive(player, player->dashCooldownUntil) && player->dashes > 0) {
         // Consume dash (Celeste StartDash() line 3408)
         player->dashes = player->dashes > 0 ? player->dashes - 1 : 0;
         // Return to dash state (will trigger dashBegin via state machine)
@@ -95,7 +95,7 @@ int normalUpdate(Player* player, u16 keys, const Level* level) {
         int facingDir = player->facingRight ? 1 : -1;
         if ((moveX == facingDir || (moveX == 0 && (keys & BTN_GRAB))) && !(keys & BTN_DOWN)) {
             if (player->vy >= 0 && player->wallSlideTimer > 0 && checkWall(player, level, facingDir)) {
-                player->ducking = 0;
+                tryUnduck(player, level);
                 player->wallSlideDir = facingDir;
             }
 
@@ -125,18 +125,18 @@ int normalUpdate(Player* player, u16 keys, const Level* level) {
 
     // Variable Jumping (Celeste line 2960-2967)
     // AutoJump simulates holding jump button for maintained jump height
-    if (player->varJumpTimer > 0) {
+    if (timerActive(player, player->varJumpUntil)) {
         if ((keys & BTN_JUMP) || player->autoJump) {
             player->vy = player->vy < player->varJumpSpeed ? player->vy : player->varJumpSpeed;
         } else {
-            player->varJumpTimer = 0;
+            player->varJumpUntil = TIMER_OFF;
         }
     }
 
     // Climbing (Celeste line 2800-2819)
-    // CheckStamina logic (Celeste line 3035-3042): account for wallBoostTimer
+    // CheckStamina logic (Celeste line 3035-3042): account for the wall boost window
     int checkStamina = player->stamina;
-    if (player->wallBoostTimer > 0) {
+    if (timerActive(player, player->wallBoostUntil)) {
         checkStamina += CLIMB_JUMP_COST;
     }
 
@@ -148,7 +148,7 @@ int normalUpdate(Player* player, u16 keys, const Level* level) {
         int speedDir = player->vx > 0 ? 1 : (player->vx < 0 ? -1 : 0);
         if (player->vy >= 0 && speedDir != -facingDir) {
             if (checkWallAt(player, level, facingDir, 0, CLIMB_CHECK_DIST)) {
-                player->ducking = 0;
+                tryUnduck(player, level);
                 return ST_CLIMB;
             }
 
@@ -157,7 +157,7 @@ int normalUpdate(Player* player, u16 keys, const Level* level) {
                     if (!isPositionCollidingAt(level, player->x >> FIXED_SHIFT, (player->y >> FIXED_SHIFT) - i) &&
                         checkWallAt(player, level, facingDir, -i, CLIMB_CHECK_DIST)) {
                         player->y -= i << FIXED_SHIFT;
-                        player->ducking = 0;
+                        tryUnduck(player, level);
                         return ST_CLIMB;
                     }
                 }
@@ -169,19 +169,19 @@ int normalUpdate(Player* player, u16 keys, const Level* level) {
     if (pressed & BTN_JUMP) {
         if (player->coyoteTime > 0) {
             // Normal jump
-            jump(player, keys);
+            jump(player, keys, level);
         } else {
             // Wall jump checks (Celeste line 2977-2997)
             // Note: Super wall jumps during dash attack are handled in dash state
             if (checkWall(player, level, 1)) {
                 // Wall on right
-                wallJump(player, -1, moveX);
+                wallJump(player, -1, moveX, level);
             } else if (checkWall(player, level, -1)) {
                 // Wall on left
-                wallJump(player, 1, moveX);
+                wallJump(player, 1, moveX, level);
             } else {
                 // Buffer jump for later (not in shown Celeste code, but in Jump() method)
-                player->jumpBuffer = JUMP_BUFFER_TIME;
+                player->jumpBufferUntil = timerIn(player, JUMP_BUFFER_TIME);
             }
         }
     }
@@ -193,10 +193,10 @@ int normalUpdate(Player* player, u16 keys, const Level* level) {
 }
 
 // Helper function: Normal Jump (Celeste Jump() method around line 1900+)
-void jump(Player* player, u16 keys) {
+void jump(Player* player, u16 keys, const Level* level) {
     int moveX = inputMoveX(keys);
 
-    player->ducking = 0;
+    tryUnduck(player, level);
     player->vx += moveX * JUMP_HORIZONTAL_BOOST;
     player->vy = JUMP_STRENGTH;
 
@@ -205,25 +205,25 @@ void jump(Player* player, u16 keys) {
     player->vy += player->liftBoostY;
 
     player->varJumpSpeed = player->vy;
-    player->varJumpTimer = VAR_JUMP_TIME;
+    player->varJumpUntil = timerIn(player, VAR_JUMP_TIME);
     player->autoJump = 0;  // Clear AutoJump (Celeste line 1665)
     player->wallSlideTimer = WALL_SLIDE_TIME;
-    player->dashAttackTimer = 0;  // Clear dash attack window
+    player->dashAttackUntil = TIMER_OFF;  // Clear dash attack window
     player->dashing = 0;  // End dash so trail can fade
     player->onGround = 0;
     player->coyoteTime = 0;
-    player->jumpBuffer = 0;
+    player->jumpBufferUntil = TIMER_OFF;
     player->jumpHeld = 1;
 }
 
 // Helper function: Wall Jump (Celeste WallJump() method line 1736-1782)
-void wallJump(Player* player, int dir, int moveX) {
-    player->ducking = 0;
+void wallJump(Player* player, int dir, int moveX, const Level* level) {
+    tryUnduck(player, level);
 
     // Force movement away from wall if holding any direction (Celeste line 1746-1750)
     if (moveX != 0) {
         player->forceMoveX = dir;
-        player->forceMoveXTimer = WALL_JUMP_FORCE_TIME;
+        player->forceMoveXUntil = timerIn(player, WALL_JUMP_FORCE_TIME);
     }
 
     player->vx = dir * WALL_JUMP_H_SPEED;
@@ -234,14 +234,14 @@ void wallJump(Player* player, int dir, int moveX) {
     player->vy += player->liftBoostY;
 
     player->varJumpSpeed = JUMP_STRENGTH;
-    player->varJumpTimer = VAR_JUMP_TIME;
+    player->varJumpUntil = timerIn(player, VAR_JUMP_TIME);
     player->autoJump = 0;  // Clear AutoJump (Celeste line 1742)
-    player->dashAttackTimer = 0;  // Clear dash attack window (Celeste line 1743)
+    player->dashAttackUntil = TIMER_OFF;  // Clear dash attack window (Celeste line 1743)
     player->wallSlideTimer = WALL_SLIDE_TIME;
-    player->wallBoostTimer = 0;  // Clear wall boost (Celeste line 1745)
+    player->wallBoostUntil = TIMER_OFF;  // Clear wall boost (Celeste line 1745)
     player->dashing = 0;  // End dash so trail can fade
     player->coyoteTime = 0;
-    player->jumpBuffer = 0;
+    player->jumpBufferUntil = TIMER_OFF;
     player->jumpHeld = 1;
     player->facingRight = dir > 0 ? 1 : 0;
 }
@@ -6,17 +6,16 @@
 #include "core/input.h"
 
 // Forward declarations
-static void superJump(Player* player);
-static void superWallJump(Player* player, int dir);
+static void superJump(Player* player, const Level* level);
+static void superWallJump(Player* player, int dir, const Level* level);
 
 void redDashBegin(Player* player, const Level* level) {
     // Celeste RedDashBegin (line 3834-3854)
-    (void)level;  // Unused in RedDash state
 
-    player->dashCooldownTimer = DASH_COOLDOWN_TIME;
-    player->dashRefillCooldownTimer = DASH_REFILL_COOLDOWN_TIME;
+    player->dashCooldownUntil = timerIn(player, DASH_COOLDOWN_TIME);
+    player->dashRefillCooldownUntil = timerIn(player, DASH_REFILL_COOLDOWN_TIME);
     player->wallSlideTimer = WALL_SLIDE_TIME;
-    player->dashAttackTimer = DASH_ATTACK_TIME;
+    player->dashAttackUntil = timerIn(player, DASH_ATTACK_TIME);
 
     // Set speed and direction immediately using lastAim (Celeste line 3922-3923)
     // Unlike normal dash, RedDash doesn't wait a frame
@@ -31,8 +30,8 @@ void redDashBegin(Player* player, const Level* level) {
     }
 
     // Unduck if in air (Celeste line 3852-3853)
-    if (!player->onGround && player->ducking) {
-        player->ducking = 0;
+    if (!player->onGround) {
+        tryUnduck(player, level);
     }
 
     // RedDash doesn't use dashing timer - it's infinite until interrupted
@@ -74,7 +73,7 @@ int redDashUpdate(Player* player, u16 keys, const Level* level) {
 
     // Check for new dash (Celeste line 3865-3866)
     // CanDash = has dashes available and cooldown expired
-    if ((pressed & BTN_DASH) && player->dashCooldownTimer == 0 && player->dashes > 0) {
+    if ((pressed & BTN_DASH) && !timerActive(player, player->dashCooldownUntil) && player->dashes > 0) {
         // Consume dash (Celeste StartDash() line 3408)
         player->dashes = player->dashes > 0 ? player->dashes - 1 : 0;
         // Return to regular dash state
@@ -109,7 +108,7 @@ int redDashUpdate(Player* player, u16 keys, const Level* level) {
         }
 
         if ((pressed & BTN_JUMP) && (player->onGround || player->coyoteTime > 0)) {
-            superJump(player);
+            superJump(player, level);
             return ST_NORMAL;
         }
     }
@@ -117,10 +116,10 @@ int redDashUpdate(Player* player, u16 keys, const Level* level) {
     else if (player->dashDirX == 0 && player->dashDirY == -1) {
         if (pressed & BTN_JUMP) {
             if (checkWall(player, level, 1)) {
-                superWallJump(player, -1);
+                superWallJump(player, -1, level);
                 return ST_NORMAL;
             } else if (checkWall(player, level, -1)) {
-                superWallJump(player, 1);
+                superWallJump(player, 1, level);
                 return ST_NORMAL;
             }
         }
@@ -129,10 +128,10 @@ int redDashUpdate(Player* player, u16 keys, const Level* level) {
     else {
         if (pressed & BTN_JUMP) {
             if (checkWall(player, level, 1)) {
-                wallJump(player, -1, moveX);
+                wallJump(player, -1, moveX, level);
                 return ST_NORMAL;
             } else if (checkWall(player, level, -1)) {
-                wallJump(player, 1, moveX);
+                wallJump(player, 1, moveX, level);
                 return ST_NORMAL;
             }
         }
@@ -142,7 +141,7 @@ int redDashUpdate(Player* player, u16 keys, const Level* level) {
 }
 
 // Helper: Super Jump (same as regular dash)
-static void superJump(Player* player) {
+static void superJump(Player* player, const Level* level) {
     int facingDir = player->facingRight ? 1 : -1;
 
     player->vx = facingDir * SUPER_JUMP_H;
@@ -154,26 +153,26 @@ static void superJump(Player* player) {
 
     // Duck multipliers
     if (player->ducking) {
-        player->ducking = 0;
+        tryUnduck(player, level);
         player->vx = fpMul(player->vx, FP_DUCK_JUMP_X_MULT);
         player->vy = fpMul(player->vy, FP_DUCK_JUMP_Y_MULT);
     }
 
     player->varJumpSpeed = player->vy;
-    player->varJumpTimer = VAR_JUMP_TIME;
+    player->varJumpUntil = timerIn(player, VAR_JUMP_TIME);
     player->autoJump = 0;
     player->wallSlideTimer = WALL_SLIDE_TIME;
-    player->dashAttackTimer = 0;
+    player->dashAttackUntil = TIMER_OFF;
     player->dashing = 0;  // End dash so trail can fade
     player->onGround = 0;
     player->coyoteTime = 0;
-    player->jumpBuffer = 0;
+    player->jumpBufferUntil = TIMER_OFF;
     player->jumpHeld = 1;
 }
 
 // Helper: Super Wall Jump (same as regular dash)
-static void superWallJump(Player* player, int dir) {
-    player->ducking = 0;
+static void superWallJump(Player* player, int dir, const Level* level) {
+    tryUnduck(player, level);
     player->vx = dir * SUPER_WALL_JUMP_H;
     player->vy = SUPER_WALL_JUMP_SPEED;
 
@@ -182,13 +181,13 @@ static void superWallJump(Player* player, int dir) {
     player->vy += player->liftBoostY;
 
     player->varJumpSpeed = SUPER_WALL_JUMP_SPEED;
-    player->varJumpTimer = SUPER_WALL_JUMP_VAR_TIME;
+    player->varJumpUntil = timerIn(player, SUPER_WALL_JUMP_VAR_TIME);
     player->autoJump = 0;
     player->wallSlideTimer = WALL_SLIDE_TIME;
-    player->dashAttackTimer = 0;
+    player->dashAttackUntil = TIMER_OFF;
     player->dashing = 0;  // End dash so trail can fade
     player->coyoteTime = 0;
-    player->jumpBuffer = 0;
+    player->jumpBufferUntil = TIMER_OFF;
     player->jumpHeld = 1;
     player->facingRight = dir > 0 ? 1 : 0;
 }
@@ -19,10 +19,56 @@ typedef struct {
     int lastScrollCanReuseTilemapOnCommit;
     int bgTileOriginX;
     int bgTileOriginY;
+    u8 screenBlank[4];  // Per BG: screenblock known to hold only tile 0
+
+    // Full refresh being built into the back screenblocks (see below)
+    int refreshPending;
+    int refreshUrgent;      // Finish this frame instead of spreading
+    int refreshRow;         // Next row to build, layer * 32 + map row offset
+    int refreshTileX;       // Camera tile the build targets
+    int refreshTileY;
+    int refreshOriginX;     // Tile origin the build targets
+    int refreshOriginY;
+    const Level* refreshLevel;
+    u8 refreshBuilt;        // Layers written to their back screenblock
+    u8 refreshBlank;        // ...of which were written entirely with tile 0
+
+    // BG scroll position last queued, i.e. what the screen shows
+    int shownBgCameraX;
+    int shownBgCameraY;
+    int shownBgCameraValid;
 } TilemapState;
 
+// Full refreshes are built into the hidden screenblock of each gameplay BG
+// and made visible by switching BGxCNT's screen base during VBlank, together
+// with the new scroll position. Up to TILEMAP_REFRESH_ROWS_PER_FRAME map rows
+// are built per frame; meanwhile the old view stays frozen on screen. That is
+// only done while the camera stands still, since sprites follow the camera:
+// a refresh that starts with the camera moving, or whose camera moves while
+// it is being built, is finished that frame and shown with the new scroll.
+#define TILEMAP_REFRESH_ROWS_PER_FRAME 32
+
 void resetTilemapState(TilemapState* ts);
 
+// Screenblock BG `bgLayer` currently displays; incremental updates go here.
+u8 getGameplayScreenBase(u8 bgLayer);
+
+// Queue BGxCNT for gameplay BG1/BG2 with its displayed screenblock. The
+// priority is remembered for later screenblock flips.
+void queueGameplayBgControl(u8 bgLayer, u8 priority);
+
+#ifdef DESKTOP_BUILD
+// Display the primary screenblocks again (tests that restart from cleared VRAM).
+void resetGameplayScreenBases(void);
+#endif
+
+// Level entry (menu, replay load): the one fill of the gameplay maps. Resets
+// *ts and builds the 32x32 window at the camera into the hidden screenblocks
+// in one go, flipping them in with the matching scroll position next VBlank.
+// The camera must already be settled on the player, so the first gameplay
+// frame finds the tilemap current and writes nothing.
+void enterLevelTilemap(TilemapState* ts, const Level* level, int cameraX, int cameraY);
+
 // Update BG scroll registers and write tile data for the current camera position.
 // Handles both normal gameplay and scroll transitions.
 // Returns 1 if a scroll transition just started this frame (caller needs this
@@ -47,14 +93,16 @@ void prefillScrollIncomingOverlap(const Level* currentLevel,
                                   int scrollBgOriginX, int scrollBgOriginY,
                                   int cameraTileX, int cameraTileY);
 
-void writeHorizontalScrollRow(volatile u16* bgMap,
+// Fill line[mapX & 31] with the 32 visible entries of virtual map row ly.
+void writeHorizontalScrollRow(u16* line,
                               u8 layerIdx,
                               const ScrollTransInfo* scrollInfo,
                               int tileOriginX, int tileOriginY,
                               int cameraTileX,
                               int ly);
 
-void writeVerticalScrollColumn(volatile u16* bgMap,
+// Fill line[mapY & 31] with the 32 visible entries of virtual map column lx.
+void writeVerticalScrollColumn(u16* line,
                                u8 layerIdx,
                                const ScrollTransInfo* scrollInfo,
                                int tileOriginX, int tileOriginY,
@@ -1,9 +1,11 @@
 #include "transition.h"
 #include "menu/menu.h"
 #include "core/game_math.h"
-#include "generated/connections.h"
+#include "world.h"
 #include "player/player.h"
 #include "player/state.h"
+#include "core/vblank_queue.h"
+#include "core/log.h"
 
 // ---------------------------------------------------------------------------
 // Blend register constants (fade fallback)
@@ -159,6 +161,7 @@ static void restorePlayerAfterTransition(Player* player, int newPlayerX, int new
         player->x = newPlayerX;
         player->y = newPlayerY;
         restoreTransitionResources(player);
+        wakePlayer(player);
 
         hidePlayerDashTrailPositions(player);
         return;
@@ -169,6 +172,7 @@ static void restorePlayerAfterTransition(Player* player, int newPlayerX, int new
     player->vx = g_trans.preservedVx;
     player->vy = g_trans.preservedVy;
     restoreTransitionResources(player);
+    wakePlayer(player);
 }
 
 #ifdef DESKTOP_BUILD
@@ -195,22 +199,26 @@ static const Level* getRegisteredLevel(int levelIdx) {
         return s_overrideLevels[levelIdx];
     }
 #endif
-    if (levelIdx < 0 || levelIdx >= LEVEL_COUNT) return NULL;
+    if (levelIdx < 0 || levelIdx >= g_levelCount) return NULL;
     return g_levels[levelIdx];
 }
 
-static const ScreenConnection* getRegisteredConnections(void) {
+// A room's exits: its slice of the sorted connection table. Test overrides
+// are unsorted, so they hand back the whole table.
+static const ScreenConnection* getRoomConnections(int levelIdx, int* count) {
 #ifdef DESKTOP_BUILD
-    if (s_overrideConnections) return s_overrideConnections;
-#endif
-    return g_connections;
-}
-
-static int getRegisteredConnectionCount(void) {
-#ifdef DESKTOP_BUILD
-    if (s_overrideConnections) return s_overrideConnectionCount;
+    if (s_overrideConnections) {
+        *count = s_overrideConnectionCount;
+        return s_overrideConnections;
+    }
 #endif
-    return g_connectionCount;
+    if (levelIdx < 0 || levelIdx >= g_levelCount) {
+        *count = 0;
+        return g_connections;
+    }
+    int first = g_roomConnections[levelIdx];
+    *count = g_roomConnections[levelIdx + 1] - first;
+    return &g_connections[first];
 }
 
 static int chooseIncomingTileVramOffset(int currentOffset, int currentCount, int incomingCount) {
@@ -301,12 +309,12 @@ void setTransitionLevelContext(int levelIdx, int cameraX, int cameraY, int playe
 int tryTriggerTransition(const Level* level, int side, int perpPos, Player* player) {
     if (!level || g_trans.phase != TRANS_NONE || g_levelIdx < 0) return 0;
 
-    // Find matching connection
-    const ScreenConnection* connections = getRegisteredConnections();
-    int connectionCount = getRegisteredConnectionCount();
+    // Find matching connection among this room's exits
+    int connectionCount;
+    const ScreenConnection* connections = getRoomConnections(g_levelIdx, &connectionCount);
     const ScreenConnection* conn = NULL;
     for (int i = 0; i < connectionCount; i++) {
-        if (connections[i].fromLevelIdx == (u8)g_levelIdx &&
+        if (connections[i].fromLevelIdx == g_levelIdx &&
             (int)connections[i].fromSide == side &&
             perpPos >= (int)connections[i].fromStart &&
             perpPos <  (int)connections[i].fromEnd) {
@@ -320,6 +328,12 @@ int tryTriggerTransition(const Level* level, int side, int perpPos, Player* play
     const Level* toLevel   = getRegisteredLevel(conn->toLevelIdx);
     if (!toLevel) return 0;
 
+    // A predicted path ends here; the real player would start a transition
+    if (g_playerPredicting) {
+        g_playerPredictExit = 1;
+        return 1;
+    }
+
     g_trans.preservedVx = player ? player->vx : 0;
     g_trans.preservedVy = player ? player->vy : 0;
     if (player) {
@@ -516,17 +530,17 @@ int tryTriggerTransition(const Level* level, int side, int perpPos, Player* play
             (((virtualEndY >> 3) - g_trans.toTileY0) == (newCameraY >> 3));
 
         g_trans.phase = TRANS_SCROLL;
+        LOG3(LOG_TRANSITION_SCROLL, g_levelIdx, conn->toLevelIdx, scrollFrames);
         return 1;
     }
 
 do_fade:
     // ---- Fade fallback ----
+    LOG3(LOG_TRANSITION_FADE, g_levelIdx, conn->toLevelIdx, N_A + N_B);
     g_trans.phase = TRANS_FADE_OUT;
     g_trans.timer = FADE_FRAMES;
-#ifndef DESKTOP_BUILD
-    REG_BLDCNT = BLDCNT_FADEBLK;
-    REG_BLDY   = 0;
-#endif
+    vblankQueueReg(VREG_BLDCNT, BLDCNT_FADEBLK);
+    vblankQueueReg(VREG_BLDY, 0);
     return 1;
 }
 
@@ -580,16 +594,14 @@ int updateTransition(Player* player, Camera* camera) {
 
     if (g_trans.phase == TRANS_FADE_OUT) {
         g_trans.timer--;
-        int brightness = ((FADE_FRAMES - g_trans.timer) * 16) / FADE_FRAMES;
+        // Reach full black one frame early: BLDY is applied at the next
+        // VBlank, so the frame that reloads VRAM below must already be
+        // displayed fully faded.
+        int brightness = ((FADE_FRAMES - g_trans.timer) * 16) / (FADE_FRAMES - 1);
         if (brightness > 16) brightness = 16;
-#ifndef DESKTOP_BUILD
-        REG_BLDY = (u16)brightness;
-#endif
+        vblankQueueReg(VREG_BLDY, (u16)brightness);
 
         if (g_trans.timer <= 0) {
-#ifndef DESKTOP_BUILD
-            REG_BLDY = 16;
-#endif
             loadLevelForTransition(g_trans.targetLevelIdx);
             setLevelTileVramOffset(0);
             g_levelIdx = g_trans.targetLevelIdx;
@@ -610,16 +622,12 @@ int updateTransition(Player* player, Camera* camera) {
         g_trans.timer--;
         int brightness = (g_trans.timer * 16) / FADE_FRAMES;
         if (brightness > 16) brightness = 16;
-#ifndef DESKTOP_BUILD
-        REG_BLDY = (u16)brightness;
-#endif
+        vblankQueueReg(VREG_BLDY, (u16)brightness);
 
         if (g_trans.timer <= 0) {
-#ifndef DESKTOP_BUILD
-            REG_BLDY     = 0;
-            REG_BLDCNT   = BLDCNT_ALPHA;
-            REG_BLDALPHA = BLDALPHA_VAL;
-#endif
+            vblankQueueReg(VREG_BLDY, 0);
+            vblankQueueReg(VREG_BLDCNT, BLDCNT_ALPHA);
+            vblankQueueReg(VREG_BLDALPHA, BLDALPHA_VAL);
             g_trans.phase = TRANS_NONE;
             return 0;
         }
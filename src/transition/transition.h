@@ -17,11 +17,12 @@ typedef enum {
 // When the player exits fromLevel on fromSide at a perpendicular position perpPos,
 // a transition triggers if fromStart <= perpPos < fromEnd.
 // The destination perpendicular position is: perpPos - fromStart + toStart.
+// 12 bytes: 16-bit room indices, sides stored as bytes.
 typedef struct {
-    u8 fromLevelIdx;
-    u8 toLevelIdx;
-    ConnectionSide fromSide;
-    ConnectionSide toSide;
+    u16 fromLevelIdx;
+    u16 toLevelIdx;
+    u8 fromSide;    // ConnectionSide
+    u8 toSide;      // ConnectionSide
     s16 fromStart;  // Range start on from-side perp axis (local px, inclusive)
     s16 fromEnd;    // Range end on from-side perp axis (local px, exclusive)
     s16 toStart;    // Corresponding start on to-side perp axis (local px)
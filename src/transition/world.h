@@ -0,0 +1,28 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "core/game_types.h"
+#include "level/level.h"
+#include "transition/transition.h"
+
+// The room registry and connection table, defined once in ROM by the
+// generated connections.c (tools/compile_connections.py). Room indices are
+// 16-bit, so a world can hold up to 65535 rooms.
+//
+// Connections are sorted by source room; a room's exits are
+// g_connections[g_roomConnections[room]] up to g_roomConnections[room + 1],
+// so finding a room's neighbours costs one table read whatever the world
+// size. Include generated/connections.h for the LEVEL_IDX_* / LEVEL_COUNT
+// constants.
+
+extern const Level* const g_levels[];
+extern const char* const g_levelNames[];
+extern const int g_levelCount;
+
+extern const ScreenConnection g_connections[];
+extern const int g_connectionCount;
+
+// g_levelCount + 1 entries
+extern const u16 g_roomConnections[];
+
+#endif // WORLD_H
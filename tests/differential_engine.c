@@ -0,0 +1,123 @@
+#ifdef DESKTOP_BUILD
+
+// Compiled twice (see differential_engine.h). With DIFF_ENGINE_REFERENCE
+// and reference_names.h force-included, every engine symbol below resolves
+// to the ref_ copy, including loadLevelForTransition, which the reference
+// transition.c calls back into.
+
+#include "differential_engine.h"
+#include "collision/collision.h"
+#include "core/vblank_queue.h"
+#include "generated/connections.h"
+#include "transition/scroll_tilemap.h"
+#include "transition/transition.h"
+
+static TilemapState s_ts;
+static const Level* s_level = 0;
+static int s_levelIndex = -1;
+static int s_lastLevelIndex = -1;
+
+static void clearGameplayTilemaps(void) {
+    volatile u16* bg1Map = vramScreenblock(getGameplayScreenBase(1));
+    volatile u16* bg2Map = vramScreenblock(getGameplayScreenBase(2));
+    for (int i = 0; i < 32 * 32; i++) {
+        bg1Map[i] = 0;
+        bg2Map[i] = 0;
+    }
+}
+
+static void configureBgs(const Level* level) {
+    queueGameplayBgControl(1, 0);
+    queueGameplayBgControl(2, 1);
+    for (u8 i = 0; i < level->layerCount; i++) {
+        queueGameplayBgControl(level->layers[i].bgLayer, level->layers[i].priority);
+    }
+}
+
+// Mirrors menu.c: adopt the scrolled-in B buffer, or reload after a fade.
+void loadLevelForTransition(int levelIndex) {
+    if (levelIndex < 0 || levelIndex >= LEVEL_COUNT) return;
+    s_level = g_levels[levelIndex];
+    s_levelIndex = levelIndex;
+    if (g_levelBLayerTiles[0] != 0) {
+        adoptLevelBBuffer(s_level);
+    } else {
+        loadLevelToVRAM(s_level);
+        clearGameplayTilemaps();
+    }
+    configureBgs(s_level);
+}
+
+static const u16* engineLayerTiles(int buffer, int layer) {
+    return (buffer == DIFF_BUFFER_B) ? g_levelBLayerTiles[layer] : g_levelLayerTiles[layer];
+}
+
+static const u16* engineTileEntries(int buffer) {
+    return (buffer == DIFF_BUFFER_B) ? g_levelBTileEntries : g_levelTileEntries;
+}
+
+static void engineBeginRoom(int levelIndex) {
+    s_level = g_levels[levelIndex];
+    s_levelIndex = levelIndex;
+    s_lastLevelIndex = -1;
+    invalidateLevelResidency();
+    initTransition();
+    loadLevelToVRAM(s_level);
+    resetTilemapState(&s_ts);
+    resetGameplayScreenBases();
+    clearGameplayTilemaps();
+    configureBgs(s_level);
+}
+
+static int engineFrame(Player* player, Camera* camera) {
+    setTransitionLevelContext(s_levelIndex, camera->x, camera->y, player->x, player->y);
+    if (isTransitioning()) {
+        updateTransition(player, camera);
+    }
+
+    int levelChanged = (s_levelIndex != s_lastLevelIndex);
+    s_lastLevelIndex = s_levelIndex;
+
+    ScrollTransInfo scrollInfo;
+    getScrollTransInfo(&scrollInfo);
+    updateTilemapForCamera(&s_ts, s_level, &scrollInfo, camera->x, camera->y, levelChanged);
+    return isTransitioning();
+}
+
+static int engineTriggerTransition(int side, int perpPos, Player* player, const Camera* camera) {
+    setTransitionLevelContext(s_levelIndex, camera->x, camera->y, player->x, player->y);
+    return tryTriggerTransition(s_level, side, perpPos, player);
+}
+
+static int engineCurrentLevelIndex(void) {
+    return s_levelIndex;
+}
+
+#ifdef DIFF_ENGINE_REFERENCE
+const DiffEngine g_referenceEngine = {
+    .name = "reference",
+#else
+const DiffEngine g_liveEngine = {
+    .name = "live",
+#endif
+    .loadLevel = loadLevelToVRAM,
+    .loadLevelB = loadLevelBToVRAM,
+    .adoptLevelB = adoptLevelBBuffer,
+    .invalidateResidency = invalidateLevelResidency,
+    .tileVramOffset = getLevelTileVramOffset,
+    .layerTiles = engineLayerTiles,
+    .tileEntries = engineTileEntries,
+    .vramTiles = getDesktopVramTiles,
+    .isLayerRegionEmpty = isLayerRegionEmpty,
+    .collideHorizontal = collideHorizontal,
+    .collideVertical = collideVertical,
+    .isPositionCollidingAt = isPositionCollidingAt,
+    .checkWallAt = checkWallAt,
+    .checkCeiling = checkCeiling,
+    .beginRoom = engineBeginRoom,
+    .frame = engineFrame,
+    .triggerTransition = engineTriggerTransition,
+    .currentLevelIndex = engineCurrentLevelIndex,
+};
+
+#endif // DESKTOP_BUILD
@@ -0,0 +1,56 @@
+#ifndef DIFFERENTIAL_ENGINE_H
+#define DIFFERENTIAL_ENGINE_H
+
+#include "core/game_types.h"
+#include "level/level.h"
+
+/**
+ * One build of the engine modules under differential test (collision,
+ * level decoding, tilemap streaming and the transition glue between them).
+ *
+ * tests/differential_engine.c is compiled twice: once against the live
+ * sources, and once with tests/reference/reference_names.h force-included
+ * so that every call inside it lands on the frozen copies in
+ * tests/reference/. The engine owns its TilemapState and current room, so
+ * the harness only ever sees plain data.
+ */
+
+#define DIFF_BUFFER_MAIN 0
+#define DIFF_BUFFER_B    1
+
+typedef struct {
+    const char* name;
+
+    // Level decoding
+    void (*loadLevel)(const Level* level);
+    void (*loadLevelB)(const Level* level, int vramOffset);
+    void (*adoptLevelB)(const Level* level);
+    void (*invalidateResidency)(void);
+    int (*tileVramOffset)(void);
+    const u16* (*layerTiles)(int buffer, int layer);
+    const u16* (*tileEntries)(int buffer);
+    const u16* (*vramTiles)(void);
+    int (*isLayerRegionEmpty)(const Level* level, u8 layer, int x0, int y0, int x1, int y1);
+
+    // Collision
+    void (*collideHorizontal)(Player* player, const Level* level);
+    void (*collideVertical)(Player* player, const Level* level);
+    int (*isPositionCollidingAt)(const Level* level, int x, int y);
+    int (*checkWallAt)(const Player* player, const Level* level, int dir, int yAdd, int dist);
+    int (*checkCeiling)(const Player* player, const Level* level);
+
+    // Tilemap streaming and transitions, in main.c's per-frame order.
+    // beginRoom loads the room, resets the tilemap and transition state.
+    void (*beginRoom)(int levelIndex);
+    // One gameplay frame: transition update if one is running, then the
+    // tilemap for the (possibly virtual) camera. Returns 1 while a
+    // transition is in progress.
+    int (*frame)(Player* player, Camera* camera);
+    int (*triggerTransition)(int side, int perpPos, Player* player, const Camera* camera);
+    int (*currentLevelIndex)(void);
+} DiffEngine;
+
+extern const DiffEngine g_liveEngine;
+extern const DiffEngine g_referenceEngine;
+
+#endif // DIFFERENTIAL_ENGINE_H
@@ -58,8 +58,8 @@ static void verifyClimbHopLedge(const Player* player, int frame, TestResults* re
     if (climbHopFrame >= 0 && prevState == ST_NORMAL && currentState == ST_CLIMB) {
         if (!hasReportedFailure) {
             printf("  FAIL: Player re-entered climb state at frame %d!\n", frame);
-            printf("        Frame %d after hop, vy=%d, hopWaitX=%d, forceMoveXTimer=%d\n",
-                   frame - climbHopFrame, player->vy, player->hopWaitX, player->forceMoveXTimer);
+            printf("        Frame %d after hop, vy=%d, hopWaitX=%d, forceMoveX frames left=%d\n",
+                   frame - climbHopFrame, player->vy, player->hopWaitX, timerRemaining(player, player->forceMoveXUntil));
             printf("        Player should stay in normal state after hop\n");
             results->failed++;
             hasReportedFailure = 1;
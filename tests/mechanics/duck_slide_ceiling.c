@@ -0,0 +1,49 @@
+#ifdef DESKTOP_BUILD
+
+#include <stdio.h>
+#include "../test_framework.h"
+#include "core/game_math.h"
+#include "player/state.h"
+#include "collision/collision.h"
+#include "level/level.h"
+#include "celeste1.h"
+
+// Dash down-left from the two-tile pocket at the top left of Celeste1 into
+// the one-tile tunnel beside it, then hold jump under the tunnel's ceiling
+static const u16 duck_slide_ceiling_inputs[] = {
+    0x0000, 0x0000, 0x0000, 0x0000, 0x01A0, 0x01A0, 0x00A0, 0x00A0,
+    0x00A0, 0x00A0, 0x00A0, 0x00A0, 0x00A0, 0x00A0, 0x0001, 0x0001,
+    0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0001, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+};
+
+// Only the duck hitbox fits in the tunnel: the jump must not unduck the
+// player into the ceiling (collision would then eject them out of the room)
+static void verifyHitboxClear(const Player* player, int frame, TestResults* results) {
+    int x = player->x >> FIXED_SHIFT;
+    int y = player->y >> FIXED_SHIFT;
+    if (isHitboxCollidingAt(&celeste1, playerHitbox(player), x, y)) {
+        printf("  FAIL: %s hitbox inside a solid at (%d, %d) (frame %d)\n",
+               player->ducking ? "Duck" : "Standing", x, y, frame);
+        results->failed++;
+    }
+}
+
+const MechanicsTest test_duck_slide_ceiling = {
+    .name = "Duck Slide Under Ceiling",
+    .description = "Jumping from a dash slide under a one-tile ceiling keeps the duck hitbox",
+    .inputs = duck_slide_ceiling_inputs,
+    .frameCount = sizeof(duck_slide_ceiling_inputs) / sizeof(duck_slide_ceiling_inputs[0]),
+    .level = &celeste1,
+    .startX = 58 << FIXED_SHIFT,
+    .startY = 20 << FIXED_SHIFT,
+    .verifyFrame = verifyHitboxClear,
+    .expectFinalX = 20 << FIXED_SHIFT,  // Stopped by the tunnel's far wall
+    .expectFinalY = 24 << FIXED_SHIFT,  // Still on the tunnel floor
+    .expectFinalVX = 0,
+    .expectFinalVY = 0,
+    .expectFinalState = ST_NORMAL,
+};
+
+#endif // DESKTOP_BUILD
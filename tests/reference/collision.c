@@ -0,0 +1,369 @@
+#include "collision.h"
+#include "transition/transition.h"
+#include "core/overlay.h"
+#include "core/cost_model.h"
+
+// Every routine below that depends on the hitbox size is an always_inline
+// body taking the width and height. PLAYER_HITBOXES stamps out one copy per
+// variant with the size as a literal, so each copy keeps the constant loop
+// bounds and edge offsets of a fixed-size hitbox; s_hitboxRoutines picks the
+// copy for the player's current hitbox once per call.
+
+#if HITBOX_TOP(0, PLAYER_HEIGHT) != PLAYER_TOP(0)
+#error "PLAYER_TOP must be the top of the HITBOX_NORMAL hitbox"
+#endif
+
+typedef int (*HitboxProbe)(const Level* level, int screenX, int screenY);
+
+// Hitbox-vs-solid-tile test, the innermost collision loop. Inlined into
+// both the gameplay IWRAM overlay copy and the ROM copy of each variant.
+static inline __attribute__((always_inline))
+int hitboxCollidesBody(const Level* level, int screenX, int screenY, int width, int height) {
+    // Hitbox with configurable Y shift (adjust PLAYER_HITBOX_Y_SHIFT to change sprite ground position)
+    COST_INSNS(20);
+    int playerLeft = screenX - width / 2;
+    int playerRight = screenX + width / 2;
+    int playerTop = HITBOX_TOP(screenY, height);
+    int playerBottom = PLAYER_BOTTOM(screenY);
+
+    int tileMinX = playerLeft / 8;
+    int tileMaxX = playerRight / 8;
+    int tileMinY = playerTop / 8;
+    int tileMaxY = playerBottom / 8;
+
+    for (int ty = tileMinY; ty <= tileMaxY; ty++) {
+        for (int tx = tileMinX; tx <= tileMaxX; tx++) {
+            if (getTileCollision(level, tx, ty) != COL_SOLID) continue;
+
+            int tileLeft = tx * 8;
+            int tileRight = (tx + 1) * 8;
+            int tileTop = ty * 8;
+            int tileBottom = (ty + 1) * 8;
+
+            if (playerRight > tileLeft && playerLeft < tileRight &&
+                playerBottom > tileTop && playerTop < tileBottom) {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+// Position test inside a sweep (ledge pop, bonk nudge): the variant's own
+// probe, or the runtime-sized body when there is none.
+static inline __attribute__((always_inline))
+int sweepProbe(HitboxProbe probe, const Level* level, int screenX, int screenY, int width, int height) {
+    return probe ? probe(level, screenX, screenY)
+                 : hitboxCollidesBody(level, screenX, screenY, width, height);
+}
+
+static inline __attribute__((always_inline))
+void collideHorizontalBody(Player* player, const Level* level, int width, int height, HitboxProbe probe) {
+    COST_INSNS(40);
+    // Horizontal sweep
+    player->x += player->vx;
+    int screenX = player->x >> FIXED_SHIFT;
+    int screenY = player->y >> FIXED_SHIFT;
+
+    // Level bounds
+    int levelWidthPx = level->width * 8;
+    int halfWidth = width / 2;
+    if (screenX < halfWidth) {
+        player->x = halfWidth << FIXED_SHIFT;
+        if (!tryTriggerTransition(level, CONN_SIDE_LEFT, screenY, player)) {
+            player->vx = 0;
+        }
+    } else if (screenX > levelWidthPx - halfWidth) {
+        player->x = (levelWidthPx - halfWidth) << FIXED_SHIFT;
+        if (!tryTriggerTransition(level, CONN_SIDE_RIGHT, screenY, player)) {
+            player->vx = 0;
+        }
+    } else {
+        // Check for tile collision at new X position
+        screenX = player->x >> FIXED_SHIFT;
+        int playerLeft = screenX - width / 2;
+        int playerRight = screenX + width / 2;
+        int playerTop = HITBOX_TOP(screenY, height);
+        int playerBottom = PLAYER_BOTTOM(screenY);
+
+        int tileMinX = playerLeft / 8;
+        int tileMaxX = playerRight / 8;
+        int tileMinY = playerTop / 8;
+        int tileMaxY = playerBottom / 8;
+
+        for (int ty = tileMinY; ty <= tileMaxY; ty++) {
+            for (int tx = tileMinX; tx <= tileMaxX; tx++) {
+                // JumpThru platforms don't block horizontal movement
+                if (getTileCollision(level, tx, ty) != COL_SOLID) continue;
+
+                int tileLeft = tx * 8;
+                int tileRight = (tx + 1) * 8;
+                int tileTop = ty * 8;
+                int tileBottom = (ty + 1) * 8;
+
+                if (playerRight > tileLeft && playerLeft < tileRight &&
+                    playerBottom > tileTop && playerTop < tileBottom) {
+                    // Collision - snap to tile edge instead of reverting
+                    int snappedX = player->vx > 0
+                        ? (tileLeft - width / 2) << FIXED_SHIFT
+                        : (tileRight + width / 2) << FIXED_SHIFT;
+
+                    // Dash ledge pop: pop up only if overlap is within range
+                    int popped = 0;
+                    if (player->dashing > 0) {
+                        int originalY = player->y;
+                        int baseScreenX = snappedX >> FIXED_SHIFT;
+                        int requiredPopPx = playerBottom - tileTop;
+                        int requiredPop = requiredPopPx << FIXED_SHIFT;
+
+                        if (requiredPopPx > 0 && requiredPop <= DASH_LEDGE_POP_HEIGHT) {
+                            int newY = originalY - requiredPop;
+                            int newScreenY = newY >> FIXED_SHIFT;
+                            if (!sweepProbe(probe, level, baseScreenX, newScreenY, width, height)) {
+                                player->y = newY;
+                                popped = 1;
+                            }
+                        }
+                    }
+
+                    player->x = snappedX;
+                    if (!popped) {
+                        player->vx = 0;
+                    }
+                    return;
+                }
+            }
+        }
+    }
+}
+
+static inline __attribute__((always_inline))
+void collideVerticalBody(Player* player, const Level* level, int width, int height, HitboxProbe probe) {
+    COST_INSNS(40);
+    // Vertical sweep
+    player->y += player->vy;
+    int screenX = player->x >> FIXED_SHIFT;
+    int screenY = player->y >> FIXED_SHIFT;
+
+    player->onGround = 0;
+
+    // Ceiling bounds
+    if (HITBOX_TOP(screenY, height) < 0) {
+        player->y = (-HITBOX_TOP(0, height)) << FIXED_SHIFT;
+        if (!tryTriggerTransition(level, CONN_SIDE_TOP, screenX, player)) {
+            player->vy = 0;
+        }
+    } else {
+        // Check for tile collision at new Y position
+        int playerLeft = screenX - width / 2;
+        int playerRight = screenX + width / 2;
+        int playerTop = HITBOX_TOP(screenY, height);
+        int playerBottom = PLAYER_BOTTOM(screenY);
+
+        int tileMinX = playerLeft / 8;
+        int tileMaxX = playerRight / 8;
+        int tileMinY = playerTop / 8;
+        int tileMaxY = playerBottom / 8;
+
+        for (int ty = tileMinY; ty <= tileMaxY; ty++) {
+            for (int tx = tileMinX; tx <= tileMaxX; tx++) {
+                CollisionType col = getTileCollision(level, tx, ty);
+
+                // JumpThru: only block when falling (vy > 0), not when moving up
+                if (col == COL_JUMPTHRU) {
+                    if (player->vy <= 0) continue;  // Don't block upward movement
+                } else if (col != COL_SOLID) {
+                    continue;
+                }
+
+                int tileLeft = tx * 8;
+                int tileRight = (tx + 1) * 8;
+                int tileTop = ty * 8;
+                int tileBottom = (ty + 1) * 8;
+
+                if (playerRight > tileLeft && playerLeft < tileRight &&
+                    playerBottom > tileTop && playerTop < tileBottom) {
+
+                    if (player->vy > 0) {
+                        // Moving down - snap to top of tile
+                        // JumpThru: only snap if player was above the platform top before this frame
+                        if (col == COL_JUMPTHRU) {
+                            int prevBottom = playerBottom - (player->vy >> FIXED_SHIFT);
+                            if (prevBottom > tileTop) continue;  // Was already below top, skip
+                        }
+                        player->y = (tileTop - PLAYER_HEIGHT / 2 - PLAYER_HITBOX_Y_SHIFT) << FIXED_SHIFT;
+                        player->vy = 0;
+                        player->onGround = 1;
+                    } else {
+                        // Moving up - only solid tiles block upward (JumpThru already filtered above)
+                        int originalX = player->x;
+                        int nudged = 0;
+
+                        for (int nudge = FIXED_ONE; nudge <= BONK_NUDGE_RANGE; nudge += FIXED_ONE) {
+                            int newXRight = originalX + nudge;
+                            int newScreenXRight = newXRight >> FIXED_SHIFT;
+                            int clearRight = !sweepProbe(probe, level, newScreenXRight, screenY, width, height);
+
+                            int newXLeft = originalX - nudge;
+                            int newScreenXLeft = newXLeft >> FIXED_SHIFT;
+                            int clearLeft = !sweepProbe(probe, level, newScreenXLeft, screenY, width, height);
+
+                            if (clearRight ^ clearLeft) {
+                                if (clearRight) {
+                                    player->x = newXRight;
+                                } else {
+                                    player->x = newXLeft;
+                                }
+                                nudged = 1;
+                                break;
+                            }
+                        }
+
+                        if (!nudged) {
+                            player->x = originalX;
+                            // HITBOX_TOP(Y) = tileBottom, so solve for Y
+                            player->y = (tileBottom - HITBOX_TOP(0, height)) << FIXED_SHIFT;
+                            player->vy = 0;
+                        }
+                    }
+                    return;
+                }
+            }
+        }
+
+        // Check bottom boundary (player fell off the bottom of the level)
+        if (PLAYER_BOTTOM(screenY) >= level->height * 8) {
+            player->y = ((level->height * 8) - PLAYER_BOTTOM(0) - 1) << FIXED_SHIFT;
+            if (!tryTriggerTransition(level, CONN_SIDE_BOTTOM, screenX, player)) {
+                player->vy = 0;
+            }
+        }
+    }
+
+    // Ground check for standing still
+    if (!player->onGround && player->vy >= 0) {
+        screenX = player->x >> FIXED_SHIFT;
+        screenY = player->y >> FIXED_SHIFT;
+        int playerBottom = PLAYER_BOTTOM(screenY);
+        int playerLeft = screenX - width / 2;
+        int playerRight = screenX + width / 2;
+        int feetY = (playerBottom + 1) / 8;
+        int tileMinX = playerLeft / 8;
+        int tileMaxX = playerRight / 8;
+
+        for (int tx = tileMinX; tx <= tileMaxX; tx++) {
+            CollisionType col = getTileCollision(level, tx, feetY);
+            if (col == COL_SOLID || col == COL_JUMPTHRU) {
+                int tileTop = feetY * 8;
+                int tileLeft = tx * 8;
+                int tileRight = (tx + 1) * 8;
+                if (playerRight > tileLeft && playerLeft < tileRight &&
+                    playerBottom >= tileTop - 1 && playerBottom <= tileTop + 1) {
+                    // Snap to ground position (same as normal landing)
+                    player->y = (tileTop - PLAYER_HEIGHT / 2 - PLAYER_HITBOX_Y_SHIFT) << FIXED_SHIFT;
+                    player->vy = 0;
+                    player->onGround = 1;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// One variant: IWRAM and ROM probe copies behind a residency dispatch, and
+// the two sweeps, which run from ROM.
+#define HITBOX_VARIANT(id, name, width, height) \
+    IWRAM_OVERLAY_GAMEPLAY \
+    static int hitboxCollides##name##Iwram(const Level* level, int screenX, int screenY) { \
+        return hitboxCollidesBody(level, screenX, screenY, width, height); \
+    } \
+    static int hitboxCollides##name##Rom(const Level* level, int screenX, int screenY) { \
+        return hitboxCollidesBody(level, screenX, screenY, width, height); \
+    } \
+    static int hitboxCollides##name(const Level* level, int screenX, int screenY) { \
+        return OVERLAY_DISPATCH(OVERLAY_GAMEPLAY, \
+                                hitboxCollides##name##Iwram(level, screenX, screenY), \
+                                hitboxCollides##name##Rom(level, screenX, screenY)); \
+    } \
+    static void collideHorizontal##name(Player* player, const Level* level) { \
+        collideHorizontalBody(player, level, width, height, hitboxCollides##name); \
+    } \
+    static void collideVertical##name(Player* player, const Level* level) { \
+        collideVerticalBody(player, level, width, height, hitboxCollides##name); \
+    }
+
+PLAYER_HITBOXES(HITBOX_VARIANT)
+
+typedef struct {
+    HitboxProbe collides;
+    void (*collideHorizontal)(Player* player, const Level* level);
+    void (*collideVertical)(Player* player, const Level* level);
+} HitboxRoutines;
+
+#define HITBOX_ROUTINES_ENTRY(id, name, width, height) \
+    [HITBOX_##id] = { hitboxCollides##name, collideHorizontal##name, collideVertical##name },
+
+static const HitboxRoutines s_hitboxRoutines[HITBOX_COUNT] = {
+    PLAYER_HITBOXES(HITBOX_ROUTINES_ENTRY)
+};
+
+
+void collideHorizontal(Player* player, const Level* level) {
+    s_hitboxRoutines[playerHitbox(player)].collideHorizontal(player, level);
+}
+
+void collideVertical(Player* player, const Level* level) {
+    s_hitboxRoutines[playerHitbox(player)].collideVertical(player, level);
+}
+
+int isPositionCollidingAt(const Level* level, int screenX, int screenY) {
+    return hitboxCollidesNormal(level, screenX, screenY);
+}
+
+int isHitboxCollidingAt(const Level* level, HitboxId hitbox, int screenX, int screenY) {
+    return s_hitboxRoutines[hitbox].collides(level, screenX, screenY);
+}
+
+int checkWallAt(const Player* player, const Level* level, int dir, int yAdd, int dist) {
+    int screenX = player->x >> FIXED_SHIFT;
+    int screenY = (player->y >> FIXED_SHIFT) + yAdd;
+
+    // Check for wall at requested distance (from player center)
+    int checkX = screenX + (dir * dist);
+    int checkY = screenY;
+
+    return isHitboxCollidingAt(level, playerHitbox(player), checkX, checkY);
+}
+
+int checkWall(const Player* player, const Level* level, int dir) {
+    return checkWallAt(player, level, dir, 0, WALL_JUMP_CHECK_DIST);
+}
+
+int checkCeiling(const Player* player, const Level* level) {
+    // Unducking swaps the duck hitbox for the standing one around the same
+    // bottom edge; it is blocked if the standing hitbox would overlap a solid
+    // tile there (Celeste CanUnDuck). JumpThru never blocks it.
+    int screenX = player->x >> FIXED_SHIFT;
+    int screenY = player->y >> FIXED_SHIFT;
+
+    return hitboxCollidesNormal(level, screenX, screenY);
+}
+
+#ifdef DESKTOP_BUILD
+// noclone: keep GCC from propagating the benchmark's sizes into a copy
+__attribute__((noinline, noclone))
+int hitboxCollidesSized(const Level* level, int screenX, int screenY, int width, int height) {
+    return hitboxCollidesBody(level, screenX, screenY, width, height);
+}
+
+__attribute__((noinline, noclone))
+void collideHorizontalSized(Player* player, const Level* level, int width, int height) {
+    collideHorizontalBody(player, level, width, height, NULL);
+}
+
+__attribute__((noinline, noclone))
+void collideVerticalSized(Player* player, const Level* level, int width, int height) {
+    collideVerticalBody(player, level, width, height, NULL);
+}
+#endif
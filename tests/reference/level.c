@@ -0,0 +1,382 @@
+#include "level.h"
+#include "grassy_stone.h"
+#include "plants.h"
+#include "decals.h"
+
+// ---------------------------------------------------------------------------
+// Decompressed tile data buffers (in EWRAM on GBA)
+// Sized for the largest possible level: 512x40 tiles, 2 layers
+// ---------------------------------------------------------------------------
+#define TILE_BUFFER_SIZE (512 * 40 * 2)  // u16s, covers 2 layers of 512x40
+
+#ifdef DESKTOP_BUILD
+static u16 g_tileBuffer[TILE_BUFFER_SIZE];
+static u16 g_tileBBuffer[TILE_BUFFER_SIZE];
+#else
+static u16 g_tileBuffer[TILE_BUFFER_SIZE]  __attribute__((section(".ewram"), aligned(4)));
+static u16 g_tileBBuffer[TILE_BUFFER_SIZE] __attribute__((section(".ewram"), aligned(4)));
+#endif
+u16* g_levelLayerTiles[4]  = {0, 0, 0, 0};
+u16* g_levelBLayerTiles[4] = {0, 0, 0, 0};
+static u16 g_tileEntryTableA[LEVEL_VRAM_TILE_LIMIT];
+static u16 g_tileEntryTableB[LEVEL_VRAM_TILE_LIMIT];
+u16* g_levelTileEntries  = g_tileEntryTableA;
+u16* g_levelBTileEntries = g_tileEntryTableB;
+
+// ---------------------------------------------------------------------------
+// Room residency
+//
+// Each slot pairs a decompressed tile buffer with its entry table and records
+// which level it holds and where that level's tile graphics sit in VRAM. A
+// room that is still resident (e.g. the one just left through a scroll
+// transition) is reused without decompressing or uploading again. Slots are
+// recycled least-recently-used; the main slot is never chosen as a victim,
+// so g_levelLayerTiles and the next loadLevelBToVRAM call always use
+// different physical storage.
+// ---------------------------------------------------------------------------
+typedef struct {
+    u16* tiles;             // Decompressed layers (TILE_BUFFER_SIZE u16s)
+    u16* entries;           // Tile entry table (LEVEL_VRAM_TILE_LIMIT u16s)
+    const Level* level;     // Resident level, 0 if empty
+    s16 entryVramOffset;    // VRAM offset the entry table was built for, -1 if none
+    s16 vramOffset;         // First VRAM slot holding this level's tiles, -1 if not resident
+    u32 lastUse;
+} RoomSlot;
+
+static RoomSlot s_rooms[LEVEL_ROOM_SLOTS] = {
+    { g_tileBuffer,  g_tileEntryTableA, 0, -1, -1, 0 },
+    { g_tileBBuffer, g_tileEntryTableB, 0, -1, -1, 0 },
+};
+static int s_mainRoom = 0;
+static int s_secRoom  = 1;
+static u32 s_roomClock = 0;
+
+static int g_tileVramOffset = 0;
+static int g_levelBTileVramOffset = 0;
+int getLevelTileVramOffset(void) { return g_tileVramOffset; }
+void setLevelTileVramOffset(int offset) { g_tileVramOffset = offset; }
+
+#ifdef DESKTOP_BUILD
+// Test helpers: expose which physical buffer main and secondary currently use.
+const u16* getMainBufBase(void)  { return s_rooms[s_mainRoom].tiles; }
+const u16* getSecBufBase(void)   { return s_rooms[s_secRoom].tiles; }
+const u16* getTileBufA(void)     { return g_tileBuffer; }
+const u16* getTileBufB(void)     { return g_tileBBuffer; }
+static u16 g_desktopVramTiles[LEVEL_VRAM_TILE_LIMIT];
+const u16* getDesktopVramTiles(void) { return g_desktopVramTiles; }
+#endif
+
+// ---------------------------------------------------------------------------
+// Desktop stub for BIOS RLE decompression (GBA provides this via SWI 0x14)
+// ---------------------------------------------------------------------------
+#ifdef DESKTOP_BUILD
+static void RLUnCompWram(const void* src, void* dst) {
+    const u8* s = (const u8*)src;
+    u8* d = (u8*)dst;
+    u32 decompressed_size = (u32)s[1] | ((u32)s[2] << 8) | ((u32)s[3] << 16);
+    const u8* start = s;
+    s += 4;
+    u32 written = 0;
+    while (written < decompressed_size) {
+        u8 flag = *s++;
+        if (flag & 0x80) {
+            u32 len = (flag & 0x7F) + 3;
+            u8 val = *s++;
+            for (u32 j = 0; j < len && written < decompressed_size; j++, written++)
+                *d++ = val;
+        } else {
+            u32 len = (flag & 0x7F) + 1;
+            for (u32 j = 0; j < len && written < decompressed_size; j++, written++)
+                *d++ = *s++;
+        }
+    }
+    // BIOS SWI 0x14: byte reads from ROM, byte writes to EWRAM, ~4 insns/byte.
+    COST_ACCESS(COST_ROM, 1, (int)(s - start));
+    COST_ACCESS(COST_EWRAM, 1, (int)decompressed_size);
+    COST_INSNS((int)decompressed_size * 4);
+}
+#endif
+
+static void buildTileEntryTable(const Level* level, int vramOffset, u16* table) {
+    for (int i = 0; i < LEVEL_VRAM_TILE_LIMIT; i++) {
+        table[i] = 0;
+    }
+
+    u16 limit = level->uniqueTileCount;
+    if (limit > LEVEL_VRAM_TILE_LIMIT) {
+        limit = LEVEL_VRAM_TILE_LIMIT;
+    }
+
+    for (u16 i = 1; i < limit; i++) {
+        table[i] = (u16)(i + vramOffset) | ((u16)level->tilePaletteBanks[i] << 12);
+    }
+    COST_ACCESS(COST_IWRAM, 2, LEVEL_VRAM_TILE_LIMIT + limit);
+    COST_ACCESS(COST_ROM, 1, limit);
+}
+
+#define TILESET_COUNT 3
+
+// Palette bank for each tileset
+#define PALETTE_GRASSY_STONE 0
+#define PALETTE_PLANTS 2
+#define PALETTE_DECALS 3
+
+// Tileset metadata
+typedef struct {
+    u16 firstTileId;
+    u16 lastTileId;
+    const unsigned int* tileData;
+    u8 paletteBank;
+} TilesetMetadata;
+
+#ifndef DESKTOP_BUILD
+static const TilesetMetadata tilesets[TILESET_COUNT] = {
+    { 1, 55, grassy_stoneTiles, PALETTE_GRASSY_STONE },
+    { 56, 215, plantsTiles, PALETTE_PLANTS },
+    { 216, 1440, decalsTiles, PALETTE_DECALS }
+};
+
+static const TilesetMetadata* findTilesetForTile(u16 originalTileId) {
+    if (originalTileId >= tilesets[0].firstTileId && originalTileId <= tilesets[0].lastTileId) {
+        return &tilesets[0];
+    }
+    if (originalTileId >= tilesets[1].firstTileId && originalTileId <= tilesets[1].lastTileId) {
+        return &tilesets[1];
+    }
+    if (originalTileId >= tilesets[2].firstTileId && originalTileId <= tilesets[2].lastTileId) {
+        return &tilesets[2];
+    }
+    return 0;
+}
+#endif
+
+// Internal: write one level's unique tiles into VRAM starting at vramSlot.
+static void writeTilesToVRAM(const Level* level, int vramSlot) {
+#ifdef DESKTOP_BUILD
+    for (u16 i = 0; i < level->uniqueTileCount && (vramSlot + i) < LEVEL_VRAM_TILE_LIMIT; i++) {
+        g_desktopVramTiles[vramSlot + i] = level->uniqueTileIds[i];
+    }
+    // One 32-byte tile copied ROM -> VRAM per unique tile.
+    COST_ACCESS(COST_ROM, 4, level->uniqueTileCount * 8);
+    COST_ACCESS(COST_VRAM, 4, level->uniqueTileCount * 8);
+    return;
+#else
+    volatile u32* bgTiles = (volatile u32*)0x06000000;
+
+    for (u16 i = 0; i < level->uniqueTileCount; ) {
+        u16 originalTileId = level->uniqueTileIds[i];
+        u32 dstOffset = (vramSlot + i) * 8;
+
+        if (originalTileId == 0) {
+            u16 runLength = 1;
+            while ((u16)(i + runLength) < level->uniqueTileCount &&
+                   level->uniqueTileIds[i + runLength] == 0) {
+                runLength++;
+            }
+
+            u32 wordCount = (u32)runLength * 8;
+            for (u32 j = 0; j < wordCount; j++) {
+                bgTiles[dstOffset + j] = 0x00000000;
+            }
+
+            i += runLength;
+            continue;
+        }
+
+        const TilesetMetadata* tileset = findTilesetForTile(originalTileId);
+        if (!tileset) {
+            i++;
+            continue;
+        }
+
+        u16 runLength = 1;
+        while ((u16)(i + runLength) < level->uniqueTileCount) {
+            u16 nextTileId = level->uniqueTileIds[i + runLength];
+            if (nextTileId != (u16)(originalTileId + runLength) ||
+                nextTileId > tileset->lastTileId) {
+                break;
+            }
+            runLength++;
+        }
+
+        u16 tilesetIndex = originalTileId - tileset->firstTileId;
+        u32 srcOffset  = tilesetIndex * 8;
+        u32 wordCount = (u32)runLength * 8;
+        const u32* src = (const u32*)&tileset->tileData[srcOffset];
+        for (u32 j = 0; j < wordCount; j++) {
+            bgTiles[dstOffset + j] = src[j];
+        }
+
+        i += runLength;
+    }
+#endif // DESKTOP_BUILD
+}
+
+static int findResidentRoom(const Level* level) {
+    for (int i = 0; i < LEVEL_ROOM_SLOTS; i++) {
+        if (s_rooms[i].level == level) return i;
+    }
+    return -1;
+}
+
+// Slot for `level`, excluding `keep`: the resident copy if there is one,
+// else an empty slot, else the least recently used one.
+static int chooseRoom(const Level* level, int keep) {
+    int resident = findResidentRoom(level);
+    if (resident >= 0 && resident != keep) return resident;
+
+    int victim = -1;
+    for (int i = 0; i < LEVEL_ROOM_SLOTS; i++) {
+        if (i == keep) continue;
+        if (!s_rooms[i].level) return i;
+        if (victim < 0 || s_rooms[i].lastUse < s_rooms[victim].lastUse) victim = i;
+    }
+    return victim;
+}
+
+// Make `room` hold `level`'s decompressed layers and its tiles at vramOffset,
+// doing only the work the residency table says is missing.
+static void fillRoom(int room, const Level* level, int vramOffset) {
+    RoomSlot* slot = &s_rooms[room];
+    slot->lastUse = ++s_roomClock;
+
+    if (slot->level != level) {
+        u16* bufPtr = slot->tiles;
+        u32 tilesPerLayer = (u32)level->width * level->height;
+        for (u8 i = 0; i < level->layerCount && i < 4; i++) {
+            RLUnCompWram(level->layers[i].rleData, bufPtr);
+            bufPtr += tilesPerLayer;
+        }
+        slot->level = level;
+        slot->entryVramOffset = -1;
+        slot->vramOffset = -1;
+    }
+
+    if (slot->entryVramOffset != vramOffset) {
+        buildTileEntryTable(level, vramOffset, slot->entries);
+        slot->entryVramOffset = (s16)vramOffset;
+    }
+
+    if (slot->vramOffset != vramOffset) {
+        // Uploading over another room's range evicts its VRAM residency
+        int end = vramOffset + level->uniqueTileCount;
+        for (int i = 0; i < LEVEL_ROOM_SLOTS; i++) {
+            RoomSlot* other = &s_rooms[i];
+            if (i == room || other->vramOffset < 0) continue;
+            int otherEnd = other->vramOffset + other->level->uniqueTileCount;
+            if (other->vramOffset < end && vramOffset < otherEnd) {
+                other->vramOffset = -1;
+            }
+        }
+        writeTilesToVRAM(level, vramOffset);
+        slot->vramOffset = (s16)vramOffset;
+    }
+}
+
+static void bindRoomLayers(u16** layers, int room) {
+    const Level* level = s_rooms[room].level;
+    u16* bufPtr = s_rooms[room].tiles;
+    u32 tilesPerLayer = (u32)level->width * level->height;
+    for (u8 i = 0; i < 4; i++) {
+        if (i < level->layerCount) {
+            layers[i] = bufPtr;
+            bufPtr += tilesPerLayer;
+        } else {
+            layers[i] = 0;
+        }
+    }
+}
+
+void loadLevelToVRAM(const Level* level) {
+    g_tileVramOffset = 0;
+    g_levelBTileVramOffset = 0;
+
+    int room = findResidentRoom(level);
+    if (room < 0) room = chooseRoom(level, -1);
+    if (room == s_secRoom) {
+        s_secRoom = s_mainRoom;
+    }
+    s_mainRoom = room;
+
+    fillRoom(room, level, 0);
+    bindRoomLayers(g_levelLayerTiles, room);
+    g_levelTileEntries = s_rooms[room].entries;
+}
+
+void loadLevelBToVRAM(const Level* level, int vramOffset) {
+    g_levelBTileVramOffset = vramOffset;
+
+    int room = chooseRoom(level, s_mainRoom);
+    s_secRoom = room;
+
+    fillRoom(room, level, vramOffset);
+    bindRoomLayers(g_levelBLayerTiles, room);
+    g_levelBTileEntries = s_rooms[room].entries;
+}
+
+void adoptLevelBBuffer(const Level* level) {
+    // Fast path used at scroll transition end: level B was already decompressed
+    // by loadLevelBToVRAM and its tile graphics are already in VRAM at
+    // g_levelBTileVramOffset. Swap main and secondary so that the next
+    // loadLevelBToVRAM call never picks the room g_levelLayerTiles now points
+    // into; the room just left stays resident for a cheap return trip.
+    int tmp    = s_mainRoom;
+    s_mainRoom = s_secRoom;
+    s_secRoom  = tmp;
+    s_rooms[s_mainRoom].lastUse = ++s_roomClock;
+    g_levelTileEntries = s_rooms[s_mainRoom].entries;
+    g_levelBTileEntries = s_rooms[s_secRoom].entries;
+
+    g_tileVramOffset = g_levelBTileVramOffset;
+    for (u8 i = 0; i < level->layerCount && i < 4; i++) {
+        g_levelLayerTiles[i] = g_levelBLayerTiles[i];
+        g_levelBLayerTiles[i] = 0;
+    }
+    for (u8 i = level->layerCount; i < 4; i++) {
+        g_levelLayerTiles[i] = 0;
+        g_levelBLayerTiles[i] = 0;
+    }
+    g_levelBTileVramOffset = 0;
+}
+
+#ifdef DESKTOP_BUILD
+void invalidateLevelResidency(void) {
+    for (int i = 0; i < LEVEL_ROOM_SLOTS; i++) {
+        s_rooms[i].level = 0;
+        s_rooms[i].entryVramOffset = -1;
+        s_rooms[i].vramOffset = -1;
+    }
+}
+#endif
+
+int isLayerRegionEmpty(const Level* level, u8 layerIndex, int x0, int y0, int x1, int y1) {
+    if (layerIndex >= level->layerCount) return 1;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= level->width) x1 = level->width - 1;
+    if (y1 >= level->height) y1 = level->height - 1;
+    if (x0 > x1 || y0 > y1) return 1;
+
+    for (int cy = y0 >> LEVEL_CHUNK_SHIFT; cy <= (y1 >> LEVEL_CHUNK_SHIFT); cy++) {
+        for (int cx = x0 >> LEVEL_CHUNK_SHIFT; cx <= (x1 >> LEVEL_CHUNK_SHIFT); cx++) {
+            if (isLayerChunkOccupied(level, layerIndex, cx, cy)) return 0;
+        }
+    }
+    return 1;
+}
+
+u16 getVramTileIndex(u16 vramIndex) {
+    // Tiles are already VRAM indices (remapped at build time)
+    return vramIndex;
+}
+
+u8 getTilePaletteBank(u16 vramIndex, const Level* level) {
+    // Palette banks are pre-computed at build time
+    if (vramIndex >= level->uniqueTileCount) return 0;
+    return level->tilePaletteBanks[vramIndex];
+}
+
+int isTileDecorative(u16 vramIndex, const Level* level) {
+    // Not needed anymore - no separate layers
+    return 0;
+}
@@ -0,0 +1,61 @@
+// Generated by `make refresh-reference`: renames every global the frozen
+// modules define, so they link next to the live ones.
+#ifndef REFERENCE_NAMES_H
+#define REFERENCE_NAMES_H
+#define checkCeiling ref_checkCeiling
+#define checkWall ref_checkWall
+#define checkWallAt ref_checkWallAt
+#define collideHorizontal ref_collideHorizontal
+#define collideHorizontalSized ref_collideHorizontalSized
+#define collideVertical ref_collideVertical
+#define collideVerticalSized ref_collideVerticalSized
+#define hitboxCollidesSized ref_hitboxCollidesSized
+#define isHitboxCollidingAt ref_isHitboxCollidingAt
+#define isPositionCollidingAt ref_isPositionCollidingAt
+#define adoptLevelBBuffer ref_adoptLevelBBuffer
+#define g_levelBLayerTiles ref_g_levelBLayerTiles
+#define g_levelBTileEntries ref_g_levelBTileEntries
+#define g_levelLayerTiles ref_g_levelLayerTiles
+#define g_levelTileEntries ref_g_levelTileEntries
+#define getDesktopVramTiles ref_getDesktopVramTiles
+#define getLevelTileVramOffset ref_getLevelTileVramOffset
+#define getMainBufBase ref_getMainBufBase
+#define getSecBufBase ref_getSecBufBase
+#define getTileBufA ref_getTileBufA
+#define getTileBufB ref_getTileBufB
+#define getTilePaletteBank ref_getTilePaletteBank
+#define getVramTileIndex ref_getVramTileIndex
+#define invalidateLevelResidency ref_invalidateLevelResidency
+#define isLayerRegionEmpty ref_isLayerRegionEmpty
+#define isTileDecorative ref_isTileDecorative
+#define loadLevelBToVRAM ref_loadLevelBToVRAM
+#define loadLevelToVRAM ref_loadLevelToVRAM
+#define setLevelTileVramOffset ref_setLevelTileVramOffset
+#define currentTileEntryAt ref_currentTileEntryAt
+#define enterLevelTilemap ref_enterLevelTilemap
+#define getGameplayScreenBase ref_getGameplayScreenBase
+#define prefillScrollIncomingOverlap ref_prefillScrollIncomingOverlap
+#define prefillScrollSeam ref_prefillScrollSeam
+#define queueGameplayBgControl ref_queueGameplayBgControl
+#define resetGameplayScreenBases ref_resetGameplayScreenBases
+#define resetTilemapState ref_resetTilemapState
+#define scrollTileEntryAt ref_scrollTileEntryAt
+#define updateTilemapForCamera ref_updateTilemapForCamera
+#define writeHorizontalScrollRow ref_writeHorizontalScrollRow
+#define writeVerticalScrollColumn ref_writeVerticalScrollColumn
+#define clearTransitionTestOverrides ref_clearTransitionTestOverrides
+#define consumeTransitionSeamPrefill ref_consumeTransitionSeamPrefill
+#define getScrollTileEntry ref_getScrollTileEntry
+#define getScrollTransInfo ref_getScrollTransInfo
+#define getTransitionVirtualCamera ref_getTransitionVirtualCamera
+#define initTransition ref_initTransition
+#define isTransitioning ref_isTransitioning
+#define setTransitionLevelContext ref_setTransitionLevelContext
+#define setTransitionTestOverrides ref_setTransitionTestOverrides
+#define tryTriggerTransition ref_tryTriggerTransition
+#define updateTransition ref_updateTransition
+#define loadLevelForTransition ref_loadLevelForTransition
+#include "level/level.h"
+#include "tile_collision.h"
+#define getTileCollision ref_getTileCollision
+#endif
@@ -0,0 +1,881 @@
+#include "scroll_tilemap.h"
+#include "core/vram_layout.h"
+#include "core/vblank_queue.h"
+#include "core/overlay.h"
+
+// Gameplay BG layers the tilemap writer maintains (BG1/BG2)
+#define TILEMAP_LAYERS 2
+
+static int floorDiv8(int v) {
+    return (v >= 0) ? (v / 8) : -(((-v) + 7) / 8);
+}
+
+// ---------------------------------------------------------------------------
+// Gameplay screenblock pairs
+//
+// BG1 and BG2 each own a primary (SB_BG1/SB_BG2) and a spare
+// (SB_BG1_BACK/SB_BG2_BACK) screenblock. Which one is displayed is hardware
+// state, so it lives here rather than in TilemapState.
+// ---------------------------------------------------------------------------
+static u8 s_showingSpare[4];
+static u8 s_bgPriority[4] = { 3, 0, 1, 0 };
+
+static u8 spareScreenBase(u8 bgLayer) {
+    if (bgLayer == 1) return SB_BG1_BACK;
+    if (bgLayer == 2) return SB_BG2_BACK;
+    return 0;
+}
+
+u8 getGameplayScreenBase(u8 bgLayer) {
+    bgLayer &= 3;
+    return s_showingSpare[bgLayer] ? spareScreenBase(bgLayer) : (u8)(SB_NIGHTSKY + bgLayer);
+}
+
+// The screenblock BG `bgLayer` is not displaying (its displayed one if it has
+// no spare, in which case refreshes are written live as before).
+static u8 hiddenScreenBase(u8 bgLayer) {
+    bgLayer &= 3;
+    if (!spareScreenBase(bgLayer)) {
+        return (u8)(SB_NIGHTSKY + bgLayer);
+    }
+    return s_showingSpare[bgLayer] ? (u8)(SB_NIGHTSKY + bgLayer) : spareScreenBase(bgLayer);
+}
+
+void queueGameplayBgControl(u8 bgLayer, u8 priority) {
+    bgLayer &= 3;
+    s_bgPriority[bgLayer] = priority;
+    u16 cnt = (u16)((getGameplayScreenBase(bgLayer) << 8) | (0 << 2) | (priority << 0));
+    if (bgLayer == 1) {
+        vblankQueueReg(VREG_BG1CNT, cnt);
+    } else if (bgLayer == 2) {
+        vblankQueueReg(VREG_BG2CNT, cnt);
+    }
+}
+
+#ifdef DESKTOP_BUILD
+void resetGameplayScreenBases(void) {
+    for (int i = 0; i < 4; i++) {
+        s_showingSpare[i] = 0;
+    }
+}
+#endif
+
+static void flipGameplayScreenBase(u8 bgLayer) {
+    if (!spareScreenBase(bgLayer)) {
+        return;
+    }
+    s_showingSpare[bgLayer] ^= 1;
+    queueGameplayBgControl(bgLayer, s_bgPriority[bgLayer]);
+}
+
+void resetTilemapState(TilemapState* ts) {
+    ts->oldCameraTileX = 0;
+    ts->oldCameraTileY = 0;
+    ts->oldCameraTileValid = 0;
+    ts->wasScrolling = 0;
+    ts->lastScrollToTileX0 = 0;
+    ts->lastScrollToTileY0 = 0;
+    ts->lastScrollBgOriginX = 0;
+    ts->lastScrollBgOriginY = 0;
+    ts->lastScrollCanReuseTilemapOnCommit = 0;
+    ts->bgTileOriginX = 0;
+    ts->bgTileOriginY = 0;
+    for (int i = 0; i < 4; i++) {
+        ts->screenBlank[i] = 0;
+    }
+    ts->refreshPending = 0;
+    ts->refreshUrgent = 0;
+    ts->refreshRow = 0;
+    ts->refreshLevel = 0;
+    ts->refreshBuilt = 0;
+    ts->refreshBlank = 0;
+    ts->shownBgCameraValid = 0;
+}
+
+// One level's contribution to a visible row or column: map range
+// [start, end] along the line, starting at local tile (localX, localY).
+typedef struct {
+    int start;
+    int end;
+    const Level* level;
+    const u16* tiles;
+    const u16* entryTable;
+    int localX;
+    int localY;
+} LayerSpan;
+
+// Write `count` entries of one level layer to line[(mapStart + i) & 31],
+// walking the layer from local tile (localX, localY) along a row
+// (vertical = 0) or a column (vertical = 1). Chunks whose occupancy bit is
+// clear are zero-filled without reading the tile buffer or entry table.
+static inline __attribute__((always_inline))
+void writeLayerSpan(u16* line, int mapStart, int count,
+                    const Level* level, u8 layerIdx,
+                    const u16* tiles, const u16* entryTable,
+                    int localX, int localY, int vertical) {
+    int stride = vertical ? level->width : 1;
+    const u16* src = tiles + localY * level->width + localX;
+    int map = mapStart;
+
+    while (count > 0) {
+        int along = vertical ? localY : localX;
+        int run = LEVEL_CHUNK_SIZE - (along & (LEVEL_CHUNK_SIZE - 1));
+        if (run > count) {
+            run = count;
+        }
+
+        if (isLayerChunkOccupied(level, layerIdx,
+                                 localX >> LEVEL_CHUNK_SHIFT, localY >> LEVEL_CHUNK_SHIFT)) {
+            for (int i = 0; i < run; i++) {
+                line[(map + i) & 31] = entryTable[*src];
+                src += stride;
+            }
+        } else {
+            for (int i = 0; i < run; i++) {
+                line[(map + i) & 31] = 0;
+            }
+            src += run * stride;
+        }
+
+        map += run;
+        count -= run;
+        if (vertical) {
+            localY += run;
+        } else {
+            localX += run;
+        }
+    }
+}
+
+// Fill line[] for the 32 visible map positions [visible0, visible0 + 31]
+// from up to two spans (in either order), zeroing every gap around them.
+static inline __attribute__((always_inline))
+void writeSpannedLine(u16* line, u8 layerIdx, LayerSpan* spans, int spanCount,
+                      int visible0, int vertical) {
+    const int visible1 = visible0 + 31;
+
+    if (spanCount == 2 && spans[1].start < spans[0].start) {
+        LayerSpan tmp = spans[0];
+        spans[0] = spans[1];
+        spans[1] = tmp;
+    }
+
+    int cursor = visible0;
+    for (int spanIdx = 0; spanIdx < spanCount; spanIdx++) {
+        const LayerSpan* span = &spans[spanIdx];
+        for (int m = cursor; m < span->start; m++) {
+            line[m & 31] = 0;
+        }
+        writeLayerSpan(line, span->start, span->end - span->start + 1,
+                       span->level, layerIdx, span->tiles, span->entryTable,
+                       span->localX, span->localY, vertical);
+        cursor = span->end + 1;
+    }
+
+    for (int m = cursor; m <= visible1; m++) {
+        line[m & 31] = 0;
+    }
+}
+
+// Outside a transition: the current level's entries for map row ly
+// (vertical = 0, fixed = ly) or map column lx (vertical = 1, fixed = lx).
+static void writeCurrentLine(u16* line, const Level* level, u8 layerIdx,
+                             int tileOriginX, int tileOriginY,
+                             int visible0, int fixed, int vertical) {
+    LayerSpan span;
+    int spanCount = 0;
+    int fixedLocal = fixed - (vertical ? tileOriginX : tileOriginY);
+    int fixedLimit = vertical ? level->width : level->height;
+
+    if (layerIdx < level->layerCount && g_levelLayerTiles[layerIdx] &&
+        fixedLocal >= 0 && fixedLocal < fixedLimit) {
+        int origin = vertical ? tileOriginY : tileOriginX;
+        int length = vertical ? level->height : level->width;
+        int start = origin > visible0 ? origin : visible0;
+        int end = origin + length - 1;
+        if (end > visible0 + 31) {
+            end = visible0 + 31;
+        }
+        if (start <= end) {
+            span.start = start;
+            span.end = end;
+            span.level = level;
+            span.tiles = g_levelLayerTiles[layerIdx];
+            span.entryTable = g_levelTileEntries;
+            span.localX = vertical ? fixedLocal : (start - origin);
+            span.localY = vertical ? (start - origin) : fixedLocal;
+            spanCount = 1;
+        }
+    }
+
+    writeSpannedLine(line, layerIdx, &span, spanCount, visible0, vertical);
+}
+
+static u16 incomingTileEntryAt(const Level* level, u8 layerIdx, int localX, int localY) {
+    if (layerIdx >= level->layerCount) {
+        return 0;
+    }
+    if (localX < 0 || localX >= level->width || localY < 0 || localY >= level->height) {
+        return 0;
+    }
+    if (!g_levelBLayerTiles[layerIdx]) {
+        return 0;
+    }
+
+    u16 tid = g_levelBLayerTiles[layerIdx][localY * level->width + localX];
+    return mapTileEntry(g_levelBTileEntries, tid);
+}
+
+u16 currentTileEntryAt(const Level* level, u8 layerIdx, int localX, int localY) {
+    if (layerIdx >= level->layerCount) {
+        return 0;
+    }
+    if (localX < 0 || localX >= level->width || localY < 0 || localY >= level->height) {
+        return 0;
+    }
+    if (!g_levelLayerTiles[layerIdx]) {
+        return 0;
+    }
+
+    u16 tid = g_levelLayerTiles[layerIdx][localY * level->width + localX];
+    return mapTileEntry(g_levelTileEntries, tid);
+}
+
+u16 scrollTileEntryAt(const ScrollTransInfo* scrollInfo, u8 layerIdx, int virtualTileX, int virtualTileY) {
+    const Level* fromLevel = scrollInfo->fromLevel;
+    int fromLocalX = virtualTileX - scrollInfo->fromTileX0;
+    int fromLocalY = virtualTileY - scrollInfo->fromTileY0;
+    if (fromLocalX >= 0 && fromLocalX < fromLevel->width &&
+        fromLocalY >= 0 && fromLocalY < fromLevel->height) {
+        return currentTileEntryAt(fromLevel, layerIdx, fromLocalX, fromLocalY);
+    }
+
+    {
+        const Level* toLevel = scrollInfo->toLevel;
+        int toLocalX = virtualTileX - scrollInfo->toTileX0;
+        int toLocalY = virtualTileY - scrollInfo->toTileY0;
+        if (toLocalX >= 0 && toLocalX < toLevel->width &&
+            toLocalY >= 0 && toLocalY < toLevel->height) {
+            return incomingTileEntryAt(toLevel, layerIdx, toLocalX, toLocalY);
+        }
+    }
+
+    return 0;
+}
+
+void prefillScrollSeam(volatile u16* bgMap, u8 layerIdx,
+                       const ScrollTransInfo* scrollInfo,
+                       int scrollBgOriginX, int scrollBgOriginY,
+                       int cameraTileX, int cameraTileY) {
+    const Level* toLevel = scrollInfo->toLevel;
+    int incomingX0 = scrollBgOriginX + scrollInfo->toTileX0;
+    int incomingY0 = scrollBgOriginY + scrollInfo->toTileY0;
+
+    if (scrollInfo->seamPrefillAxis == 1) {
+        int seamStartsOnRight = scrollInfo->toTileX0 > scrollInfo->fromTileX0;
+        for (int s = 0; s < 2; s++) {
+            int localX = seamStartsOnRight ? s : (toLevel->width - 1 - s);
+            int mapX = incomingX0 + localX;
+            int mx = mapX & 31;
+            for (int ty = 0; ty < 32; ty++) {
+                int mapY = cameraTileY + ty;
+                int localY = mapY - incomingY0;
+                bgMap[(mapY & 31) * 32 + mx] =
+                    incomingTileEntryAt(toLevel, layerIdx, localX, localY);
+            }
+            VRAM_NOTE_MAP_WRITES(&bgMap[mx], 32, 32);
+        }
+    } else if (scrollInfo->seamPrefillAxis == 2) {
+        int seamStartsBelow = scrollInfo->toTileY0 > scrollInfo->fromTileY0;
+        for (int s = 0; s < 2; s++) {
+            int localY = seamStartsBelow ? s : (toLevel->height - 1 - s);
+            int mapY = incomingY0 + localY;
+            int my = mapY & 31;
+            for (int tx = 0; tx < 32; tx++) {
+                int mapX = cameraTileX + tx;
+                int localX = mapX - incomingX0;
+                bgMap[my * 32 + (mapX & 31)] =
+                    incomingTileEntryAt(toLevel, layerIdx, localX, localY);
+            }
+            VRAM_NOTE_MAP_WRITES(&bgMap[my * 32], 32, 1);
+        }
+    }
+}
+
+void prefillScrollIncomingOverlap(const Level* currentLevel,
+                                  const ScrollTransInfo* scrollInfo,
+                                  int scrollBgOriginX, int scrollBgOriginY,
+                                  int cameraTileX, int cameraTileY) {
+    int incomingX0 = scrollBgOriginX + scrollInfo->toTileX0;
+    int incomingY0 = scrollBgOriginY + scrollInfo->toTileY0;
+    int incomingX1 = incomingX0 + scrollInfo->toLevel->width - 1;
+    int incomingY1 = incomingY0 + scrollInfo->toLevel->height - 1;
+
+    int windowX0 = cameraTileX;
+    int windowY0 = cameraTileY;
+    int windowX1 = cameraTileX + 31;
+    int windowY1 = cameraTileY + 31;
+
+    int startX = incomingX0 > windowX0 ? incomingX0 : windowX0;
+    int startY = incomingY0 > windowY0 ? incomingY0 : windowY0;
+    int endX = incomingX1 < windowX1 ? incomingX1 : windowX1;
+    int endY = incomingY1 < windowY1 ? incomingY1 : windowY1;
+
+    if (startX > endX || startY > endY) {
+        return;
+    }
+
+    const u8 MAX_BG_LAYERS = 2;
+    const Level* toLevel = scrollInfo->toLevel;
+    for (u8 layerIdx = 0; layerIdx < MAX_BG_LAYERS; layerIdx++) {
+        u8 bgLayer;
+        if (layerIdx < currentLevel->layerCount) {
+            bgLayer = currentLevel->layers[layerIdx].bgLayer;
+        } else if (layerIdx < toLevel->layerCount) {
+            bgLayer = toLevel->layers[layerIdx].bgLayer;
+        } else {
+            bgLayer = layerIdx;
+        }
+
+        {
+            u8 screenBase = getGameplayScreenBase(bgLayer);
+            volatile u16* bgMap = vramScreenblock(screenBase);
+            for (int mapY = startY; mapY <= endY; mapY++) {
+                int rowBase = (mapY & 31) * 32;
+                int localY = mapY - incomingY0;
+                if (layerIdx < toLevel->layerCount && g_levelBLayerTiles[layerIdx]) {
+                    const u16* src =
+                        g_levelBLayerTiles[layerIdx] + localY * toLevel->width + (startX - incomingX0);
+                    const u16* entryTable = g_levelBTileEntries;
+                    for (int mapX = startX; mapX <= endX; mapX++) {
+                        bgMap[rowBase + (mapX & 31)] = entryTable[*src++];
+                        VRAM_NOTE_MAP_WRITES(&bgMap[rowBase + (mapX & 31)], 1, 1);
+                    }
+                } else {
+                    for (int mapX = startX; mapX <= endX; mapX++) {
+                        bgMap[rowBase + (mapX & 31)] = 0;
+                        VRAM_NOTE_MAP_WRITES(&bgMap[rowBase + (mapX & 31)], 1, 1);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Span writers: the per-frame hot path of a scroll transition. Each body is
+// inlined into a transition IWRAM overlay copy and a ROM copy; the public
+// functions dispatch on overlay residency.
+static inline __attribute__((always_inline))
+void horizontalScrollRowBody(u16* line,
+                             u8 layerIdx,
+                             const ScrollTransInfo* scrollInfo,
+                             int tileOriginX, int tileOriginY,
+                             int cameraTileX,
+                             int ly) {
+    const int visibleX0 = cameraTileX;
+    const int visibleX1 = cameraTileX + 31;
+    LayerSpan spans[2];
+    int spanCount = 0;
+
+    const Level* fromLevel = scrollInfo->fromLevel;
+    int fromLocalY = ly - (tileOriginY + scrollInfo->fromTileY0);
+    if (layerIdx < fromLevel->layerCount &&
+        fromLocalY >= 0 && fromLocalY < fromLevel->height &&
+        g_levelLayerTiles[layerIdx]) {
+        int fromMapX0 = tileOriginX + scrollInfo->fromTileX0;
+        int startX = fromMapX0 > visibleX0 ? fromMapX0 : visibleX0;
+        int endX = fromMapX0 + fromLevel->width - 1;
+        if (endX > visibleX1) {
+            endX = visibleX1;
+        }
+        if (startX <= endX) {
+            spans[spanCount].start = startX;
+            spans[spanCount].end = endX;
+            spans[spanCount].level = fromLevel;
+            spans[spanCount].tiles = g_levelLayerTiles[layerIdx];
+            spans[spanCount].entryTable = g_levelTileEntries;
+            spans[spanCount].localX = startX - fromMapX0;
+            spans[spanCount].localY = fromLocalY;
+            spanCount++;
+        }
+    }
+
+    {
+        const Level* toLevel = scrollInfo->toLevel;
+        int toLocalY = ly - (tileOriginY + scrollInfo->toTileY0);
+        if (layerIdx < toLevel->layerCount &&
+            toLocalY >= 0 && toLocalY < toLevel->height &&
+            g_levelBLayerTiles[layerIdx]) {
+            int toMapX0 = tileOriginX + scrollInfo->toTileX0;
+            int startX = toMapX0 > visibleX0 ? toMapX0 : visibleX0;
+            int endX = toMapX0 + toLevel->width - 1;
+            if (endX > visibleX1) {
+                endX = visibleX1;
+            }
+            if (startX <= endX) {
+                spans[spanCount].start = startX;
+                spans[spanCount].end = endX;
+                spans[spanCount].level = toLevel;
+                spans[spanCount].tiles = g_levelBLayerTiles[layerIdx];
+                spans[spanCount].entryTable = g_levelBTileEntries;
+                spans[spanCount].localX = startX - toMapX0;
+                spans[spanCount].localY = toLocalY;
+                spanCount++;
+            }
+        }
+    }
+
+    writeSpannedLine(line, layerIdx, spans, spanCount, visibleX0, 0);
+}
+
+IWRAM_OVERLAY_TRANSITION
+static void horizontalScrollRowIwram(u16* line, u8 layerIdx, const ScrollTransInfo* scrollInfo,
+                                     int tileOriginX, int tileOriginY, int cameraTileX, int ly) {
+    horizontalScrollRowBody(line, layerIdx, scrollInfo, tileOriginX, tileOriginY, cameraTileX, ly);
+}
+
+static void horizontalScrollRowRom(u16* line, u8 layerIdx, const ScrollTransInfo* scrollInfo,
+                                   int tileOriginX, int tileOriginY, int cameraTileX, int ly) {
+    horizontalScrollRowBody(line, layerIdx, scrollInfo, tileOriginX, tileOriginY, cameraTileX, ly);
+}
+
+void writeHorizontalScrollRow(u16* line,
+                              u8 layerIdx,
+                              const ScrollTransInfo* scrollInfo,
+                              int tileOriginX, int tileOriginY,
+                              int cameraTileX,
+                              int ly) {
+    OVERLAY_DISPATCH(OVERLAY_TRANSITION,
+                     horizontalScrollRowIwram(line, layerIdx, scrollInfo,
+                                              tileOriginX, tileOriginY, cameraTileX, ly),
+                     horizontalScrollRowRom(line, layerIdx, scrollInfo,
+                                            tileOriginX, tileOriginY, cameraTileX, ly));
+}
+
+static inline __attribute__((always_inline))
+void verticalScrollColumnBody(u16* line,
+                              u8 layerIdx,
+                              const ScrollTransInfo* scrollInfo,
+                              int tileOriginX, int tileOriginY,
+                              int cameraTileY,
+                              int lx) {
+    const int visibleY0 = cameraTileY;
+    const int visibleY1 = cameraTileY + 31;
+    LayerSpan spans[2];
+    int spanCount = 0;
+
+    const Level* fromLevel = scrollInfo->fromLevel;
+    int fromLocalX = lx - (tileOriginX + scrollInfo->fromTileX0);
+    if (layerIdx < fromLevel->layerCount &&
+        fromLocalX >= 0 && fromLocalX < fromLevel->width &&
+        g_levelLayerTiles[layerIdx]) {
+        int fromMapY0 = tileOriginY + scrollInfo->fromTileY0;
+        int startY = fromMapY0 > visibleY0 ? fromMapY0 : visibleY0;
+        int endY = fromMapY0 + fromLevel->height - 1;
+        if (endY > visibleY1) {
+            endY = visibleY1;
+        }
+        if (startY <= endY) {
+            spans[spanCount].start = startY;
+            spans[spanCount].end = endY;
+            spans[spanCount].level = fromLevel;
+            spans[spanCount].tiles = g_levelLayerTiles[layerIdx];
+            spans[spanCount].entryTable = g_levelTileEntries;
+            spans[spanCount].localX = fromLocalX;
+            spans[spanCount].localY = startY - fromMapY0;
+            spanCount++;
+        }
+    }
+
+    {
+        const Level* toLevel = scrollInfo->toLevel;
+        int toLocalX = lx - (tileOriginX + scrollInfo->toTileX0);
+        if (layerIdx < toLevel->layerCount &&
+            toLocalX >= 0 && toLocalX < toLevel->width &&
+            g_levelBLayerTiles[layerIdx]) {
+            int toMapY0 = tileOriginY + scrollInfo->toTileY0;
+            int startY = toMapY0 > visibleY0 ? toMapY0 : visibleY0;
+            int endY = toMapY0 + toLevel->height - 1;
+            if (endY > visibleY1) {
+                endY = visibleY1;
+            }
+            if (startY <= endY) {
+                spans[spanCount].start = startY;
+                spans[spanCount].end = endY;
+                spans[spanCount].level = toLevel;
+                spans[spanCount].tiles = g_levelBLayerTiles[layerIdx];
+                spans[spanCount].entryTable = g_levelBTileEntries;
+                spans[spanCount].localX = toLocalX;
+                spans[spanCount].localY = startY - toMapY0;
+                spanCount++;
+            }
+        }
+    }
+
+    writeSpannedLine(line, layerIdx, spans, spanCount, visibleY0, 1);
+}
+
+IWRAM_OVERLAY_TRANSITION
+static void verticalScrollColumnIwram(u16* line, u8 layerIdx, const ScrollTransInfo* scrollInfo,
+                                      int tileOriginX, int tileOriginY, int cameraTileY, int lx) {
+    verticalScrollColumnBody(line, layerIdx, scrollInfo, tileOriginX, tileOriginY, cameraTileY, lx);
+}
+
+static void verticalScrollColumnRom(u16* line, u8 layerIdx, const ScrollTransInfo* scrollInfo,
+                                    int tileOriginX, int tileOriginY, int cameraTileY, int lx) {
+    verticalScrollColumnBody(line, layerIdx, scrollInfo, tileOriginX, tileOriginY, cameraTileY, lx);
+}
+
+void writeVerticalScrollColumn(u16* line,
+                               u8 layerIdx,
+                               const ScrollTransInfo* scrollInfo,
+                               int tileOriginX, int tileOriginY,
+                               int cameraTileY,
+                               int lx) {
+    OVERLAY_DISPATCH(OVERLAY_TRANSITION,
+                     verticalScrollColumnIwram(line, layerIdx, scrollInfo,
+                                               tileOriginX, tileOriginY, cameraTileY, lx),
+                     verticalScrollColumnRom(line, layerIdx, scrollInfo,
+                                             tileOriginX, tileOriginY, cameraTileY, lx));
+}
+
+static u8 layerBgLayer(const Level* currentLevel, const ScrollTransInfo* scrollInfo, u8 layerIdx) {
+    if (layerIdx < currentLevel->layerCount) {
+        return currentLevel->layers[layerIdx].bgLayer;
+    }
+    if (scrollInfo->active && layerIdx < scrollInfo->toLevel->layerCount) {
+        return scrollInfo->toLevel->layers[layerIdx].bgLayer;
+    }
+    return layerIdx;
+}
+
+static void startFullRefresh(TilemapState* ts, const Level* level, int urgent,
+                             int cameraTileX, int cameraTileY,
+                             int tileOriginX, int tileOriginY) {
+    ts->refreshPending = 1;
+    ts->refreshUrgent = urgent;
+    ts->refreshRow = 0;
+    ts->refreshTileX = cameraTileX;
+    ts->refreshTileY = cameraTileY;
+    ts->refreshOriginX = tileOriginX;
+    ts->refreshOriginY = tileOriginY;
+    ts->refreshLevel = level;
+    ts->refreshBuilt = 0;
+    ts->refreshBlank = 0;
+}
+
+static void buildRefreshRow(volatile u16* bgMap, const TilemapState* ts,
+                            const ScrollTransInfo* scrollInfo, u8 layerIdx, int ty) {
+    int ly = ts->refreshTileY + ty;
+    volatile u16* row = &bgMap[(ly & 31) * 32];
+    VRAM_NOTE_MAP_WRITES(row, 32, 1);
+
+    if (!scrollInfo->active) {
+        writeCurrentLine((u16*)row, ts->refreshLevel, layerIdx,
+                         ts->refreshOriginX, ts->refreshOriginY, ts->refreshTileX, ly, 0);
+        return;
+    }
+
+    for (int tx = 0; tx < 32; tx++) {
+        int lx = ts->refreshTileX + tx;
+        row[lx & 31] = scrollTileEntryAt(scrollInfo, layerIdx,
+                                         lx - ts->refreshOriginX, ly - ts->refreshOriginY);
+    }
+}
+
+// Build up to one frame's budget of the pending full refresh into the hidden
+// screenblocks. Once every layer is done, queue the flips; the caller queues
+// the matching scroll position in the same VBlank.
+static void continueFullRefresh(TilemapState* ts, const ScrollTransInfo* scrollInfo) {
+    const int totalRows = TILEMAP_LAYERS * 32;
+    int budget = ts->refreshUrgent ? totalRows : TILEMAP_REFRESH_ROWS_PER_FRAME;
+
+    while (budget > 0 && ts->refreshRow < totalRows) {
+        u8 layerIdx = (u8)(ts->refreshRow >> 5);
+        int ty = ts->refreshRow & 31;
+        u8 bgLayer = layerBgLayer(ts->refreshLevel, scrollInfo, layerIdx);
+        volatile u16* bgMap = vramScreenblock(hiddenScreenBase(bgLayer));
+
+        if (ty == 0 && !scrollInfo->active &&
+            isLayerRegionEmpty(ts->refreshLevel, layerIdx,
+                               ts->refreshTileX - ts->refreshOriginX,
+                               ts->refreshTileY - ts->refreshOriginY,
+                               ts->refreshTileX - ts->refreshOriginX + 31,
+                               ts->refreshTileY - ts->refreshOriginY + 31)) {
+            // Nothing visible: a blank screen stays as is, anything else is
+            // replaced by a cleared back screenblock.
+            if (!ts->screenBlank[bgLayer]) {
+                for (int i = 0; i < 32 * 32; i++) {
+                    bgMap[i] = 0;
+                }
+                VRAM_NOTE_MAP_WRITES(bgMap, 32 * 32, 1);
+                ts->refreshBuilt |= (u8)(1 << layerIdx);
+                ts->refreshBlank |= (u8)(1 << layerIdx);
+            }
+            ts->refreshRow += 32;
+            budget--;
+            continue;
+        }
+
+        buildRefreshRow(bgMap, ts, scrollInfo, layerIdx, ty);
+        ts->refreshBuilt |= (u8)(1 << layerIdx);
+        ts->refreshRow++;
+        budget--;
+    }
+
+    if (ts->refreshRow < totalRows) {
+        return;
+    }
+
+    for (u8 layerIdx = 0; layerIdx < TILEMAP_LAYERS; layerIdx++) {
+        if (!(ts->refreshBuilt & (1 << layerIdx))) {
+            continue;
+        }
+        u8 bgLayer = layerBgLayer(ts->refreshLevel, scrollInfo, layerIdx);
+        flipGameplayScreenBase(bgLayer);
+        ts->screenBlank[bgLayer] = (u8)((ts->refreshBlank >> layerIdx) & 1);
+    }
+
+    ts->refreshPending = 0;
+    ts->oldCameraTileX = ts->refreshTileX;
+    ts->oldCameraTileY = ts->refreshTileY;
+    ts->oldCameraTileValid = 1;
+}
+
+static void queueBgScroll(TilemapState* ts, int bgCameraX, int bgCameraY) {
+    ts->shownBgCameraX = bgCameraX;
+    ts->shownBgCameraY = bgCameraY;
+    ts->shownBgCameraValid = 1;
+    vblankQueueReg(VREG_BG1HOFS, (u16)bgCameraX);
+    vblankQueueReg(VREG_BG1VOFS, (u16)bgCameraY);
+    vblankQueueReg(VREG_BG2HOFS, (u16)bgCameraX);
+    vblankQueueReg(VREG_BG2VOFS, (u16)bgCameraY);
+}
+
+int updateTilemapForCamera(
+    TilemapState* ts,
+    const Level* currentLevel,
+    const ScrollTransInfo* scrollInfo,
+    int cameraX, int cameraY,
+    int levelChanged)
+{
+    int scrollJustStarted = (!ts->wasScrolling && scrollInfo->active);
+    int scrollJustEnded   = ( ts->wasScrolling && !scrollInfo->active);
+    int usedSeamPrefill   = 0;
+    int scrollBgOriginX   = ts->bgTileOriginX;
+    int scrollBgOriginY   = ts->bgTileOriginY;
+    int scrollCameraX     = cameraX;
+    int scrollCameraY     = cameraY;
+
+    if (scrollInfo->active) {
+        if (scrollJustStarted) {
+            getTransitionVirtualCamera(&scrollCameraX, &scrollCameraY);
+        }
+        scrollBgOriginX = ts->bgTileOriginX - scrollInfo->fromTileX0;
+        scrollBgOriginY = ts->bgTileOriginY - scrollInfo->fromTileY0;
+    }
+
+    if (levelChanged && !scrollJustEnded) {
+        ts->bgTileOriginX = 0;
+        ts->bgTileOriginY = 0;
+    }
+
+    if (scrollJustEnded) {
+        ts->bgTileOriginX = ts->lastScrollBgOriginX + ts->lastScrollToTileX0;
+        ts->bgTileOriginY = ts->lastScrollBgOriginY + ts->lastScrollToTileY0;
+    }
+
+    int bgCameraX = scrollInfo->active ? (scrollCameraX + scrollBgOriginX * 8)
+                                       : (cameraX + ts->bgTileOriginX * 8);
+    int bgCameraY = scrollInfo->active ? (scrollCameraY + scrollBgOriginY * 8)
+                                       : (cameraY + ts->bgTileOriginY * 8);
+
+    if (scrollInfo->active) {
+        ts->lastScrollToTileX0 = scrollInfo->toTileX0;
+        ts->lastScrollToTileY0 = scrollInfo->toTileY0;
+        ts->lastScrollBgOriginX = scrollBgOriginX;
+        ts->lastScrollBgOriginY = scrollBgOriginY;
+        ts->lastScrollCanReuseTilemapOnCommit = scrollInfo->canReuseTilemapOnCommit;
+    }
+    ts->wasScrolling = scrollInfo->active;
+
+    int cameraTileX = floorDiv8(bgCameraX);
+    int cameraTileY = floorDiv8(bgCameraY);
+    if (scrollInfo->active) {
+        // Transition prefills write both levels' tiles straight to VRAM
+        for (int i = 0; i < 4; i++) {
+            ts->screenBlank[i] = 0;
+        }
+    }
+    if (scrollJustStarted) {
+        prefillScrollIncomingOverlap(currentLevel, scrollInfo,
+                                    scrollBgOriginX, scrollBgOriginY,
+                                    cameraTileX, cameraTileY);
+        // The trigger frame should keep showing the already-correct
+        // current view. If old camera-tile bookkeeping drifted during a
+        // prior reused handoff, seed it from the actual BG camera here
+        // so we stay on the incremental scroll path instead of doing an
+        // unnecessary full refresh on transition start.
+        ts->oldCameraTileX = cameraTileX;
+        ts->oldCameraTileY = cameraTileY;
+        ts->oldCameraTileValid = 1;
+    } else if (scrollJustEnded) {
+        if (ts->lastScrollCanReuseTilemapOnCommit) {
+            ts->oldCameraTileX = cameraTileX;
+            ts->oldCameraTileY = cameraTileY;
+            ts->oldCameraTileValid = 1;
+        } else {
+            ts->oldCameraTileValid = 0;
+        }
+        ts->lastScrollCanReuseTilemapOnCommit = 0;
+    }
+
+    int tileOriginX = scrollInfo->active ? scrollBgOriginX : ts->bgTileOriginX;
+    int tileOriginY = scrollInfo->active ? scrollBgOriginY : ts->bgTileOriginY;
+
+    // The held view only lines up with the sprites while the camera is where
+    // the screen already shows it.
+    int cameraStill = ts->shownBgCameraValid &&
+                      bgCameraX == ts->shownBgCameraX && bgCameraY == ts->shownBgCameraY;
+
+    if (ts->refreshPending &&
+        (cameraTileX != ts->refreshTileX || cameraTileY != ts->refreshTileY ||
+         tileOriginX != ts->refreshOriginX || tileOriginY != ts->refreshOriginY ||
+         currentLevel != ts->refreshLevel || scrollInfo->active)) {
+        // The partial build no longer matches what must be shown
+        startFullRefresh(ts, currentLevel, 1, cameraTileX, cameraTileY, tileOriginX, tileOriginY);
+    } else if (ts->refreshPending && !cameraStill) {
+        // Same target, but the scroll can no longer wait: finish what is left
+        ts->refreshUrgent = 1;
+    }
+
+    if (!ts->refreshPending &&
+        (!ts->oldCameraTileValid || cameraTileX != ts->oldCameraTileX || cameraTileY != ts->oldCameraTileY)) {
+        int deltaX = ts->oldCameraTileValid ? (cameraTileX - ts->oldCameraTileX) : 0;
+        int deltaY = ts->oldCameraTileValid ? (cameraTileY - ts->oldCameraTileY) : 0;
+        int adx = deltaX < 0 ? -deltaX : deltaX;
+        int ady = deltaY < 0 ? -deltaY : deltaY;
+
+        usedSeamPrefill = scrollInfo->active &&
+                          scrollInfo->seamPrefillAxis != 0 &&
+                          !scrollJustStarted;
+
+        if (!ts->oldCameraTileValid || adx > 2 || ady > 2) {
+            // Full refresh (only on init or after large jumps like scroll end).
+            // Transitions and a moving camera need the new view this frame;
+            // otherwise spread it.
+            startFullRefresh(ts, currentLevel, scrollInfo->active || !cameraStill,
+                             cameraTileX, cameraTileY, tileOriginX, tileOriginY);
+        } else {
+            // Always iterate all supported BG layers so extra layers get cleared
+            // (tile 0 = transparent) when switching to a level with fewer layers.
+            for (u8 layerIdx = 0; layerIdx < TILEMAP_LAYERS; layerIdx++) {
+                u8 bgLayer = layerBgLayer(currentLevel, scrollInfo, layerIdx);
+                u8 screenBase = getGameplayScreenBase(bgLayer);
+
+                volatile u16* bgMap = vramScreenblock(screenBase);
+
+                // A layer with nothing in the 32x32 window needs no lookups at
+                // all; if its screenblock is already blank it needs no writes.
+                int windowEmpty = !scrollInfo->active &&
+                                  isLayerRegionEmpty(currentLevel, layerIdx,
+                                                     cameraTileX - tileOriginX,
+                                                     cameraTileY - tileOriginY,
+                                                     cameraTileX - tileOriginX + 31,
+                                                     cameraTileY - tileOriginY + 31);
+                if (windowEmpty && ts->screenBlank[bgLayer]) {
+                    continue;
+                }
+                if (!windowEmpty) {
+                    ts->screenBlank[bgLayer] = 0;
+                }
+
+#define TILE_ENTRY(lx, ly) \
+    scrollTileEntryAt(scrollInfo, layerIdx, (lx) - tileOriginX, (ly) - tileOriginY)
+
+                if (usedSeamPrefill) {
+                    prefillScrollSeam(bgMap, layerIdx, scrollInfo,
+                                      scrollBgOriginX, scrollBgOriginY,
+                                      cameraTileX, cameraTileY);
+                }
+
+                // Incremental: queue up to 2 new columns and/or rows.
+                u16 line[32];
+                if (deltaX != 0) {
+                    for (int s = 0; s < adx; s++) {
+                        int lx = (deltaX > 0) ? (cameraTileX + 31 - s)
+                                              : (cameraTileX + s);
+                        if (scrollInfo->active && scrollInfo->seamPrefillAxis == 2) {
+                            writeVerticalScrollColumn(line, layerIdx, scrollInfo,
+                                                      tileOriginX, tileOriginY,
+                                                      cameraTileY, lx);
+                        } else if (!scrollInfo->active) {
+                            writeCurrentLine(line, currentLevel, layerIdx,
+                                             tileOriginX, tileOriginY, cameraTileY, lx, 1);
+                        } else {
+                            for (int ty = 0; ty < 32; ty++) {
+                                int ly = cameraTileY + ty;
+                                line[ly & 31] = TILE_ENTRY(lx, ly);
+                            }
+                        }
+                        vblankQueueMapColumn(screenBase, lx, line);
+                    }
+                }
+                if (deltaY != 0) {
+                    for (int s = 0; s < ady; s++) {
+                        int ly = (deltaY > 0) ? (cameraTileY + 31 - s)
+                                              : (cameraTileY + s);
+                        if (scrollInfo->active && scrollInfo->seamPrefillAxis == 1) {
+                            writeHorizontalScrollRow(line, layerIdx, scrollInfo,
+                                                     tileOriginX, tileOriginY,
+                                                     cameraTileX, ly);
+                        } else if (!scrollInfo->active) {
+                            writeCurrentLine(line, currentLevel, layerIdx,
+                                             tileOriginX, tileOriginY, cameraTileX, ly, 0);
+                        } else {
+                            for (int tx = 0; tx < 32; tx++) {
+                                int lx = cameraTileX + tx;
+                                line[lx & 31] = TILE_ENTRY(lx, ly);
+                            }
+                        }
+                        vblankQueueMapRow(screenBase, ly, line);
+                    }
+                }
+#undef TILE_ENTRY
+            }
+
+            ts->oldCameraTileX = cameraTileX;
+            ts->oldCameraTileY = cameraTileY;
+            ts->oldCameraTileValid = 1;
+        }
+
+        if (usedSeamPrefill) {
+            consumeTransitionSeamPrefill();
+        }
+    }
+
+    if (ts->refreshPending) {
+        continueFullRefresh(ts, scrollInfo);
+    }
+
+    // Scroll registers and the incremental edge lines above are queued and
+    // land together in the next VBlank. The new column/row sits past the
+    // visible right/bottom edge at the new scroll position but can wrap onto
+    // the opposite edge at the old one, so it must not be written early.
+    // While a full refresh is still being built the old view stays put; the
+    // frame that flips the new screenblocks in queues the new position.
+    if (!ts->refreshPending) {
+        queueBgScroll(ts, bgCameraX, bgCameraY);
+    }
+
+    return scrollJustStarted;
+}
+
+void enterLevelTilemap(TilemapState* ts, const Level* level, int cameraX, int cameraY) {
+    static const ScrollTransInfo noScroll;  // active = 0
+
+    resetTilemapState(ts);
+    startFullRefresh(ts, level, 1, floorDiv8(cameraX), floorDiv8(cameraY), 0, 0);
+    continueFullRefresh(ts, &noScroll);
+    queueBgScroll(ts, cameraX, cameraY);
+}
@@ -0,0 +1,37 @@
+// Frozen collision lookup for the reference modules, included by
+// reference_names.h in place of level.h's getTileCollision. It resolves each
+// query from the level's ROM data (tile defaults plus Collision layer runs)
+// on the reference's own decoded layers, independently of the live tables.
+#ifndef REFERENCE_TILE_COLLISION_H
+#define REFERENCE_TILE_COLLISION_H
+
+static inline CollisionType ref_getTileCollision(const Level* level, int tileX, int tileY) {
+    COST_INSNS(12);
+    if (tileX < 0 || tileX >= level->width || tileY < 0 || tileY >= level->height) {
+        COLDEBUG_PROBE(tileX, tileY, COL_NONE);
+        return COL_NONE;
+    }
+    COST_ACCESS(COST_EWRAM, 2, 1);
+    u16 tile = g_levelLayerTiles[LEVEL_COLLISION_LAYER][tileY * level->width + tileX];
+    COST_ACCESS(COST_ROM, 4, 1);
+    CollisionType col = (CollisionType)((level->tileCollision[tile >> 4] >> ((tile & 15) * 2)) & 3);
+
+    const u16* rows = level->collisionRowRuns;
+    if (rows) {
+        COST_ACCESS(COST_ROM, 2, 2);
+        for (int i = rows[tileY], end = rows[tileY + 1]; i < end; i++) {
+            const CollisionRun* run = &level->collisionRuns[i];
+            COST_INSNS(4);
+            COST_ACCESS(COST_ROM, 2, 2);
+            if (tileX < run->start) break;
+            if (tileX < run->end) {
+                col = (CollisionType)run->type;
+                break;
+            }
+        }
+    }
+    COLDEBUG_PROBE(tileX, tileY, col);
+    return col;
+}
+
+#endif
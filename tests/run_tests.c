@@ -2,8 +2,11 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
 #include "test_framework.h"
 #include "level/level.h"
+#include "core/pc_profiler.h"
 
 // External test declarations
 extern const MechanicsTest test_diagonal_dash_slide;
@@ -12,6 +15,7 @@ extern const MechanicsTest test_climb_stamina_glitch;
 extern const MechanicsTest test_wall_grab_slide;
 extern const MechanicsTest test_climb_hop_ledge;
 extern const MechanicsTest test_spring_bounce_superjump;
+extern const MechanicsTest test_duck_slide_ceiling;
 
 // Test registry
 static const MechanicsTest* all_tests[] = {
@@ -21,6 +25,7 @@ static const MechanicsTest* all_tests[] = {
     &test_wall_grab_slide,
     &test_climb_hop_ledge,
     &test_spring_bounce_superjump,
+    &test_duck_slide_ceiling,
     // Add more tests here as they're created
 };
 
@@ -35,12 +40,44 @@ int main(int argc, char** argv) {
     // Individual tests can override this by setting .level in their struct
     const Level* defaultLevel = &level3;
 
+    // PC_PROFILE=<path> samples the whole run (see tests/README.md)
+    const char* profilePath = getenv("PC_PROFILE");
+    if (profilePath) {
+        pcProfilerStart();
+    }
+
     // Run all tests
     int numTests = sizeof(all_tests) / sizeof(all_tests[0]);
     for (int i = 0; i < numTests; i++) {
         runMechanicsTest(all_tests[i], defaultLevel, &results);
     }
 
+    if (profilePath) {
+        // One pass is a few milliseconds; replay the suite quietly until the
+        // profile has enough samples to mean something.
+        int repeats = getenv("PC_PROFILE_REPEAT") ? atoi(getenv("PC_PROFILE_REPEAT")) : 2000;
+        fflush(stdout);
+        int savedStdout = dup(STDOUT_FILENO);
+        int devNull = open("/dev/null", O_WRONLY);
+        dup2(devNull, STDOUT_FILENO);
+        for (int r = 0; r < repeats; r++) {
+            TestResults scratch;
+            initTestResults(&scratch);
+            for (int i = 0; i < numTests; i++) {
+                runMechanicsTest(all_tests[i], defaultLevel, &scratch);
+            }
+        }
+        fflush(stdout);
+        dup2(savedStdout, STDOUT_FILENO);
+        close(devNull);
+        close(savedStdout);
+
+        pcProfilerStop();
+        if (pcProfilerDumpToFile(profilePath) == 0) {
+            printf("PC profile: %u samples -> %s\n", (unsigned)pcProfilerSampleCount(), profilePath);
+        }
+    }
+
     // Print summary
     printTestSummary(&results);
 
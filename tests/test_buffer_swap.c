@@ -11,9 +11,16 @@
 #include "collision/collision.h"
 #include "level/level.h"
 #include "level4.h"
+#include "menu/level_entry.h"
+#include "player/player.h"
 #include "player/state.h"
 #include "smb11.h"  // level3.h pulled in by level.h; smb11.h is not, add explicitly
 #include "transition/transition.h"
+#include "transition/scroll_tilemap.h"
+#include "core/vblank_queue.h"
+#include "core/vram_layout.h"
+#include "desktop/gba_cost.h"
+#include "generated/connections.h"
 
 // Test-accessor functions exposed by level.c under DESKTOP_BUILD
 extern const u16* getMainBufBase(void);
@@ -23,9 +30,15 @@ extern const u16* getTileBufB(void);  // always g_tileBBuffer
 extern const u16* getDesktopVramTiles(void);
 
 // transition.c links against this menu API, but the transition unit test only
-// needs scroll setup and tile queries.
+// needs scroll setup and tile queries. Record the fade brightness that was
+// committed to the display when the (hidden) reload happens.
+static int g_loadCount = 0;
+static u16 g_bldyAtLoad = 0;
+
 void loadLevelForTransition(int levelIndex) {
     (void)levelIndex;
+    g_loadCount++;
+    g_bldyAtLoad = vblankQueueDesktopReg(VREG_BLDY);
 }
 
 // ---- tiny test harness ----
@@ -171,7 +184,7 @@ static const Level kFadeFromLevel = {
     .playerSpawnY = 0,
     .tilesetCount = 0,
     .tilesets = NULL,
-    .collisionMap = NULL,
+    .tileCollision = NULL,
     .uniqueTileCount = 400,
     .uniqueTileIds = NULL,
     .tilePaletteBanks = NULL,
@@ -189,7 +202,7 @@ static const Level kFadeToLevel = {
     .playerSpawnY = 0,
     .tilesetCount = 0,
     .tilesets = NULL,
-    .collisionMap = NULL,
+    .tileCollision = NULL,
     .uniqueTileCount = 200,
     .uniqueTileIds = NULL,
     .tilePaletteBanks = NULL,
@@ -279,6 +292,10 @@ static void test_buffer_swap_invariant(void) {
            "After reverse loadLevelBToVRAM: g_levelBLayerTiles[1] populated (level3 layer 1)");
     ASSERT(g_levelBLayerTiles[1] >= bufA && g_levelBLayerTiles[1] < bufA + 512*40*2,
            "g_levelBLayerTiles[1] lives in bufA");
+
+    // The markers above live in resident rooms; drop them so later tests
+    // decompress clean data.
+    invalidateLevelResidency();
 }
 
 // ---------------------------------------------------------------------------
@@ -327,6 +344,134 @@ static void test_double_transition_buffers(void) {
     ASSERT(g_levelBLayerTiles[0] != NULL, "smb11 layerB0 loaded");
     ASSERT_NE_PTR(g_levelLayerTiles[0], g_levelBLayerTiles[0],
                   "Different buffers after 2nd round-trip");
+
+    invalidateLevelResidency();
+}
+
+// ---------------------------------------------------------------------------
+// Test 2a: returning to the room just left reuses its resident buffer
+//
+// After level3→smb11, level3's layers are still decompressed in the secondary
+// buffer and its tiles still sit at VRAM 0. Loading it back as level B at
+// offset 0 must cost nothing; loading a third room evicts it.
+// ---------------------------------------------------------------------------
+static u16 s_expectedEntries[LEVEL_VRAM_TILE_LIMIT];
+
+static unsigned measure_level_b_load(const Level* level, int vramOffset) {
+    gbaCostReset();
+    gbaCostPush(COST_SUB_TILEMAP);
+    loadLevelBToVRAM(level, vramOffset);
+    gbaCostPop();
+    gbaCostEndFrame();
+    return gbaCostWorst(COST_SUB_TILEMAP);
+}
+
+static void test_reverse_transition_reuses_resident_room(void) {
+    printf("\n[Test 2a] Reverse transition reuses resident room\n");
+
+    invalidateLevelResidency();
+    loadLevelToVRAM(&level3);
+    const u16* level3Layer0 = g_levelLayerTiles[0];
+
+    ASSERT(measure_level_b_load(&smb11, (int)level3.uniqueTileCount) > 0,
+           "First visit to smb11 decompresses and uploads");
+    adoptLevelBBuffer(&smb11);
+
+    ASSERT(measure_level_b_load(&level3, 0) == 0,
+           "Returning to level3 skips decompression and tile upload");
+    ASSERT_EQ_PTR(g_levelBLayerTiles[0], level3Layer0,
+                  "Returning to level3 reuses its resident buffer");
+    ASSERT(g_levelBLayerTiles[1] != NULL, "Resident level3 keeps its decoration layer");
+    ASSERT(getDesktopVramTiles()[1] == level3.uniqueTileIds[1],
+           "level3 tiles are still in VRAM at offset 0");
+    adoptLevelBBuffer(&level3);
+
+    ASSERT(measure_level_b_load(&celeste1, (int)level3.uniqueTileCount) > 0,
+           "A third room is loaded cold");
+    adoptLevelBBuffer(&celeste1);
+    ASSERT(measure_level_b_load(&smb11, 0) > 0,
+           "smb11 was evicted by the third room and reloads");
+
+    invalidateLevelResidency();
+}
+
+// ---------------------------------------------------------------------------
+// Test 2c: level select preload
+//
+// The menu decodes the highlighted level a budget at a time. Once it has
+// finished, confirming only uploads tiles; the decoded layers must match a
+// cold load byte for byte. A preload cancelled part way must not leave a
+// half-decoded room that a later load mistakes for resident.
+// ---------------------------------------------------------------------------
+static unsigned measure_level_load(const Level* level) {
+    gbaCostReset();
+    gbaCostPush(COST_SUB_TILEMAP);
+    loadLevelToVRAM(level);
+    gbaCostPop();
+    gbaCostEndFrame();
+    return gbaCostWorst(COST_SUB_TILEMAP);
+}
+
+static int layers_match(const Level* level, const u16* expected) {
+    size_t tiles = (size_t)level->width * level->height * level->layerCount;
+    return memcmp(g_levelLayerTiles[0], expected, tiles * sizeof(u16)) == 0 &&
+           memcmp(g_levelTileEntries, s_expectedEntries, sizeof(s_expectedEntries)) == 0;
+}
+
+static void test_level_select_preload(void) {
+    printf("\n[Test 2c] Level select preload\n");
+
+    static u16 cold[512 * 40 * 2];
+    const Level* level = &level4;  // 240x50: several slices
+    size_t tiles = (size_t)level->width * level->height * level->layerCount;
+
+    invalidateLevelResidency();
+    unsigned otherColdCost = measure_level_load(&celeste1);
+    invalidateLevelResidency();
+    unsigned coldCost = measure_level_load(level);
+    memcpy(cold, g_levelLayerTiles[0], tiles * sizeof(u16));
+    memcpy(s_expectedEntries, g_levelTileEntries, sizeof(s_expectedEntries));
+
+    // Full preload, then confirm
+    invalidateLevelResidency();
+    levelPreloadStart(level);
+    int steps = 1;
+    while (!levelPreloadStep(LEVEL_PRELOAD_BYTES_PER_FRAME) && steps < 1000) {
+        steps++;
+    }
+    int expectedSteps = (int)((tiles * sizeof(u16) + LEVEL_PRELOAD_BYTES_PER_FRAME - 1) /
+                              LEVEL_PRELOAD_BYTES_PER_FRAME);
+    char msg[128];
+    snprintf(msg, sizeof(msg), "Preload is sliced by the budget (%d steps for %d bytes)",
+             steps, (int)(tiles * sizeof(u16)));
+    ASSERT(steps >= expectedSteps && steps <= expectedSteps + 1, msg);
+    unsigned warmCost = measure_level_load(level);
+    snprintf(msg, sizeof(msg), "Confirm after preload costs less than a cold load (%u vs %u cycles)",
+             warmCost, coldCost);
+    ASSERT(warmCost * 4 < coldCost, msg);
+    ASSERT(layers_match(level, cold), "Preloaded layers and entry table match a cold load");
+
+    // Confirm part way through: the load finishes the preload
+    invalidateLevelResidency();
+    levelPreloadStart(level);
+    levelPreloadStep(LEVEL_PRELOAD_BYTES_PER_FRAME);
+    loadLevelToVRAM(level);
+    ASSERT(layers_match(level, cold), "Confirming mid-preload finishes the decode");
+
+    // Selection moves on mid-preload: the abandoned room is not resident
+    invalidateLevelResidency();
+    levelPreloadStart(level);
+    levelPreloadStep(LEVEL_PRELOAD_BYTES_PER_FRAME);
+    levelPreloadStart(&celeste1);
+    while (!levelPreloadStep(LEVEL_PRELOAD_BYTES_PER_FRAME)) {
+    }
+    ASSERT(measure_level_load(level) * 4 > coldCost,
+           "Cancelled preload leaves no resident room behind");
+    ASSERT(layers_match(level, cold), "Cancelled level reloads cold with the right data");
+    ASSERT(measure_level_load(&celeste1) * 4 < otherColdCost,
+           "The new selection's preload is kept");
+
+    invalidateLevelResidency();
 }
 
 // ---------------------------------------------------------------------------
@@ -368,8 +513,6 @@ static void test_adopt_preserves_incoming_vram_offset(void) {
 static void test_player_render_offset_during_transition(void) {
     printf("\n[Test 3] Player render coordinates during horizontal transition\n");
 
-#define FIXED_SHIFT 8
-
     int fromTileX0  = (int)level3.width;   // 80 tiles = 640 px
     int smb11_camX  = 0;
     int virtual_camX = fromTileX0 * 8 + smb11_camX;  // 640
@@ -393,8 +536,6 @@ static void test_player_render_offset_during_transition(void) {
 
     printf("    buggy screenX: %d (< -16, offscreen)\n", buggy_screenX);
     printf("    fixed screenX: %d (onscreen)\n", correct_screenX);
-
-#undef FIXED_SHIFT
 }
 
 // ---------------------------------------------------------------------------
@@ -425,6 +566,314 @@ static void test_decoration_layer_valid_after_load(void) {
            sample_tile, (int)level3.uniqueTileCount - 1);
 }
 
+// ---------------------------------------------------------------------------
+// Test 4a: converter chunk occupancy matches the decompressed layers
+//
+// The tilemap writers zero-fill any 8x8 chunk whose occupancy bit is clear
+// without reading the layer, so a clear bit over a non-zero tile would drop
+// visible tiles. Every bit must equal "chunk has a non-zero tile".
+// ---------------------------------------------------------------------------
+static int chunkMaskMatches(const Level* level, int* occupied, int* total) {
+    int ok = 1;
+    *occupied = 0;
+    *total = 0;
+    loadLevelToVRAM(level);
+    int chunksWide = (level->width + LEVEL_CHUNK_SIZE - 1) / LEVEL_CHUNK_SIZE;
+    int chunksHigh = (level->height + LEVEL_CHUNK_SIZE - 1) / LEVEL_CHUNK_SIZE;
+    for (u8 layer = 0; layer < level->layerCount; layer++) {
+        for (int cy = 0; cy < chunksHigh; cy++) {
+            for (int cx = 0; cx < chunksWide; cx++) {
+                int any = 0;
+                for (int ty = cy * LEVEL_CHUNK_SIZE; ty < (cy + 1) * LEVEL_CHUNK_SIZE && ty < level->height; ty++) {
+                    for (int tx = cx * LEVEL_CHUNK_SIZE; tx < (cx + 1) * LEVEL_CHUNK_SIZE && tx < level->width; tx++) {
+                        if (getTileAt(level, layer, tx, ty) != 0) any = 1;
+                    }
+                }
+                if (any != isLayerChunkOccupied(level, layer, cx, cy)) ok = 0;
+                *occupied += any;
+                (*total)++;
+            }
+        }
+    }
+    return ok;
+}
+
+static void test_chunk_occupancy_matches_layers(void) {
+    printf("\n[Test 4a] Chunk occupancy bits match decompressed layers\n");
+
+    const Level* levels[] = { &level3, &level4, &smb11, &celeste1 };
+    for (int i = 0; i < (int)(sizeof(levels) / sizeof(levels[0])); i++) {
+        int occupied, total;
+        int ok = chunkMaskMatches(levels[i], &occupied, &total);
+        char msg[96];
+        snprintf(msg, sizeof(msg), "%s: occupancy bits match (%d/%d chunks non-empty)",
+                 levels[i]->name, occupied, total);
+        ASSERT(ok, msg);
+    }
+
+    // celeste1's decoration layer has a single occupied chunk
+    ASSERT(isLayerRegionEmpty(&celeste1, 1, 0, 0, celeste1.width - 1, celeste1.height - 1) == 0,
+           "celeste1 decoration layer is not empty as a whole");
+    ASSERT(isLayerRegionEmpty(&celeste1, 2, 0, 0, celeste1.width - 1, celeste1.height - 1) == 1,
+           "Missing layer counts as empty");
+    ASSERT(isLayerRegionEmpty(&celeste1, 0, -40, -40, -1, -1) == 1,
+           "Region outside the level counts as empty");
+}
+
+// ---------------------------------------------------------------------------
+// Test 4b: level entry writes each gameplay screen entry exactly once
+//
+// Entry goes the way main.c takes it: beginLevel() (the level select's and
+// switchToLevel()'s load, BG setup, initPlayer and camera settle), a replay
+// load then moving the player and camera, enterLevelTilemap() at the camera,
+// and gameplay frames of updatePlayer, updateCamera and
+// updateTilemapForCamera. Every entry of the two displayed screenblocks is
+// written once, with the level's tile, and the screenblocks they replace are
+// not touched at all.
+// ---------------------------------------------------------------------------
+#define ENTRY_SPAWN (-1)
+
+static void enterLevelAndCountWrites(int levelIndex, int startX, int startY) {
+    static const u8 s_pairs[3][2] = { { 0, 0 }, { SB_BG1, SB_BG1_BACK }, { SB_BG2, SB_BG2_BACK } };
+    const Level* level = g_levels[levelIndex];
+    char msg[128];
+
+    invalidateLevelResidency();
+    initTransition();
+    initVBlankQueue();
+    vblankQueueDesktopClearVram();
+    resetGameplayScreenBases();
+
+    Player player;
+    Camera camera;
+    beginLevel(level, &player, &camera);
+    if (startX != ENTRY_SPAWN) {
+        // Replay load: moved to the replay start before the fill
+        player.x = startX * FIXED_ONE;
+        player.y = startY * FIXED_ONE;
+        player.vx = 0;
+        player.vy = 0;
+        updateCamera(&camera, &player, level);
+    }
+
+    TilemapState ts;
+    enterLevelTilemap(&ts, level, camera.x, camera.y);
+    vblankQueueSubmit();
+    vblankQueueFlush();
+    Camera entered = camera;
+
+    // First gameplay frames, no input
+    for (int frame = 0; frame < 3; frame++) {
+        setTransitionLevelContext(levelIndex, camera.x, camera.y, player.x, player.y);
+        updatePlayer(&player, 0, level);
+        updateCamera(&camera, &player, level);
+        ScrollTransInfo scrollInfo;
+        getScrollTransInfo(&scrollInfo);
+        updateTilemapForCamera(&ts, level, &scrollInfo, camera.x, camera.y, frame == 0);
+        vblankQueueSubmit();
+        vblankQueueFlush();
+    }
+    snprintf(msg, sizeof(msg), "%s: camera settled at entry stays put (%d,%d)", level->name, camera.x, camera.y);
+    ASSERT(camera.x == entered.x && camera.y == entered.y, msg);
+
+    int cameraTileX = camera.x / 8;
+    int cameraTileY = camera.y / 8;
+    for (u8 layerIdx = 0; layerIdx < 2; layerIdx++) {
+        // Layers past the level's own count are cleared on their default BG
+        int bg = (layerIdx < level->layerCount) ? level->layers[layerIdx].bgLayer : layerIdx;
+        u8 shown = getGameplayScreenBase((u8)bg);
+        u8 other = (shown == s_pairs[bg][0]) ? s_pairs[bg][1] : s_pairs[bg][0];
+        int once = 1, untouched = 1, correct = 1;
+        for (int ty = 0; ty < 32; ty++) {
+            for (int tx = 0; tx < 32; tx++) {
+                int mapX = cameraTileX + tx;
+                int mapY = cameraTileY + ty;
+                int index = (mapY & 31) * 32 + (mapX & 31);
+                if (vblankQueueDesktopMapWrites(shown, index) != 1) once = 0;
+                if (vblankQueueDesktopMapWrites(other, index) != 0) untouched = 0;
+                if (vramScreenblock(shown)[index] != currentTileEntryAt(level, layerIdx, mapX, mapY)) correct = 0;
+            }
+        }
+        snprintf(msg, sizeof(msg), "%s BG%d: each displayed entry written exactly once", level->name, bg);
+        ASSERT(once, msg);
+        snprintf(msg, sizeof(msg), "%s BG%d: replaced screenblock not written", level->name, bg);
+        ASSERT(untouched, msg);
+        snprintf(msg, sizeof(msg), "%s BG%d: displayed window matches the level at the camera", level->name, bg);
+        ASSERT(correct, msg);
+    }
+    snprintf(msg, sizeof(msg), "%s: BG1 scroll matches the settled camera (%d,%d)",
+             level->name, camera.x, camera.y);
+    ASSERT(vblankQueueDesktopReg(VREG_BG1HOFS) == (u16)camera.x &&
+           vblankQueueDesktopReg(VREG_BG1VOFS) == (u16)camera.y, msg);
+}
+
+static void test_level_entry_fills_each_entry_once(void) {
+    printf("\n[Test 4b] Level entry writes each screen entry once\n");
+
+    enterLevelAndCountWrites(LEVEL_IDX_celeste1, ENTRY_SPAWN, ENTRY_SPAWN);
+    enterLevelAndCountWrites(LEVEL_IDX_smb11, ENTRY_SPAWN, ENTRY_SPAWN);
+    // Replay load into smb11, far from its spawn
+    enterLevelAndCountWrites(LEVEL_IDX_smb11, smb11.width * 8 - 40, smb11.playerSpawnY);
+}
+
+// ---------------------------------------------------------------------------
+// Test 4d: a spread-out full refresh never holds the scroll behind the camera
+//
+// Sprites are drawn at the camera every frame, so the held BG scroll of a
+// refresh built over several frames must only ever be the camera's own. A
+// refresh is spread only while the camera stands still; one that starts with
+// the camera moving, or whose camera moves mid-build, is shown that frame.
+// ---------------------------------------------------------------------------
+static int displayedWindowMatches(const Level* level, const Camera* camera) {
+    u8 bg = level->layers[0].bgLayer;
+    volatile u16* map = vramScreenblock(getGameplayScreenBase(bg));
+    for (int ty = 0; ty < 32; ty++) {
+        for (int tx = 0; tx < 32; tx++) {
+            int mapX = camera->x / 8 + tx;
+            int mapY = camera->y / 8 + ty;
+            if (map[(mapY & 31) * 32 + (mapX & 31)] != currentTileEntryAt(level, 0, mapX, mapY)) return 0;
+        }
+    }
+    return 1;
+}
+
+static int scrollMatchesCamera(const Camera* camera) {
+    return vblankQueueDesktopReg(VREG_BG1HOFS) == (u16)camera->x &&
+           vblankQueueDesktopReg(VREG_BG1VOFS) == (u16)camera->y;
+}
+
+static void runTilemapFrame(TilemapState* ts, const Level* level, const Camera* camera) {
+    ScrollTransInfo scrollInfo;
+    getScrollTransInfo(&scrollInfo);
+    updateTilemapForCamera(ts, level, &scrollInfo, camera->x, camera->y, 0);
+    vblankQueueSubmit();
+    vblankQueueFlush();
+}
+
+static void test_deferred_refresh_keeps_scroll_in_step(void) {
+    printf("\n[Test 4d] Spread full refresh keeps the scroll with the camera\n");
+    const Level* level = &celeste1;
+
+    invalidateLevelResidency();
+    initTransition();
+    initVBlankQueue();
+    vblankQueueDesktopClearVram();
+    resetGameplayScreenBases();
+
+    Player player;
+    Camera camera;
+    beginLevel(level, &player, &camera);
+    TilemapState ts;
+    enterLevelTilemap(&ts, level, camera.x, camera.y);
+    vblankQueueSubmit();
+    vblankQueueFlush();
+
+    // Camera still: the build is spread and the unchanged scroll is held
+    ts.oldCameraTileValid = 0;
+    runTilemapFrame(&ts, level, &camera);
+    ASSERT(ts.refreshPending, "Still camera: refresh spread over frames");
+    ASSERT(scrollMatchesCamera(&camera), "Still camera: held scroll is the camera's");
+    int frames = 1;
+    while (ts.refreshPending && frames < 8) {
+        runTilemapFrame(&ts, level, &camera);
+        frames++;
+    }
+    ASSERT(!ts.refreshPending && scrollMatchesCamera(&camera) && displayedWindowMatches(level, &camera),
+           "Still camera: spread refresh lands on the camera's view");
+
+    // Camera moving when the refresh starts: shown the same frame
+    ts.oldCameraTileValid = 0;
+    camera.x += 3;
+    runTilemapFrame(&ts, level, &camera);
+    ASSERT(!ts.refreshPending && scrollMatchesCamera(&camera) && displayedWindowMatches(level, &camera),
+           "Moving camera: refresh shown with the new scroll that frame");
+
+    // Camera moves within its tile mid-build: the rest is finished that frame
+    ts.oldCameraTileValid = 0;
+    runTilemapFrame(&ts, level, &camera);
+    int pendingBefore = ts.refreshPending;
+    camera.x += (camera.x % 8 == 7) ? -1 : 1;
+    runTilemapFrame(&ts, level, &camera);
+    ASSERT(pendingBefore && !ts.refreshPending && scrollMatchesCamera(&camera) &&
+           displayedWindowMatches(level, &camera),
+           "Sub-tile move mid-build: refresh finished with the new scroll");
+
+    // Camera changes tile mid-build: rebuilt for the new tile that frame
+    ts.oldCameraTileValid = 0;
+    runTilemapFrame(&ts, level, &camera);
+    pendingBefore = ts.refreshPending;
+    camera.y += 8;
+    runTilemapFrame(&ts, level, &camera);
+    ASSERT(pendingBefore && !ts.refreshPending && scrollMatchesCamera(&camera) &&
+           displayedWindowMatches(level, &camera),
+           "Tile move mid-build: refresh rebuilt and shown with the new scroll");
+}
+
+// ---------------------------------------------------------------------------
+// Test 4c: collision follows the level's room
+//
+// Collision is the terrain tile's tileset default plus the level's override
+// runs, read through the room's decoded layer and IWRAM tables. The same
+// level must give the same grid whether it was loaded cold, queried as the
+// incoming room of a scroll, adopted at the end of it, or made current from
+// a finished preload.
+// ---------------------------------------------------------------------------
+static u8 s_collisionGrid[3][256 * 30];
+
+static void collisionGrid(const Level* level, u8* grid, int* solid, int* jumpthru) {
+    *solid = 0;
+    *jumpthru = 0;
+    for (int ty = 0; ty < level->height; ty++) {
+        for (int tx = 0; tx < level->width; tx++) {
+            u8 col = (u8)getTileCollision(level, tx, ty);
+            grid[ty * level->width + tx] = col;
+            if (col == COL_SOLID) (*solid)++;
+            if (col == COL_JUMPTHRU) (*jumpthru)++;
+        }
+    }
+}
+
+static void test_collision_follows_current_room(void) {
+    printf("\n[Test 4c] Collision resolves through the level's room\n");
+    int size = smb11.width * smb11.height;
+    int solid, jumpthru, solidAdopted, jumpthruAdopted, solidPreloaded, jumpthruPreloaded;
+
+    invalidateLevelResidency();
+    loadLevelToVRAM(&smb11);
+    collisionGrid(&smb11, s_collisionGrid[0], &solid, &jumpthru);
+    printf("    smb11: %d solid, %d jump-through tiles\n", solid, jumpthru);
+    ASSERT(solid > 0, "smb11 terrain is solid by tileset default");
+    ASSERT(jumpthru == 18, "smb11 jump-through platforms come from the override runs");
+    ASSERT(getTileCollision(&smb11, 8, 20) == COL_JUMPTHRU && getTileCollision(&smb11, 7, 20) == COL_NONE,
+           "Override run starts where the Collision layer does");
+
+    invalidateLevelResidency();
+    loadLevelToVRAM(&level3);
+    loadLevelBToVRAM(&smb11, (int)level3.uniqueTileCount);
+    collisionGrid(&smb11, s_collisionGrid[1], &solidAdopted, &jumpthruAdopted);
+    ASSERT(memcmp(s_collisionGrid[0], s_collisionGrid[1], size) == 0,
+           "Incoming room resolves its own collision before it is adopted");
+    adoptLevelBBuffer(&smb11);
+    collisionGrid(&smb11, s_collisionGrid[1], &solidAdopted, &jumpthruAdopted);
+    ASSERT(memcmp(s_collisionGrid[0], s_collisionGrid[1], size) == 0,
+           "Adopted room resolves the same collision as a cold load");
+
+    loadLevelToVRAM(&level3);
+    collisionGrid(&level3, s_collisionGrid[2], &solid, &jumpthru);
+    ASSERT(jumpthru == 6, "Reloading the resident room switches back to its own overrides");
+
+    invalidateLevelResidency();
+    loadLevelToVRAM(&level3);
+    levelPreloadStart(&smb11);
+    while (!levelPreloadStep(LEVEL_PRELOAD_BYTES_PER_FRAME)) {
+    }
+    loadLevelToVRAM(&smb11);
+    collisionGrid(&smb11, s_collisionGrid[2], &solidPreloaded, &jumpthruPreloaded);
+    ASSERT(memcmp(s_collisionGrid[0], s_collisionGrid[2], size) == 0,
+           "Preloaded room resolves the same collision as a cold load");
+    invalidateLevelResidency();
+}
+
 // ---------------------------------------------------------------------------
 // Test 5: destination-only BG1 stays visible during reverse scroll
 //
@@ -554,7 +1003,7 @@ static void test_scroll_player_handoff_and_trail_cleanup(void) {
     player.facingRight = 0;
     player.stateMachine.state = ST_DASH;
     player.dashing = 5;
-    player.dashAttackTimer = 7;
+    player.dashAttackUntil = 7;  // clock 0: seven frames left
     player.maxDashes = 2;
     player.dashes = 0;
     player.stamina = 13 << TEST_FIXED_SHIFT;
@@ -587,7 +1036,8 @@ static void test_scroll_player_handoff_and_trail_cleanup(void) {
     int preservedVx = player.vx;
     int preservedVy = player.vy;
     int preservedDashing = player.dashing;
-    int preservedDashAttackTimer = player.dashAttackTimer;
+    int preservedDashAttackUntil = player.dashAttackUntil;
+    int preservedClock = player.clock;
     int preservedState = player.stateMachine.state;
     int preservedTrailTimer = player.trailTimer;
     int preservedTrailIndex = player.trailIndex;
@@ -599,7 +1049,8 @@ static void test_scroll_player_handoff_and_trail_cleanup(void) {
            player.trailY[0] == (64 << TEST_FIXED_SHIFT),
            "Scroll transition keeps dash trail positions frozen");
     ASSERT(player.dashing == preservedDashing &&
-           player.dashAttackTimer == preservedDashAttackTimer &&
+           player.dashAttackUntil == preservedDashAttackUntil &&
+           player.clock == preservedClock &&
            player.stateMachine.state == preservedState,
            "Scroll transition pauses active dash state without consuming it");
 
@@ -610,7 +1061,7 @@ static void test_scroll_player_handoff_and_trail_cleanup(void) {
            "Transition commit preserves player momentum");
     ASSERT(player.dashing == preservedDashing,
            "Transition commit preserves dash timer");
-    ASSERT(player.dashAttackTimer == preservedDashAttackTimer,
+    ASSERT(player.dashAttackUntil == preservedDashAttackUntil && player.clock == preservedClock,
            "Transition commit preserves dash attack timer");
     ASSERT(player.stateMachine.state == preservedState,
            "Transition commit preserves the active dash state");
@@ -840,6 +1291,74 @@ static void test_fade_transition_offset(void) {
     clearTransitionTestOverrides();
 }
 
+// ---------------------------------------------------------------------------
+// Test 9b: fade blend registers go through the VBlank queue
+// ---------------------------------------------------------------------------
+static int count_flushed_writes(int from, u16 reg) {
+    const VBlankRegCmd* log = vblankQueueLog();
+    int n = 0;
+    for (int i = from; i < vblankQueueLogCount(); i++) {
+        if (log[i].reg == reg) n++;
+    }
+    return n;
+}
+
+static void test_fade_queues_blend_registers(void) {
+    printf("\n[Test 9b] Fade blend registers are committed by the VBlank queue\n");
+
+    enum { TEST_FIXED_SHIFT = 8, PERP_POS = 84 };
+
+    Player player = {0};
+    Camera camera = {0};
+    player.y = PERP_POS << TEST_FIXED_SHIFT;
+
+    clearTransitionTestOverrides();
+    setTransitionTestOverrides(kFadeLevelTable, 2, kFadeOffsetConnections, 2);
+    initTransition();
+    setTransitionLevelContext(0, 0, 0, 0, player.y);
+
+    initVBlankQueue();
+    vblankQueueClearLog();
+    g_loadCount = 0;
+    g_bldyAtLoad = 0;
+
+    ASSERT(tryTriggerTransition(&kFadeFromLevel, CONN_SIDE_RIGHT, PERP_POS, &player),
+           "Fade transition triggered");
+    ASSERT(vblankQueueLogCount() == 0, "Fade start does not touch registers before VBlank");
+    vblankQueueSubmit();
+    vblankQueueFlush();
+    ASSERT(vblankQueueDesktopReg(VREG_BLDCNT) == ((2 << 6) | 0x1F),
+           "Fade start commits fade-to-black BLDCNT");
+
+    int frames = 0;
+    int oneBldyPerFrame = 1;
+    while (isTransitioning() && frames < 40) {
+        updateTransition(&player, &camera);
+        int logStart = vblankQueueLogCount();
+        vblankQueueSubmit();
+        vblankQueueFlush();
+        if (count_flushed_writes(logStart, VREG_BLDY) != 1) oneBldyPerFrame = 0;
+        frames++;
+    }
+
+    ASSERT(!isTransitioning(), "Fade transition completed");
+    ASSERT(oneBldyPerFrame, "Each frame commits exactly one coalesced BLDY write");
+    ASSERT(g_loadCount == 1, "Fade reloads the level once");
+    ASSERT(g_bldyAtLoad == 16, "Display is fully black before the reload frame");
+    ASSERT(vblankQueueDesktopReg(VREG_BLDY) == 0, "Fade in ends at full brightness");
+    ASSERT(vblankQueueDesktopReg(VREG_BLDCNT) == ((1 << 6) | (1 << 8) | (1 << 9) | (1 << 10) | (1 << 13)),
+           "Fade end restores sprite alpha BLDCNT");
+    ASSERT(vblankQueueDesktopReg(VREG_BLDALPHA) == ((7 << 0) | (9 << 8)),
+           "Fade end restores BLDALPHA");
+
+    vblankQueueFlush();
+    int logCount = vblankQueueLogCount();
+    vblankQueueFlush();
+    ASSERT(vblankQueueLogCount() == logCount, "Unsubmitted frame is never replayed twice");
+
+    clearTransitionTestOverrides();
+}
+
 // ---------------------------------------------------------------------------
 // Test 10: reverse horizontal offset still reuses tilemap on commit
 // ---------------------------------------------------------------------------
@@ -1121,6 +1640,41 @@ static void test_transition_preserves_boost_state(void) {
            "Transition commit translates current bubble Y with the player");
 }
 
+// ---------------------------------------------------------------------------
+// Test 15: the u16 timer clock rebases without changing any timer
+// ---------------------------------------------------------------------------
+static void test_timer_rebase_keeps_timers(void) {
+    printf("\n[Test 15] Timer rebase keeps every timer\n");
+
+    Player player = {0};
+    player.clock = TIMER_REBASE_AT;
+    player.jumpBufferUntil = TIMER_REBASE_AT - 5;    // ran out a while ago
+    player.varJumpUntil = TIMER_REBASE_AT;           // runs out this frame
+    player.dashAttackUntil = TIMER_REBASE_AT + 12;
+    player.forceMoveXUntil = TIMER_OFF;
+
+    Player before = player;
+    timerRebase(&player);
+
+    int same = 1;
+#define CHECK_DEADLINE(f) \
+    if (timerActive(&player, player.f) != timerActive(&before, before.f) || \
+        timerWasActive(&player, player.f) != timerWasActive(&before, before.f) || \
+        timerRemaining(&player, player.f) != timerRemaining(&before, before.f)) same = 0;
+    PLAYER_DEADLINES(CHECK_DEADLINE)
+#undef CHECK_DEADLINE
+
+    ASSERT(player.clock == TIMER_REBASE_AT - TIMER_REBASE_BY, "Clock moves back by TIMER_REBASE_BY");
+    ASSERT(same, "Every deadline keeps its active / was-active state and remaining time");
+    ASSERT(player.jumpBufferUntil == TIMER_OFF && player.forceMoveXUntil == TIMER_OFF,
+           "Deadlines behind the clock become TIMER_OFF");
+
+    player.clock = TIMER_REBASE_AT - 1;
+    before = player;
+    timerRebase(&player);
+    ASSERT(memcmp(&player, &before, sizeof(Player)) == 0, "Nothing moves below TIMER_REBASE_AT");
+}
+
 // ---------------------------------------------------------------------------
 // main
 // ---------------------------------------------------------------------------
@@ -1129,9 +1683,15 @@ int main(void) {
 
     test_buffer_swap_invariant();
     test_double_transition_buffers();
+    test_reverse_transition_reuses_resident_room();
+    test_level_select_preload();
     test_adopt_preserves_incoming_vram_offset();
     test_player_render_offset_during_transition();
     test_decoration_layer_valid_after_load();
+    test_chunk_occupancy_matches_layers();
+    test_level_entry_fills_each_entry_once();
+    test_deferred_refresh_keeps_scroll_in_step();
+    test_collision_follows_current_room();
     test_destination_only_layer_visible_during_scroll();
     test_scroll_handoff_extra_frame();
     test_scroll_player_handoff_and_trail_cleanup();
@@ -1139,11 +1699,13 @@ int main(void) {
     test_horizontal_connection_offset();
     test_vertical_connection_offset();
     test_fade_transition_offset();
+    test_fade_queues_blend_registers();
     test_reverse_horizontal_offset_commit_reuse();
     test_generated_horizontal_connection_quantization();
     test_generated_vertical_connection_handoff();
     test_generated_reverse_vertical_camera_stability();
     test_transition_preserves_boost_state();
+    test_timer_rebase_keeps_timers();
 
     printf("\n================================\n");
     printf("Results: %d passed, %d failed\n", g_passed, g_failed);
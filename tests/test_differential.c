@@ -0,0 +1,920 @@
+#ifdef DESKTOP_BUILD
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "desktop/desktop_stubs.h"
+#include "differential_engine.h"
+#include "test_framework.h"
+#include "camera/camera.h"
+#include "core/game_math.h"
+#include "core/vblank_queue.h"
+#include "core/vram_layout.h"
+#include "entities/spring.h"
+#include "generated/connections.h"
+#include "player/player.h"
+
+/**
+ * Differential tests.
+ *
+ * The replay tests only catch a regression along the handful of paths
+ * somebody recorded. This drives the live collision, level decoding,
+ * tilemap streaming and transition modules side by side with the frozen
+ * copies in tests/reference/ over randomised and replay-derived inputs,
+ * and fails on the first frame or probe where any observable output
+ * differs (player state, tile buffers, screenblocks, BG registers).
+ *
+ * Divergences are shrunk before they are reported: collision probes
+ * greedily reset player fields to their spawn values, camera paths are
+ * delta-debugged down to the frames that still reproduce it.
+ *
+ * The VRAM and vblank queue are shared between the two builds, so the
+ * engines never run interleaved: each pass starts from cleared VRAM.
+ */
+
+#define DIFF_SEED             0x2545F491u
+#define COLLISION_PROBES      4000
+#define CAMERA_PATHS          6
+#define CAMERA_PATH_FRAMES    180
+#define MAX_RUN_FRAMES        320
+#define TRANSITION_SETTLE     30
+
+#define SCREEN_WIDTH  240
+#define SCREEN_HEIGHT 160
+
+static int g_passed = 0;
+static int g_failed = 0;
+
+#define ASSERT(cond, msg) \
+    do { \
+        if (cond) { printf("  PASS: %s\n", msg); g_passed++; } \
+        else      { printf("  FAIL: %s\n", msg); g_failed++; } \
+    } while(0)
+
+extern const MechanicsTest test_diagonal_dash_slide;
+extern const MechanicsTest test_dash_height;
+extern const MechanicsTest test_climb_stamina_glitch;
+extern const MechanicsTest test_wall_grab_slide;
+extern const MechanicsTest test_climb_hop_ledge;
+extern const MechanicsTest test_spring_bounce_superjump;
+extern const MechanicsTest test_duck_slide_ceiling;
+
+static const MechanicsTest* s_replays[] = {
+    &test_diagonal_dash_slide,
+    &test_dash_height,
+    &test_climb_stamina_glitch,
+    &test_wall_grab_slide,
+    &test_climb_hop_ledge,
+    &test_spring_bounce_superjump,
+    &test_duck_slide_ceiling,
+};
+#define REPLAY_COUNT ((int)(sizeof(s_replays) / sizeof(s_replays[0])))
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+
+static u32 s_rng = DIFF_SEED;
+
+static u32 rngNext(void) {
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng;
+}
+
+// Uniform in [lo, hi]
+static int rngRange(int lo, int hi) {
+    return lo + (int)(rngNext() % (u32)(hi - lo + 1));
+}
+
+// Level headers define static data, so a unit that includes one has its own
+// copy; match on content rather than address.
+static int levelIndexOf(const Level* level) {
+    for (int i = 0; i < LEVEL_COUNT; i++) {
+        const Level* l = g_levels[i];
+        if (l == level || (l->width == level->width && l->height == level->height &&
+                           strcmp(l->name, level->name) == 0)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Player fields compared after collision and transitions. Compared one by
+// one because the struct has padding, and only the state machine's state
+// ids are meaningful (the callbacks are the same functions in both runs).
+typedef struct {
+    const char* name;
+    size_t offset;
+    size_t size;
+} PlayerField;
+
+#define PLAYER_FIELD(f) { #f, offsetof(Player, f), sizeof(((Player*)0)->f) }
+
+static const PlayerField s_playerFields[] = {
+    PLAYER_FIELD(clock), PLAYER_FIELD(x), PLAYER_FIELD(y), PLAYER_FIELD(vx), PLAYER_FIELD(vy),
+    PLAYER_FIELD(maxFall), PLAYER_FIELD(onGround), PLAYER_FIELD(wasOnGround),
+    PLAYER_FIELD(coyoteTime), PLAYER_FIELD(jumpBufferUntil), PLAYER_FIELD(jumpHeld),
+    PLAYER_FIELD(autoJump), PLAYER_FIELD(autoJumpUntil), PLAYER_FIELD(liftBoostX),
+    PLAYER_FIELD(liftBoostY), PLAYER_FIELD(varJumpSpeed), PLAYER_FIELD(varJumpUntil),
+    PLAYER_FIELD(dashing), PLAYER_FIELD(dashes), PLAYER_FIELD(maxDashes),
+    PLAYER_FIELD(dashCooldownUntil), PLAYER_FIELD(dashRefillCooldownUntil),
+    PLAYER_FIELD(facingRight), PLAYER_FIELD(prevKeys), PLAYER_FIELD(wallSlideTimer),
+    PLAYER_FIELD(wallSlideDir), PLAYER_FIELD(dashAttackUntil), PLAYER_FIELD(dashDirX),
+    PLAYER_FIELD(dashDirY), PLAYER_FIELD(beforeDashSpeedX), PLAYER_FIELD(ducking),
+    PLAYER_FIELD(lastAimX), PLAYER_FIELD(lastAimY), PLAYER_FIELD(stamina),
+    PLAYER_FIELD(climbNoMoveUntil), PLAYER_FIELD(lastClimbMove),
+    PLAYER_FIELD(wallBoostUntil), PLAYER_FIELD(wallBoostDir), PLAYER_FIELD(hopWaitX),
+    PLAYER_FIELD(hopWaitXSpeed), PLAYER_FIELD(forceMoveX), PLAYER_FIELD(forceMoveXUntil),
+    PLAYER_FIELD(hitSquashNoMoveTimer), PLAYER_FIELD(boostTargetX),
+    PLAYER_FIELD(boostTargetY), PLAYER_FIELD(boostRed), PLAYER_FIELD(boostTimer),
+    PLAYER_FIELD(currentBubbleX), PLAYER_FIELD(currentBubbleY), PLAYER_FIELD(trailX),
+    PLAYER_FIELD(trailY), PLAYER_FIELD(trailFacing), PLAYER_FIELD(trailIndex),
+    PLAYER_FIELD(trailTimer), PLAYER_FIELD(trailFadeTimer),
+    PLAYER_FIELD(stateMachine.state), PLAYER_FIELD(stateMachine.previousState),
+    PLAYER_FIELD(asleep),
+};
+#define PLAYER_FIELD_COUNT ((int)(sizeof(s_playerFields) / sizeof(s_playerFields[0])))
+
+// Name of the first differing field, or NULL if the players match.
+static const char* playerDiff(const Player* a, const Player* b) {
+    for (int i = 0; i < PLAYER_FIELD_COUNT; i++) {
+        const PlayerField* f = &s_playerFields[i];
+        if (memcmp((const u8*)a + f->offset, (const u8*)b + f->offset, f->size) != 0) {
+            return f->name;
+        }
+    }
+    return NULL;
+}
+
+// Scalar fields only: ints and the u16 clock / deadlines / keys.
+static int isScalarField(const PlayerField* f) {
+    return f->size == sizeof(int) || f->size == sizeof(u16);
+}
+
+static int playerFieldGet(const Player* p, const PlayerField* f) {
+    const u8* at = (const u8*)p + f->offset;
+    return f->size == sizeof(u16) ? *(const u16*)at : *(const int*)at;
+}
+
+static void playerFieldSet(Player* p, const PlayerField* f, int v) {
+    u8* at = (u8*)p + f->offset;
+    if (f->size == sizeof(u16)) {
+        *(u16*)at = (u16)v;
+    } else {
+        *(int*)at = v;
+    }
+}
+
+// Print the fields of `p` that differ from a freshly spawned player.
+static void printPlayerRepro(const Player* p, const Level* level, const char* indent) {
+    Player spawn;
+    initPlayer(&spawn, level);
+    printf("%sinitPlayer(&p, &%s);", indent, level->name);
+    for (int i = 0; i < PLAYER_FIELD_COUNT; i++) {
+        const PlayerField* f = &s_playerFields[i];
+        if (!isScalarField(f)) continue;
+        int v = playerFieldGet(p, f);
+        if (v != playerFieldGet(&spawn, f)) {
+            printf(" p.%s = %d;", f->name, v);
+        }
+    }
+    printf("\n");
+}
+
+// ---------------------------------------------------------------------------
+// Frame snapshots (gameplay screenblocks + BG registers)
+// ---------------------------------------------------------------------------
+
+static const u8 s_snapshotScreenblocks[] = { SB_BG1, SB_BG2, SB_BG1_BACK, SB_BG2_BACK };
+#define SNAPSHOT_SBS  ((int)sizeof(s_snapshotScreenblocks))
+#define SNAPSHOT_REGS (0x60 / 2)   // DISPCNT .. BLDY
+
+typedef struct {
+    u16 map[SNAPSHOT_SBS][32 * 32];
+    u16 regs[SNAPSHOT_REGS];
+    Player player;
+    Camera camera;
+    int levelIndex;
+    int transitioning;
+} FrameSnapshot;
+
+static FrameSnapshot s_snapsA[MAX_RUN_FRAMES];
+static FrameSnapshot s_snapsB[MAX_RUN_FRAMES];
+
+static void resetSharedVram(void) {
+    vblankQueueDesktopClearVram();
+    initVBlankQueue();
+}
+
+// Present the frame the way the VBlank ISR would, then record it.
+static void takeSnapshot(FrameSnapshot* s, const DiffEngine* e, const Player* player,
+                         const Camera* camera, int transitioning) {
+    vblankQueueSubmit();
+    vblankQueueFlush();
+    for (int i = 0; i < SNAPSHOT_SBS; i++) {
+        volatile u16* sb = vramScreenblock(s_snapshotScreenblocks[i]);
+        for (int j = 0; j < 32 * 32; j++) s->map[i][j] = sb[j];
+    }
+    for (int r = 0; r < SNAPSHOT_REGS; r++) {
+        s->regs[r] = vblankQueueDesktopReg((u16)(r * 2));
+    }
+    s->player = *player;
+    s->camera = *camera;
+    s->levelIndex = e->currentLevelIndex();
+    s->transitioning = transitioning;
+}
+
+// Describe the first difference between two snapshots into `out`; 0 if equal.
+static int snapshotDiff(const FrameSnapshot* a, const FrameSnapshot* b, char* out, size_t outSize) {
+    for (int i = 0; i < SNAPSHOT_SBS; i++) {
+        for (int j = 0; j < 32 * 32; j++) {
+            if (a->map[i][j] != b->map[i][j]) {
+                snprintf(out, outSize, "screenblock %d (%d,%d): 0x%04X vs 0x%04X",
+                         s_snapshotScreenblocks[i], j & 31, j >> 5, a->map[i][j], b->map[i][j]);
+                return 1;
+            }
+        }
+    }
+    for (int r = 0; r < SNAPSHOT_REGS; r++) {
+        if (a->regs[r] != b->regs[r]) {
+            snprintf(out, outSize, "register 0x%02X: 0x%04X vs 0x%04X", r * 2, a->regs[r], b->regs[r]);
+            return 1;
+        }
+    }
+    const char* field = playerDiff(&a->player, &b->player);
+    if (field) {
+        snprintf(out, outSize, "player.%s", field);
+        return 1;
+    }
+    if (a->camera.x != b->camera.x || a->camera.y != b->camera.y) {
+        snprintf(out, outSize, "camera (%d,%d) vs (%d,%d)", a->camera.x, a->camera.y, b->camera.x, b->camera.y);
+        return 1;
+    }
+    if (a->levelIndex != b->levelIndex || a->transitioning != b->transitioning) {
+        snprintf(out, outSize, "room %d%s vs %d%s", a->levelIndex, a->transitioning ? " (transitioning)" : "",
+                 b->levelIndex, b->transitioning ? " (transitioning)" : "");
+        return 1;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Level decoding
+// ---------------------------------------------------------------------------
+
+// Compare the decoded layer buffers and tile entry tables of one buffer.
+// Only the VRAM slots this level was placed in are compared; the rest still
+// hold whatever earlier loads left there.
+static int decodeDiff(const DiffEngine* a, const DiffEngine* b, const Level* level, int buffer,
+                      int vramStart, char* out, size_t outSize) {
+    for (int layer = 0; layer < level->layerCount; layer++) {
+        const u16* ta = a->layerTiles(buffer, layer);
+        const u16* tb = b->layerTiles(buffer, layer);
+        if (!ta || !tb) {
+            if (ta != tb) {
+                snprintf(out, outSize, "layer %d buffer missing in one engine", layer);
+                return 1;
+            }
+            continue;
+        }
+        for (int i = 0; i < level->width * level->height; i++) {
+            if (ta[i] != tb[i]) {
+                snprintf(out, outSize, "layer %d tile (%d,%d): %d vs %d",
+                         layer, i % level->width, i / level->width, ta[i], tb[i]);
+                return 1;
+            }
+        }
+    }
+    const u16* ea = a->tileEntries(buffer);
+    const u16* eb = b->tileEntries(buffer);
+    for (int i = 0; i < LEVEL_VRAM_TILE_LIMIT; i++) {
+        if (ea[i] != eb[i]) {
+            snprintf(out, outSize, "tile entry %d: 0x%04X vs 0x%04X", i, ea[i], eb[i]);
+            return 1;
+        }
+    }
+    const u16* va = a->vramTiles();
+    const u16* vb = b->vramTiles();
+    for (int i = vramStart; i < vramStart + level->uniqueTileCount; i++) {
+        if (va[i] != vb[i]) {
+            snprintf(out, outSize, "VRAM tile slot %d: %d vs %d", i, va[i], vb[i]);
+            return 1;
+        }
+    }
+    if (a->tileVramOffset() != b->tileVramOffset()) {
+        snprintf(out, outSize, "tile VRAM offset %d vs %d", a->tileVramOffset(), b->tileVramOffset());
+        return 1;
+    }
+    return 0;
+}
+
+static int regionQueriesDiff(const DiffEngine* a, const DiffEngine* b, const Level* level,
+                             char* out, size_t outSize) {
+    for (int q = 0; q < 200; q++) {
+        u8 layer = (u8)rngRange(0, level->layerCount);   // One past the end: missing layer
+        int x0 = rngRange(-8, level->width + 8);
+        int y0 = rngRange(-8, level->height + 8);
+        int x1 = x0 + rngRange(0, 40);
+        int y1 = y0 + rngRange(0, 30);
+        int ra = a->isLayerRegionEmpty(level, layer, x0, y0, x1, y1);
+        int rb = b->isLayerRegionEmpty(level, layer, x0, y0, x1, y1);
+        if (ra != rb) {
+            snprintf(out, outSize, "isLayerRegionEmpty(layer %d, %d,%d..%d,%d): %d vs %d",
+                     layer, x0, y0, x1, y1, ra, rb);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int runDecodeSuite(const DiffEngine* a, const DiffEngine* b) {
+    char detail[160];
+    int divergences = 0;
+
+    for (int i = 0; i < LEVEL_COUNT; i++) {
+        const Level* level = g_levels[i];
+        a->invalidateResidency();
+        b->invalidateResidency();
+        a->loadLevel(level);
+        b->loadLevel(level);
+        if (decodeDiff(a, b, level, DIFF_BUFFER_MAIN, 0, detail, sizeof(detail)) ||
+            regionQueriesDiff(a, b, level, detail, sizeof(detail))) {
+            printf("  DIVERGED: loadLevelToVRAM(&%s): %s\n", level->name, detail);
+            divergences++;
+            continue;
+        }
+
+        for (int j = 0; j < LEVEL_COUNT; j++) {
+            const Level* incoming = g_levels[j];
+            if (level->uniqueTileCount + incoming->uniqueTileCount > LEVEL_VRAM_TILE_LIMIT) continue;
+
+            a->loadLevel(level);
+            b->loadLevel(level);
+            a->loadLevelB(incoming, level->uniqueTileCount);
+            b->loadLevelB(incoming, level->uniqueTileCount);
+            if (decodeDiff(a, b, incoming, DIFF_BUFFER_B, level->uniqueTileCount, detail, sizeof(detail))) {
+                printf("  DIVERGED: loadLevelBToVRAM(&%s) after &%s: %s\n", incoming->name, level->name, detail);
+                divergences++;
+                continue;
+            }
+            a->adoptLevelB(incoming);
+            b->adoptLevelB(incoming);
+            if (decodeDiff(a, b, incoming, DIFF_BUFFER_MAIN, level->uniqueTileCount, detail, sizeof(detail))) {
+                printf("  DIVERGED: adoptLevelBBuffer(&%s) after &%s: %s\n", incoming->name, level->name, detail);
+                divergences++;
+            }
+        }
+    }
+    return divergences;
+}
+
+// ---------------------------------------------------------------------------
+// Collision
+// ---------------------------------------------------------------------------
+
+#define WALL_PROBES 12
+
+typedef struct {
+    Player afterBoth;      // collideHorizontal then collideVertical
+    Player afterVertical;  // collideVertical alone
+    int colliding;
+    int walls[WALL_PROBES];
+    int ceiling;
+} CollisionResult;
+
+static void collisionProbe(const DiffEngine* e, const Level* level, const Player* probe,
+                           CollisionResult* r) {
+    r->afterBoth = *probe;
+    e->collideHorizontal(&r->afterBoth, level);
+    e->collideVertical(&r->afterBoth, level);
+
+    r->afterVertical = *probe;
+    e->collideVertical(&r->afterVertical, level);
+
+    r->colliding = e->isPositionCollidingAt(level, probe->x >> FIXED_SHIFT, probe->y >> FIXED_SHIFT);
+
+    int n = 0;
+    static const int yAdds[] = { 0, -1, 1 };
+    static const int dists[] = { 1, CLIMB_CHECK_DIST };
+    for (int dir = -1; dir <= 1; dir += 2) {
+        for (int y = 0; y < 3; y++) {
+            for (int d = 0; d < 2; d++) {
+                r->walls[n++] = e->checkWallAt(probe, level, dir, yAdds[y], dists[d]);
+            }
+        }
+    }
+    r->ceiling = e->checkCeiling(probe, level);
+}
+
+static int collisionDiff(const DiffEngine* a, const DiffEngine* b, const Level* level,
+                         const Player* probe, char* out, size_t outSize) {
+    CollisionResult ra, rb;
+    collisionProbe(a, level, probe, &ra);
+    collisionProbe(b, level, probe, &rb);
+
+    const char* field = playerDiff(&ra.afterBoth, &rb.afterBoth);
+    if (field) {
+        snprintf(out, outSize, "collideHorizontal+collideVertical: player.%s", field);
+        return 1;
+    }
+    field = playerDiff(&ra.afterVertical, &rb.afterVertical);
+    if (field) {
+        snprintf(out, outSize, "collideVertical: player.%s", field);
+        return 1;
+    }
+    if (ra.colliding != rb.colliding) {
+        snprintf(out, outSize, "isPositionCollidingAt: %d vs %d", ra.colliding, rb.colliding);
+        return 1;
+    }
+    for (int i = 0; i < WALL_PROBES; i++) {
+        if (ra.walls[i] != rb.walls[i]) {
+            snprintf(out, outSize, "checkWallAt probe %d: %d vs %d", i, ra.walls[i], rb.walls[i]);
+            return 1;
+        }
+    }
+    if (ra.ceiling != rb.ceiling) {
+        snprintf(out, outSize, "checkCeiling: %d vs %d", ra.ceiling, rb.ceiling);
+        return 1;
+    }
+    return 0;
+}
+
+// Greedily simplify a diverging probe: each int field is pulled back to its
+// spawn value, halfway there, or (for sub-pixel values) onto the pixel grid,
+// and the change is kept if the probe still diverges. Every accepted step
+// moves a field strictly closer to spawn, so this reaches a fixed point.
+static void minimiseProbe(const DiffEngine* a, const DiffEngine* b, const Level* level, Player* probe) {
+    char scratch[160];
+    Player spawn;
+    initPlayer(&spawn, level);
+
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (int i = 0; i < PLAYER_FIELD_COUNT; i++) {
+            const PlayerField* f = &s_playerFields[i];
+            if (!isScalarField(f)) continue;
+            int home = playerFieldGet(&spawn, f);
+            int old = playerFieldGet(probe, f);
+            int candidates[3] = { home, home + (old - home) / 2, old & ~(FIXED_ONE - 1) };
+            for (int c = 0; c < 3; c++) {
+                if (abs(candidates[c] - home) >= abs(old - home)) continue;
+                playerFieldSet(probe, f, candidates[c]);
+                if (collisionDiff(a, b, level, probe, scratch, sizeof(scratch))) {
+                    changed = 1;
+                    break;
+                }
+                playerFieldSet(probe, f, old);
+            }
+        }
+    }
+}
+
+static void randomProbe(Player* p, const Level* level) {
+    initPlayer(p, level);
+    p->x = (rngRange(-PLAYER_WIDTH, level->width * 8 + PLAYER_WIDTH) << FIXED_SHIFT) | rngRange(0, FIXED_ONE - 1);
+    p->y = (rngRange(-PLAYER_HEIGHT, level->height * 8 + PLAYER_HEIGHT) << FIXED_SHIFT) | rngRange(0, FIXED_ONE - 1);
+    p->vx = rngRange(-8 * FIXED_ONE, 8 * FIXED_ONE);
+    p->vy = rngRange(-8 * FIXED_ONE, 8 * FIXED_ONE);
+    p->onGround = rngRange(0, 1);
+    p->ducking = (rngRange(0, 3) == 0);
+    p->dashing = (rngRange(0, 3) == 0);
+}
+
+static int reportProbe(const DiffEngine* a, const DiffEngine* b, const Level* level,
+                       Player* probe, const char* origin) {
+    char detail[160];
+    if (!collisionDiff(a, b, level, probe, detail, sizeof(detail))) return 0;
+    printf("  DIVERGED: %s probe in %s: %s\n", origin, level->name, detail);
+    minimiseProbe(a, b, level, probe);
+    collisionDiff(a, b, level, probe, detail, sizeof(detail));
+    printf("    minimal repro (%s):\n", detail);
+    printPlayerRepro(probe, level, "      ");
+    return 1;
+}
+
+// Random probes in every level, then every frame of the recorded replays
+// (player stepped with the live code, each state probed in both engines).
+static int runCollisionSuite(const DiffEngine* a, const DiffEngine* b, int probesPerLevel) {
+    int divergences = 0;
+
+    for (int i = 0; i < LEVEL_COUNT && !divergences; i++) {
+        const Level* level = g_levels[i];
+        a->beginRoom(i);
+        b->beginRoom(i);
+        for (int n = 0; n < probesPerLevel; n++) {
+            Player probe;
+            randomProbe(&probe, level);
+            if (reportProbe(a, b, level, &probe, "random")) {
+                divergences++;
+                break;
+            }
+        }
+    }
+
+    for (int t = 0; t < REPLAY_COUNT && !divergences; t++) {
+        const MechanicsTest* test = s_replays[t];
+        const Level* level = test->level ? test->level : &level3;
+        int levelIndex = levelIndexOf(level);
+        if (levelIndex < 0) continue;
+
+        // The live player code needs the live engine's buffers; each engine
+        // keeps its own, so loading both rooms leaves both ready.
+        g_liveEngine.beginRoom(levelIndex);
+        a->beginRoom(levelIndex);
+        b->beginRoom(levelIndex);
+
+        Player player;
+        initPlayer(&player, level);
+        if (test->startX != 0 || test->startY != 0) {
+            player.x = test->startX;
+            player.y = test->startY;
+            player.vx = 0;
+            player.vy = 0;
+        }
+        SpringManager springs;
+        initSpringManager(&springs);
+        loadSpringsFromLevel(&springs, level);
+
+        for (int frame = 0; frame < test->frameCount; frame++) {
+            Player probe = player;
+            if (reportProbe(a, b, level, &probe, test->name)) {
+                printf("    (frame %d of the replay)\n", frame);
+                divergences++;
+                break;
+            }
+            updatePlayer(&player, test->inputs[frame], level);
+            updateSprings(&springs, &player);
+        }
+    }
+    return divergences;
+}
+
+// ---------------------------------------------------------------------------
+// Tilemap streaming along camera paths
+// ---------------------------------------------------------------------------
+
+static void clampCamera(Camera* c, const Level* level) {
+    int maxX = level->width * 8 - SCREEN_WIDTH;
+    int maxY = level->height * 8 - SCREEN_HEIGHT;
+    if (c->x > maxX) c->x = maxX;
+    if (c->y > maxY) c->y = maxY;
+    if (c->x < 0) c->x = 0;
+    if (c->y < 0) c->y = 0;
+}
+
+// Run one engine along a camera path, one snapshot per frame.
+static void runCameraPath(const DiffEngine* e, int levelIndex, const Camera* path, int frames,
+                          FrameSnapshot* snaps) {
+    resetSharedVram();
+    e->beginRoom(levelIndex);
+    Player player;
+    initPlayer(&player, g_levels[levelIndex]);
+    for (int f = 0; f < frames; f++) {
+        Camera camera = path[f];
+        int transitioning = e->frame(&player, &camera);
+        takeSnapshot(&snaps[f], e, &player, &camera, transitioning);
+    }
+}
+
+// First diverging frame of a path, or -1.
+static int cameraPathDiverges(const DiffEngine* a, const DiffEngine* b, int levelIndex,
+                              const Camera* path, int frames, char* out, size_t outSize) {
+    runCameraPath(a, levelIndex, path, frames, s_snapsA);
+    runCameraPath(b, levelIndex, path, frames, s_snapsB);
+    for (int f = 0; f < frames; f++) {
+        if (snapshotDiff(&s_snapsA[f], &s_snapsB[f], out, outSize)) return f;
+    }
+    return -1;
+}
+
+// Delta debugging (ddmin) over the frames of a diverging path: repeatedly
+// drop chunks of frames while some frame of the remainder still diverges.
+static int minimisePath(const DiffEngine* a, const DiffEngine* b, int levelIndex,
+                        Camera* path, int frames) {
+    static Camera candidate[MAX_RUN_FRAMES];
+    char scratch[160];
+    int granularity = 2;
+
+    while (frames >= 2) {
+        int chunk = (frames + granularity - 1) / granularity;
+        int reduced = 0;
+        for (int start = 0; start < frames; start += chunk) {
+            int n = 0;
+            for (int f = 0; f < frames; f++) {
+                if (f < start || f >= start + chunk) candidate[n++] = path[f];
+            }
+            if (n > 0 && cameraPathDiverges(a, b, levelIndex, candidate, n, scratch, sizeof(scratch)) >= 0) {
+                memcpy(path, candidate, n * sizeof(Camera));
+                frames = n;
+                if (granularity > 2) granularity--;
+                reduced = 1;
+                break;
+            }
+        }
+        if (!reduced) {
+            if (granularity >= frames) break;
+            granularity = (granularity * 2 < frames) ? granularity * 2 : frames;
+        }
+    }
+    return frames;
+}
+
+static int randomCameraPath(Camera* path, const Level* level) {
+    Camera c = { rngRange(0, level->width * 8), rngRange(0, level->height * 8) };
+    clampCamera(&c, level);
+    for (int f = 0; f < CAMERA_PATH_FRAMES; f++) {
+        if (rngRange(0, 59) == 0) {
+            c.x = rngRange(0, level->width * 8);
+            c.y = rngRange(0, level->height * 8);
+        } else {
+            c.x += rngRange(-16, 16);
+            c.y += rngRange(-16, 16);
+        }
+        clampCamera(&c, level);
+        path[f] = c;
+    }
+    return CAMERA_PATH_FRAMES;
+}
+
+// Camera followed by the live camera code along a recorded replay.
+static int replayCameraPath(Camera* path, const MechanicsTest* test, const Level* level) {
+    g_liveEngine.beginRoom(levelIndexOf(level));
+    Player player;
+    initPlayer(&player, level);
+    if (test->startX != 0 || test->startY != 0) {
+        player.x = test->startX;
+        player.y = test->startY;
+    }
+    Camera camera = {0};
+    settleCameraToPlayer(&camera, player.x >> FIXED_SHIFT, player.y >> FIXED_SHIFT, level);
+    int frames = test->frameCount < MAX_RUN_FRAMES ? test->frameCount : MAX_RUN_FRAMES;
+    for (int f = 0; f < frames; f++) {
+        updatePlayer(&player, test->inputs[f], level);
+        updateCamera(&camera, &player, level);
+        path[f] = camera;
+    }
+    return frames;
+}
+
+static int checkCameraPath(const DiffEngine* a, const DiffEngine* b, int levelIndex,
+                           Camera* path, int frames, const char* origin, int* minimisedFrames) {
+    char detail[160];
+    int at = cameraPathDiverges(a, b, levelIndex, path, frames, detail, sizeof(detail));
+    if (at < 0) return 0;
+
+    printf("  DIVERGED: %s path in %s, frame %d: %s\n", origin, g_levels[levelIndex]->name, at, detail);
+    int n = minimisePath(a, b, levelIndex, path, at + 1);
+    at = cameraPathDiverges(a, b, levelIndex, path, n, detail, sizeof(detail));
+    printf("    minimal repro, %d frame%s (frame %d: %s):\n      camera", n, n == 1 ? "" : "s", at, detail);
+    for (int f = 0; f < n; f++) printf(" (%d,%d)", path[f].x, path[f].y);
+    printf("\n");
+    if (minimisedFrames) *minimisedFrames = n;
+    return 1;
+}
+
+static int runCameraSuite(const DiffEngine* a, const DiffEngine* b, int pathsPerLevel, int* minimisedFrames) {
+    static Camera path[MAX_RUN_FRAMES];
+
+    for (int i = 0; i < LEVEL_COUNT; i++) {
+        for (int p = 0; p < pathsPerLevel; p++) {
+            int frames = randomCameraPath(path, g_levels[i]);
+            if (checkCameraPath(a, b, i, path, frames, "random", minimisedFrames)) return 1;
+        }
+    }
+    for (int t = 0; t < REPLAY_COUNT; t++) {
+        const Level* level = s_replays[t]->level ? s_replays[t]->level : &level3;
+        int levelIndex = levelIndexOf(level);
+        if (levelIndex < 0) continue;
+        int frames = replayCameraPath(path, s_replays[t], level);
+        if (checkCameraPath(a, b, levelIndex, path, frames, s_replays[t]->name, minimisedFrames)) return 1;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Room transitions
+// ---------------------------------------------------------------------------
+
+// Player standing at the from-side edge at perpPos, moving out of the room,
+// where collision would clamp it before asking for a transition.
+static void placeAtEdge(Player* p, const Level* level, int side, int perpPos) {
+    initPlayer(p, level);
+    int halfWidth = PLAYER_WIDTH / 2;
+    switch (side) {
+    case CONN_SIDE_RIGHT:
+        p->x = (level->width * 8 - halfWidth) << FIXED_SHIFT;
+        p->y = perpPos << FIXED_SHIFT;
+        p->vx = 2 * FIXED_ONE;
+        break;
+    case CONN_SIDE_LEFT:
+        p->x = halfWidth << FIXED_SHIFT;
+        p->y = perpPos << FIXED_SHIFT;
+        p->vx = -2 * FIXED_ONE;
+        break;
+    case CONN_SIDE_BOTTOM:
+        p->x = perpPos << FIXED_SHIFT;
+        p->y = (level->height * 8 - PLAYER_BOTTOM(0) - 1) << FIXED_SHIFT;
+        p->vy = 2 * FIXED_ONE;
+        break;
+    default:
+        p->x = perpPos << FIXED_SHIFT;
+        p->y = (-PLAYER_TOP(0)) << FIXED_SHIFT;
+        p->vy = -2 * FIXED_ONE;
+        break;
+    }
+}
+
+// Settle in the room, trigger the transition, run until it has finished
+// and the new room has streamed in. Returns the number of frames recorded.
+static int runTransition(const DiffEngine* e, const ScreenConnection* conn, int perpPos,
+                         FrameSnapshot* snaps, int* triggered) {
+    const Level* level = g_levels[conn->fromLevelIdx];
+    resetSharedVram();
+    e->beginRoom(conn->fromLevelIdx);
+
+    Player player;
+    placeAtEdge(&player, level, conn->fromSide, perpPos);
+    Camera camera = {0};
+    settleCameraToPlayer(&camera, player.x >> FIXED_SHIFT, player.y >> FIXED_SHIFT, level);
+
+    int f = 0;
+    for (; f < 3; f++) {
+        int transitioning = e->frame(&player, &camera);
+        takeSnapshot(&snaps[f], e, &player, &camera, transitioning);
+    }
+
+    *triggered = e->triggerTransition(conn->fromSide, perpPos, &player, &camera);
+    int settled = 0;
+    while (f < MAX_RUN_FRAMES && settled < TRANSITION_SETTLE) {
+        int transitioning = e->frame(&player, &camera);
+        takeSnapshot(&snaps[f], e, &player, &camera, transitioning);
+        f++;
+        if (!transitioning) settled++;
+    }
+    return f;
+}
+
+static int runTransitionSuite(const DiffEngine* a, const DiffEngine* b, int* triggeredCount) {
+    static const char* sideNames[] = { "right", "left", "bottom", "top" };
+    char detail[160];
+    int divergences = 0;
+    *triggeredCount = 0;
+
+    for (int c = 0; c < g_connectionCount; c++) {
+        const ScreenConnection* conn = &g_connections[c];
+        int perps[3] = { conn->fromStart, (conn->fromStart + conn->fromEnd) / 2, conn->fromEnd - 1 };
+        for (int p = 0; p < 3; p++) {
+            int trigA, trigB;
+            int framesA = runTransition(a, conn, perps[p], s_snapsA, &trigA);
+            int framesB = runTransition(b, conn, perps[p], s_snapsB, &trigB);
+            *triggeredCount += trigA;
+
+            int at = -1;
+            if (trigA != trigB) {
+                snprintf(detail, sizeof(detail), "trigger returned %d vs %d", trigA, trigB);
+                at = 3;
+            } else if (framesA != framesB) {
+                snprintf(detail, sizeof(detail), "ran %d vs %d frames", framesA, framesB);
+                at = framesA < framesB ? framesA : framesB;
+            }
+            for (int f = 0; f < framesA && f < framesB && at < 0; f++) {
+                if (snapshotDiff(&s_snapsA[f], &s_snapsB[f], detail, sizeof(detail))) at = f;
+            }
+            if (at >= 0) {
+                printf("  DIVERGED: %s -> %s (%s edge, perp %d), frame %d: %s\n",
+                       g_levels[conn->fromLevelIdx]->name, g_levels[conn->toLevelIdx]->name,
+                       sideNames[conn->fromSide], perps[p], at, detail);
+                divergences++;
+            }
+        }
+    }
+    return divergences;
+}
+
+// ---------------------------------------------------------------------------
+// Self-test: deliberately broken engines must be caught and shrunk
+// ---------------------------------------------------------------------------
+
+// Snaps a falling player one pixel lower than the live code would.
+static void mutantCollideVertical(Player* player, const Level* level) {
+    g_liveEngine.collideVertical(player, level);
+    if (player->vy > FIXED_ONE && !player->onGround) {
+        player->y += FIXED_ONE;
+    }
+}
+
+// Forgets to refresh one screen entry after a long camera jump.
+static Camera s_mutantLastCamera;
+static int s_mutantFirstFrame;
+static int mutantFrame(Player* player, Camera* camera) {
+    int transitioning = g_liveEngine.frame(player, camera);
+    int dx = camera->x - s_mutantLastCamera.x;
+    if (!s_mutantFirstFrame && (dx > 64 || dx < -64)) {
+        vramScreenblock(SB_BG1)[0] ^= 0x0001;
+    }
+    s_mutantLastCamera = *camera;
+    s_mutantFirstFrame = 0;
+    return transitioning;
+}
+
+static void mutantBeginRoom(int levelIndex) {
+    g_liveEngine.beginRoom(levelIndex);
+    s_mutantFirstFrame = 1;
+}
+
+static void test_self_check(void) {
+    printf("\n[Self-test] Mutant engines\n");
+
+    DiffEngine collisionMutant = g_liveEngine;
+    collisionMutant.name = "mutant collision";
+    collisionMutant.collideVertical = mutantCollideVertical;
+    ASSERT(runCollisionSuite(&g_liveEngine, &collisionMutant, 200) > 0,
+           "Collision mutant is detected");
+
+    // Every field but x/y/vy/onGround is noise the minimiser must strip.
+    Player probe;
+    initPlayer(&probe, &level3);
+    g_liveEngine.beginRoom(LEVEL_IDX_level3);
+    probe.x = 40 * FIXED_ONE + 77;
+    probe.y = 16 * FIXED_ONE + 13;
+    probe.vy = 5 * FIXED_ONE + 31;
+    probe.onGround = 0;
+    probe.dashes = 0;
+    probe.stamina = 1234;
+    probe.facingRight = !probe.facingRight;
+    char detail[160];
+    int diverges = collisionDiff(&g_liveEngine, &collisionMutant, &level3, &probe, detail, sizeof(detail));
+    ASSERT(diverges, "Hand-made collision probe diverges");
+    minimiseProbe(&g_liveEngine, &collisionMutant, &level3, &probe);
+    Player spawn;
+    initPlayer(&spawn, &level3);
+    ASSERT(probe.stamina == spawn.stamina && probe.dashes == spawn.dashes &&
+           probe.facingRight == spawn.facingRight,
+           "Minimiser drops the fields that do not matter");
+    ASSERT(collisionDiff(&g_liveEngine, &collisionMutant, &level3, &probe, detail, sizeof(detail)),
+           "Minimised probe still diverges");
+
+    DiffEngine tilemapMutant = g_liveEngine;
+    tilemapMutant.name = "mutant tilemap";
+    tilemapMutant.beginRoom = mutantBeginRoom;
+    tilemapMutant.frame = mutantFrame;
+    int minimisedFrames = MAX_RUN_FRAMES;
+    ASSERT(runCameraSuite(&g_liveEngine, &tilemapMutant, 1, &minimisedFrames) > 0,
+           "Tilemap mutant is detected");
+    ASSERT(minimisedFrames == 2, "Camera path shrinks to the jump that triggers it");
+}
+
+// ---------------------------------------------------------------------------
+// Live vs reference
+// ---------------------------------------------------------------------------
+
+static void test_level_decoding(void) {
+    printf("\n[Differential] Level decoding, %d levels\n", LEVEL_COUNT);
+    ASSERT(runDecodeSuite(&g_liveEngine, &g_referenceEngine) == 0,
+           "Layer buffers, tile entries and VRAM placement match the reference");
+}
+
+static void test_collision(void) {
+    printf("\n[Differential] Collision, %d random probes per level + %d replays\n",
+           COLLISION_PROBES, REPLAY_COUNT);
+    ASSERT(runCollisionSuite(&g_liveEngine, &g_referenceEngine, COLLISION_PROBES) == 0,
+           "Collision results match the reference");
+}
+
+static void test_tilemap_streaming(void) {
+    printf("\n[Differential] Tilemap streaming, %d random camera paths per level + %d replays\n",
+           CAMERA_PATHS, REPLAY_COUNT);
+    ASSERT(runCameraSuite(&g_liveEngine, &g_referenceEngine, CAMERA_PATHS, NULL) == 0,
+           "Screenblocks and BG registers match the reference every frame");
+}
+
+static void test_transitions(void) {
+    printf("\n[Differential] Transitions, %d connections x 3 entry points\n", g_connectionCount);
+    int triggered = 0;
+    ASSERT(runTransitionSuite(&g_liveEngine, &g_referenceEngine, &triggered) == 0,
+           "Transitions match the reference every frame");
+    ASSERT(triggered > 0, "Scenarios actually start transitions");
+}
+
+int main(void) {
+    printf("=== Differential Tests (live vs tests/reference) ===\n");
+
+    // Self-test first so a harness bug cannot masquerade as a clean run.
+    test_self_check();
+
+    test_level_decoding();
+    test_collision();
+    test_tilemap_streaming();
+    test_transitions();
+
+    printf("\n================================\n");
+    printf("Results: %d passed, %d failed\n", g_passed, g_failed);
+    return (g_failed > 0) ? 1 : 0;
+}
+
+#endif // DESKTOP_BUILD
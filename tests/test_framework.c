@@ -3,10 +3,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
 #include "test_framework.h"
 #include "player/player.h"
 #include "core/game_math.h"
 #include "entities/spring.h"
+#include "core/cost_model.h"
+#include "core/log.h"
 
 void initTestResults(TestResults* results) {
     results->passed = 0;
@@ -14,6 +17,47 @@ void initTestResults(TestResults* results) {
     results->currentTest = NULL;
 }
 
+static int playersMatch(const Player* a, const Player* b) {
+    Player lhs = *a;
+    Player rhs = *b;
+    lhs.asleep = 0;
+    rhs.asleep = 0;
+    return memcmp(&lhs, &rhs, sizeof(Player)) == 0;
+}
+
+// Replay the inputs twice in lockstep, once with the idle sleep fast path
+// and once forcing the full update, and require identical players every frame.
+static int verifySleepEquivalence(const MechanicsTest* test, const Player* start, const Level* level) {
+    Player fast = *start;
+    Player full = *start;
+    SpringManager fastSprings, fullSprings;
+    initSpringManager(&fastSprings);
+    loadSpringsFromLevel(&fastSprings, level);
+    initSpringManager(&fullSprings);
+    loadSpringsFromLevel(&fullSprings, level);
+
+    int asleepFrames = 0;
+    for (int frame = 0; frame < test->frameCount; frame++) {
+        u16 keys = test->inputs[frame];
+
+        updatePlayer(&fast, keys, level);
+        updateSprings(&fastSprings, &fast);
+
+        g_playerSleepEnabled = 0;
+        updatePlayer(&full, keys, level);
+        updateSprings(&fullSprings, &full);
+        g_playerSleepEnabled = 1;
+
+        if (fast.asleep) asleepFrames++;
+        if (!playersMatch(&fast, &full)) {
+            printf("  FAIL: Sleep fast path diverged from full update (frame %d)\n", frame);
+            return 0;
+        }
+    }
+    printf("  INFO: Sleep fast path matched full update (%d frames asleep)\n", asleepFrames);
+    return 1;
+}
+
 void runMechanicsTest(const MechanicsTest* test, const Level* defaultLevel, TestResults* results) {
     results->currentTest = test->name;
 
@@ -22,6 +66,7 @@ void runMechanicsTest(const MechanicsTest* test, const Level* defaultLevel, Test
 
     // Use test-specific level if provided, otherwise use default
     const Level* level = test->level ? test->level : defaultLevel;
+    loadLevelToVRAM(level);  // collision reads the decoded tile layer
 
     // Initialize player
     Player player;
@@ -46,10 +91,18 @@ void runMechanicsTest(const MechanicsTest* test, const Level* defaultLevel, Test
     }
     printf("  INFO: Player starts at (%d, %d) pixels\n", test->startX >> FIXED_SHIFT, test->startY >> FIXED_SHIFT);
 
-    // Run replay
+    if (!verifySleepEquivalence(test, &player, level)) {
+        results->failed++;
+        printf("  ❌ FAILED\n");
+        return;
+    }
+
+    // Run replay, tallying estimated GBA cycles per subsystem
+    gbaCostReset();
     int testFailed = 0;
     for (int frame = 0; frame < test->frameCount; frame++) {
         u16 keys = test->inputs[frame];
+        logSetFrame(frame);
 
         // Custom per-frame verification
         if (test->verifyFrame) {
@@ -61,16 +114,25 @@ void runMechanicsTest(const MechanicsTest* test, const Level* defaultLevel, Test
         }
 
         // Update player
+        COST_PUSH(COST_SUB_PLAYER);
         updatePlayer(&player, keys, level);
+        COST_POP();
 
         // Update springs (check collisions and trigger bounces)
+        COST_PUSH(COST_SUB_ENTITIES);
         updateSprings(&springManager, &player);
+        COST_POP();
+
+        gbaCostEndFrame();
+        logDrain(LOG_RING_SIZE);  // Only prints when built with a lower LOG_LEVEL
     }
 
     if (testFailed) {
         return;  // Already counted as failed
     }
 
+    gbaCostPrintReport("  ");
+
     // Verify final state
     int finalFailed = 0;
 
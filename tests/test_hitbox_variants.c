@@ -0,0 +1,289 @@
+#ifdef DESKTOP_BUILD
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "desktop/desktop_stubs.h"
+#include "collision/collision.h"
+#include "level/level.h"
+#include "player/player.h"
+#include "transition/transition.h"
+#include "generated/connections.h"
+
+/**
+ * Player hitbox variants.
+ *
+ * collision.c compiles one copy of the sweeps and probes per entry of
+ * PLAYER_HITBOXES, with the hitbox size folded in, and picks the copy through
+ * a function-pointer table. This checks every copy against the runtime-sized
+ * build of the same bodies (*Sized, desktop only) on random player states in
+ * every level, checks what the duck hitbox changes, and times both builds.
+ * Built with -O2 so the constant folding the copies exist for happens.
+ */
+
+#define PROBES_PER_LEVEL 4000
+#define BENCH_PROBES 1024
+#define BENCH_REPEATS 400
+
+// transition.c calls back into the menu module on a real transition; the
+// sweeps here only predict, so this is never reached.
+void loadLevelForTransition(int levelIndex) {
+    (void)levelIndex;
+}
+
+// Trajectory prediction flags (player.c, not linked here)
+int g_playerPredicting = 0;
+int g_playerPredictExit = 0;
+
+static int g_passed = 0;
+static int g_failed = 0;
+
+#define ASSERT(cond, msg) \
+    do { \
+        if (cond) { printf("  PASS: %s\n", msg); g_passed++; } \
+        else      { printf("  FAIL: %s\n", msg); g_failed++; } \
+    } while(0)
+
+#define HITBOX_SIZE_ENTRY(id, name, width, height) [HITBOX_##id] = { #name, width, height },
+static const struct {
+    const char* name;
+    int width;
+    int height;
+} s_hitboxes[HITBOX_COUNT] = {
+    PLAYER_HITBOXES(HITBOX_SIZE_ENTRY)
+};
+
+static unsigned int g_rng = 0x41C64E6Du;
+
+static int rngRange(int lo, int hi) {
+    g_rng = g_rng * 1103515245u + 12345u;
+    return lo + (int)((g_rng >> 8) % (unsigned)(hi - lo + 1));
+}
+
+// Anywhere in the level, edges included, moving up to 4px a frame
+static void randomPlayer(Player* p, const Level* level, HitboxId hitbox) {
+    memset(p, 0, sizeof(*p));
+    p->x = rngRange(0, level->width * 8 - 1) << FIXED_SHIFT;
+    p->y = rngRange(0, level->height * 8 - 1) << FIXED_SHIFT;
+    p->vx = rngRange(-4 * FIXED_ONE, 4 * FIXED_ONE);
+    p->vy = rngRange(-4 * FIXED_ONE, 4 * FIXED_ONE);
+    p->dashing = rngRange(0, 1);
+    p->ducking = (hitbox == HITBOX_DUCK);
+}
+
+static void test_matches_runtime_sized(void) {
+    printf("\n[Hitbox] Specialised copies vs runtime-sized build, %d probes per level\n", PROBES_PER_LEVEL);
+    int mismatches[HITBOX_COUNT] = { 0 };
+    int probeMismatches = 0;
+    int duckOutsideNormal = 0;
+    int duckOnlyClear = 0;
+    int ceilingMismatches = 0;
+
+    for (int i = 0; i < LEVEL_COUNT; i++) {
+        const Level* level = g_levels[i];
+        loadLevelToVRAM(level);
+        setTransitionLevelContext(i, 0, 0, 0, 0);
+
+        for (int n = 0; n < PROBES_PER_LEVEL; n++) {
+            for (int h = 0; h < HITBOX_COUNT; h++) {
+                Player special, sized;
+                randomPlayer(&special, level, (HitboxId)h);
+                sized = special;
+
+                collideHorizontal(&special, level);
+                collideVertical(&special, level);
+                collideHorizontalSized(&sized, level, s_hitboxes[h].width, s_hitboxes[h].height);
+                collideVerticalSized(&sized, level, s_hitboxes[h].width, s_hitboxes[h].height);
+                if (memcmp(&special, &sized, sizeof(Player)) != 0) mismatches[h]++;
+            }
+
+            int x = rngRange(0, level->width * 8 - 1);
+            int y = rngRange(0, level->height * 8 - 1);
+            int collides[HITBOX_COUNT];
+            for (int h = 0; h < HITBOX_COUNT; h++) {
+                collides[h] = isHitboxCollidingAt(level, (HitboxId)h, x, y);
+                if (collides[h] != hitboxCollidesSized(level, x, y, s_hitboxes[h].width, s_hitboxes[h].height)) {
+                    probeMismatches++;
+                }
+            }
+            if (collides[HITBOX_DUCK] && !collides[HITBOX_NORMAL]) duckOutsideNormal++;
+            if (!collides[HITBOX_DUCK] && collides[HITBOX_NORMAL]) duckOnlyClear++;
+
+            Player ducked;
+            memset(&ducked, 0, sizeof(ducked));
+            ducked.x = x << FIXED_SHIFT;
+            ducked.y = y << FIXED_SHIFT;
+            ducked.ducking = 1;
+            if (checkCeiling(&ducked, level) != collides[HITBOX_NORMAL]) ceilingMismatches++;
+        }
+    }
+
+    for (int h = 0; h < HITBOX_COUNT; h++) {
+        char msg[96];
+        snprintf(msg, sizeof(msg), "%s (%dx%d) sweeps match the runtime-sized build",
+                 s_hitboxes[h].name, s_hitboxes[h].width, s_hitboxes[h].height);
+        ASSERT(mismatches[h] == 0, msg);
+    }
+    ASSERT(probeMismatches == 0, "isHitboxCollidingAt matches the runtime-sized probe");
+    ASSERT(ceilingMismatches == 0, "checkCeiling is the standing hitbox probe");
+
+    printf("  Positions only the duck hitbox fits: %d\n", duckOnlyClear);
+    ASSERT(duckOutsideNormal == 0, "Duck hitbox never collides where the standing one is clear");
+    ASSERT(duckOnlyClear > 0, "Duck hitbox fits under ceilings the standing one hits");
+}
+
+static void test_duck_shares_bottom_edge(void) {
+    printf("\n[Hitbox] Landing and bonking while ducked\n");
+    const Level* level = g_levels[0];
+    loadLevelToVRAM(level);
+    setTransitionLevelContext(0, 0, 0, 0, 0);
+
+    // Drop both hitboxes from the same spots: they land at the same Y
+    int landed = 0;
+    int sameLanding = 1;
+    for (int n = 0; n < PROBES_PER_LEVEL; n++) {
+        Player standing, ducked;
+        randomPlayer(&standing, level, HITBOX_NORMAL);
+        standing.vy = 3 * FIXED_ONE;
+        standing.vx = 0;
+        ducked = standing;
+        ducked.ducking = 1;
+        int y = standing.y >> FIXED_SHIFT;
+        if (isHitboxCollidingAt(level, HITBOX_NORMAL, standing.x >> FIXED_SHIFT, y)) continue;
+
+        collideVertical(&standing, level);
+        collideVertical(&ducked, level);
+        if (!standing.onGround) continue;
+        landed++;
+        if (!ducked.onGround || ducked.y != standing.y) sameLanding = 0;
+    }
+    printf("  Landings compared: %d\n", landed);
+    ASSERT(landed > 0 && sameLanding, "Both hitboxes land on the same floor at the same Y");
+
+    // Rising into a ceiling stops the duck hitbox's own top edge at the tile
+    int bonked = 0;
+    int topAtTile = 1;
+    for (int n = 0; n < PROBES_PER_LEVEL; n++) {
+        Player ducked;
+        randomPlayer(&ducked, level, HITBOX_DUCK);
+        ducked.vy = -3 * FIXED_ONE;
+        ducked.vx = 0;
+        ducked.dashing = 0;
+        int x = ducked.x >> FIXED_SHIFT;
+        if (isHitboxCollidingAt(level, HITBOX_DUCK, x, ducked.y >> FIXED_SHIFT)) continue;
+
+        collideVertical(&ducked, level);
+        if (ducked.vy != 0 || (ducked.x >> FIXED_SHIFT) != x) continue;  // clear, or nudged aside
+        int screenY = ducked.y >> FIXED_SHIFT;
+        int top = HITBOX_TOP(screenY, PLAYER_DUCK_HEIGHT);
+        if (top <= 0 || PLAYER_BOTTOM(screenY) >= level->height * 8 - 1) continue;  // level bounds
+        bonked++;
+        if (top % 8 != 0 || isHitboxCollidingAt(level, HITBOX_DUCK, x, screenY)) topAtTile = 0;
+    }
+    printf("  Bonks compared: %d\n", bonked);
+    ASSERT(bonked > 0 && topAtTile, "Ducked bonk snaps the duck hitbox top to the tile bottom");
+}
+
+// ---- benchmark ----
+
+typedef struct {
+    Player players[BENCH_PROBES];
+    int x[BENCH_PROBES];
+    int y[BENCH_PROBES];
+} BenchSet;
+
+static BenchSet s_bench[HITBOX_COUNT];
+
+// Read through a volatile so the runtime-sized calls cannot be folded
+static volatile int s_runtimeSize[HITBOX_COUNT][2];
+
+static double nsPerCall(clock_t start, int calls) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC * 1e9 / calls;
+}
+
+static void test_benchmark(void) {
+    printf("\n[Hitbox] Host time per call, specialised vs runtime-sized (-O2, %d x %d calls)\n",
+           BENCH_REPEATS, BENCH_PROBES);
+    const Level* level = g_levels[0];
+    loadLevelToVRAM(level);
+    setTransitionLevelContext(0, 0, 0, 0, 0);
+
+    for (int h = 0; h < HITBOX_COUNT; h++) {
+        s_runtimeSize[h][0] = s_hitboxes[h].width;
+        s_runtimeSize[h][1] = s_hitboxes[h].height;
+        for (int n = 0; n < BENCH_PROBES; n++) {
+            randomPlayer(&s_bench[h].players[n], level, (HitboxId)h);
+            s_bench[h].x[n] = rngRange(0, level->width * 8 - 1);
+            s_bench[h].y[n] = rngRange(0, level->height * 8 - 1);
+        }
+    }
+
+    int calls = BENCH_REPEATS * BENCH_PROBES;
+    volatile int sink = 0;
+    for (int h = 0; h < HITBOX_COUNT; h++) {
+        const BenchSet* set = &s_bench[h];
+        int width = s_runtimeSize[h][0];
+        int height = s_runtimeSize[h][1];
+
+        clock_t start = clock();
+        for (int r = 0; r < BENCH_REPEATS; r++) {
+            for (int n = 0; n < BENCH_PROBES; n++) {
+                sink += isHitboxCollidingAt(level, (HitboxId)h, set->x[n], set->y[n]);
+            }
+        }
+        double probeSpecial = nsPerCall(start, calls);
+
+        start = clock();
+        for (int r = 0; r < BENCH_REPEATS; r++) {
+            for (int n = 0; n < BENCH_PROBES; n++) {
+                sink += hitboxCollidesSized(level, set->x[n], set->y[n], width, height);
+            }
+        }
+        double probeSized = nsPerCall(start, calls);
+
+        start = clock();
+        for (int r = 0; r < BENCH_REPEATS; r++) {
+            for (int n = 0; n < BENCH_PROBES; n++) {
+                Player p = set->players[n];
+                collideHorizontal(&p, level);
+                collideVertical(&p, level);
+                sink += p.y;
+            }
+        }
+        double sweepSpecial = nsPerCall(start, calls);
+
+        start = clock();
+        for (int r = 0; r < BENCH_REPEATS; r++) {
+            for (int n = 0; n < BENCH_PROBES; n++) {
+                Player p = set->players[n];
+                collideHorizontalSized(&p, level, width, height);
+                collideVerticalSized(&p, level, width, height);
+                sink += p.y;
+            }
+        }
+        double sweepSized = nsPerCall(start, calls);
+
+        printf("  %-6s probe %6.1f ns vs %6.1f ns (%.2fx), sweeps %6.1f ns vs %6.1f ns (%.2fx)\n",
+               s_hitboxes[h].name, probeSpecial, probeSized, probeSized / probeSpecial,
+               sweepSpecial, sweepSized, sweepSized / sweepSpecial);
+    }
+    (void)sink;
+}
+
+int main(void) {
+    printf("=== Hitbox Variants ===\n");
+
+    initTransition();
+    g_playerPredicting = 1;  // report exits instead of starting transitions
+
+    test_matches_runtime_sized();
+    test_duck_shares_bottom_edge();
+    test_benchmark();
+
+    printf("\n================================\n");
+    printf("Results: %d passed, %d failed\n", g_passed, g_failed);
+    return (g_failed > 0) ? 1 : 0;
+}
+
+#endif // DESKTOP_BUILD
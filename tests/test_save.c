@@ -0,0 +1,259 @@
+#ifdef DESKTOP_BUILD
+
+#include <stdio.h>
+#include <string.h>
+
+#include "desktop/desktop_stubs.h"
+#include "desktop/flash_emu.h"
+#include "core/quality.h"
+#include "core/save.h"
+
+// ---- tiny test harness ----
+static int g_passed = 0;
+static int g_failed = 0;
+
+#define ASSERT(cond, msg) \
+    do { \
+        if (cond) { printf("  PASS: %s\n", msg); g_passed++; } \
+        else      { printf("  FAIL: %s\n", msg); g_failed++; } \
+    } while(0)
+
+#define SECTORS_64K (FLASH_EMU_BANK_SIZE / FLASH_EMU_SECTOR_SIZE)
+
+static u32 s_rng = 0x12345678;
+
+static u32 nextRandom(void) {
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng;
+}
+
+static u8 s_expected[SAVE_LOGICAL_SIZE];
+
+static void writeRange(u32 offset, u32 len, u32 seed) {
+    s_rng = seed;
+    for (u32 i = 0; i < len; i++) {
+        u8 value = (u8)nextRandom();
+        s_expected[offset + i] = value;
+        saveWrite8(offset + i, value);
+    }
+}
+
+static int matchesExpected(u32 offset, u32 len) {
+    for (u32 i = 0; i < len; i++) {
+        if (saveRead8(offset + i) != s_expected[offset + i]) return 0;
+    }
+    return 1;
+}
+
+static void freshFlash(const SaveBackend* backend, int banks) {
+    flashEmuReset(banks);
+    saveInit(backend);
+    memset(s_expected, 0xFF, sizeof(s_expected));
+}
+
+// ---------------------------------------------------------------------------
+
+static void test_sram_round_trip(void) {
+    printf("\n[SRAM backend]\n");
+    saveInit(&g_saveSram);
+    writeRange(0, SAVE_LOGICAL_SIZE, 1);
+    ASSERT(saveService(1000) == 0, "SRAM never has pending writes");
+    ASSERT(matchesExpected(0, SAVE_LOGICAL_SIZE), "every byte reads back");
+    saveWrite32(0x7000, 0x4D4C4554);
+    ASSERT(saveRead32(0x7000) == 0x4D4C4554 && saveRead8(0x7000) == 0x54, "u32 helpers are little-endian");
+    ASSERT(saveRead8(SAVE_LOGICAL_SIZE) == 0xFF, "reads past the logical size return 0xFF");
+}
+
+static void test_flash_round_trip(const SaveBackend* backend, int banks) {
+    printf("\n[%s: round trip]\n", backend->name);
+    freshFlash(backend, banks);
+    ASSERT(saveRead8(0) == 0xFF && saveRead8(SAVE_LOGICAL_SIZE - 1) == 0xFF, "blank chip mounts as all 0xFF");
+
+    writeRange(0, SAVE_LOGICAL_SIZE, 2);
+    ASSERT(matchesExpected(0, SAVE_LOGICAL_SIZE), "writes are visible before they reach the chip");
+    saveFlush();
+    ASSERT(flashEmuViolations() == 0, "no program over 0 bits, stray writes or writes while erasing");
+
+    flashEmuPowerCycle();
+    saveInit(backend);
+    ASSERT(matchesExpected(0, SAVE_LOGICAL_SIZE), "everything survives a remount");
+
+    writeRange(0x7000, 64, 3);
+    saveFlush();
+    flashEmuPowerCycle();
+    saveInit(backend);
+    ASSERT(matchesExpected(0, SAVE_LOGICAL_SIZE), "partial rewrite keeps the rest of the sector");
+    ASSERT(flashEmuViolations() == 0, "still no erase semantics violations");
+}
+
+// Each service call stays inside its byte budget, so a save can never
+// stall a frame; with no budget nothing touches the chip at all.
+static void test_flash_bounded_chunks(void) {
+    printf("\n[Flash: bounded chunks]\n");
+    freshFlash(&g_saveFlash64, 1);
+    writeRange(0x2000, 0x3000, 4);
+
+    // Slack of T ticks buys N bytes: N programs of 4 bus writes each, plus
+    // one erase (6 writes) when a new sector is started.
+    const int ticks = 20;
+    const int budget = SAVE_FLASH_TICKS_TO_BYTES(ticks);
+    u32 worstWrites = 0;
+    int calls = 0;
+    int pending = 1;
+    while (pending && calls < 100000) {
+        u32 before = flashEmuWriteCount();
+        pending = saveService(ticks);
+        u32 writes = flashEmuWriteCount() - before;
+        if (writes > worstWrites) worstWrites = writes;
+        calls++;
+    }
+    char msg[128];
+    snprintf(msg, sizeof(msg), "worst call issued %u bus writes (limit %d)", worstWrites, budget * 4 + 6);
+    ASSERT(worstWrites <= (u32)(budget * 4 + 6), msg);
+    ASSERT(!pending, "pending writes drain");
+
+    writeRange(0x2000, 0x3000, 6);
+    worstWrites = 0;
+    pending = 1;
+    for (calls = 0; pending && calls < 100000; calls++) {
+        u32 before = flashEmuWriteCount();
+        pending = saveService(QUALITY_FRAME_TICKS);
+        u32 writes = flashEmuWriteCount() - before;
+        if (writes > worstWrites) worstWrites = writes;
+    }
+    snprintf(msg, sizeof(msg), "a whole frame of slack still stops at %d bytes (%u bus writes)",
+             SAVE_FLASH_BYTES_PER_SERVICE, worstWrites);
+    ASSERT(worstWrites <= (u32)(SAVE_FLASH_BYTES_PER_SERVICE * 4 + 6), msg);
+
+    writeRange(0, 16, 5);
+    u32 before = flashEmuWriteCount();
+    saveService(0);
+    ASSERT(flashEmuWriteCount() - before <= 6, "zero slack only starts the erase");
+    saveFlush();
+
+    u32 idle = flashEmuWriteCount();
+    ASSERT(saveService(1000) == 0 && flashEmuWriteCount() == idle, "idle service does not touch the chip");
+
+    saveWrite8(0x10, saveRead8(0x10));
+    ASSERT(saveService(1000) == 0, "rewriting the same value does not dirty the sector");
+}
+
+// Rewriting one logical sector over and over must rotate through every
+// physical sector that does not hold another live copy.
+static void test_flash_wear_rotation(const SaveBackend* backend, int banks) {
+    printf("\n[%s: wear rotation]\n", backend->name);
+    freshFlash(backend, banks);
+    writeRange(0, SAVE_LOGICAL_SIZE, 6);
+    saveFlush();
+
+    const int rewrites = 400;
+    for (int i = 0; i < rewrites; i++) {
+        saveWrite32(0, (u32)i);
+        saveFlush();
+    }
+
+    int sectors = banks * SECTORS_64K;
+    u32 lo = 0xFFFFFFFF, hi = 0, total = 0;
+    for (int s = 0; s < sectors; s++) {
+        u32 n = flashEmuEraseCount(s);
+        total += n;
+        if (n < lo) lo = n;
+        if (n > hi) hi = n;
+    }
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%d erases over %d sectors, min %u max %u", total, sectors, lo, hi);
+    ASSERT(total == (u32)(rewrites + SAVE_FLASH_LOGICAL_SECTORS), msg);
+    // The seven sectors holding the untouched logical sectors are erased
+    // once; everything else shares the rewrites evenly.
+    u32 share = (u32)(rewrites + sectors - 1) / (u32)(sectors - (SAVE_FLASH_LOGICAL_SECTORS - 1));
+    ASSERT(hi <= share + 1, "no sector is erased much more than its share");
+
+    flashEmuPowerCycle();
+    saveInit(backend);
+    ASSERT(saveRead32(0) == (u32)(rewrites - 1), "newest copy wins after remount");
+    s_expected[0] = saveRead8(0);
+    s_expected[1] = saveRead8(1);
+    s_expected[2] = saveRead8(2);
+    s_expected[3] = saveRead8(3);
+    ASSERT(matchesExpected(0, SAVE_LOGICAL_SIZE), "other sectors untouched by the rotation");
+}
+
+// Cut the power at points spread over a whole sector rewrite (erase,
+// payload, header, commit); after a remount the sector must read back
+// either entirely old or entirely new.
+static void test_flash_power_cut(void) {
+    printf("\n[Flash: power cut during a save]\n");
+    static u8 before[SAVE_FLASH_PAYLOAD];
+    static u8 after[SAVE_FLASH_PAYLOAD];
+
+    freshFlash(&g_saveFlash64, 1);
+    writeRange(0, 2 * SAVE_FLASH_PAYLOAD, 7);
+    saveFlush();
+    memcpy(before, s_expected, SAVE_FLASH_PAYLOAD);
+
+    // Count the bus writes a full rewrite takes
+    u32 start = flashEmuWriteCount();
+    writeRange(0, SAVE_FLASH_PAYLOAD, 8);
+    memcpy(after, s_expected, SAVE_FLASH_PAYLOAD);
+    saveFlush();
+    u32 fullWrites = flashEmuWriteCount() - start;
+
+    int torn = 0, sawOld = 0, sawNew = 0, otherDamaged = 0;
+    int steps = 0;
+    for (u32 cut = 0; cut <= fullWrites + 64; cut += 37) {
+        // Alternate between the two contents so every cut rewrites the sector
+        const u8* oldData = (steps & 1) ? before : after;
+        const u8* newData = (steps & 1) ? after : before;
+        steps++;
+
+        flashEmuCutPowerAfter((int)cut);
+        for (u32 i = 0; i < SAVE_FLASH_PAYLOAD; i++) saveWrite8(i, newData[i]);
+        // Powered off, every program fails and is retried: keep going for
+        // as long as a full save would take, then power back on.
+        for (int i = 0; i < 200 && saveService(SAVE_FLASH_SERVICE_TICKS); i++) {
+        }
+        flashEmuPowerCycle();
+        saveInit(&g_saveFlash64);
+
+        int isOld = 1, isNew = 1;
+        for (u32 i = 0; i < SAVE_FLASH_PAYLOAD; i++) {
+            u8 v = saveRead8(i);
+            if (v != oldData[i]) isOld = 0;
+            if (v != newData[i]) isNew = 0;
+        }
+        if (!isOld && !isNew) torn++;
+        sawOld += isOld;
+        sawNew += isNew;
+        if (!matchesExpected(SAVE_FLASH_PAYLOAD, SAVE_FLASH_PAYLOAD)) otherDamaged++;
+
+        // Settle on the new contents for the next round
+        for (u32 i = 0; i < SAVE_FLASH_PAYLOAD; i++) saveWrite8(i, newData[i]);
+        saveFlush();
+    }
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%d cuts: %d kept the old copy, %d the new, %d torn", steps, sawOld, sawNew, torn);
+    ASSERT(torn == 0, msg);
+    ASSERT(sawOld > 0 && sawNew > 0, "cuts landed both before and after the commit");
+    ASSERT(otherDamaged == 0, "the neighbouring sector is never damaged");
+}
+
+int main(void) {
+    printf("=== Save Backend Tests ===\n");
+
+    test_sram_round_trip();
+    test_flash_round_trip(&g_saveFlash64, 1);
+    test_flash_round_trip(&g_saveFlash128, 2);
+    test_flash_bounded_chunks();
+    test_flash_wear_rotation(&g_saveFlash64, 1);
+    test_flash_wear_rotation(&g_saveFlash128, 2);
+    test_flash_power_cut();
+
+    printf("\n================================\n");
+    printf("Results: %d passed, %d failed\n", g_passed, g_failed);
+    return (g_failed > 0) ? 1 : 0;
+}
+
+#endif // DESKTOP_BUILD
@@ -0,0 +1,291 @@
+#ifdef DESKTOP_BUILD
+
+#include <stdio.h>
+#include <string.h>
+
+#include "desktop/desktop_stubs.h"
+#include "camera/camera.h"
+#include "core/cost_model.h"
+#include "core/input.h"
+#include "core/log.h"
+#include "desktop/gba_cost.h"
+#include "entities/entity_managers.h"
+#include "level/level.h"
+#include "player/player.h"
+#include "player/player_predict.h"
+#include "player/state.h"
+#include "transition/transition.h"
+
+// Generated into generated/stress/ by `make stress`
+#include "stress_connections.h"
+#include "stress_entities.h"
+#include "stress_fit_a.h"
+#include "stress_fit_b.h"
+#include "stress_miss_a.h"
+#include "stress_miss_b.h"
+#include "stress_inputs.h"
+#include "stress_wide.h"
+
+/**
+ * Worst-case stress runs.
+ *
+ * Drives the synthetic levels from tools/stress_level_generator.py through
+ * the same per-frame order as main.c (transition or player+entities, then
+ * camera) and prints estimated GBA cycles per subsystem, average and worst
+ * frame. The connected pairs also check which side of the VRAM budget the
+ * transition lands on.
+ */
+
+static const Level* s_currentLevel = NULL;
+static int s_currentLevelIndex = 0;
+static int s_levelChanged = 0;
+
+// transition.c calls back into the menu module to make the destination level
+// current; mirror menu.c's scroll-adopt / fade-reload split.
+void loadLevelForTransition(int levelIndex) {
+    if (levelIndex < 0 || levelIndex >= LEVEL_COUNT) return;
+    s_currentLevel = g_levels[levelIndex];
+    s_currentLevelIndex = levelIndex;
+    s_levelChanged = 1;
+
+    COST_PUSH(COST_SUB_TILEMAP);
+    if (g_levelBLayerTiles[0] != 0) {
+        adoptLevelBBuffer(s_currentLevel);
+    } else {
+        loadLevelToVRAM(s_currentLevel);
+    }
+    COST_POP();
+}
+
+static int g_passed = 0;
+static int g_failed = 0;
+
+#define ASSERT(cond, msg) \
+    do { \
+        if (cond) { printf("  PASS: %s\n", msg); g_passed++; } \
+        else      { printf("  FAIL: %s\n", msg); g_failed++; } \
+    } while(0)
+
+typedef struct {
+    int sawScroll;          // A scroll transition was active on some frame
+    int transitions;        // Transitions started
+    int endLevelIndex;
+    // With s_checkPrediction: a held-input path predicted every frame
+    int predictions;
+    int predictionsLeftRoom;
+    int predictionSideEffects;  // player, transition or log touched
+    int predictionMismatches;   // first predicted frame != the real update
+} StressRun;
+
+static int s_checkPrediction = 0;
+
+// Predict 32 frames of the current input in small step budgets, as the
+// overlay does, and check nothing outside the Prediction changed.
+static void predictAndCheck(Prediction* prediction, const Player* player, u16 keys,
+                            const Level* level, StressRun* run) {
+    Player before = *player;
+    int logged = logPending();
+    predictStart(prediction, player, keys, 32);
+    while (!predictRun(prediction, level, 5)) {
+    }
+    run->predictions++;
+    if (prediction->leftRoom) run->predictionsLeftRoom++;
+    if (memcmp(&before, player, sizeof(Player)) != 0 || isTransitioning() || logPending() != logged) {
+        run->predictionSideEffects++;
+    }
+}
+
+static void runStressPath(int levelIndex, const u16* inputs, int frameCount, StressRun* run) {
+    Player player;
+    Camera camera = {0};
+    EntityManagers entities;
+
+    memset(run, 0, sizeof(*run));
+    clearTransitionTestOverrides();  // stress_connections.c is the registered world
+    initTransition();
+
+    gbaCostReset();
+
+    s_currentLevel = g_levels[levelIndex];
+    s_currentLevelIndex = levelIndex;
+    COST_PUSH(COST_SUB_TILEMAP);
+    loadLevelToVRAM(s_currentLevel);
+    COST_POP();
+
+    initPlayer(&player, s_currentLevel);
+    initEntityManagers(&entities);
+    loadEntitiesFromLevel(&entities, s_currentLevel);
+    settleCameraToPlayer(&camera, player.x >> FIXED_SHIFT, player.y >> FIXED_SHIFT, s_currentLevel);
+    gbaCostEndFrame();
+
+    for (int frame = 0; frame < frameCount; frame++) {
+        u16 keys = inputs[frame];
+        s_levelChanged = 0;
+
+        setTransitionLevelContext(s_currentLevelIndex, camera.x, camera.y, player.x, player.y);
+        int transitionActiveAtFrameStart = isTransitioning();
+
+        if (transitionActiveAtFrameStart) {
+            COST_PUSH(COST_SUB_TILEMAP);
+            updateTransition(&player, &camera);
+            COST_POP();
+        } else {
+            Prediction prediction;
+            if (s_checkPrediction) {
+                predictAndCheck(&prediction, &player, keys, s_currentLevel, run);
+            }
+            COST_PUSH(COST_SUB_PLAYER);
+            updatePlayer(&player, keys, s_currentLevel);
+            COST_POP();
+            if (s_checkPrediction && !isTransitioning() && prediction.done > 0 &&
+                (prediction.pathX[0] != (player.x >> FIXED_SHIFT) ||
+                 prediction.pathY[0] != (player.y >> FIXED_SHIFT))) {
+                run->predictionMismatches++;
+            }
+            updateEntities(&entities, &player);
+            if (isTransitioning()) run->transitions++;
+        }
+
+        ScrollTransInfo info;
+        getScrollTransInfo(&info);
+        if (info.active) run->sawScroll = 1;
+
+        if (s_levelChanged) {
+            initEntityManagers(&entities);
+            loadEntitiesFromLevel(&entities, s_currentLevel);
+        }
+
+        if (!transitionActiveAtFrameStart && !isTransitioning()) {
+            updateCamera(&camera, &player, s_currentLevel);
+        } else {
+            player.prevKeys = keys;
+        }
+
+        gbaCostEndFrame();
+    }
+
+    run->endLevelIndex = s_currentLevelIndex;
+    gbaCostPrintReport("  ");
+    clearTransitionTestOverrides();
+}
+
+static void test_wide_noisy_level(void) {
+    printf("\n[Stress] 512x40, noisy layers, %d unique tiles\n", (int)stress_wide.uniqueTileCount);
+    ASSERT(stress_wide.width == 512 && stress_wide.height == 40, "Wide level fills the tile buffer");
+    ASSERT(stress_wide.uniqueTileCount == LEVEL_VRAM_TILE_LIMIT, "Wide level uses every VRAM tile slot");
+
+    StressRun run;
+    runStressPath(LEVEL_IDX_stress_wide, stress_wide_inputs, STRESS_WIDE_INPUT_FRAMES, &run);
+    ASSERT(run.endLevelIndex == LEVEL_IDX_stress_wide, "Wide level run stays in its room");
+}
+
+static void test_full_entity_screen(void) {
+    printf("\n[Stress] One screen, 32 of each entity\n");
+    int springs = 0, red = 0, green = 0;
+    for (int i = 0; i < stress_entities.objectCount; i++) {
+        ObjectType t = stress_entities.objects[i].type;
+        if (t == OBJ_SPRING) springs++;
+        else if (t == OBJ_RED_BUBBLE) red++;
+        else if (t == OBJ_GREEN_BUBBLE) green++;
+    }
+    ASSERT(springs == 32 && red == 32 && green == 32, "Entity level fills every manager");
+
+    StressRun run;
+    runStressPath(LEVEL_IDX_stress_entities, stress_entities_inputs, STRESS_ENTITIES_INPUT_FRAMES, &run);
+}
+
+static void test_vram_budget_fit(void) {
+    printf("\n[Stress] Connected pair at exactly the VRAM budget (%d + %d)\n",
+           (int)stress_fit_a.uniqueTileCount, (int)stress_fit_b.uniqueTileCount);
+    ASSERT(stress_fit_a.uniqueTileCount + stress_fit_b.uniqueTileCount == LEVEL_VRAM_TILE_LIMIT,
+           "Fit pair sums to the VRAM limit");
+
+    StressRun run;
+    runStressPath(LEVEL_IDX_stress_fit_a, stress_pair_inputs, STRESS_PAIR_INPUT_FRAMES, &run);
+    ASSERT(run.transitions > 0, "Fit pair: sprint reaches the connection");
+    ASSERT(run.sawScroll, "Fit pair: takes the scroll transition");
+    ASSERT(run.endLevelIndex == LEVEL_IDX_stress_fit_b, "Fit pair: ends in the destination room");
+}
+
+static void test_vram_budget_miss(void) {
+    printf("\n[Stress] Connected pair one tile over the VRAM budget (%d + %d)\n",
+           (int)stress_miss_a.uniqueTileCount, (int)stress_miss_b.uniqueTileCount);
+    ASSERT(stress_miss_a.uniqueTileCount + stress_miss_b.uniqueTileCount == LEVEL_VRAM_TILE_LIMIT + 1,
+           "Miss pair exceeds the VRAM limit by one tile");
+
+    StressRun run;
+    runStressPath(LEVEL_IDX_stress_miss_a, stress_pair_inputs, STRESS_PAIR_INPUT_FRAMES, &run);
+    ASSERT(run.transitions > 0, "Miss pair: sprint reaches the connection");
+    ASSERT(!run.sawScroll, "Miss pair: falls back to the fade transition");
+    ASSERT(run.endLevelIndex == LEVEL_IDX_stress_miss_b, "Miss pair: ends in the destination room");
+}
+
+static void test_prediction(void) {
+    printf("\n[Stress] Trajectory prediction across the fit pair\n");
+    StressRun run;
+    s_checkPrediction = 1;
+    runStressPath(LEVEL_IDX_stress_fit_a, stress_pair_inputs, STRESS_PAIR_INPUT_FRAMES, &run);
+    s_checkPrediction = 0;
+    ASSERT(run.predictions > 0, "Predicted a path every simulated frame");
+    ASSERT(run.predictionSideEffects == 0, "Prediction leaves the player, transitions and log alone");
+    ASSERT(run.predictionMismatches == 0, "First predicted frame matches the real update");
+    ASSERT(run.predictionsLeftRoom > 0, "Paths ending at the connection stop there");
+    ASSERT(run.endLevelIndex == LEVEL_IDX_stress_fit_b, "The real run still transitions");
+
+    Player player;
+    initPlayer(&player, &stress_fit_a);
+    Prediction dash;
+    predictStartDash(&dash, &player, BTN_UP | BTN_RIGHT, 20);
+    predictRun(&dash, &stress_fit_a, PREDICT_MAX_FRAMES);
+    int dashed = 0, rose = 0;
+    for (int i = 0; i < dash.done; i++) {
+        if (dash.state[i] == ST_DASH) dashed = 1;
+        if (dash.pathY[i] < (player.y >> FIXED_SHIFT)) rose = 1;
+    }
+    ASSERT(dash.done == 20 && dashed && rose, "Dash candidate up-right dashes and rises");
+
+    // The overlay keeps a path while predictSameSource holds: a sleeping
+    // player's clock still advances, and a timer is its time left
+    Player idle = player;
+    for (int i = 0; i < 120 && !idle.asleep; i++) {
+        updatePlayer(&idle, 0, &stress_fit_a);
+    }
+    Player later = idle;
+    updatePlayer(&later, 0, &stress_fit_a);
+    ASSERT(idle.asleep && later.clock != idle.clock && predictSameSource(&later, &idle),
+           "A sleeping player keeps its prediction as its clock advances");
+
+    Player shifted = dash.clone;
+    shifted.clock += 7;
+#define SHIFT_DEADLINE(f) if (shifted.f != TIMER_OFF) shifted.f += 7;
+    PLAYER_DEADLINES(SHIFT_DEADLINE)
+#undef SHIFT_DEADLINE
+    Prediction a, b;
+    predictStart(&a, &dash.clone, BTN_RIGHT, 30);
+    predictStart(&b, &shifted, BTN_RIGHT, 30);
+    predictRun(&a, &stress_fit_a, PREDICT_MAX_FRAMES);
+    predictRun(&b, &stress_fit_a, PREDICT_MAX_FRAMES);
+    ASSERT(predictSameSource(&shifted, &dash.clone) && a.done == b.done &&
+           memcmp(a.pathX, b.pathX, a.done * sizeof(s16)) == 0 &&
+           memcmp(a.pathY, b.pathY, a.done * sizeof(s16)) == 0,
+           "Timers compare as time left, and predict the same path");
+
+    shifted.x += FIXED_ONE;
+    ASSERT(!predictSameSource(&shifted, &dash.clone), "A moved player needs a new prediction");
+}
+
+int main(void) {
+    printf("=== Worst-Case Stress Levels ===\n");
+
+    test_wide_noisy_level();
+    test_full_entity_screen();
+    test_vram_budget_fit();
+    test_vram_budget_miss();
+    test_prediction();
+
+    printf("\n================================\n");
+    printf("Results: %d passed, %d failed\n", g_passed, g_failed);
+    return (g_failed > 0) ? 1 : 0;
+}
+
+#endif // DESKTOP_BUILD
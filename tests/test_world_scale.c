@@ -0,0 +1,189 @@
+#ifdef DESKTOP_BUILD
+
+#include <stdio.h>
+#include <time.h>
+
+#include "desktop/desktop_stubs.h"
+#include "level/level.h"
+#include "player/player.h"
+#include "transition/transition.h"
+
+// Generated into generated/world/ by `make world-scale`
+#include "world_connections.h"
+
+/**
+ * World pipeline at scale.
+ *
+ * Runs against the 2000-room world from tools/world_generator.py, whose
+ * adjacency compile_connections.py derives on its own (autoConnect). Checks
+ * that room indices past a byte survive, that the per-room start table
+ * covers the sorted connection table exactly, that every exit has its way
+ * back, and that tryTriggerTransition finds every exit through the table.
+ * Prints the ROM the world tables take and the lookup time near the start
+ * and the end of the world, which should not differ.
+ */
+
+#define GBA_POINTER_SIZE 4
+#define OLD_CONNECTION_SIZE 20  // u8 indices, enum sides: 1+1+2 pad+4+4+6, padded
+#define TIMING_ROOMS 100
+#define TIMING_REPEATS 200
+
+// transition.c calls back into the menu module on a real transition; the
+// lookups here only predict, so this is never reached.
+void loadLevelForTransition(int levelIndex) {
+    (void)levelIndex;
+}
+
+static int g_passed = 0;
+static int g_failed = 0;
+
+#define ASSERT(cond, msg) \
+    do { \
+        if (cond) { printf("  PASS: %s\n", msg); g_passed++; } \
+        else      { printf("  FAIL: %s\n", msg); g_failed++; } \
+    } while(0)
+
+static int roomExitCount(int room) {
+    return g_roomConnections[room + 1] - g_roomConnections[room];
+}
+
+static void test_registry(void) {
+    printf("\n[World] %d rooms, %d connection entries\n", g_levelCount, g_connectionCount);
+    ASSERT(g_levelCount == LEVEL_COUNT, "Registry size matches LEVEL_COUNT");
+    ASSERT(g_levelCount > 255, "World needs 16-bit room indices");
+
+    int named = 1;
+    for (int i = 0; i < g_levelCount; i++) {
+        if (!g_levels[i] || !g_levelNames[i] || g_levels[i]->width == 0) named = 0;
+    }
+    ASSERT(named, "Every room has level data and a name");
+}
+
+static void test_room_table(void) {
+    printf("\n[World] Per-room connection table\n");
+    int ordered = g_roomConnections[0] == 0 && g_roomConnections[g_levelCount] == g_connectionCount;
+    int owned = 1;
+    int maxExits = 0;
+    int highRoomExits = 0;
+    for (int room = 0; room < g_levelCount; room++) {
+        int first = g_roomConnections[room];
+        int count = roomExitCount(room);
+        if (count < 0) ordered = 0;
+        if (count > maxExits) maxExits = count;
+        for (int i = first; i < first + count; i++) {
+            if (g_connections[i].fromLevelIdx != room) owned = 0;
+            if (room > 255) highRoomExits++;
+        }
+    }
+    printf("  Most exits from one room: %d\n", maxExits);
+    ASSERT(ordered, "Start table is monotonic and ends at the connection count");
+    ASSERT(owned, "Every slice holds only its own room's exits");
+    ASSERT(highRoomExits > 0, "Rooms past index 255 have exits");
+    ASSERT(maxExits <= 6, "Brick layout: at most 2 side and 4 vertical exits");
+}
+
+static int hasReverse(const ScreenConnection* conn) {
+    int first = g_roomConnections[conn->toLevelIdx];
+    int count = roomExitCount(conn->toLevelIdx);
+    for (int i = first; i < first + count; i++) {
+        const ScreenConnection* back = &g_connections[i];
+        if (back->toLevelIdx == conn->fromLevelIdx && back->fromSide == conn->toSide &&
+            back->toSide == conn->fromSide && back->fromStart == conn->toStart &&
+            back->toStart == conn->fromStart &&
+            back->fromEnd - back->fromStart == conn->fromEnd - conn->fromStart) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void test_symmetry(void) {
+    printf("\n[World] Derived adjacency\n");
+    int oneWay = 0;
+    int halfEdges = 0;
+    for (int i = 0; i < g_connectionCount; i++) {
+        if (!hasReverse(&g_connections[i])) oneWay++;
+        if (g_connections[i].fromEnd - g_connections[i].fromStart < 240 &&
+            (g_connections[i].fromSide == CONN_SIDE_TOP || g_connections[i].fromSide == CONN_SIDE_BOTTOM)) {
+            halfEdges++;
+        }
+    }
+    ASSERT(oneWay == 0, "Every exit has a matching way back");
+    ASSERT(halfEdges > 0, "Offset rows connect along partial edges");
+}
+
+static int triggerExit(const ScreenConnection* conn) {
+    setTransitionLevelContext(conn->fromLevelIdx, 0, 0, 0, 0);
+    g_playerPredictExit = 0;
+    int perp = (conn->fromStart + conn->fromEnd) / 2;
+    return tryTriggerTransition(g_levels[conn->fromLevelIdx], conn->fromSide, perp, NULL) &&
+           g_playerPredictExit;
+}
+
+static double lookupNanoseconds(int firstRoom) {
+    clock_t start = clock();
+    int found = 0;
+    for (int r = 0; r < TIMING_REPEATS; r++) {
+        for (int room = firstRoom; room < firstRoom + TIMING_ROOMS; room++) {
+            int i = g_roomConnections[room];
+            if (i < g_roomConnections[room + 1]) found += triggerExit(&g_connections[i]);
+        }
+    }
+    double elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    return found ? elapsed * 1e9 / found : 0.0;
+}
+
+static void test_runtime_lookup(void) {
+    printf("\n[World] tryTriggerTransition through the room table\n");
+    clearTransitionTestOverrides();
+    initTransition();
+    g_playerPredicting = 1;  // report exits instead of starting transitions
+
+    int missed = 0;
+    for (int i = 0; i < g_connectionCount; i++) {
+        if (!triggerExit(&g_connections[i])) missed++;
+    }
+    ASSERT(missed == 0, "Every exit triggers from its own room");
+
+    // Room 0 is the top-left corner: nothing beyond its left or top edge
+    setTransitionLevelContext(0, 0, 0, 0, 0);
+    ASSERT(!tryTriggerTransition(g_levels[0], CONN_SIDE_LEFT, 80, NULL) &&
+           !tryTriggerTransition(g_levels[0], CONN_SIDE_TOP, 120, NULL),
+           "World edges have no exits");
+
+    double early = lookupNanoseconds(0);
+    double late = lookupNanoseconds(g_levelCount - TIMING_ROOMS - 1);
+    printf("  Host time per lookup: rooms 0-%d %.0f ns, rooms %d-%d %.0f ns\n",
+           TIMING_ROOMS - 1, early, g_levelCount - TIMING_ROOMS - 1, g_levelCount - 2, late);
+    g_playerPredicting = 0;
+}
+
+static void test_memory(void) {
+    printf("\n[World] ROM taken by the world tables (GBA sizes)\n");
+    int connections = g_connectionCount * (int)sizeof(ScreenConnection);
+    int starts = (g_levelCount + 1) * (int)sizeof(u16);
+    int registry = g_levelCount * GBA_POINTER_SIZE * 2;  // g_levels + g_levelNames
+    int oldConnections = g_connectionCount * OLD_CONNECTION_SIZE;
+    printf("  Connections: %d x %d = %d bytes (was %d x %d = %d)\n",
+           g_connectionCount, (int)sizeof(ScreenConnection), connections,
+           g_connectionCount, OLD_CONNECTION_SIZE, oldConnections);
+    printf("  Room start table: %d bytes, registry pointers: %d bytes\n", starts, registry);
+    printf("  Total %d bytes of ROM, no RAM (all tables are const)\n", connections + starts + registry);
+    ASSERT(sizeof(ScreenConnection) == 12, "ScreenConnection packs into 12 bytes");
+}
+
+int main(void) {
+    printf("=== World Scale ===\n");
+
+    test_registry();
+    test_room_table();
+    test_symmetry();
+    test_runtime_lookup();
+    test_memory();
+
+    printf("\n================================\n");
+    printf("Results: %d passed, %d failed\n", g_passed, g_failed);
+    return (g_failed > 0) ? 1 : 0;
+}
+
+#endif // DESKTOP_BUILD
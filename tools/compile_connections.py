@@ -1,27 +1,36 @@
 #!/usr/bin/env python3
 """
-Connection Compiler - Compiles connections.json to a C header for GBA.
+Connection Compiler - Compiles connections.json to C for GBA.
 Usage: compile_connections.py <connections.json> <levels_dir> <output_connections.h>
 
 Scans levels_dir for *.tmx files, reads their dimensions and names,
-then generates a C header with level indices and connection data.
+then generates a C header with the level indices and, next to it, a .c
+file (same name) holding the level registry and connection data.
 
 Connection format in connections.json:
   "levels": { "stem": { "worldX": int, "worldY": int } }
   "connections": [ { "a": "stemA", "b": "stemB" } ]
+  "autoConnect": true   (optional: also connect every pair of rooms that
+                         share an edge, found with a sweep over the world)
 
 The shared edge and valid range are derived from the world positions.
 fromStart/fromEnd define the valid perpendicular exit range (local px).
 newPerpPos = perpPos - fromStart + toStart
+
+Connections are emitted sorted by source room, with a per-room start table
+(g_roomConnections) so the game finds a room's exits without a search.
 """
 
 import sys
 import os
 import json
+import heapq
 import xml.etree.ElementTree as ET
 from pathlib import Path
 
 SNAP_TOLERANCE = 2  # pixels — how close edges must be to count as adjacent
+MAX_ROOMS = 0xFFFF  # room indices and table offsets are u16
+VERBOSE_LIMIT = 64  # list every level / connection only for worlds this small
 
 
 def sanitize_identifier(name: str) -> str:
@@ -174,6 +183,51 @@ def derive_connection(a_stem, b_stem, meta, world_pos):
     return None
 
 
+def sweep_adjacent(stems, meta, world_pos, axis):
+    """
+    Pairs of rooms whose closing edge (right or bottom) meets another room's
+    opening edge (left or top) within SNAP_TOLERANCE, with overlapping spans.
+
+    axis 'x' finds right/left neighbours, 'y' bottom/top. Edges are swept in
+    order of where their span starts along the edge; each kind keeps the
+    spans still open, bucketed by edge coordinate, and a heap of their ends
+    to retire them. A new span only looks at the other kind's buckets within
+    the tolerance, so the cost is O(n log n) plus the number of pairs.
+
+    Returns a list of (closing_stem, opening_stem).
+    """
+    if axis == 'x':
+        pos, size, span_pos, span_size = 'worldX', 'widthPx', 'worldY', 'heightPx'
+    else:
+        pos, size, span_pos, span_size = 'worldY', 'heightPx', 'worldX', 'widthPx'
+
+    events = []  # (span_start, span_end, kind, edge_coord, stem); kind 0 closing, 1 opening
+    for stem in stems:
+        p = int(world_pos[stem][pos])
+        start = int(world_pos[stem][span_pos])
+        end = start + meta[stem][span_size]
+        events.append((start, end, 0, p + meta[stem][size], stem))
+        events.append((start, end, 1, p, stem))
+    events.sort()
+
+    active = ({}, {})  # per kind: edge_coord -> set of stems
+    ends = []          # (span_end, kind, edge_coord, stem)
+    pairs = []
+    for start, end, kind, coord, stem in events:
+        while ends and ends[0][0] <= start:
+            _, k, c, st = heapq.heappop(ends)
+            active[k][c].discard(st)
+        other = active[1 - kind]
+        for c in range(coord - SNAP_TOLERANCE, coord + SNAP_TOLERANCE + 1):
+            for st in other.get(c, ()):
+                if st == stem:
+                    continue
+                pairs.append((stem, st) if kind == 0 else (st, stem))
+        active[kind].setdefault(coord, set()).add(stem)
+        heapq.heappush(ends, (end, kind, coord, stem))
+    return pairs
+
+
 def main():
     if len(sys.argv) != 4:
         print(f"Usage: {sys.argv[0]} <connections.json> <levels_dir> <output_connections.h>",
@@ -208,9 +262,17 @@ def main():
             continue
         display_name, w, h = result
         stem = tmx_path.stem
-        print(f"  Level: {stem!r}  name={display_name!r}  size={w}x{h} tiles")
+        if len(tmx_files) <= VERBOSE_LIMIT:
+            print(f"  Level: {stem!r}  name={display_name!r}  size={w}x{h} tiles")
         level_info.append((stem, display_name, w, h))
 
+    if len(level_info) > MAX_ROOMS:
+        print(f"ERROR: {len(level_info)} levels, at most {MAX_ROOMS} fit a u16 index",
+              file=sys.stderr)
+        sys.exit(1)
+    if len(level_info) > VERBOSE_LIMIT:
+        print(f"  {len(level_info)} levels")
+
     # -------------------------------------------------------------------------
     # 3. Update _metadata in connections.json and write back
     # -------------------------------------------------------------------------
@@ -237,16 +299,25 @@ def main():
     # 5. Parse world positions and connections
     # -------------------------------------------------------------------------
     world_pos = conn_data.get('levels', {})
-    connections = conn_data.get('connections', [])
+    connections = [(c.get('a', ''), c.get('b', '')) for c in conn_data.get('connections', [])]
+
+    if conn_data.get('autoConnect', False):
+        placed = [stem for stem, _, _, _ in level_info if stem in world_pos]
+        found = sweep_adjacent(placed, meta, world_pos, 'x') + sweep_adjacent(placed, meta, world_pos, 'y')
+        connections.extend(sorted(found, key=lambda p: (stem_to_idx[p[0]], stem_to_idx[p[1]])))
+        print(f"  autoConnect: {len(found)} adjacent pair(s)")
 
     # -------------------------------------------------------------------------
     # 6. Derive connection entries from world positions
     # -------------------------------------------------------------------------
-    conn_entries = []
+    derived_entries = []
+    seen_pairs = set()
     errors = 0
-    for conn in connections:
-        a_stem = conn.get('a', '')
-        b_stem = conn.get('b', '')
+    for a_stem, b_stem in connections:
+        pair = frozenset((a_stem, b_stem))
+        if pair in seen_pairs:
+            continue
+        seen_pairs.add(pair)
 
         ok = True
         if a_stem not in stem_to_idx:
@@ -273,80 +344,100 @@ def main():
             errors += 1
             continue
 
-        for e in derived:
-            from_idx = stem_to_idx[e['from_stem']]
-            to_idx   = stem_to_idx[e['to_stem']]
-            fs = SIDE_C_NAME[e['from_side']]
-            ts = SIDE_C_NAME[e['to_side']]
-            conn_entries.append(
-                f'    {{ {from_idx}, {to_idx}, {fs}, {ts}, '
-                f'{e["from_start"]}, {e["from_end"]}, {e["to_start"]} }},'
-            )
-            print(f"  {e['from_stem']} ({e['from_side']}) -> {e['to_stem']} ({e['to_side']})  "
-                  f"range [{e['from_start']}, {e['from_end']}) -> [{e['to_start']}, "
-                  f"{e['to_start'] + e['from_end'] - e['from_start']})")
+        derived_entries.extend(derived)
 
     if errors:
         print(f"WARNING: {errors} connection(s) skipped due to errors.", file=sys.stderr)
 
+    # Group by source room (stable, so each room keeps the declared order)
+    derived_entries.sort(key=lambda e: stem_to_idx[e['from_stem']])
+    if len(derived_entries) > MAX_ROOMS:
+        print(f"ERROR: {len(derived_entries)} connection entries, at most {MAX_ROOMS} "
+              f"fit a u16 offset", file=sys.stderr)
+        sys.exit(1)
+
+    conn_entries = []
+    room_starts = [0] * (len(level_info) + 1)
+    for e in derived_entries:
+        from_idx = stem_to_idx[e['from_stem']]
+        to_idx   = stem_to_idx[e['to_stem']]
+        room_starts[from_idx + 1] += 1
+        fs = SIDE_C_NAME[e['from_side']]
+        ts = SIDE_C_NAME[e['to_side']]
+        conn_entries.append(
+            f'    {{ {from_idx}, {to_idx}, {fs}, {ts}, '
+            f'{e["from_start"]}, {e["from_end"]}, {e["to_start"]} }},'
+        )
+        if len(derived_entries) <= VERBOSE_LIMIT:
+            print(f"  {e['from_stem']} ({e['from_side']}) -> {e['to_stem']} ({e['to_side']})  "
+                  f"range [{e['from_start']}, {e['from_end']}) -> [{e['to_start']}, "
+                  f"{e['to_start'] + e['from_end'] - e['from_start']})")
+    for i in range(len(level_info)):
+        room_starts[i + 1] += room_starts[i]
+
     # -------------------------------------------------------------------------
-    # 7. Generate connections.h
+    # 7. Generate connections.h (indices) and connections.c (tables)
     # -------------------------------------------------------------------------
     output_path.parent.mkdir(parents=True, exist_ok=True)
+    source_path = output_path.with_suffix('.c')
 
     lines = []
     lines.append('#ifndef CONNECTIONS_H')
     lines.append('#define CONNECTIONS_H')
     lines.append('')
-    lines.append('#ifdef DESKTOP_BUILD')
-    lines.append('#include "desktop/desktop_stubs.h"')
-    lines.append('#else')
-    lines.append('#include <tonc.h>')
-    lines.append('#endif')
-    lines.append('')
-    lines.append('#include "transition/transition.h"')
-    lines.append('#include "level/level.h"')
-    lines.append('')
-
-    for stem, display_name, w, h in level_info:
-        lines.append(f'#include "{stem}.h"')
+    lines.append('#include "transition/world.h"')
     lines.append('')
 
     for i, (stem, display_name, w, h) in enumerate(level_info):
         lines.append(f'#define LEVEL_IDX_{stem} {i}')
     lines.append(f'#define LEVEL_COUNT {len(level_info)}')
     lines.append('')
+    lines.append('#endif /* CONNECTIONS_H */')
+
+    with open(output_path, 'w', encoding='utf-8') as f:
+        f.write('\n'.join(lines) + '\n')
 
-    lines.append('static const Level* g_levels[LEVEL_COUNT] = {')
+    lines = []
+    lines.append(f'#include "{output_path.name}"')
+    lines.append('')
+    for stem, display_name, w, h in level_info:
+        lines.append(f'#include "{stem}.h"')
+    lines.append('')
+
+    lines.append('const Level* const g_levels[] = {')
     for stem, display_name, w, h in level_info:
         c_var = sanitize_identifier(stem)
         lines.append(f'    &{c_var},')
     lines.append('};')
     lines.append('')
 
-    lines.append('static const char* g_levelNames[LEVEL_COUNT]')
-    lines.append('    __attribute__((unused)) = {')
+    lines.append('const char* const g_levelNames[] = {')
     for stem, display_name, w, h in level_info:
         escaped = display_name.replace('\\', '\\\\').replace('"', '\\"')
         lines.append(f'    "{escaped}",')
     lines.append('};')
+    lines.append(f'const int g_levelCount = {len(level_info)};')
     lines.append('')
 
-    lines.append('static const ScreenConnection g_connections[] = {')
+    lines.append('const ScreenConnection g_connections[] = {')
     if conn_entries:
         lines.extend(conn_entries)
     else:
         lines.append('    /* no connections defined */')
     lines.append('};')
-    lines.append(f'static const int g_connectionCount = {len(conn_entries)};')
+    lines.append(f'const int g_connectionCount = {len(conn_entries)};')
     lines.append('')
-    lines.append('#endif /* CONNECTIONS_H */')
 
-    content = '\n'.join(lines) + '\n'
-    with open(output_path, 'w', encoding='utf-8') as f:
-        f.write(content)
+    lines.append('const u16 g_roomConnections[] = {')
+    for i in range(0, len(room_starts), 16):
+        lines.append('    ' + ', '.join(str(v) for v in room_starts[i:i + 16]) + ',')
+    lines.append('};')
+
+    with open(source_path, 'w', encoding='utf-8') as f:
+        f.write('\n'.join(lines) + '\n')
 
-    print(f"Generated {output_path}  ({len(level_info)} levels, {len(conn_entries)} connection entries)")
+    print(f"Generated {output_path} and {source_path.name}  "
+          f"({len(level_info)} levels, {len(conn_entries)} connection entries)")
 
 
 if __name__ == '__main__':
@@ -3,7 +3,10 @@
 Level Converter - Converts Tiled TMX level files to C header files for GBA
 Usage: python level_converter.py input.tmx output.h
 
-Supports multi-tileset levels with a dedicated Collision layer.
+Supports multi-tileset levels. Collision defaults come from the tilesets (a
+"collision" property on the TSX, per tile or for the whole tileset) and are
+resolved through the tiles of the first layer; an optional Collision layer,
+painted with the collision_types tileset, overrides them where it is set.
 Parses Tiled TMX format and external TSX tileset files.
 """
 
@@ -86,6 +89,29 @@ COL_NONE     = 0
 COL_SOLID    = 1
 COL_JUMPTHRU = 2
 
+COLLISION_NAMES = {'none': COL_NONE, 'solid': COL_SOLID, 'jumpthru': COL_JUMPTHRU}
+
+# Tile layer whose tiles give the default collision (LEVEL_COLLISION_LAYER)
+COLLISION_LAYER = 0
+
+# Occupancy chunk edge in tiles (must match LEVEL_CHUNK_SHIFT in level.h)
+CHUNK_SIZE = 8
+
+
+def collision_property(elem, where):
+    """CollisionType from an element's "collision" property, or None if unset."""
+    props = elem.find('properties')
+    if props is None:
+        return None
+    for prop in props.findall('property'):
+        if prop.get('name') == 'collision':
+            value = prop.get('value', '').lower()
+            if value not in COLLISION_NAMES:
+                raise ValueError(f"{where}: unknown collision type {value!r} "
+                                 f"(expected one of {', '.join(COLLISION_NAMES)})")
+            return COLLISION_NAMES[value]
+    return None
+
 
 def parse_tsx_tileset(tsx_path: str) -> Dict[str, Any]:
     """Parse an external TSX tileset file."""
@@ -105,6 +131,16 @@ def parse_tsx_tileset(tsx_path: str) -> Dict[str, Any]:
     if image is not None:
         tileset_info['imageSource'] = image.get('source')
 
+    # Collision per tile: the tileset's own property, then per-tile overrides
+    default = collision_property(root, tsx_path)
+    collision = [default if default is not None else COL_NONE] * tileset_info['tileCount']
+    for tile in root.findall('tile'):
+        tile_id = int(tile.get('id'))
+        col = collision_property(tile, f"{tsx_path} tile {tile_id}")
+        if col is not None and tile_id < len(collision):
+            collision[tile_id] = col
+    tileset_info['collision'] = collision
+
     return tileset_info
 
 
@@ -142,8 +178,11 @@ def parse_tmx_file(tmx_path: str) -> Dict[str, Any]:
     tmx_dir = os.path.dirname(os.path.abspath(tmx_path))
     gid_to_game_id = {0: 0}  # 0 always maps to 0 (empty tile)
 
-    # GID -> CollisionType mapping for the collision_types tileset
-    gid_to_col_type = {0: COL_NONE}
+    # GID -> CollisionType for the collision_types tileset (Collision layer)
+    gid_to_col_type = {}
+
+    # Game tile ID -> default CollisionType from its tileset
+    tile_collision = {0: COL_NONE}
 
     for tileset_elem in root.findall('tileset'):
         firstgid = int(tileset_elem.get('firstgid'))
@@ -158,13 +197,9 @@ def parse_tmx_file(tmx_path: str) -> Dict[str, Any]:
             tile_count = tsx_info['tileCount']
 
             if tileset_name == 'collision_types':
-                # Build GID -> CollisionType mapping
-                # Tile index 0 = COL_SOLID, tile index 1 = COL_JUMPTHRU
-                col_type_map = [COL_SOLID, COL_JUMPTHRU]
-                for i in range(tile_count):
-                    tmx_gid = firstgid + i
-                    col_type = col_type_map[i] if i < len(col_type_map) else COL_NONE
-                    gid_to_col_type[tmx_gid] = col_type
+                # Each tile forces the type named by its collision property
+                for i, col_type in enumerate(tsx_info['collision']):
+                    gid_to_col_type[firstgid + i] = col_type
                 # Don't add to game tilesets - collision tiles aren't rendered
                 continue
 
@@ -176,6 +211,7 @@ def parse_tmx_file(tmx_path: str) -> Dict[str, Any]:
                 tmx_gid = firstgid + i
                 game_id = expected_first_id + i
                 gid_to_game_id[tmx_gid] = game_id
+                tile_collision[game_id] = tsx_info['collision'][i]
 
             # Convert image source path to be relative to assets directory
             image_source = tsx_info.get('imageSource', '')
@@ -192,7 +228,7 @@ def parse_tmx_file(tmx_path: str) -> Dict[str, Any]:
 
     # Parse tile layers
     layer_index = 0
-    collision_layer_tiles = None  # Raw collision type grid [height][width] if Collision layer found
+    collision_layer_tiles = None  # Override grid [height][width] (None = unset) if Collision layer found
 
     for layer in root.findall('layer'):
         layer_name = layer.get('name', f'Layer {layer_index}')
@@ -212,7 +248,7 @@ def parse_tmx_file(tmx_path: str) -> Dict[str, Any]:
                     for row in rows:
                         tmx_gids = [int(tile_id) for tile_id in row.strip().rstrip(',').split(',') if tile_id.strip()]
                         if tmx_gids:
-                            col_row = [gid_to_col_type.get(gid, COL_NONE) for gid in tmx_gids]
+                            col_row = [gid_to_col_type.get(gid) for gid in tmx_gids]
                             col_tiles.append(col_row)
                     collision_layer_tiles = col_tiles
                     # Don't add to visual layers
@@ -261,10 +297,8 @@ def parse_tmx_file(tmx_path: str) -> Dict[str, Any]:
             else:
                 raise ValueError(f"Unsupported encoding: {encoding}. Only CSV encoding is supported.")
 
-    if collision_layer_tiles is None:
-        raise ValueError("No 'Collision' layer found. Add a Collision layer using the collision_types tileset.")
-
     data['collisionLayerTiles'] = collision_layer_tiles
+    data['tileCollision'] = tile_collision
 
     # Parse object layers
     for objectgroup in root.findall('objectgroup'):
@@ -355,6 +389,12 @@ def validate_level(data: Dict[str, Any], filename: str) -> None:
                 if not isinstance(tile_id, int) or tile_id < 0 or tile_id > 65535:
                     errors.append(f"Layer {layer_idx} invalid tile ID at ({i},{j}): {tile_id}")
 
+    # Validate the Collision layer against the map size
+    collision = data.get('collisionLayerTiles')
+    if collision is not None:
+        if len(collision) != height or any(len(row) != width for row in collision):
+            errors.append(f"Collision layer is not {width}x{height}")
+
     # Validate player spawn
     spawn = data['playerSpawn']
     if 'x' not in spawn or 'y' not in spawn:
@@ -443,8 +483,9 @@ def generate_header(data: Dict[str, Any], output_name: str) -> str:
     # Get tilesets
     tilesets = data.get('tilesets', [])
 
-    # Get collision map (per-tile collision type grid)
-    collision_layer_tiles = data['collisionLayerTiles']
+    # Collision overrides (per-tile grid, None where unset) and tileset defaults
+    collision_layer_tiles = data.get('collisionLayerTiles')
+    tile_collision = data.get('tileCollision', {})
 
     # Collect all unique tiles used across ALL layers
     all_tiles = []
@@ -498,8 +539,37 @@ def generate_header(data: Dict[str, Any], output_name: str) -> str:
             'tiles': remapped_tiles
         })
 
-    # Flatten collision layer to a 1D array (row-major)
-    collision_map_flat = [col_type for row in collision_layer_tiles for col_type in row]
+    # Default collision per compact tile ID: 2 bits each, 16 per word
+    tile_collision_words = [0] * ((len(unique_tiles) + 15) // 16)
+    for vram_index, tile_id in enumerate(unique_tiles):
+        col = tile_collision.get(tile_id, COL_NONE)
+        tile_collision_words[vram_index >> 4] |= col << ((vram_index & 15) * 2)
+
+    # Overrides, as runs of one type per row. A run may span tiles whose
+    # default already matches (fewer, longer runs); it starts and ends on a
+    # tile that differs.
+    collision_tiles = layers[COLLISION_LAYER]['tiles']
+    collision_runs = []
+    row_run_starts = [0]
+    for y in range(height):
+        effective = []
+        differs = []
+        for x in range(width):
+            default = tile_collision.get(collision_tiles[y][x], COL_NONE)
+            override = collision_layer_tiles[y][x] if collision_layer_tiles else None
+            col = default if override is None else override
+            effective.append(col)
+            differs.append(col != default)
+        x = 0
+        while x < width:
+            end = x
+            while end < width and effective[end] == effective[x]:
+                end += 1
+            marked = [i for i in range(x, end) if differs[i]]
+            if marked:
+                collision_runs.append((marked[0], marked[-1] + 1, effective[x]))
+            x = end
+        row_run_starts.append(len(collision_runs))
 
     lines = []
     lines.append(f"#ifndef {guard_name}")
@@ -567,30 +637,66 @@ def generate_header(data: Dict[str, Any], output_name: str) -> str:
         lines.append("};")
         lines.append("")
 
-    # Collision map (4 bits per tile, 2 tiles per byte, low nibble first)
-    packed_collision = []
-    for i in range(0, len(collision_map_flat), 2):
-        lo = collision_map_flat[i] & 0x0F
-        hi = (collision_map_flat[i + 1] & 0x0F) if (i + 1) < len(collision_map_flat) else 0
-        packed_collision.append(lo | (hi << 4))
-    packed_size = len(packed_collision)
-    lines.append(f"// Collision map: 4 bits per tile, 2 tiles per byte (low nibble = even tile)")
-    lines.append(f"// {len(collision_map_flat)} tiles -> {packed_size} bytes")
-    lines.append(f"static const u8 {level_name}_collision_map[{packed_size}] = {{")
-    for i in range(0, packed_size, 32):
-        chunk = packed_collision[i:i+32]
-        line = "    " + ", ".join(f"0x{v:02X}" for v in chunk)
-        if i + 32 < packed_size:
+        # Chunk occupancy: one bit per 8x8-tile chunk, row-major, set if any
+        # tile in the chunk is non-zero. Lets the tilemap writers zero-fill
+        # empty spans of sparse layers without touching the tile buffer.
+        chunks_w = (width + CHUNK_SIZE - 1) // CHUNK_SIZE
+        chunks_h = (height + CHUNK_SIZE - 1) // CHUNK_SIZE
+        chunk_words = [0] * ((chunks_w * chunks_h + 31) // 32)
+        occupied = 0
+        for ty in range(height):
+            for tx in range(width):
+                if layer_tiles[ty * width + tx] != 0:
+                    bit = (ty // CHUNK_SIZE) * chunks_w + (tx // CHUNK_SIZE)
+                    if not (chunk_words[bit >> 5] >> (bit & 31)) & 1:
+                        occupied += 1
+                    chunk_words[bit >> 5] |= 1 << (bit & 31)
+        lines.append(f"// Layer {layer_idx} occupancy: {occupied}/{chunks_w * chunks_h} chunks non-empty")
+        lines.append(f"static const u32 {level_name}_layer{layer_idx}_chunks[{len(chunk_words)}] = {{")
+        for j in range(0, len(chunk_words), 8):
+            chunk = chunk_words[j:j+8]
+            line = "    " + ", ".join(f"0x{w:08X}" for w in chunk)
+            if j + 8 < len(chunk_words):
+                line += ","
+            lines.append(line)
+        lines.append("};")
+        lines.append("")
+
+    lines.append(f"// Collision defaults: 2 bits per unique tile, from the tilesets")
+    lines.append(f"static const u32 {level_name}_tile_collision[{len(tile_collision_words)}] = {{")
+    for i in range(0, len(tile_collision_words), 8):
+        chunk = tile_collision_words[i:i+8]
+        line = "    " + ", ".join(f"0x{w:08X}" for w in chunk)
+        if i + 8 < len(tile_collision_words):
             line += ","
         lines.append(line)
     lines.append("};")
     lines.append("")
 
+    if collision_runs:
+        lines.append(f"// Collision layer overrides: {len(collision_runs)} runs")
+        lines.append(f"static const u16 {level_name}_collision_row_runs[{height + 1}] = {{")
+        for i in range(0, len(row_run_starts), 16):
+            chunk = row_run_starts[i:i+16]
+            line = "    " + ", ".join(f"{v}" for v in chunk)
+            if i + 16 < len(row_run_starts):
+                line += ","
+            lines.append(line)
+        lines.append("};")
+        lines.append(f"static const CollisionRun {level_name}_collision_runs[{len(collision_runs)}] = {{")
+        for i, (start, end, col) in enumerate(collision_runs):
+            comma = "," if i < len(collision_runs) - 1 else ""
+            lines.append(f"    {{{start}, {end}, {col}}}{comma}")
+        lines.append("};")
+    else:
+        lines.append(f"// No collision overrides")
+    lines.append("")
+
     # Layer metadata array
     lines.append(f"static const TileLayer {level_name}_layers[{len(remapped_layers)}] = {{")
     for layer_idx, layer in enumerate(remapped_layers):
         comma = "," if layer_idx < len(remapped_layers) - 1 else ""
-        lines.append(f'    {{"{layer["name"]}", {layer["bgLayer"]}, {layer["priority"]}, {level_name}_layer{layer_idx}_rle}}{comma}')
+        lines.append(f'    {{"{layer["name"]}", {layer["bgLayer"]}, {layer["priority"]}, {level_name}_layer{layer_idx}_rle, {level_name}_layer{layer_idx}_chunks}}{comma}')
     lines.append("};")
     lines.append("")
 
@@ -623,7 +729,13 @@ def generate_header(data: Dict[str, Any], output_name: str) -> str:
     lines.append(f"    {spawn['y']},")
     lines.append(f"    0,  // tilesetCount (set at runtime)")
     lines.append(f"    0,  // tilesets (set at runtime)")
-    lines.append(f"    {level_name}_collision_map,  // collisionMap")
+    lines.append(f"    {level_name}_tile_collision,  // tileCollision")
+    if collision_runs:
+        lines.append(f"    {level_name}_collision_row_runs,  // collisionRowRuns")
+        lines.append(f"    {level_name}_collision_runs,  // collisionRuns")
+    else:
+        lines.append(f"    0,  // collisionRowRuns")
+        lines.append(f"    0,  // collisionRuns")
     lines.append(f"    {len(unique_tiles)},  // uniqueTileCount")
     lines.append(f"    {level_name}_unique_tile_ids,  // uniqueTileIds")
     lines.append(f"    {level_name}_tile_palette_banks  // tilePaletteBanks")
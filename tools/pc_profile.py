@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""
+Symbolise a PC sampling profile (src/core/pc_profiler.c).
+
+Usage:
+    python pc_profile.py game.sav game.elf          # GBA: SELECT+UP twice, then read the save
+    python pc_profile.py profile.txt run_tests      # desktop: PC_PROFILE=profile.txt ./run_tests
+
+Options:
+    --top N           rows per table (default 20)
+    --addr2line TOOL  addr2line to use (default arm-none-eabi-addr2line for
+                      .sav input, addr2line otherwise)
+"""
+
+import argparse
+import struct
+import subprocess
+import sys
+from collections import defaultdict
+
+PC_PROFILER_SRAM_OFFSET = 0x2000
+PC_PROFILER_MAGIC = 0x46504350
+ROM_BASE = 0x08000000
+IWRAM_BASE = 0x03000000
+
+
+def read_sav(path):
+    """Return (samples, {address: count}, extra) from a GBA save file."""
+    with open(path, 'rb') as f:
+        data = f.read()
+    header = data[PC_PROFILER_SRAM_OFFSET:PC_PROFILER_SRAM_OFFSET + 32]
+    if len(header) < 32:
+        sys.exit("Error: save file too small for a profile")
+    magic, samples, shift, rom_buckets, iwram_buckets, bios, other, hz = struct.unpack('<8I', header)
+    if magic != PC_PROFILER_MAGIC:
+        sys.exit(f"Error: no profile in save (magic 0x{magic:08X})")
+
+    offset = PC_PROFILER_SRAM_OFFSET + 32
+    counts = {}
+    for base, n in ((ROM_BASE, rom_buckets), (IWRAM_BASE, iwram_buckets)):
+        buckets = struct.unpack_from(f'<{n}H', data, offset)
+        offset += n * 2
+        for i, c in enumerate(buckets):
+            if c:
+                # Attribute the bucket to its middle; Thumb code is 2-aligned
+                counts[base + (i << shift) + (1 << shift) // 2] = c
+    extra = {'BIOS (halted / SWI)': bios, 'other': other}
+    return samples, hz, counts, extra
+
+
+def read_text(path, elf):
+    """Return (samples, {address: count}, extra) from a desktop text profile."""
+    header = {}
+    counts = {}
+    anchor = None
+    with open(path) as f:
+        for line in f:
+            parts = line.split()
+            if not parts or parts[0].startswith('#'):
+                continue
+            if parts[0] == 'anchor':
+                anchor = (parts[1], int(parts[2], 16))
+            elif parts[0].startswith('0x'):
+                counts[int(parts[0], 16)] = int(parts[1])
+            else:
+                header[parts[0]] = int(parts[1])
+
+    # Undo PIE relocation: compare the runtime address of the anchor symbol
+    # with its link-time address.
+    bias = 0
+    if anchor:
+        nm = subprocess.run(['nm', elf], capture_output=True, text=True).stdout
+        for line in nm.splitlines():
+            fields = line.split()
+            if len(fields) == 3 and fields[2] == anchor[0]:
+                bias = anchor[1] - int(fields[0], 16)
+                break
+    counts = {pc - bias: c for pc, c in counts.items()}
+    extra = {'other (table full)': header.get('other', 0)}
+    return header.get('samples', 0), header.get('hz', 0), counts, extra
+
+
+def symbolise(addresses, elf, tool):
+    """Map each address to (function, file:line) with one addr2line call."""
+    if not addresses:
+        return {}
+    proc = subprocess.run([tool, '-f', '-C', '-e', elf] + [hex(a) for a in addresses],
+                          capture_output=True, text=True)
+    lines = proc.stdout.splitlines()
+    result = {}
+    for i, addr in enumerate(addresses):
+        func = lines[2 * i] if 2 * i < len(lines) else '??'
+        loc = lines[2 * i + 1] if 2 * i + 1 < len(lines) else '??:0'
+        loc = loc.split(' (discriminator')[0]
+        result[addr] = (func, loc.rsplit('/', 1)[-1])
+    return result
+
+
+def print_table(title, totals, samples, top):
+    print(f"\n{title}")
+    for name, count in sorted(totals.items(), key=lambda kv: -kv[1])[:top]:
+        pct = 100.0 * count / samples if samples else 0.0
+        print(f"  {pct:5.1f}%  {count:7d}  {name}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Symbolise a PC sampling profile")
+    parser.add_argument('profile', help="game.sav or a desktop text profile")
+    parser.add_argument('elf', help="binary the profile was taken from")
+    parser.add_argument('--top', type=int, default=20)
+    parser.add_argument('--addr2line')
+    args = parser.parse_args()
+
+    is_sav = args.profile.endswith('.sav')
+    if is_sav:
+        samples, hz, counts, extra = read_sav(args.profile)
+    else:
+        samples, hz, counts, extra = read_text(args.profile, args.elf)
+    tool = args.addr2line or ('arm-none-eabi-addr2line' if is_sav else 'addr2line')
+
+    addresses = sorted(counts)
+    symbols = symbolise(addresses, args.elf, tool)
+
+    by_func = defaultdict(int)
+    by_line = defaultdict(int)
+    for addr in addresses:
+        func, loc = symbols.get(addr, ('??', '??:0'))
+        by_func[func] += counts[addr]
+        by_line[f"{loc}  ({func})"] += counts[addr]
+
+    print(f"{samples} samples at {hz} Hz")
+    for name, count in extra.items():
+        if count:
+            pct = 100.0 * count / samples if samples else 0.0
+            print(f"  {pct:5.1f}%  {count:7d}  {name}")
+    print_table("Top functions:", by_func, samples, args.top)
+    print_table("Top lines:", by_line, samples, args.top)
+
+
+if __name__ == '__main__':
+    main()
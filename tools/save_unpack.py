@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""
+Turn a flash save (make SAVE=FLASH64 / FLASH128, src/core/save.c) back into
+the flat SRAM layout that extract_replay.py, pc_profile.py and
+telemetry_report.py read.
+
+Usage:
+    python save_unpack.py game.sav game_sram.sav
+
+Every 4 KB sector with a committed header is a copy of one logical sector;
+the copy with the highest sequence number wins. Logical sectors that were
+never written come out as 0xFF, like blank SRAM. A 32 KB file is passed
+through unchanged.
+"""
+
+import struct
+import sys
+
+SECTOR_SIZE = 0x1000
+HEADER_SIZE = 16
+PAYLOAD = SECTOR_SIZE - HEADER_SIZE
+LOGICAL_SECTORS = 8
+MAGIC = 0x46564153  # "SAVF"
+COMMIT_OFFSET = 15
+SRAM_SIZE = 0x8000
+
+
+def unpack(data):
+    live = {}
+    for base in range(0, len(data) - SECTOR_SIZE + 1, SECTOR_SIZE):
+        magic, seq, logical = struct.unpack_from('<IIB', data, base)
+        if magic != MAGIC or data[base + COMMIT_OFFSET] != 0 or logical >= LOGICAL_SECTORS:
+            continue
+        if logical not in live or seq > live[logical][0]:
+            live[logical] = (seq, base)
+
+    out = bytearray(b'\xff' * SRAM_SIZE)
+    for logical, (seq, base) in live.items():
+        start = logical * PAYLOAD
+        out[start:start + PAYLOAD] = data[base + HEADER_SIZE:base + SECTOR_SIZE]
+    return bytes(out), len(live)
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    with open(sys.argv[1], 'rb') as f:
+        data = f.read()
+
+    if len(data) <= SRAM_SIZE:
+        out, sectors = data, None
+    else:
+        out, sectors = unpack(data)
+
+    with open(sys.argv[2], 'wb') as f:
+        f.write(out)
+    if sectors is None:
+        print(f"{sys.argv[1]}: already an SRAM save, copied")
+    else:
+        print(f"{sys.argv[1]}: {sectors} of {LOGICAL_SECTORS} logical sectors recovered")
+
+
+if __name__ == '__main__':
+    main()
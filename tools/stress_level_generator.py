@@ -0,0 +1,300 @@
+#!/usr/bin/env python3
+"""
+Stress Level Generator - Emits synthetic worst-case TMX levels for benchmarking
+Usage: python stress_level_generator.py output_dir
+
+Every level sits exactly at one of the engine's limits:
+
+  stress_wide       512x40 tiles (fills TILE_BUFFER_SIZE), both layers noisy so
+                    BIOS RLE cannot compress them, exactly 512 unique tiles
+                    (LEVEL_VRAM_TILE_LIMIT).
+  stress_entities   One 240x160 screen holding 32 springs, 32 red bubbles and
+                    32 green bubbles (MAX_SPRINGS / MAX_*_BUBBLES).
+  stress_fit_a/b    Horizontally connected pair with 256 + 256 unique tiles:
+                    just fits the shared VRAM budget, so it scroll-transitions.
+  stress_miss_a/b   Same pair shape with 256 + 257 unique tiles: one tile over,
+                    so it must take the fade fallback.
+
+Alongside the TMX files it writes stress_connections.json (for
+compile_connections.py) and stress_inputs.h, one scripted input path per level
+that keeps the camera moving as fast as the player can drive it.
+
+Output is deterministic (fixed seed) so worst-frame numbers are comparable
+between runs.
+"""
+
+import json
+import os
+import random
+import sys
+from pathlib import Path
+
+# Must match level.h / entity headers
+LEVEL_VRAM_TILE_LIMIT = 512
+MAX_ENTITIES_PER_TYPE = 32
+SCREEN_W_TILES = 30
+SCREEN_H_TILES = 20
+
+# TMX firstgid for each tileset, chosen to equal the game tile IDs that
+# level_converter.py assigns (EXPECTED_RANGES), plus the collision tileset.
+TILESETS = [
+    ('grassy_stone', 1, 55),
+    ('plants', 56, 160),
+    ('decals', 216, 1225),
+]
+COLLISION_FIRSTGID = 1441
+COL_GID_SOLID = COLLISION_FIRSTGID + 0
+COL_GID_NONE = COLLISION_FIRSTGID + 2
+
+# Input bits (must match KEY_* / core/input.h)
+KEY_A = 0x0001
+KEY_RIGHT = 0x0010
+KEY_LEFT = 0x0020
+KEY_UP = 0x0040
+KEY_R = 0x0100
+BTN_JUMP = KEY_A
+BTN_DASH = KEY_R
+
+SEED = 0x5EED
+
+
+def tile_pool(count: int):
+    """First `count` game tile IDs across all visual tilesets."""
+    ids = []
+    for _, first, n in TILESETS:
+        ids.extend(range(first, first + n))
+    if count > len(ids):
+        raise ValueError(f"Requested {count} unique tiles, only {len(ids)} available")
+    return ids[:count]
+
+
+def noisy_layers(rng, width, height, unique_count, layer_count=2):
+    """
+    Fill `layer_count` layers so that every tile in a pool of `unique_count`
+    IDs appears at least once and no tile repeats its left neighbour, which
+    defeats RLE (runs of 3+ identical bytes) on every row.
+    """
+    pool = tile_pool(unique_count)
+    cells = width * height * layer_count
+    if cells < len(pool):
+        raise ValueError("Level too small to place every unique tile")
+
+    # Guarantee coverage: each pool tile lands in a distinct random cell.
+    forced = {}
+    for tile, cell in zip(pool, rng.sample(range(cells), len(pool))):
+        forced[cell] = tile
+
+    layers = []
+    for layer in range(layer_count):
+        rows = []
+        for y in range(height):
+            row = []
+            prev = None
+            for x in range(width):
+                cell = (layer * height + y) * width + x
+                tile = forced.get(cell)
+                if tile is None:
+                    tile = rng.choice(pool)
+                    while tile == prev and len(pool) > 1:
+                        tile = rng.choice(pool)
+                row.append(tile)
+                prev = tile
+            rows.append(row)
+        layers.append(rows)
+    return layers
+
+
+def floor_collision(width, height, floor_rows):
+    # Every cell is set: the noisy layers use grassy_stone tiles, which the
+    # tileset makes solid by default, and only the floor should block.
+    return [[COL_GID_SOLID if y >= height - floor_rows else COL_GID_NONE for _ in range(width)]
+            for y in range(height)]
+
+
+def csv_block(rows):
+    lines = [','.join(str(v) for v in row) for row in rows]
+    return ',\n'.join(lines)
+
+
+def write_tmx(path: Path, assets_rel: str, name, width, height, layers, collision, spawn, objects):
+    out = []
+    out.append('<?xml version="1.0" encoding="UTF-8"?>')
+    out.append(f'<map version="1.10" tiledversion="1.10.1" orientation="orthogonal" '
+               f'renderorder="right-down" width="{width}" height="{height}" '
+               f'tilewidth="8" tileheight="8" infinite="0" '
+               f'nextlayerid="{len(layers) + 3}" nextobjectid="{len(objects) + 2}">')
+    out.append(' <properties>')
+    out.append(f'  <property name="name" value="{name}"/>')
+    out.append(' </properties>')
+    for ts_name, first, _ in TILESETS:
+        out.append(f' <tileset firstgid="{first}" source="{assets_rel}/{ts_name}.tsx"/>')
+    out.append(f' <tileset firstgid="{COLLISION_FIRSTGID}" source="{assets_rel}/collision_types.tsx"/>')
+
+    layer_names = ['Terrain', 'Decor']
+    for i, rows in enumerate(layers):
+        out.append(f' <layer id="{i + 1}" name="{layer_names[i]}" width="{width}" height="{height}">')
+        out.append('  <data encoding="csv">')
+        out.append(csv_block(rows))
+        out.append('</data>')
+        out.append(' </layer>')
+
+    out.append(f' <objectgroup id="{len(layers) + 1}" name="Objects">')
+    out.append(f'  <object id="1" name="PlayerSpawn" type="PlayerSpawn" x="{spawn[0]}" y="{spawn[1]}">')
+    out.append('   <point/>')
+    out.append('  </object>')
+    for i, (obj_type, x, y) in enumerate(objects):
+        out.append(f'  <object id="{i + 2}" type="{obj_type}" x="{x}" y="{y}">')
+        out.append('   <point/>')
+        out.append('  </object>')
+    out.append(' </objectgroup>')
+
+    out.append(f' <layer id="{len(layers) + 2}" name="Collision" width="{width}" height="{height}" opacity="0.5">')
+    out.append('  <data encoding="csv">')
+    out.append(csv_block(collision))
+    out.append('</data>')
+    out.append(' </layer>')
+    out.append('</map>')
+
+    path.write_text('\n'.join(out) + '\n', encoding='utf-8')
+
+
+def repeat_pattern(pattern, frames):
+    """Expand [(keys, count), ...] cyclically to exactly `frames` entries."""
+    out = []
+    while len(out) < frames:
+        for keys, count in pattern:
+            out.extend([keys] * count)
+    return out[:frames]
+
+
+def sprint_right(frames):
+    """
+    Fastest sustained rightward travel: ground dash into a super jump, land,
+    repeat, with an up-right dash mixed in so the camera also moves vertically.
+    """
+    return [0] * 4 + repeat_pattern([
+        (KEY_RIGHT | BTN_DASH, 2),
+        (KEY_RIGHT, 10),
+        (KEY_RIGHT | BTN_JUMP, 4),
+        (KEY_RIGHT, 16),
+        (KEY_RIGHT | KEY_UP | BTN_DASH, 2),
+        (KEY_RIGHT | KEY_UP, 14),
+        (KEY_RIGHT, 24),
+    ], frames - 4)
+
+
+def zigzag(frames):
+    """Bounce across one screen so every entity gets overlap-tested each frame."""
+    return [0] * 4 + repeat_pattern([
+        (KEY_RIGHT | BTN_JUMP, 6),
+        (KEY_RIGHT, 20),
+        (KEY_RIGHT | KEY_UP | BTN_DASH, 2),
+        (KEY_RIGHT, 30),
+        (KEY_LEFT | BTN_JUMP, 6),
+        (KEY_LEFT, 20),
+        (KEY_LEFT | KEY_UP | BTN_DASH, 2),
+        (KEY_LEFT, 30),
+    ], frames - 4)
+
+
+def write_inputs_header(path: Path, paths):
+    lines = []
+    lines.append('// Generated by tools/stress_level_generator.py - do not edit')
+    lines.append('#ifndef STRESS_INPUTS_H')
+    lines.append('#define STRESS_INPUTS_H')
+    lines.append('')
+    lines.append('#ifdef DESKTOP_BUILD')
+    lines.append('#include "desktop/desktop_stubs.h"')
+    lines.append('#else')
+    lines.append('#include <tonc.h>')
+    lines.append('#endif')
+    lines.append('')
+    for name, keys in paths:
+        lines.append(f'#define {name.upper()}_INPUT_FRAMES {len(keys)}')
+        lines.append(f'static const u16 {name}_inputs[{len(keys)}] = {{')
+        for i in range(0, len(keys), 12):
+            chunk = ', '.join(f'0x{k:04X}' for k in keys[i:i + 12])
+            sep = ',' if i + 12 < len(keys) else ''
+            lines.append(f'    {chunk}{sep}')
+        lines.append('};')
+        lines.append('')
+    lines.append('#endif // STRESS_INPUTS_H')
+    path.write_text('\n'.join(lines) + '\n', encoding='utf-8')
+
+
+def main():
+    if len(sys.argv) != 2:
+        print(f"Usage: {sys.argv[0]} <output_dir>", file=sys.stderr)
+        sys.exit(1)
+
+    out_dir = Path(sys.argv[1])
+    out_dir.mkdir(parents=True, exist_ok=True)
+    assets_dir = Path(__file__).resolve().parent.parent / 'assets'
+    assets_rel = os.path.relpath(assets_dir, out_dir.resolve()).replace(os.sep, '/')
+
+    rng = random.Random(SEED)
+
+    # --- 512x40, two noisy layers, exactly LEVEL_VRAM_TILE_LIMIT unique tiles ---
+    w, h = 512, 40
+    write_tmx(out_dir / 'stress_wide.tmx', assets_rel, 'Stress Wide', w, h,
+              noisy_layers(rng, w, h, LEVEL_VRAM_TILE_LIMIT),
+              floor_collision(w, h, 3), (16, (h - 6) * 8), [])
+
+    # --- one screen, every entity manager full ---
+    w, h = SCREEN_W_TILES, SCREEN_H_TILES
+    floor_y = (h - 2) * 8
+    objects = []
+    for i in range(MAX_ENTITIES_PER_TYPE):
+        objects.append(('spring', 4 + i * 7, floor_y))
+    for i in range(MAX_ENTITIES_PER_TYPE):
+        objects.append(('RedBubble', 16 + (i % 8) * 28, 24 + (i // 8) * 24))
+    for i in range(MAX_ENTITIES_PER_TYPE):
+        objects.append(('GreenBubble', 30 + (i % 8) * 28, 36 + (i // 8) * 24))
+    write_tmx(out_dir / 'stress_entities.tmx', assets_rel, 'Stress Entities', w, h,
+              noisy_layers(rng, w, h, 64),
+              floor_collision(w, h, 2), (16, floor_y - 24), objects)
+
+    # --- connected pairs straddling the shared VRAM budget ---
+    half = LEVEL_VRAM_TILE_LIMIT // 2
+    w, h = 64, SCREEN_H_TILES
+    pairs = [
+        ('stress_fit_a', 'Stress Fit A', half),
+        ('stress_fit_b', 'Stress Fit B', half),
+        ('stress_miss_a', 'Stress Miss A', half),
+        ('stress_miss_b', 'Stress Miss B', half + 1),
+    ]
+    for stem, name, unique in pairs:
+        write_tmx(out_dir / f'{stem}.tmx', assets_rel, name, w, h,
+                  noisy_layers(rng, w, h, unique),
+                  floor_collision(w, h, 3), (16, (h - 6) * 8), [])
+
+    room_w_px = w * 8
+    room_h_px = h * 8
+    connections = {
+        'levels': {
+            'stress_entities': {'worldX': -4 * room_w_px, 'worldY': 0},
+            'stress_wide': {'worldX': -4 * room_w_px, 'worldY': 4 * room_h_px},
+            'stress_fit_a': {'worldX': 0, 'worldY': 0},
+            'stress_fit_b': {'worldX': room_w_px, 'worldY': 0},
+            'stress_miss_a': {'worldX': 0, 'worldY': 2 * room_h_px},
+            'stress_miss_b': {'worldX': room_w_px, 'worldY': 2 * room_h_px},
+        },
+        'connections': [
+            {'a': 'stress_fit_a', 'b': 'stress_fit_b'},
+            {'a': 'stress_miss_a', 'b': 'stress_miss_b'},
+        ],
+    }
+    with open(out_dir / 'stress_connections.json', 'w', encoding='utf-8') as f:
+        json.dump(connections, f, indent=2)
+
+    write_inputs_header(out_dir / 'stress_inputs.h', [
+        ('stress_wide', sprint_right(900)),
+        ('stress_entities', zigzag(600)),
+        ('stress_pair', sprint_right(400)),
+    ])
+
+    print(f"Generated stress levels in {out_dir}")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""
+Rank rooms and transitions by frame cost from a tester's save file
+(per-room telemetry, src/core/telemetry.c).
+
+Usage:
+    python telemetry_report.py game.sav
+    python telemetry_report.py game.sav --connections generated/connections.h
+
+Costs are TM0 ticks (16.384 kHz); the header records ticks per frame, and
+values are also shown as a percentage of one frame. With --connections the
+room indices are mapped to level names.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+TELEMETRY_SRAM_OFFSET = 0x7000
+TELEMETRY_MAGIC = 0x4D4C4554
+TELEMETRY_VERSION = 1
+NO_ROOM = 0xFFFF
+PHASES = ['player', 'camera', 'tilemap', 'render', 'transition']
+
+
+def read_telemetry(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    base = TELEMETRY_SRAM_OFFSET
+    if len(data) < base + 16:
+        sys.exit("Error: save file too small for telemetry")
+    magic, version, room_slots, trans_slots, frame_ticks = struct.unpack_from('<IHHHH', data, base)
+    if magic != TELEMETRY_MAGIC:
+        sys.exit(f"Error: no telemetry in save (magic 0x{magic:08X})")
+    if version != TELEMETRY_VERSION:
+        sys.exit(f"Error: telemetry version {version}, expected {TELEMETRY_VERSION}")
+
+    rooms = []
+    offset = base + 16
+    for _ in range(room_slots):
+        fields = struct.unpack_from('<HHIIIHH5HH', data, offset)
+        offset += 32
+        room, visits, frames, lag, total, worst, p95 = fields[:7]
+        if room == NO_ROOM or frames == 0:
+            continue
+        rooms.append({
+            'room': room, 'visits': visits, 'frames': frames, 'lag': lag,
+            'avg': total / frames, 'worst': worst, 'p95': p95,
+            'phases': dict(zip(PHASES, fields[7:12])),
+        })
+
+    transitions = []
+    for _ in range(trans_slots):
+        src, dst, count, longest, worst, phase, lag = struct.unpack_from('<HHHHHHI', data, offset)
+        offset += 16
+        if src == NO_ROOM or count == 0:
+            continue
+        transitions.append({
+            'from': src, 'to': dst, 'count': count, 'longest': longest,
+            'worst': worst, 'phase': phase, 'lag': lag,
+        })
+    return frame_ticks, rooms, transitions
+
+
+def read_level_names(path):
+    """Room index -> 'ident (name)' from a generated connections.h."""
+    names = {}
+    with open(path) as f:
+        text = f.read()
+    for ident, index in re.findall(r'#define LEVEL_IDX_(\w+) (\d+)', text):
+        names[int(index)] = ident
+    return names
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Per-room performance report")
+    parser.add_argument('sav')
+    parser.add_argument('--connections', help="generated connections.h for room names")
+    parser.add_argument('--top', type=int, default=10)
+    args = parser.parse_args()
+
+    frame_ticks, rooms, transitions = read_telemetry(args.sav)
+    names = read_level_names(args.connections) if args.connections else {}
+
+    def room_name(index):
+        return names.get(index, f"room {index}")
+
+    def pct(ticks):
+        return f"{100.0 * ticks / frame_ticks:5.0f}%"
+
+    # Worst rooms: lag frames first, then p95, then worst single frame
+    rooms.sort(key=lambda r: (r['lag'], r['p95'], r['worst']), reverse=True)
+    print(f"Rooms ({len(rooms)} recorded, {frame_ticks} ticks per frame)")
+    print(f"  {'room':<20} {'visits':>6} {'frames':>8} {'lag':>6}  {'avg':>6} {'p95':>6} {'worst':>6}  worst phase")
+    for r in rooms[:args.top]:
+        phase, ticks = max(r['phases'].items(), key=lambda kv: kv[1])
+        print(f"  {room_name(r['room']):<20} {r['visits']:>6} {r['frames']:>8} {r['lag']:>6}"
+              f"  {pct(r['avg'])} {pct(r['p95'])} {pct(r['worst'])}  {phase} {pct(ticks).strip()}")
+
+    transitions.sort(key=lambda t: (t['worst'], t['lag']), reverse=True)
+    print(f"\nTransitions ({len(transitions)} recorded)")
+    print(f"  {'from -> to':<34} {'count':>5} {'frames':>6} {'lag':>5} {'worst':>6}  transition phase")
+    for t in transitions[:args.top]:
+        route = f"{room_name(t['from'])} -> {room_name(t['to'])}"
+        print(f"  {route:<34} {t['count']:>5} {t['longest']:>6} {t['lag']:>5} {pct(t['worst'])}  {pct(t['phase'])}")
+
+
+if __name__ == '__main__':
+    main()
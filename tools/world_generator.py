@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""
+World Generator - Emits a large synthetic world for benchmarking the world
+pipeline (level conversion, connection compilation, runtime lookups)
+Usage: python world_generator.py output_dir [room_count]
+
+Writes room_count (default 2000) one-screen rooms laid out in brick courses:
+every other row is shifted by half a room, so each room meets its left and
+right neighbours along a full edge and two rooms above and below along half
+an edge each. Nothing is listed in "connections"; world_connections.json
+sets "autoConnect" and leaves the adjacency to compile_connections.py.
+
+The rooms are converted in-process with level_converter.py and the world is
+compiled with compile_connections.py, printing the time each phase takes.
+Output is deterministic (fixed seed).
+"""
+
+import json
+import math
+import os
+import random
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+import level_converter
+from stress_level_generator import SCREEN_W_TILES, SCREEN_H_TILES, floor_collision, noisy_layers, write_tmx
+
+DEFAULT_ROOMS = 2000
+UNIQUE_TILES_PER_ROOM = 24
+SEED = 0x3011D
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        print(f"Usage: {sys.argv[0]} <output_dir> [room_count]", file=sys.stderr)
+        sys.exit(1)
+
+    out_dir = Path(sys.argv[1])
+    rooms = int(sys.argv[2]) if len(sys.argv) == 3 else DEFAULT_ROOMS
+    out_dir.mkdir(parents=True, exist_ok=True)
+    tools_dir = Path(__file__).resolve().parent
+    assets_rel = os.path.relpath(tools_dir.parent / 'assets', out_dir.resolve()).replace(os.sep, '/')
+
+    rng = random.Random(SEED)
+    w, h = SCREEN_W_TILES, SCREEN_H_TILES
+    room_w_px, room_h_px = w * 8, h * 8
+    cols = math.ceil(math.sqrt(rooms))
+    digits = len(str(rooms - 1))
+
+    # --- rooms ---
+    started = time.perf_counter()
+    levels = {}
+    for i in range(rooms):
+        stem = f'world_{i:0{digits}d}'
+        row, col = divmod(i, cols)
+        write_tmx(out_dir / f'{stem}.tmx', assets_rel, f'World {i}', w, h,
+                  noisy_layers(rng, w, h, UNIQUE_TILES_PER_ROOM),
+                  floor_collision(w, h, 2), (16, (h - 6) * 8), [])
+        levels[stem] = {'worldX': col * room_w_px + (row % 2) * (room_w_px // 2),
+                        'worldY': row * room_h_px}
+
+    with open(out_dir / 'world_connections.json', 'w', encoding='utf-8') as f:
+        json.dump({'levels': levels, 'autoConnect': True, 'connections': []}, f, indent=2)
+    generated = time.perf_counter()
+
+    # --- convert ---
+    for stem in levels:
+        data = level_converter.parse_tmx_file(str(out_dir / f'{stem}.tmx'))
+        level_converter.validate_level(data, stem)
+        (out_dir / f'{stem}.h').write_text(level_converter.generate_header(data, f'{stem}.h'))
+    converted = time.perf_counter()
+
+    # --- connections ---
+    subprocess.run([sys.executable, str(tools_dir / 'compile_connections.py'),
+                    str(out_dir / 'world_connections.json'), str(out_dir),
+                    str(out_dir / 'world_connections.h')], check=True)
+    compiled = time.perf_counter()
+
+    print(f"Generated {rooms} rooms ({cols} per row) in {out_dir}")
+    print(f"  write TMX:           {generated - started:6.2f} s")
+    print(f"  level_converter:     {converted - generated:6.2f} s")
+    print(f"  compile_connections: {compiled - converted:6.2f} s")
+
+
+if __name__ == '__main__':
+    main()